@@ -1,7 +1,10 @@
 #include "admin_server.h"
 
+#include "base/util.h"
 #include "net/session.h"
 #include "frame/sf_logger.h"
+#include "monitor/cpu_profiler.h"
+#include "monitor/metrics.h"
 #include "server/range_server.h"
 #include "server/worker.h"
 
@@ -37,6 +40,16 @@ Status AdminServer::Start(uint16_t port) {
 }
 
 Status AdminServer::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(profile_mu_);
+        if (stopped_) return Status::OK();
+        stopped_ = true;
+    }
+    // 结束进行中的cpu profile，不等采样时间到
+    monitor::CPUProfiler::Instance()->Shutdown();
+    if (profile_thread_.joinable()) {
+        profile_thread_.join();
+    }
     return Status::OK();
 }
 
@@ -63,6 +76,12 @@ Status AdminServer::execute(const AdminRequest& req, AdminResponse* resp) {
             return getPending(req.get_pendings_req(), resp->mutable_get_pendings_resp());
         case FLUSH_DB:
             return flushDB(req.flush_db_req(), resp->mutable_flush_db_resp());
+        case GET_METRICS:
+            return getMetrics(req.get_metrics_req(), resp->mutable_get_metrics_resp());
+        case CPU_PROFILE:
+            return cpuProfile(req.cpu_profile_req(), resp->mutable_cpu_profile_resp());
+        case PRE_SPLIT:
+            return preSplit(req.pre_split_req(), resp->mutable_pre_split_resp());
         default:
             return Status(Status::kNotSupported, "admin type", std::to_string(req.typ()));
     }
@@ -79,27 +98,58 @@ void AdminServer::onMessage(const net::Context& ctx, const net::MessagePtr& msg)
 
     AdminResponse resp;
     Status ret = checkAuth(req.auth());
-    if (ret.ok()) {
+    if (ret.ok() && req.typ() == CPU_PROFILE) {
+        ret = startCPUProfile(ctx, msg->head, req);
+        if (ret.ok()) return;
+    } else if (ret.ok()) {
         ret = execute(req, &resp);
     }
+    reply(ctx, msg->head, req, ret, &resp);
+}
 
+void AdminServer::reply(const net::Context& ctx, const net::Head& req_head, const AdminRequest& req,
+                        const Status& ret, AdminResponse* resp) {
     if (!ret.ok()) {
         FLOG_WARN("[Admin] handle %s from %s error: %s", AdminType_Name(req.typ()).c_str(),
                 ctx.remote_addr.c_str(), ret.ToString().c_str());
-        resp.set_code(static_cast<uint32_t>(ret.code()));
-        resp.set_error_msg(ret.ToString());
+        resp->set_code(static_cast<uint32_t>(ret.code()));
+        resp->set_error_msg(ret.ToString());
     }
 
     auto resp_msg = net::NewMessage();
-    resp_msg->head.SetResp(msg->head);
-    resp_msg->body.resize(resp.ByteSizeLong());
-    resp.SerializeToArray(resp_msg->body.data(), static_cast<int>(resp_msg->body.size()));
+    resp_msg->head.SetResp(req_head);
+    resp_msg->body.resize(resp->ByteSizeLong());
+    resp->SerializeToArray(resp_msg->body.data(), static_cast<int>(resp_msg->body.size()));
     auto conn = ctx.session.lock();
     if (conn) {
         conn->Write(resp_msg);
     }
 }
 
+Status AdminServer::startCPUProfile(const net::Context& ctx, const net::Head& req_head,
+                                    const AdminRequest& req) {
+    std::lock_guard<std::mutex> lock(profile_mu_);
+    if (stopped_) {
+        return Status(Status::kShutdownInProgress, "admin server", "stopped");
+    }
+    if (profiling_) {
+        return Status(Status::kBusy, "cpu profile", "already running");
+    }
+    // 上一次的profile已经结束
+    if (profile_thread_.joinable()) {
+        profile_thread_.join();
+    }
+    profiling_ = true;
+    profile_thread_ = std::thread([this, ctx, req_head, req] {
+        AdminResponse resp;
+        auto ret = cpuProfile(req.cpu_profile_req(), resp.mutable_cpu_profile_resp());
+        reply(ctx, req_head, req, ret, &resp);
+        profiling_ = false;
+    });
+    AnnotateThread(profile_thread_.native_handle(), "admin-profile");
+    return Status::OK();
+}
+
 Status AdminServer::forceSplit(const ForceSplitRequest& req, ForceSplitResponse* resp) {
     auto rng = context_->range_server->Find(req.range_id());
     if (rng == nullptr) {
@@ -109,6 +159,22 @@ Status AdminServer::forceSplit(const ForceSplitRequest& req, ForceSplitResponse*
     return rng->ForceSplit(req.version(), resp->mutable_split_key());
 }
 
+Status AdminServer::preSplit(const PreSplitRequest& req, PreSplitResponse* resp) {
+    auto rng = context_->range_server->Find(req.range_id());
+    if (rng == nullptr) {
+        return Status(Status::kNotFound, "range", std::to_string(req.range_id()));
+    }
+    FLOG_INFO("[Admin] pre split range %" PRIu64 ", version: %" PRIu64 ", keys: %d, count: %u",
+            req.range_id(), req.version(), req.split_keys_size(), req.range_count());
+    std::vector<std::string> keys(req.split_keys().begin(), req.split_keys().end());
+    std::vector<std::string> split_keys;
+    auto s = rng->PreSplit(req.version(), std::move(keys), req.range_count(), &split_keys);
+    for (auto& key : split_keys) {
+        resp->add_split_keys(std::move(key));
+    }
+    return s;
+}
+
 Status AdminServer::compaction(const CompactionRequest& req, CompactionResponse* resp) {
     auto db = context_->rocks_db;
     rocksdb::Status s;
@@ -169,6 +235,34 @@ Status AdminServer::flushDB(const FlushDBRequest& req, FlushDBResponse* resp) {
     return Status::OK();
 }
 
+Status AdminServer::getMetrics(const GetMetricsRequest& req, GetMetricsResponse* resp) {
+    resp->set_text(monitor::metrics::Registry::Default()->Render());
+    return Status::OK();
+}
+
+Status AdminServer::cpuProfile(const CPUProfileRequest& req, CPUProfileResponse* resp) {
+    monitor::CPUProfileOptions opt;
+    if (req.seconds() > 0) opt.seconds = req.seconds();
+    if (req.frequency() > 0) opt.frequency = req.frequency();
+    for (const auto& pool : req.thread_pools()) {
+        opt.thread_prefixes.push_back(pool);
+    }
+
+    FLOG_WARN("[Admin] cpu profile start: seconds=%u, frequency=%u", opt.seconds, opt.frequency);
+    monitor::CPUProfileResult result;
+    auto s = monitor::CPUProfiler::Instance()->Profile(opt, &result);
+    if (!s.ok()) {
+        return s;
+    }
+    FLOG_WARN("[Admin] cpu profile finished: samples=%" PRIu64 ", dropped=%" PRIu64,
+            result.samples, result.dropped);
+
+    resp->set_collapsed(std::move(result.collapsed));
+    resp->set_samples(result.samples);
+    resp->set_dropped(result.dropped);
+    return Status::OK();
+}
+
 } // namespace admin
 } // namespace dataserver
 } // namespace sharkstore
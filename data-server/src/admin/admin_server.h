@@ -1,5 +1,9 @@
 _Pragma("once");
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #include "server/context_server.h"
 #include "proto/gen/ds_admin.pb.h"
 #include "net/server.h"
@@ -21,6 +25,11 @@ public:
 
 private:
     void onMessage(const net::Context& ctx, const net::MessagePtr& msg);
+    void reply(const net::Context& ctx, const net::Head& req_head, const ds_adminpb::AdminRequest& req,
+               const Status& ret, ds_adminpb::AdminResponse* resp);
+    // 采样要持续数秒，在单独的线程中执行，结束后再回应
+    Status startCPUProfile(const net::Context& ctx, const net::Head& req_head,
+                           const ds_adminpb::AdminRequest& req);
 
     Status checkAuth(const ds_adminpb::AdminAuth& auth);
     Status execute(const ds_adminpb::AdminRequest& req, ds_adminpb::AdminResponse* resp);
@@ -29,15 +38,23 @@ private:
     Status getConfig(const ds_adminpb::GetConfigRequest& req, ds_adminpb::GetConfigResponse* resp);
     Status getInfo(const ds_adminpb::GetInfoRequest& req, ds_adminpb::GetInfoResponse* resp);
     Status forceSplit(const ds_adminpb::ForceSplitRequest& req, ds_adminpb::ForceSplitResponse* resp);
+    Status preSplit(const ds_adminpb::PreSplitRequest& req, ds_adminpb::PreSplitResponse* resp);
     Status compaction(const ds_adminpb::CompactionRequest& req, ds_adminpb::CompactionResponse* resp);
     Status clearQueue(const ds_adminpb::ClearQueueRequest& req, ds_adminpb::ClearQueueResponse* resp);
     Status getPending(const ds_adminpb::GetPendingsRequest& req, ds_adminpb::GetPendingsResponse* resp);
     Status flushDB(const ds_adminpb::FlushDBRequest& req, ds_adminpb::FlushDBResponse* resp);
+    Status getMetrics(const ds_adminpb::GetMetricsRequest& req, ds_adminpb::GetMetricsResponse* resp);
+    Status cpuProfile(const ds_adminpb::CPUProfileRequest& req, ds_adminpb::CPUProfileResponse* resp);
 
 private:
     server::ContextServer* context_ = nullptr;
     std::unique_ptr<net::Server> net_server_;
     // TODO: worker thread
+
+    std::mutex profile_mu_;
+    bool stopped_ = false;
+    std::atomic<bool> profiling_ = {false};
+    std::thread profile_thread_;
 };
 
 } // namespace admin
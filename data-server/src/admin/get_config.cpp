@@ -65,34 +65,62 @@ static const ConfigGeterMap cfg_getters = {
         ADD_CFG_GETTER(rocksdb, ttl),
         ADD_CFG_GETTER(rocksdb, enable_stats),
         ADD_CFG_GETTER(rocksdb, enable_debug_log),
+        ADD_CFG_GETTER(rocksdb, tombstone_compact_interval_ms),
+        ADD_CFG_GETTER(rocksdb, tombstone_compact_percent),
+        ADD_CFG_GETTER(rocksdb, compact_on_deletion_window),
+        ADD_CFG_GETTER(rocksdb, compact_on_deletion_trigger),
 
         // range
         ADD_CFG_GETTER(range, recover_skip_fail),
         ADD_CFG_GETTER(range, recover_concurrency),
+        ADD_CFG_GETTER(range, recover_in_background),
         ADD_CFG_GETTER(range, check_size),
         ADD_CFG_GETTER(range, split_size),
         ADD_CFG_GETTER(range, max_size),
         ADD_CFG_GETTER(range, worker_threads),
         ADD_CFG_GETTER(range, access_mode),
+        ADD_CFG_GETTER(range, lock_lease_in_memory),
+        ADD_CFG_GETTER(range, hotkey_top_k),
+        ADD_CFG_GETTER(range, hotkey_prefix_len),
+        ADD_CFG_GETTER(range, hotkey_sample_interval),
+        ADD_CFG_GETTER(range, leader_time_tick),
+        ADD_CFG_GETTER(range, watch_log_retention),
+        ADD_CFG_GETTER(range, mvcc),
+        ADD_CFG_GETTER(range, mvcc_gc_seconds),
+        ADD_CFG_GETTER(range, leader_balance_interval_ms),
+        ADD_CFG_GETTER(range, leader_balance_tolerance),
+        ADD_CFG_GETTER(range, leader_balance_max_transfers),
+        ADD_CFG_GETTER(range, leader_balance_cooldown),
 
         // raft
         ADD_CFG_GETTER(raft, port),
         ADD_CFG_GETTER_STR(raft, log_path),
         ADD_CFG_GETTER(raft, log_file_size),
         ADD_CFG_GETTER(raft, max_log_files),
+        ADD_CFG_GETTER(raft, log_preallocate_size),
+        ADD_CFG_GETTER(raft, recycle_log_files),
+        ADD_CFG_GETTER(raft, log_mmap_budget),
         ADD_CFG_GETTER(raft, allow_log_corrupt),
         ADD_CFG_GETTER(raft, consensus_threads),
         ADD_CFG_GETTER(raft, consensus_queue),
+        ADD_CFG_GETTER(raft, apply_in_place),
         ADD_CFG_GETTER(raft, apply_threads),
         ADD_CFG_GETTER(raft, apply_queue),
         ADD_CFG_GETTER(raft, transport_send_threads),
         ADD_CFG_GETTER(raft, transport_recv_threads),
         ADD_CFG_GETTER(raft, tick_interval_ms),
+        ADD_CFG_GETTER(raft, election_tick),
+        ADD_CFG_GETTER(raft, pre_vote),
+        ADD_CFG_GETTER(raft, check_quorum),
         ADD_CFG_GETTER(raft, max_msg_size),
 
         // metric
         ADD_CFG_GETTER(metric, interval),
 
+        // memory
+        ADD_CFG_GETTER(memory, soft_limit),
+        ADD_CFG_GETTER(memory, hard_limit),
+
         // worker
         ADD_CFG_GETTER_STR(worker, ip_addr),
         ADD_CFG_GETTER(worker, port),
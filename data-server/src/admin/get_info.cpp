@@ -5,10 +5,13 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include "base/mem_tracker.h"
+#include "server/leader_balancer.h"
 #include "server/version.h"
 #include "server/range_server.h"
 #include "server/run_status.h"
 #include "server/worker.h"
+#include "storage/compactor.h"
 
 namespace sharkstore {
 namespace dataserver {
@@ -111,6 +114,48 @@ static Status getRangeInfo(ContextServer* ctx, const vector<string>& path, JsonW
     writer.Key("submit_queue");
     writer.Uint64(rng->GetSubmitQueueSize());
 
+    storage::TombstoneStats tombstone_stats;
+    auto s = storage::GetTombstoneStats(ctx->rocks_db, meta.start_key(), meta.end_key(),
+                                        &tombstone_stats);
+    if (s.ok()) {
+        writer.Key("tombstone");
+        writer.StartObject();
+        writer.Key("files");
+        writer.Uint64(tombstone_stats.num_files);
+        writer.Key("entries");
+        writer.Uint64(tombstone_stats.num_entries);
+        writer.Key("deletions");
+        writer.Uint64(tombstone_stats.num_deletions);
+        writer.Key("percent");
+        writer.Uint64(tombstone_stats.Percent());
+        writer.EndObject();
+    }
+
+    storage::HotKeysStat hot_keys;
+    rng->GetHotKeys(&hot_keys);
+    auto write_hot_keys = [&writer](const char* name, const std::vector<storage::HotKey>& keys) {
+        writer.Key(name);
+        writer.StartArray();
+        for (const auto& hk : keys) {
+            writer.StartObject();
+            writer.Key("key");
+            writer.String(EncodeToHex(hk.key).c_str());
+            writer.Key("count");
+            writer.Uint64(hk.count);
+            writer.Key("error");
+            writer.Uint64(hk.error);
+            writer.EndObject();
+        }
+        writer.EndArray();
+    };
+    writer.Key("hot_keys");
+    writer.StartObject();
+    write_hot_keys("read", hot_keys.read_keys);
+    write_hot_keys("write", hot_keys.write_keys);
+    write_hot_keys("read_prefix", hot_keys.read_prefixes);
+    write_hot_keys("write_prefix", hot_keys.write_prefixes);
+    writer.EndObject();
+
     // table info
     writer.Key("table_id");
     writer.Uint64(meta.table_id());
@@ -142,6 +187,33 @@ static Status getRaftInfo(ContextServer* ctx, const vector<string>& path, JsonWr
         writer.Uint64(ss.total_snap_applying);
         writer.Key("snap_send");
         writer.Uint64(ss.total_snap_sending);
+        writer.Key("compress_raw_bytes");
+        writer.Uint64(ss.compress_raw_bytes);
+        writer.Key("compress_out_bytes");
+        writer.Uint64(ss.compress_out_bytes);
+        writer.Key("compress_usecs");
+        writer.Uint64(ss.compress_usecs);
+        writer.Key("decompress_usecs");
+        writer.Uint64(ss.decompress_usecs);
+
+        auto balancer = ctx->leader_balancer;
+        if (balancer != nullptr) {
+            server::LeaderBalanceStats bs;
+            balancer->GetStats(&bs);
+            writer.Key("leader_balance");
+            writer.StartObject();
+            writer.Key("transfers");
+            writer.Uint64(bs.transfer_count);
+            writer.Key("skew_percent");
+            writer.Uint64(bs.skew_percent);
+            writer.Key("unbalanced_ms");
+            writer.Uint64(bs.unbalanced_msec);
+            writer.Key("last_converge_ms");
+            writer.Uint64(bs.last_converge_msec);
+            writer.Key("converge_count");
+            writer.Uint64(bs.converge_count);
+            writer.EndObject();
+        }
         return Status::OK();
     }
 
@@ -170,6 +242,8 @@ static Status getRaftInfo(ContextServer* ctx, const vector<string>& path, JsonWr
     writer.Uint64(stat.commit);
     writer.Key("applied");
     writer.Uint64(stat.applied);
+    writer.Key("apply_pending");
+    writer.Uint64(stat.apply_pending);
     writer.Key("state");
     writer.String(stat.state.c_str());
     writer.Key("replicas");
@@ -199,9 +273,78 @@ static Status getRaftInfo(ContextServer* ctx, const vector<string>& path, JsonWr
     return Status::OK();
 }
 
+static void writeMemTracker(const MemTracker& tracker, int depth, JsonWriter& writer) {
+    writer.Key("usage");
+    writer.Int64(tracker.Usage());
+    writer.Key("peak");
+    writer.Int64(tracker.Peak());
+    if (tracker.SoftLimit() > 0 || tracker.HardLimit() > 0) {
+        writer.Key("soft_limit");
+        writer.Int64(tracker.SoftLimit());
+        writer.Key("hard_limit");
+        writer.Int64(tracker.HardLimit());
+    }
+    if (tracker.ChildrenCount() == 0) {
+        return;
+    }
+    // 子节点太多（如每个range一个）时只输出个数
+    if (depth <= 0) {
+        writer.Key("children_count");
+        writer.Uint64(tracker.ChildrenCount());
+        return;
+    }
+    writer.Key("children");
+    writer.StartObject();
+    tracker.VisitChildren([depth, &writer](const MemTracker& child) {
+        writer.Key(child.Label().c_str());
+        writer.StartObject();
+        writeMemTracker(child, depth - 1, writer);
+        writer.EndObject();
+    });
+    writer.EndObject();
+}
+
+static Status getMemoryInfo(ContextServer* ctx, const vector<string>& path, JsonWriter& writer) {
+    assert(!path.empty());
+    auto root = MemTracker::Root();
+    if (path.size() == 1) {
+        writer.Key("level");
+        writer.String(MemTrackerLevelName(root->CheckLimit()).c_str());
+        writeMemTracker(*root, 2, writer);
+        return Status::OK();
+    }
+
+    // memory.{range_id}
+    uint64_t id = 0;
+    try {
+        id = std::stoull(path[1]);
+    } catch (std::exception &e) {
+        return Status(Status::kInvalidArgument, "range id", path[1]);
+    }
+    auto rng = ctx->range_server->Find(id);
+    if (rng == nullptr) {
+        return Status(Status::kNotFound, "range", std::to_string(id));
+    }
+    writeMemTracker(rng->GetMemTracker(), 1, writer);
+    return Status::OK();
+}
+
 static Status getRocksdbInfo(ContextServer* ctx, const vector<string>& path, JsonWriter& writer) {
     writer.Key("version");
     writer.String(server::GetRocksdbVersion().c_str());
+
+    auto compactor = ctx->compactor;
+    if (compactor != nullptr) {
+        writer.Key("compactor");
+        writer.StartObject();
+        writer.Key("pending");
+        writer.Uint64(compactor->PendingCount());
+        writer.Key("compacted");
+        writer.Uint64(compactor->CompactedCount());
+        writer.Key("skipped");
+        writer.Uint64(compactor->SkippedCount());
+        writer.EndObject();
+    }
     return Status::OK();
 }
 
@@ -211,6 +354,7 @@ static const GetInfoFunMap get_info_funcs = {
         {"raft", getRaftInfo},
         {"range", getRangeInfo},
         {"rocksdb", getRocksdbInfo},
+        {"memory", getMemoryInfo},
 };
 
 Status AdminServer::getInfo(const ds_adminpb::GetInfoRequest& req, ds_adminpb::GetInfoResponse* resp) {
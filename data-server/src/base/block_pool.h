@@ -0,0 +1,172 @@
+_Pragma("once");
+
+#include <stdlib.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace sharkstore {
+
+struct BlockPoolStats {
+    std::atomic<uint64_t> sys_allocs = {0};  // 池中没有空闲块，向系统申请的次数
+    std::atomic<uint64_t> sys_frees = {0};   // 空闲块超过缓存上限，还给系统的次数
+};
+
+// 定长内存块池
+// 每个线程缓存一批空闲块，分配和释放不加锁；
+// 线程缓存超过上限时整批归还到全局，线程缓存空了从全局取一批。
+// 请求一般在网络线程分配、在worker/apply线程释放，通过全局的批量交换保持两边平衡
+template <size_t kBlockSize>
+class BlockPool {
+public:
+    static void* Allocate() {
+        auto& c = cache();
+        if (c.head == nullptr) {
+            c.head = depot().Take();
+            c.count = c.head != nullptr ? kBatchSize : 0;
+        }
+        if (c.head != nullptr) {
+            auto b = c.head;
+            c.head = b->next;
+            --c.count;
+            return b;
+        }
+        Stats().sys_allocs.fetch_add(1, std::memory_order_relaxed);
+        auto p = ::malloc(kAllocSize);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    static void Free(void* p) {
+        auto& c = cache();
+        auto b = static_cast<Block*>(p);
+        b->next = c.head;
+        c.head = b;
+        if (++c.count >= 2 * kBatchSize) {
+            c.count -= kBatchSize;
+            depot().Put(c.detach(kBatchSize));
+        }
+    }
+
+    static BlockPoolStats& Stats() {
+        static BlockPoolStats stats;
+        return stats;
+    }
+
+private:
+    struct Block {
+        Block* next;
+    };
+
+    static const size_t kAllocSize = kBlockSize < sizeof(Block) ? sizeof(Block) : kBlockSize;
+    static const size_t kBatchSize = 64;
+    // 全局最多缓存的批数，超过的还给系统
+    static const size_t kMaxDepotBatches = 256;
+
+    static void freeBatch(Block* head) {
+        while (head != nullptr) {
+            auto next = head->next;
+            ::free(head);
+            Stats().sys_frees.fetch_add(1, std::memory_order_relaxed);
+            head = next;
+        }
+    }
+
+    // 全局的空闲块，每批kBatchSize个
+    class Depot {
+    public:
+        Block* Take() {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (batches_.empty()) {
+                return nullptr;
+            }
+            auto b = batches_.back();
+            batches_.pop_back();
+            return b;
+        }
+
+        void Put(Block* batch) {
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                if (batches_.size() < kMaxDepotBatches) {
+                    batches_.push_back(batch);
+                    return;
+                }
+            }
+            freeBatch(batch);
+        }
+
+    private:
+        std::mutex mu_;
+        std::vector<Block*> batches_;
+    };
+
+    struct LocalCache {
+        Block* head = nullptr;
+        size_t count = 0;
+
+        // 从链表头部摘下n个块
+        Block* detach(size_t n) {
+            auto batch = head;
+            auto tail = head;
+            for (size_t i = 1; i < n; ++i) {
+                tail = tail->next;
+            }
+            head = tail->next;
+            tail->next = nullptr;
+            return batch;
+        }
+
+        // 线程退出时归还
+        ~LocalCache() {
+            while (count >= kBatchSize) {
+                count -= kBatchSize;
+                depot().Put(detach(kBatchSize));
+            }
+            freeBatch(head);
+        }
+    };
+
+    // 不析构，线程退出时可能还在使用
+    static Depot& depot() {
+        static Depot* d = new Depot;
+        return *d;
+    }
+
+    static LocalCache& cache() {
+        static thread_local LocalCache c;
+        return c;
+    }
+};
+
+// 继承后T的new/delete从BlockPool分配；
+// 大小不同的子类(sized delete传入的是实际大小)仍然使用全局的new/delete
+template <class T>
+class PoolAllocated {
+public:
+    static void* operator new(size_t size) {
+        if (size == sizeof(T)) {
+            return BlockPool<sizeof(T)>::Allocate();
+        }
+        return ::operator new(size);
+    }
+
+    static void operator delete(void* p, size_t size) {
+        if (p == nullptr) {
+            return;
+        }
+        if (size == sizeof(T)) {
+            BlockPool<sizeof(T)>::Free(p);
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    static BlockPoolStats& PoolStats() { return BlockPool<sizeof(T)>::Stats(); }
+};
+
+}  // namespace sharkstore
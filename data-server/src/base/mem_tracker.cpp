@@ -0,0 +1,114 @@
+#include "mem_tracker.h"
+
+#include <algorithm>
+
+namespace sharkstore {
+
+MemTracker::MemTracker(const std::string& label, MemTracker* parent)
+    : label_(label), parent_(parent) {
+    if (parent_ != nullptr) {
+        parent_->addChild(this);
+    }
+}
+
+MemTracker::~MemTracker() {
+    if (parent_ != nullptr) {
+        parent_->removeChild(this);
+        auto left = usage_.load();
+        for (auto p = parent_; p != nullptr; p = p->parent_) {
+            p->usage_.fetch_sub(left, std::memory_order_relaxed);
+        }
+    }
+}
+
+MemTracker* MemTracker::Root() {
+    static MemTracker* root = new MemTracker("root", nullptr);
+    return root;
+}
+
+void MemTracker::Consume(int64_t bytes) {
+    if (bytes == 0) return;
+    for (auto t = this; t != nullptr; t = t->parent_) {
+        auto now = t->usage_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        if (bytes > 0) {
+            auto peak = t->peak_.load(std::memory_order_relaxed);
+            while (now > peak &&
+                   !t->peak_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+            }
+        }
+    }
+}
+
+void MemTracker::Set(int64_t bytes) {
+    // 并发Set时以后一次为准，差值仍然能正确累加到祖先节点
+    auto old = usage_.load(std::memory_order_relaxed);
+    while (!usage_.compare_exchange_weak(old, bytes, std::memory_order_relaxed)) {
+    }
+    auto peak = peak_.load(std::memory_order_relaxed);
+    while (bytes > peak && !peak_.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+    }
+    if (parent_ != nullptr) {
+        parent_->Consume(bytes - old);
+    }
+}
+
+void MemTracker::SetLimit(int64_t soft_limit, int64_t hard_limit) {
+    soft_limit_ = soft_limit;
+    hard_limit_ = hard_limit;
+}
+
+MemTracker::Level MemTracker::CheckLimit() const {
+    auto level = Level::kNormal;
+    for (auto t = this; t != nullptr; t = t->parent_) {
+        auto usage = t->Usage();
+        auto hard = t->HardLimit();
+        if (hard > 0 && usage >= hard) {
+            return Level::kHard;
+        }
+        auto soft = t->SoftLimit();
+        if (soft > 0 && usage >= soft) {
+            level = Level::kSoft;
+        }
+    }
+    return level;
+}
+
+size_t MemTracker::ChildrenCount() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return children_.size();
+}
+
+void MemTracker::VisitChildren(const std::function<void(const MemTracker&)>& visitor) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (auto child : children_) {
+        visitor(*child);
+    }
+}
+
+void MemTracker::addChild(MemTracker* child) {
+    std::lock_guard<std::mutex> lock(mu_);
+    children_.push_back(child);
+}
+
+void MemTracker::removeChild(MemTracker* child) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = std::find(children_.begin(), children_.end(), child);
+    if (it != children_.end()) {
+        children_.erase(it);
+    }
+}
+
+std::string MemTrackerLevelName(MemTracker::Level level) {
+    switch (level) {
+        case MemTracker::Level::kNormal:
+            return "normal";
+        case MemTracker::Level::kSoft:
+            return "soft";
+        case MemTracker::Level::kHard:
+            return "hard";
+        default:
+            return "unknown";
+    }
+}
+
+} /* namespace sharkstore */
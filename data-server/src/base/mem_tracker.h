@@ -0,0 +1,92 @@
+_Pragma("once");
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sharkstore {
+
+// 内存使用统计，按子系统/range组织成树形结构
+// 子节点的用量同时累加到所有祖先节点上，根节点即为整个进程的统计量
+// 每个节点可以设置软/硬限制(0表示不限制)，由使用方根据CheckLimit的结果决定如何减载
+class MemTracker {
+public:
+    enum class Level {
+        kNormal = 0,
+        kSoft,  // 超过软限制
+        kHard,  // 超过硬限制
+    };
+
+    // parent为nullptr表示根节点
+    MemTracker(const std::string& label, MemTracker* parent);
+    // 从父节点摘除，并把剩余的用量从祖先节点上扣除
+    ~MemTracker();
+
+    MemTracker(const MemTracker&) = delete;
+    MemTracker& operator=(const MemTracker&) = delete;
+
+    // 进程级的根节点，永不释放
+    static MemTracker* Root();
+
+    const std::string& Label() const { return label_; }
+    MemTracker* Parent() const { return parent_; }
+
+    void Consume(int64_t bytes);
+    void Release(int64_t bytes) { Consume(-bytes); }
+    // 外部采集的量(如rocksdb memtable)，直接设置为当前值
+    void Set(int64_t bytes);
+
+    int64_t Usage() const { return usage_.load(std::memory_order_relaxed); }
+    int64_t Peak() const { return peak_.load(std::memory_order_relaxed); }
+
+    void SetLimit(int64_t soft_limit, int64_t hard_limit);
+    int64_t SoftLimit() const { return soft_limit_.load(std::memory_order_relaxed); }
+    int64_t HardLimit() const { return hard_limit_.load(std::memory_order_relaxed); }
+
+    // 检查自身及所有祖先节点的限制，返回其中最严重的级别
+    Level CheckLimit() const;
+    bool SoftLimitExceeded() const { return CheckLimit() != Level::kNormal; }
+    bool HardLimitExceeded() const { return CheckLimit() == Level::kHard; }
+
+    size_t ChildrenCount() const;
+    void VisitChildren(const std::function<void(const MemTracker&)>& visitor) const;
+
+private:
+    void addChild(MemTracker* child);
+    void removeChild(MemTracker* child);
+
+private:
+    const std::string label_;
+    MemTracker* const parent_ = nullptr;
+
+    std::atomic<int64_t> usage_ = {0};
+    std::atomic<int64_t> peak_ = {0};
+    std::atomic<int64_t> soft_limit_ = {0};
+    std::atomic<int64_t> hard_limit_ = {0};
+
+    std::vector<MemTracker*> children_;
+    mutable std::mutex mu_;
+};
+
+// 作用域内临时占用的内存，析构时释放
+class ScopedMemConsume {
+public:
+    ScopedMemConsume(MemTracker* tracker, int64_t bytes) : tracker_(tracker), bytes_(bytes) {
+        tracker_->Consume(bytes_);
+    }
+    ~ScopedMemConsume() { tracker_->Release(bytes_); }
+
+    ScopedMemConsume(const ScopedMemConsume&) = delete;
+    ScopedMemConsume& operator=(const ScopedMemConsume&) = delete;
+
+private:
+    MemTracker* tracker_ = nullptr;
+    const int64_t bytes_ = 0;
+};
+
+std::string MemTrackerLevelName(MemTracker::Level level);
+
+} /* namespace sharkstore */
@@ -360,4 +360,28 @@ std::string FindMiddle(const std::string& left, const std::string& right) {
     return result;
 }
 
+std::vector<std::string> FindSplitKeys(const std::string& left, const std::string& right,
+                                       size_t count) {
+    std::vector<std::string> keys;
+    if (left >= right || count < 2) {
+        return keys;
+    }
+    auto common_len = commonPrefixLen(left, right);
+    auto left_val = approximateInt(left, common_len);
+    auto right_val = approximateInt(right, common_len);
+    auto step = (right_val - left_val) / count;
+    for (size_t i = 1; i < count; ++i) {
+        std::string key(left.begin(), left.begin() + common_len);
+        key += approximateStr(left_val + step * i);
+        while (!key.empty() && key.back() == '\0') {
+            key.pop_back();
+        }
+        // 区间太小时相邻的key可能相同
+        if (key > left && key < right && (keys.empty() || key > keys.back())) {
+            keys.push_back(std::move(key));
+        }
+    }
+    return keys;
+}
+
 } /* namespace sharkstore */
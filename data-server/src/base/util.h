@@ -34,4 +34,8 @@ int ParseBytesValue(const char* str, int64_t* value);
 // left should less than right
 std::string FindMiddle(const std::string& left, const std::string& right);
 
+// 把[left, right)按key空间平均分成count份，返回递增的分裂点(最多count-1个)
+std::vector<std::string> FindSplitKeys(const std::string& left, const std::string& right,
+                                       size_t count);
+
 } /* namespace sharkstore */
@@ -138,6 +138,28 @@ static int load_rocksdb_config(IniContext *ini_context) {
     ds_config.rocksdb_config.enable_debug_log =
             (bool)iniGetIntValue(section, "enable_debug_log",ini_context, 0);
 
+    ds_config.rocksdb_config.tombstone_compact_interval_ms = (size_t)load_integer_value_atleast(
+            ini_context, section, "tombstone_compact_interval_ms", 10000, 0);
+    ds_config.rocksdb_config.tombstone_compact_percent =
+            load_integer_value_atleast(ini_context, section, "tombstone_compact_percent", 30, 1);
+    if (ds_config.rocksdb_config.tombstone_compact_percent > 100) {
+        fprintf(stderr, "invalid rocksdb tombstone_compact_percent config(%d)",
+                ds_config.rocksdb_config.tombstone_compact_percent);
+        return -1;
+    }
+
+    ds_config.rocksdb_config.compact_on_deletion_window = (size_t)load_integer_value_atleast(
+            ini_context, section, "compact_on_deletion_window", 0, 0);
+    ds_config.rocksdb_config.compact_on_deletion_trigger = (size_t)load_integer_value_atleast(
+            ini_context, section, "compact_on_deletion_trigger", 0, 0);
+    if (ds_config.rocksdb_config.compact_on_deletion_trigger >
+            ds_config.rocksdb_config.compact_on_deletion_window) {
+        fprintf(stderr, "invalid rocksdb compact_on_deletion_trigger config(%lu), "
+                "should not be greater than compact_on_deletion_window",
+                ds_config.rocksdb_config.compact_on_deletion_trigger);
+        return -1;
+    }
+
     return 0;
 }
 
@@ -178,6 +200,10 @@ void print_rocksdb_config() {
               "\n\tttl: %d"
               "\n\tenable_stats: %d"
               "\n\tenable_debug_log: %d"
+              "\n\ttombstone_compact_interval_ms: %lu"
+              "\n\ttombstone_compact_percent: %d"
+              "\n\tcompact_on_deletion_window: %lu"
+              "\n\tcompact_on_deletion_trigger: %lu"
               ,
               ds_config.rocksdb_config.path,
               ds_config.rocksdb_config.block_cache_size,
@@ -213,7 +239,11 @@ void print_rocksdb_config() {
               ds_config.rocksdb_config.blob_ttl_range,
               ds_config.rocksdb_config.ttl,
               ds_config.rocksdb_config.enable_stats,
-              ds_config.rocksdb_config.enable_debug_log
+              ds_config.rocksdb_config.enable_debug_log,
+              ds_config.rocksdb_config.tombstone_compact_interval_ms,
+              ds_config.rocksdb_config.tombstone_compact_percent,
+              ds_config.rocksdb_config.compact_on_deletion_window,
+              ds_config.rocksdb_config.compact_on_deletion_trigger
               );
 }
 
@@ -238,6 +268,44 @@ static int load_range_config(IniContext *ini_context) {
     ds_config.range_config.recover_concurrency =
             load_integer_value_atleast(ini_context, section, "recover_concurrency", 8, 1);
 
+    ds_config.range_config.recover_in_background =
+            (bool)iniGetIntValue(section, "recover_in_background", ini_context, 0);
+
+    ds_config.range_config.lock_lease_in_memory =
+            (bool)iniGetIntValue(section, "lock_lease_in_memory", ini_context, 0);
+
+    ds_config.range_config.hotkey_top_k =
+            load_integer_value_atleast(ini_context, section, "hotkey_top_k", 5, 0);
+    ds_config.range_config.hotkey_prefix_len =
+            load_integer_value_atleast(ini_context, section, "hotkey_prefix_len", 16, 0);
+    ds_config.range_config.hotkey_sample_interval =
+            load_integer_value_atleast(ini_context, section, "hotkey_sample_interval", 4, 1);
+
+    ds_config.range_config.leader_time_tick =
+            (bool)iniGetIntValue(section, "leader_time_tick", ini_context, 0);
+
+    ds_config.range_config.watch_log_retention =
+            load_integer_value_atleast(ini_context, section, "watch_log_retention", 100000, 0);
+
+    ds_config.range_config.mvcc = (bool)iniGetIntValue(section, "mvcc", ini_context, 0);
+    ds_config.range_config.mvcc_gc_seconds =
+            load_integer_value_atleast(ini_context, section, "mvcc_gc_seconds", 600, 1);
+    if (ds_config.range_config.mvcc && ds_config.rocksdb_config.storage_type == 1 &&
+        ds_config.rocksdb_config.ttl > 0) {
+        FLOG_ERROR("load range config error, mvcc is not supported with blobdb ttl");
+        return -1;
+    }
+
+    ds_config.range_config.leader_balance_interval_ms =
+            (size_t)load_integer_value_atleast(ini_context, section,
+                                               "leader_balance_interval_ms", 0, 0);
+    ds_config.range_config.leader_balance_tolerance =
+            load_integer_value_atleast(ini_context, section, "leader_balance_tolerance", 10, 1);
+    ds_config.range_config.leader_balance_max_transfers = load_integer_value_atleast(
+            ini_context, section, "leader_balance_max_transfers", 8, 1);
+    ds_config.range_config.leader_balance_cooldown =
+            load_integer_value_atleast(ini_context, section, "leader_balance_cooldown", 300, 0);
+
     ds_config.range_config.access_mode =
         iniGetIntValue(section, "access_mode", ini_context, 0);
     if (ds_config.range_config.access_mode != 0 && ds_config.range_config.access_mode != 1) {
@@ -314,6 +382,13 @@ static int load_raft_config(IniContext *ini_context) {
     ds_config.raft_config.max_log_files = (size_t)load_integer_value_atleast(
             ini_context, section, "max_log_files", kDefaultMaxLogFiles, 2);
 
+    ds_config.raft_config.log_preallocate_size = load_bytes_value_ne(
+            ini_context, section, "log_preallocate_size", 1024 * 1024);
+    ds_config.raft_config.recycle_log_files = (size_t)load_integer_value_atleast(
+            ini_context, section, "recycle_log_files", 0, 0);
+    ds_config.raft_config.log_mmap_budget = load_bytes_value_ne(
+            ini_context, section, "log_mmap_budget", 256 * 1024 * 1024);
+
     ds_config.raft_config.allow_log_corrupt =
          iniGetIntValue(section, "allow_log_corrupt", ini_context, 1);
 
@@ -322,6 +397,8 @@ static int load_raft_config(IniContext *ini_context) {
     ds_config.raft_config.consensus_queue = (size_t)load_integer_value_atleast(
             ini_context, section , "consensus_queue", 100000, 100);
 
+    ds_config.raft_config.apply_in_place =
+         iniGetIntValue(section, "apply_in_place", ini_context, 1);
     ds_config.raft_config.apply_threads = (size_t)load_integer_value_atleast(
             ini_context, section, "apply_threads", 4, 1);
     ds_config.raft_config.apply_queue = (size_t)load_integer_value_atleast(
@@ -331,9 +408,20 @@ static int load_raft_config(IniContext *ini_context) {
             ini_context, section, "transport_send_threads", 4, 1);
     ds_config.raft_config.transport_recv_threads = (size_t)load_integer_value_atleast(
             ini_context, section, "transport_recv_threads", 4, 1);
+    ds_config.raft_config.transport_connections = (size_t)load_integer_value_atleast(
+            ini_context, section, "transport_connections", 2, 1);
+    ds_config.raft_config.transport_compression =
+        iniGetIntValue(section, "transport_compression", ini_context, 0);
+    ds_config.raft_config.transport_compress_threshold = load_bytes_value_ne(
+            ini_context, section, "transport_compress_threshold", 4 * 1024);
 
     ds_config.raft_config.tick_interval_ms = (size_t)load_integer_value_atleast(
            ini_context, section, "tick_interval", 500, 100);
+    ds_config.raft_config.election_tick = (size_t)load_integer_value_atleast(
+           ini_context, section, "election_tick", 5, 2);
+    ds_config.raft_config.pre_vote = iniGetIntValue(section, "pre_vote", ini_context, 1);
+    ds_config.raft_config.check_quorum =
+        iniGetIntValue(section, "check_quorum", ini_context, 1);
 
     ds_config.raft_config.max_msg_size =
         load_bytes_value_ne(ini_context, section, "max_msg_size", 1024 * 1024);
@@ -347,28 +435,48 @@ void print_raft_config() {
               "\n\tpath: %s"
               "\n\tlog_file_size: %lu"
               "\n\tmax_log_files: %lu"
+              "\n\tlog_preallocate_size: %lu"
+              "\n\trecycle_log_files: %lu"
+              "\n\tlog_mmap_budget: %lu"
               "\n\tallow_log_corrupt: %d"
               "\n\tconsensus_threads: %lu"
               "\n\tconsensus_queue: %lu"
+              "\n\tapply_in_place: %d"
               "\n\tapply_threads: %lu"
               "\n\tapply_queue: %lu"
               "\n\tsend_threads: %lu"
               "\n\trecv_threads: %lu"
+              "\n\ttransport_connections: %lu"
+              "\n\ttransport_compression: %d"
+              "\n\ttransport_compress_threshold: %lu"
               "\n\ttick_interval_ms: %lu"
+              "\n\telection_tick: %lu"
+              "\n\tpre_vote: %d"
+              "\n\tcheck_quorum: %d"
               "\n\tmax_msg_size: %lu"
               ,
               ds_config.raft_config.port,
               ds_config.raft_config.log_path,
               ds_config.raft_config.log_file_size,
               ds_config.raft_config.max_log_files,
+              ds_config.raft_config.log_preallocate_size,
+              ds_config.raft_config.recycle_log_files,
+              ds_config.raft_config.log_mmap_budget,
               ds_config.raft_config.allow_log_corrupt,
               ds_config.raft_config.consensus_threads,
               ds_config.raft_config.consensus_queue,
+              ds_config.raft_config.apply_in_place,
               ds_config.raft_config.apply_threads,
               ds_config.raft_config.apply_queue,
               ds_config.raft_config.transport_send_threads,
               ds_config.raft_config.transport_recv_threads,
+              ds_config.raft_config.transport_connections,
+              ds_config.raft_config.transport_compression,
+              ds_config.raft_config.transport_compress_threshold,
               ds_config.raft_config.tick_interval_ms,
+              ds_config.raft_config.election_tick,
+              ds_config.raft_config.pre_vote,
+              ds_config.raft_config.check_quorum,
               ds_config.raft_config.max_msg_size
     );
 }
@@ -384,6 +492,24 @@ static int load_metric_config(IniContext *ini_context) {
     return 0;
 }
 
+static int load_memory_config(IniContext *ini_context) {
+    char *section = "memory";
+
+    ds_config.memory_config.soft_limit =
+        load_bytes_value_ne(ini_context, section, "soft_limit", 0);
+    ds_config.memory_config.hard_limit =
+        load_bytes_value_ne(ini_context, section, "hard_limit", 0);
+
+    if (ds_config.memory_config.hard_limit > 0 &&
+        ds_config.memory_config.soft_limit > ds_config.memory_config.hard_limit) {
+        fprintf(stderr, "[ds config] memory soft_limit(%lu) should not be greater than hard_limit(%lu)\n",
+                ds_config.memory_config.soft_limit, ds_config.memory_config.hard_limit);
+        return -1;
+    }
+
+    return 0;
+}
+
 static int load_watch_config(IniContext *ini_context) {
     char *section = "watch";
 
@@ -509,6 +635,10 @@ int load_from_conf_file(IniContext *ini_context, const char *filename) {
         return -1;
     }
 
+    if (load_memory_config(ini_context) != 0) {
+        return -1;
+    }
+
     if(load_watch_config(ini_context) != 0) {
         return -1;
     }
@@ -46,6 +46,10 @@ typedef struct ds_config_s {
         int ttl;
         bool enable_stats;
         bool enable_debug_log;
+        size_t tombstone_compact_interval_ms; // 定向压缩的最小间隔，0表示不压缩
+        int tombstone_compact_percent;        // 删除标记超过该百分比时压缩
+        size_t compact_on_deletion_window;    // 0表示不启用
+        size_t compact_on_deletion_trigger;
     } rocksdb_config;
 
     struct {
@@ -58,11 +62,24 @@ typedef struct ds_config_s {
     struct {
         bool recover_skip_fail;
         int recover_concurrency;
+        bool recover_in_background;
         uint64_t check_size;
         uint64_t split_size;
         uint64_t max_size;
         int worker_threads;
         int access_mode; // 0 sql, 1 redis, default=0
+        bool lock_lease_in_memory; // leader在内存中处理锁续约，定时批量持久化
+        int hotkey_top_k;            // 每个range统计的读写热点key个数，0表示不统计
+        int hotkey_prefix_len;       // 按key前缀统计热点的前缀长度，0表示不统计前缀
+        int hotkey_sample_interval;  // 每多少次访问采样一次
+        bool leader_time_tick;  // 空闲的leader每个心跳周期提交一个空命令，推进follower的已应用时间
+        int watch_log_retention;  // watch变更日志保留的版本(raft index)个数，0表示不记录
+        bool mvcc;            // 数据按mvcc编码保存多个版本，只能在空的数据目录上开启
+        int mvcc_gc_seconds;  // 保留多少秒内的旧版本，更早的版本在compaction时回收
+        size_t leader_balance_interval_ms;  // 节点间leader均衡的间隔，0表示不均衡
+        int leader_balance_tolerance;       // leader比例相差超过该百分点才转移
+        int leader_balance_max_transfers;   // 每轮最多转移的leader个数
+        int leader_balance_cooldown;        // 同一个range两次转移的最小间隔(秒)
     } range_config;
 
     struct {
@@ -70,14 +87,24 @@ typedef struct ds_config_s {
         char log_path[PATH_MAX];
         size_t log_file_size;
         size_t max_log_files;
+        size_t log_preallocate_size;
+        size_t recycle_log_files;
+        size_t log_mmap_budget;
         int allow_log_corrupt;
         size_t consensus_threads;
         size_t consensus_queue;
+        int apply_in_place;  // 1 在consensus线程里apply, 0 交给apply线程池
         size_t apply_threads;
         size_t apply_queue;
         size_t transport_send_threads;
         size_t transport_recv_threads;
+        size_t transport_connections;
+        int transport_compression;  // 0 none, 1 zstd
+        size_t transport_compress_threshold;
         size_t tick_interval_ms;
+        size_t election_tick;  // 选举超时是几个tick，实际超时在1到2倍之间
+        int pre_vote;
+        int check_quorum;  // leader失去大多数副本后退位，租约内不响应更高term的投票
         size_t max_msg_size;
     } raft_config;
 
@@ -85,6 +112,11 @@ typedef struct ds_config_s {
         int interval;
     } metric_config;
 
+    struct {
+        size_t soft_limit;  // 超过后拒绝新的watch，缩减watch事件缓存; 0不限制
+        size_t hard_limit;  // 超过后拒绝写入; 0不限制
+    } memory_config;
+
     struct {
         int buffer_map_size;
         int buffer_queue_size;
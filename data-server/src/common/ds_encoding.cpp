@@ -4,6 +4,7 @@
 #include <string.h>
 #include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace sharkstore {
 namespace dataserver {
@@ -439,7 +440,7 @@ void EncodeFloatAscending(std::string *buf, double value) {
     uint64_t u = 0;
     assert(sizeof(u) == sizeof(double));
     memcpy(&u, &value, sizeof(double));
-    if (std::isnan(u)) {
+    if (std::isnan(value)) {
         buf->push_back(static_cast<char>(kFloatNaN));
         return;
     } else if (u == 0) {
@@ -509,7 +510,30 @@ bool DecodeVarintAscending(const std::string& buf, size_t& pos, int64_t* out) {
 }
 
 bool DecodeFloatAscending(const std::string& buf, size_t& pos, double* out) {
-    return false;
+    if (pos >= buf.size()) return false;
+    auto marker = static_cast<uint8_t>(buf[pos]);
+    switch (marker) {
+        case kFloatNaN:
+            ++pos;
+            *out = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        case kFloatZero:
+            ++pos;
+            *out = 0;
+            return true;
+        case kFloatNeg:
+        case kFloatPos: {
+            size_t offset = pos + 1;
+            uint64_t u = 0;
+            if (!DecodeUint64Ascending(buf, offset, &u)) return false;
+            if (marker == kFloatNeg) u = ~u;
+            memcpy(out, &u, sizeof(double));
+            pos = offset;
+            return true;
+        }
+        default:
+            return false;
+    }
 }
 
 bool DecodeBytesAscending(const std::string& buf, size_t& pos, std::string* out) {
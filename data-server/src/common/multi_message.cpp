@@ -0,0 +1,95 @@
+#include "multi_message.h"
+
+#include "frame/sf_logger.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace common {
+
+// 子请求被回应或者被丢弃(如超时)时都会被delete，以此计数
+class MultiMessage::SubMessage : public ProtoMessage {
+public:
+    explicit SubMessage(MultiMessage *parent) : parent_(parent) {}
+    ~SubMessage() override { parent_->unref(); }
+
+private:
+    MultiMessage *parent_ = nullptr;
+};
+
+MultiMessage::MultiMessage(ProtoMessage *msg, SocketSession *session, size_t count)
+    : msg_(msg), session_(session), resp_(new kvrpcpb::DsMultiResponse), replied_(count, 0) {
+    for (size_t i = 0; i < count; ++i) {
+        resp_->add_resps();
+    }
+}
+
+MultiMessage::~MultiMessage() {
+    delete msg_;
+}
+
+ProtoMessage *MultiMessage::NewSubMessage(size_t index, const kvrpcpb::MultiSubRequest &req) {
+    pending_.fetch_add(1);
+
+    auto sub = new SubMessage(this);
+    sub->session_id = msg_->session_id;
+    sub->begin_time = msg_->begin_time;
+    sub->expire_time = msg_->expire_time;
+    sub->header = msg_->header;
+    sub->header.func_id = static_cast<short>(req.func_id());
+    sub->header.body_len = static_cast<int>(req.body().size());
+    // 回应时通过msg_id找到对应的子请求
+    sub->header.msg_id = index;
+    sub->socket = this;
+    sub->body.assign(req.body().begin(), req.body().end());
+
+    resp_->mutable_resps(static_cast<int>(index))->set_func_id(req.func_id());
+    return sub;
+}
+
+void MultiMessage::SetError(size_t index, uint32_t func_id, const std::string &message) {
+    auto sub_resp = resp_->mutable_resps(static_cast<int>(index));
+    sub_resp->set_func_id(func_id);
+    sub_resp->mutable_error()->set_message(message);
+    replied_[index] = 1;
+}
+
+void MultiMessage::Release() { unref(); }
+
+int MultiMessage::Send(response_buff_t *response) {
+    auto index = static_cast<size_t>(response->msg_id);
+    if (index < replied_.size()) {
+        auto sub_resp = resp_->mutable_resps(static_cast<int>(index));
+        sub_resp->set_body(response->buff + header_size, response->buff_len - header_size);
+        replied_[index] = 1;
+    } else {
+        FLOG_ERROR("multi request: invalid sub response index %zu", index);
+    }
+    delete_response_buff(response);
+    return 0;
+}
+
+bool MultiMessage::Closed(uint64_t session_id) {
+    return msg_->socket->Closed(session_id);
+}
+
+void MultiMessage::unref() {
+    if (pending_.fetch_sub(1) == 1) {
+        reply();
+        delete this;
+    }
+}
+
+void MultiMessage::reply() {
+    for (size_t i = 0; i < replied_.size(); ++i) {
+        if (!replied_[i]) {
+            resp_->mutable_resps(static_cast<int>(i))->mutable_error()->set_message("no response");
+        }
+    }
+    // Send会delete msg和resp
+    session_->Send(msg_, resp_.release());
+    msg_ = nullptr;
+}
+
+}  // namespace common
+}  // namespace dataserver
+}  // namespace sharkstore
@@ -0,0 +1,60 @@
+_Pragma("once");
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "proto/gen/kvrpcpb.pb.h"
+
+#include "socket_base.h"
+#include "socket_message.h"
+#include "socket_session.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace common {
+
+// 一个DsMultiRequest批量请求
+// 每个子请求生成一个ProtoMessage，按单独请求走原有的处理流程，
+// 子请求的socket指向MultiMessage，回应在这里收集，全部完成后合并成一个DsMultiResponse发送
+class MultiMessage : public SocketBase {
+public:
+    // msg为原始的批量请求，count为子请求个数
+    MultiMessage(ProtoMessage *msg, SocketSession *session, size_t count);
+    ~MultiMessage();
+
+    MultiMessage(const MultiMessage &) = delete;
+    MultiMessage &operator=(const MultiMessage &) = delete;
+
+    // 生成第index个子请求
+    ProtoMessage *NewSubMessage(size_t index, const kvrpcpb::MultiSubRequest &req);
+
+    // 第index个子请求不执行，直接回应错误
+    void SetError(size_t index, uint32_t func_id, const std::string &message);
+
+    // 所有子请求已分发完，之后最后一个子请求结束时发送回应（然后delete this）
+    void Release();
+
+    // 子请求的回应
+    int Send(response_buff_t *response) override;
+    bool Closed(uint64_t session_id) override;
+
+private:
+    class SubMessage;
+
+    void unref();
+    void reply();
+
+private:
+    ProtoMessage *msg_ = nullptr;
+    SocketSession *session_ = nullptr;
+    std::unique_ptr<kvrpcpb::DsMultiResponse> resp_;
+    std::vector<char> replied_;  // 每个子请求一个字节，不同线程写不同的元素
+    // 分发中的引用 + 未结束的子请求数
+    std::atomic<size_t> pending_ = {1};
+};
+
+}  // namespace common
+}  // namespace dataserver
+}  // namespace sharkstore
@@ -3,6 +3,7 @@ _Pragma("once");
 #include <vector>
 #include <google/protobuf/message.h>
 
+#include "base/block_pool.h"
 #include "proto/gen/errorpb.pb.h"
 #include "proto/gen/kvrpcpb.pb.h"
 
@@ -14,7 +15,8 @@ namespace sharkstore {
 namespace dataserver {
 namespace common {
 
-struct ProtoMessage {
+// 每个请求都会分配，从线程缓存的内存池中分配
+struct ProtoMessage : public PoolAllocated<ProtoMessage> {
     int64_t session_id = 0;
     int64_t begin_time = 0;
     int64_t expire_time = 0;
@@ -36,6 +38,10 @@ struct ProtoMessage {
         this->body.assign(other.body.begin(), other.body.end());
     }
 
+    // 内存占用估算，用于内存统计
+    int64_t MemBytes() const {
+        return static_cast<int64_t>(sizeof(ProtoMessage) + body.capacity());
+    }
 };
 
 // 从报文数据中解析生成ProtoMessage
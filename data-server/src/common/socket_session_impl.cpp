@@ -10,8 +10,13 @@ namespace sharkstore {
 namespace dataserver {
 namespace common {
 
+SendStats SocketSessionImpl::stats_;
+
 void SocketSessionImpl::Send(ProtoMessage *msg, google::protobuf::Message *resp) {
+    auto begin = get_micro_second();
+
     // // 分配回应内存
+    // ByteSizeLong会缓存各层子消息的大小，序列化时直接使用
     size_t body_len = resp == nullptr ? 0 : resp->ByteSizeLong();
     size_t data_len = header_size + body_len;
 
@@ -37,14 +42,20 @@ void SocketSessionImpl::Send(ProtoMessage *msg, google::protobuf::Message *resp)
 
     do {
         if (resp != nullptr) {
-            char *data = response->buff + header_size;
-            if (!resp->SerializeToArray(data, body_len)) {
+            // SerializeToArray会再遍历一遍消息计算大小，大的Select/KvScan回应开销明显
+            auto data = reinterpret_cast<uint8_t *>(response->buff + header_size);
+            auto end = resp->SerializeWithCachedSizesToArray(data);
+            if (end - data != static_cast<ptrdiff_t>(body_len)) {
                 FLOG_ERROR("serialize response failed, func_id: %d", header.func_id);
                 delete_response_buff(response);
                 break;
             }
         }
 
+        stats_.responses.fetch_add(1, std::memory_order_relaxed);
+        stats_.bytes.fetch_add(data_len, std::memory_order_relaxed);
+        stats_.serialize_usec.fetch_add(get_micro_second() - begin, std::memory_order_relaxed);
+
         //处理完成，socket send
         msg->socket->Send(response);
 
@@ -1,6 +1,8 @@
 #ifndef __SOCKET_SESSION_IMPL_H__
 #define __SOCKET_SESSION_IMPL_H__
 
+#include <atomic>
+
 #include "socket_session.h"
 
 namespace sharkstore {
@@ -8,6 +10,13 @@ namespace dataserver {
 namespace common {
 
 
+// 回应序列化的统计，用于衡量每个回应的分配和拷贝
+struct SendStats {
+    std::atomic<uint64_t> responses = {0};
+    std::atomic<uint64_t> bytes = {0};           // 分配并序列化拷贝的字节数（含头部）
+    std::atomic<uint64_t> serialize_usec = {0};  // 计算大小和序列化的耗时
+};
+
 class SocketSessionImpl : public SocketSession {
 public:
     SocketSessionImpl() = default;
@@ -17,6 +26,11 @@ public:
     SocketSessionImpl& operator=(const SocketSessionImpl&) = delete;
 
     void Send(ProtoMessage *msg, google::protobuf::Message* resp) override;
+
+    static const SendStats& Stats() { return stats_; }
+
+private:
+    static SendStats stats_;
 };
 
 } //namespace common
@@ -0,0 +1,271 @@
+#include "cpu_profiler.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <thread>
+
+#ifdef __linux__
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#endif
+
+namespace sharkstore {
+namespace monitor {
+
+const uint32_t CPUProfiler::kMaxSeconds;
+const uint32_t CPUProfiler::kMaxFrequency;
+const size_t CPUProfiler::kMaxSamples;
+const int CPUProfiler::kMaxDepth;
+
+CPUProfiler* CPUProfiler::Instance() {
+    static CPUProfiler profiler;
+    return &profiler;
+}
+
+#ifdef __linux__
+
+// 被中断时的pc，用于跳过backtrace中信号处理函数自身的栈帧
+static void* interruptedPC(void* ucontext) {
+    auto uc = static_cast<ucontext_t*>(ucontext);
+#if defined(__x86_64__)
+    return reinterpret_cast<void*>(uc->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+    return reinterpret_cast<void*>(uc->uc_mcontext.pc);
+#else
+    (void)uc;
+    return nullptr;
+#endif
+}
+
+void CPUProfiler::signalHandler(int sig, void* info, void* ucontext) {
+    (void)sig;
+    (void)info;
+    Instance()->record(ucontext);
+}
+
+bool CPUProfiler::threadMatched(const char* name) const {
+    if (thread_prefixes_.empty()) {
+        return true;
+    }
+    for (const auto& prefix : thread_prefixes_) {
+        if (strncmp(name, prefix.c_str(), prefix.size()) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 在信号处理函数中执行：不分配内存、不加锁
+void CPUProfiler::record(void* ucontext) {
+    in_handler_.fetch_add(1, std::memory_order_acquire);
+    if (!active_.load(std::memory_order_acquire)) {
+        in_handler_.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    int saved_errno = errno;
+    char name[16] = {'\0'};
+    prctl(PR_GET_NAME, name, 0, 0, 0);
+    if (threadMatched(name)) {
+        auto idx = next_.fetch_add(1, std::memory_order_relaxed);
+        if (idx < capacity_) {
+            auto& sample = samples_[idx];
+            memcpy(sample.thread, name, sizeof(sample.thread));
+            void* pcs[kMaxDepth + 3];
+            int depth = backtrace(pcs, kMaxDepth + 3);
+            // 从被中断的函数开始，找不到时跳过信号处理的两层
+            int begin = depth > 2 ? 2 : depth;
+            auto pc = interruptedPC(ucontext);
+            for (int i = 0; i < depth && i < 4; ++i) {
+                if (pcs[i] == pc) {
+                    begin = i;
+                    break;
+                }
+            }
+            sample.depth = std::min(depth - begin, static_cast<int>(kMaxDepth));
+            memcpy(sample.pcs, pcs + begin, sample.depth * sizeof(void*));
+        } else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    errno = saved_errno;
+    in_handler_.fetch_sub(1, std::memory_order_release);
+}
+
+Status CPUProfiler::start(const CPUProfileOptions& options) {
+    auto handler = reinterpret_cast<void (*)(int, siginfo_t*, void*)>(&CPUProfiler::signalHandler);
+    // 其他profiler(如gperftools)已经占用了SIGPROF，之前的profile留下的是自己的处理函数
+    struct sigaction old;
+    sigaction(SIGPROF, nullptr, &old);
+    bool installed = (old.sa_flags & SA_SIGINFO)
+                         ? (old.sa_sigaction != nullptr && old.sa_sigaction != handler)
+                         : (old.sa_handler != SIG_DFL && old.sa_handler != SIG_IGN);
+    if (installed) {
+        return Status(Status::kBusy, "SIGPROF", "in use by another profiler");
+    }
+
+    thread_prefixes_ = options.thread_prefixes;
+    auto cpus = std::max(sysconf(_SC_NPROCESSORS_ONLN), 1L);
+    capacity_ = std::min(static_cast<size_t>(options.seconds) * options.frequency * cpus, kMaxSamples);
+    samples_.reset(new Sample[capacity_]);
+    next_ = 0;
+    dropped_ = 0;
+
+    // backtrace第一次调用时会加载libgcc，不能在信号处理函数中发生
+    void* warmup[1];
+    backtrace(warmup, 1);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = handler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, nullptr) != 0) {
+        return Status(Status::kIOError, "sigaction", strerror(errno));
+    }
+    active_ = true;
+
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 1000000 / options.frequency;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        auto err = errno;
+        stop();
+        return Status(Status::kIOError, "setitimer", strerror(err));
+    }
+    return Status::OK();
+}
+
+void CPUProfiler::stop() {
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    active_ = false;
+    // 等待正在执行的信号处理函数返回
+    while (in_handler_.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+    // 处理函数保持安装，停止计时器前已经产生、还未递送的SIGPROF到达时直接返回；
+    // 恢复成SIG_DFL的话这样的信号会终止进程
+}
+
+static std::string symbolize(void* pc, std::map<void*, std::string>* cache) {
+    auto it = cache->find(pc);
+    if (it != cache->end()) {
+        return it->second;
+    }
+
+    std::string symbol;
+    Dl_info info;
+    memset(&info, 0, sizeof(info));
+    if (dladdr(pc, &info) != 0 && info.dli_sname != nullptr) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        symbol = (status == 0 && demangled != nullptr) ? demangled : info.dli_sname;
+        free(demangled);
+    } else if (info.dli_fname != nullptr && info.dli_fbase != nullptr) {
+        // 没有符号时输出模块内的偏移，可以用addr2line离线解析
+        const char* base = strrchr(info.dli_fname, '/');
+        char buf[64] = {'\0'};
+        snprintf(buf, sizeof(buf), "+0x%lx",
+                 static_cast<unsigned long>(static_cast<char*>(pc) - static_cast<char*>(info.dli_fbase)));
+        symbol = std::string(base != nullptr ? base + 1 : info.dli_fname) + buf;
+    } else {
+        char buf[32] = {'\0'};
+        snprintf(buf, sizeof(buf), "%p", pc);
+        symbol = buf;
+    }
+    // ';'和' '是collapsed格式的分隔符
+    for (auto& c : symbol) {
+        if (c == ';') c = ':';
+        if (c == ' ') c = '_';
+    }
+    (*cache)[pc] = symbol;
+    return symbol;
+}
+
+void CPUProfiler::aggregate(CPUProfileResult* result) {
+    auto count = std::min(next_.load(), capacity_);
+    std::map<void*, std::string> symbols;
+    std::map<std::string, uint64_t> stacks;
+    for (size_t i = 0; i < count; ++i) {
+        const auto& sample = samples_[i];
+        // 线程名去掉编号，同一个线程池的样本合并
+        std::string stack(sample.thread, strnlen(sample.thread, sizeof(sample.thread)));
+        auto pos = stack.rfind(':');
+        if (pos != std::string::npos) {
+            stack.resize(pos);
+        }
+        for (int d = sample.depth - 1; d >= 0; --d) {
+            stack.push_back(';');
+            stack.append(symbolize(sample.pcs[d], &symbols));
+        }
+        ++stacks[stack];
+    }
+
+    result->collapsed.clear();
+    for (const auto& s : stacks) {
+        result->collapsed.append(s.first).append(" ").append(std::to_string(s.second)).append("\n");
+    }
+    result->samples = count;
+    result->dropped = dropped_.load();
+    samples_.reset();
+}
+
+Status CPUProfiler::Profile(const CPUProfileOptions& options, CPUProfileResult* result) {
+    if (options.seconds == 0 || options.seconds > kMaxSeconds) {
+        return Status(Status::kInvalidArgument, "seconds", std::to_string(options.seconds));
+    }
+    if (options.frequency == 0 || options.frequency > kMaxFrequency) {
+        return Status(Status::kInvalidArgument, "frequency", std::to_string(options.frequency));
+    }
+
+    std::unique_lock<std::mutex> lock(profile_mu_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return Status(Status::kBusy, "cpu profile", "already running");
+    }
+
+    std::unique_lock<std::mutex> shutdown_lock(shutdown_mu_);
+    if (shutdown_) {
+        return Status(Status::kShutdownInProgress, "cpu profile", "shutdown");
+    }
+    auto s = start(options);
+    if (!s.ok()) {
+        return s;
+    }
+    shutdown_cond_.wait_for(shutdown_lock, std::chrono::seconds(options.seconds),
+                            [this] { return shutdown_; });
+    shutdown_lock.unlock();
+    stop();
+    aggregate(result);
+    return Status::OK();
+}
+
+#else
+
+Status CPUProfiler::Profile(const CPUProfileOptions& options, CPUProfileResult* result) {
+    return Status(Status::kNotSupported, "cpu profile", "only supported on linux");
+}
+
+#endif
+
+void CPUProfiler::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(shutdown_mu_);
+        shutdown_ = true;
+    }
+    shutdown_cond_.notify_all();
+}
+
+}  // namespace monitor
+}  // namespace sharkstore
@@ -0,0 +1,82 @@
+_Pragma("once");
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "base/status.h"
+
+namespace sharkstore {
+namespace monitor {
+
+struct CPUProfileOptions {
+    uint32_t seconds = 10;
+    // 每秒cpu时间的采样次数
+    uint32_t frequency = 99;
+    // 只采样线程名以这些前缀开头的线程（如fast_worker、raft-worker、raft-apply），空表示所有线程
+    std::vector<std::string> thread_prefixes;
+};
+
+struct CPUProfileResult {
+    // collapsed格式，每行为: 线程池;栈底函数;...;栈顶函数 次数
+    std::string collapsed;
+    uint64_t samples = 0;
+    uint64_t dropped = 0;  // 超过采样上限丢弃的次数
+};
+
+// 基于SIGPROF(ITIMER_PROF)的采样cpu profiler，线上可以随时开启，不需要重启
+// 开销上限由采样频率、时长和样本数上限保证；同一时间只能有一个profile，
+// 第一次profile之后SIGPROF一直由本profiler的处理函数占用，不采样时直接返回
+class CPUProfiler {
+public:
+    static const uint32_t kMaxSeconds = 60;
+    static const uint32_t kMaxFrequency = 1000;
+    static const size_t kMaxSamples = 1 << 16;
+    static const int kMaxDepth = 48;
+
+    static CPUProfiler* Instance();
+
+    // 阻塞seconds秒后返回聚合后的结果
+    Status Profile(const CPUProfileOptions& options, CPUProfileResult* result);
+
+    // 进程退出前调用，进行中的Profile提前返回已采集的结果，之后的Profile直接返回错误
+    void Shutdown();
+
+private:
+    CPUProfiler() = default;
+
+    struct Sample {
+        char thread[16];
+        int depth;
+        void* pcs[kMaxDepth];
+    };
+
+    Status start(const CPUProfileOptions& options);
+    void stop();
+    void aggregate(CPUProfileResult* result);
+
+    static void signalHandler(int sig, void* info, void* ucontext);
+    void record(void* ucontext);
+    bool threadMatched(const char* name) const;
+
+private:
+    std::mutex profile_mu_;  // 同一时间只能有一个profile
+
+    std::mutex shutdown_mu_;
+    std::condition_variable shutdown_cond_;
+    bool shutdown_ = false;
+
+    std::vector<std::string> thread_prefixes_;
+    std::unique_ptr<Sample[]> samples_;
+    size_t capacity_ = 0;
+    std::atomic<size_t> next_ = {0};
+    std::atomic<uint64_t> dropped_ = {0};
+    std::atomic<bool> active_ = {false};
+    std::atomic<int> in_handler_ = {0};
+};
+
+}  // namespace monitor
+}  // namespace sharkstore
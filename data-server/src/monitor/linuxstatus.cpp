@@ -331,19 +331,21 @@ namespace sharkstore
         bool LinuxStatus::GetCPUInfo(CpuInfo &info,const pid_t  id)
         {
             bool bRet = true;
-            unsigned int total1,total2;
-            unsigned int proc1,proc2;
-            total1 = this->GetTotalCPU();
-            proc1 = this->GetProcCPU(id);
-            usleep(DELAY_TIME);//延迟500毫秒
-            total2 = this->GetTotalCPU();
-            proc2 = this->GetProcCPU(id);
-            float pcpu = 100.0*(proc2 - proc1)/(total2 - total1);
-
-            info.Rate = pcpu;
-            info.Used = proc2 - proc1;
+            // 与上一次调用的采样值计算增量，不再sleep等待；第一次调用时使用率为0
+            unsigned int total2 = this->GetTotalCPU();
+            unsigned int proc2 = this->GetProcCPU(id);
+            if (last_cpu_pid_ == id && total2 > last_total_cpu_ && proc2 >= last_proc_cpu_) {
+                info.Rate = 100.0 * (proc2 - last_proc_cpu_) / (total2 - last_total_cpu_);
+                info.Used = proc2 - last_proc_cpu_;
+            } else {
+                info.Rate = 0;
+                info.Used = 0;
+            }
+            last_cpu_pid_ = id;
+            last_total_cpu_ = total2;
+            last_proc_cpu_ = proc2;
             info.CpuCount = this->GetCpuNum();
-            
+
             return bRet;
         }
         uint64_t LinuxStatus::GetMemUse(const pid_t pid,uint32_t &threadCount)
@@ -682,30 +684,15 @@ namespace sharkstore
 
             return 0;
         }
-        uint32_t LinuxStatus::GetCpuNum() 
-        {  
-            return 32;
-            char buf[16] = {0};  
-            int num;  
-            FILE* fp = popen("cat /proc/cpuinfo |grep processor|wc -l", "r");  
-            if(fp) 
-            {                                                                                                                                                                               
-                int ret = fread(buf, 1, sizeof(buf) - 1, fp);  
-                // TODO: check return value
-                (void)ret;
-                pclose(fp);  
-            }
-            else
+        uint32_t LinuxStatus::GetCpuNum()
+        {
+            long num = sysconf(_SC_NPROCESSORS_ONLN);
+            if (num <= 0)
             {
-                return 0;
-            }     
-            sscanf(buf,"%d",&num);  
-            if(num <= 0)
-            {   
-                num = 1;  
-            }     
-            return (uint32_t)num;  
-        } 
+                num = 1;
+            }
+            return static_cast<uint32_t>(num);
+        }
         uint32_t LinuxStatus::GetFileCount(pid_t pid)
         {
             DIR *dir = NULL;
@@ -52,6 +52,11 @@ public:
 private:
     std::vector<HardDiskInfo> vecSize_;
     DiskRwStatus drs_;
+
+    // GetCPUInfo(info, pid)的上一次采样
+    pid_t last_cpu_pid_ = 0;
+    uint32_t last_total_cpu_ = 0;
+    uint32_t last_proc_cpu_ = 0;
 };
 
 }
@@ -0,0 +1,238 @@
+#include "metrics.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <algorithm>
+#include <cmath>
+
+namespace sharkstore {
+namespace monitor {
+namespace metrics {
+
+size_t StripedCounter::threadSlot() {
+    static std::atomic<size_t> next = {0};
+    thread_local size_t slot = next.fetch_add(1, std::memory_order_relaxed) % kSlots;
+    return slot;
+}
+
+uint64_t StripedCounter::Sum() const {
+    uint64_t sum = 0;
+    for (const auto& slot : slots_) {
+        sum += slot.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+Histogram::Histogram(const std::vector<uint64_t>& bounds, double scale)
+    : bounds_(bounds), scale_(scale), buckets_(new std::atomic<uint64_t>[bounds.size() + 1]) {
+    for (size_t i = 0; i <= bounds_.size(); ++i) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::Observe(uint64_t value) {
+    auto idx = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+    buckets_[idx].fetch_add(1, std::memory_order_relaxed);
+    sum_.Add(value);
+}
+
+void Histogram::Collect(Snapshot* snapshot) const {
+    snapshot->cumulative.resize(bounds_.size() + 1);
+    uint64_t count = 0;
+    for (size_t i = 0; i <= bounds_.size(); ++i) {
+        count += buckets_[i].load(std::memory_order_relaxed);
+        snapshot->cumulative[i] = count;
+    }
+    snapshot->count = count;
+    snapshot->sum = sum_.Sum();
+}
+
+const std::vector<uint64_t>& LatencyBucketsUsec() {
+    static const std::vector<uint64_t> buckets = {
+        100,    250,    500,     1000,    2500,    5000,    10000,
+        25000,  50000,  100000,  250000,  500000,  1000000, 2500000,
+        5000000, 10000000,
+    };
+    return buckets;
+}
+
+static void appendEscaped(std::string* out, const std::string& value) {
+    for (auto c : value) {
+        switch (c) {
+            case '\\':
+                out->append("\\\\");
+                break;
+            case '"':
+                out->append("\\\"");
+                break;
+            case '\n':
+                out->append("\\n");
+                break;
+            default:
+                out->push_back(c);
+        }
+    }
+}
+
+static std::string formatDouble(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    char buf[64] = {'\0'};
+    snprintf(buf, sizeof(buf), "%.9g", value);
+    return buf;
+}
+
+void Writer::Header(const std::string& name, const std::string& help, const char* type) {
+    out_->append("# HELP ").append(name).append(" ");
+    for (auto c : help) {
+        if (c == '\n') {
+            out_->append("\\n");
+        } else {
+            out_->push_back(c);
+        }
+    }
+    out_->append("\n# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+void Writer::appendName(const std::string& name, const Labels& labels) {
+    out_->append(name);
+    if (labels.empty()) {
+        return;
+    }
+    out_->push_back('{');
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (i > 0) out_->push_back(',');
+        out_->append(labels[i].first).append("=\"");
+        appendEscaped(out_, labels[i].second);
+        out_->push_back('"');
+    }
+    out_->push_back('}');
+}
+
+void Writer::Sample(const std::string& name, const Labels& labels, double value) {
+    appendName(name, labels);
+    out_->append(" ").append(formatDouble(value)).append("\n");
+}
+
+void Writer::Sample(const std::string& name, const Labels& labels, uint64_t value) {
+    appendName(name, labels);
+    out_->append(" ").append(std::to_string(value)).append("\n");
+}
+
+void Writer::Sample(const std::string& name, const Labels& labels, int64_t value) {
+    appendName(name, labels);
+    out_->append(" ").append(std::to_string(value)).append("\n");
+}
+
+Registry* Registry::Default() {
+    static Registry registry;
+    return &registry;
+}
+
+CounterFamily* Registry::AddCounter(const std::string& name, const std::string& help,
+                                    const std::vector<std::string>& label_names) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& family = counters_[name];
+    if (!family) {
+        family.reset(new CounterFamily(name, help, label_names, [] { return new Counter; }));
+    }
+    return family.get();
+}
+
+GaugeFamily* Registry::AddGauge(const std::string& name, const std::string& help,
+                                const std::vector<std::string>& label_names) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& family = gauges_[name];
+    if (!family) {
+        family.reset(new GaugeFamily(name, help, label_names, [] { return new Gauge; }));
+    }
+    return family.get();
+}
+
+HistogramFamily* Registry::AddHistogram(const std::string& name, const std::string& help,
+                                        const std::vector<std::string>& label_names,
+                                        const std::vector<uint64_t>& bounds, double scale) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& family = histograms_[name];
+    if (!family) {
+        family.reset(new HistogramFamily(name, help, label_names,
+                                         [bounds, scale] { return new Histogram(bounds, scale); }));
+    }
+    return family.get();
+}
+
+uint64_t Registry::AddCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(collect_mu_);
+    auto id = next_collector_id_++;
+    collectors_.emplace(id, std::move(collector));
+    return id;
+}
+
+void Registry::RemoveCollector(uint64_t id) {
+    std::lock_guard<std::mutex> lock(collect_mu_);
+    collectors_.erase(id);
+}
+
+template <class T>
+static Labels makeLabels(const Family<T>& family, const std::vector<std::string>& values) {
+    Labels labels;
+    const auto& names = family.LabelNames();
+    for (size_t i = 0; i < names.size() && i < values.size(); ++i) {
+        labels.emplace_back(names[i], values[i]);
+    }
+    return labels;
+}
+
+std::string Registry::Render() const {
+    std::string out;
+    Writer writer(&out);
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (const auto& f : counters_) {
+            const auto& family = *f.second;
+            writer.Header(family.Name(), family.Help(), "counter");
+            family.ForEach([&](const std::vector<std::string>& values, const Counter& c) {
+                writer.Sample(family.Name(), makeLabels(family, values), c.Value());
+            });
+        }
+        for (const auto& f : gauges_) {
+            const auto& family = *f.second;
+            writer.Header(family.Name(), family.Help(), "gauge");
+            family.ForEach([&](const std::vector<std::string>& values, const Gauge& g) {
+                writer.Sample(family.Name(), makeLabels(family, values), g.Value());
+            });
+        }
+        for (const auto& f : histograms_) {
+            const auto& family = *f.second;
+            writer.Header(family.Name(), family.Help(), "histogram");
+            family.ForEach([&](const std::vector<std::string>& values, const Histogram& h) {
+                Histogram::Snapshot snapshot;
+                h.Collect(&snapshot);
+                auto labels = makeLabels(family, values);
+                const auto& bounds = h.Bounds();
+                for (size_t i = 0; i <= bounds.size(); ++i) {
+                    auto le = labels;
+                    le.emplace_back("le", i < bounds.size()
+                                              ? formatDouble(bounds[i] * h.Scale())
+                                              : std::string("+Inf"));
+                    writer.Sample(family.Name() + "_bucket", le, snapshot.cumulative[i]);
+                }
+                writer.Sample(family.Name() + "_sum", labels, snapshot.sum * h.Scale());
+                writer.Sample(family.Name() + "_count", labels, snapshot.count);
+            });
+        }
+    }
+
+    // collector可能读取文件或者加其他锁，不持有family的锁；
+    // 持有collect_mu_保证RemoveCollector返回后collector不会再被调用
+    std::lock_guard<std::mutex> lock(collect_mu_);
+    for (const auto& c : collectors_) {
+        c.second(&writer);
+    }
+    return out;
+}
+
+}  // namespace metrics
+}  // namespace monitor
+}  // namespace sharkstore
@@ -0,0 +1,203 @@
+_Pragma("once");
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sharkstore {
+namespace monitor {
+namespace metrics {
+
+// prometheus风格的指标：counter/gauge/histogram，按label分组，抓取时输出文本格式
+// 更新操作只有relaxed原子操作，不加锁；创建带label的指标需要加锁，调用方应缓存返回的指针
+
+// 按线程分片的累加值，避免大量线程同时更新同一个cache line
+class StripedCounter {
+public:
+    StripedCounter() = default;
+
+    StripedCounter(const StripedCounter&) = delete;
+    StripedCounter& operator=(const StripedCounter&) = delete;
+
+    void Add(uint64_t n) {
+        slots_[threadSlot()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+    uint64_t Sum() const;
+
+private:
+    static const size_t kSlots = 16;
+    static size_t threadSlot();
+
+    // 用padding而不是alignas，堆上分配时c++14不保证对齐，但保证两个slot不在同一个cache line
+    struct Slot {
+        std::atomic<uint64_t> value = {0};
+        char padding[56];
+    };
+    Slot slots_[kSlots];
+};
+
+class Counter {
+public:
+    void Inc(uint64_t n = 1) { value_.Add(n); }
+    uint64_t Value() const { return value_.Sum(); }
+
+private:
+    StripedCounter value_;
+};
+
+class Gauge {
+public:
+    void Set(int64_t v) { value_.store(v, std::memory_order_relaxed); }
+    void Add(int64_t v) { value_.fetch_add(v, std::memory_order_relaxed); }
+    int64_t Value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> value_ = {0};
+};
+
+// bounds为各个bucket的上界（升序，整数单位，如微秒），输出时乘以scale（如1e-6转为秒）
+class Histogram {
+public:
+    Histogram(const std::vector<uint64_t>& bounds, double scale);
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void Observe(uint64_t value);
+
+    struct Snapshot {
+        std::vector<uint64_t> cumulative;  // 与bounds一一对应，最后一个为+Inf
+        uint64_t count = 0;
+        uint64_t sum = 0;
+    };
+    void Collect(Snapshot* snapshot) const;
+
+    const std::vector<uint64_t>& Bounds() const { return bounds_; }
+    double Scale() const { return scale_; }
+
+private:
+    const std::vector<uint64_t> bounds_;
+    const double scale_;
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets_;  // bounds_.size() + 1
+    StripedCounter sum_;
+};
+
+// 默认的延时bucket，单位微秒：100us ~ 10s
+const std::vector<uint64_t>& LatencyBucketsUsec();
+
+template <class T>
+class Family {
+public:
+    using Factory = std::function<T*()>;
+
+    Family(std::string name, std::string help, std::vector<std::string> label_names,
+           Factory factory)
+        : name_(std::move(name)),
+          help_(std::move(help)),
+          label_names_(std::move(label_names)),
+          factory_(std::move(factory)) {}
+
+    Family(const Family&) = delete;
+    Family& operator=(const Family&) = delete;
+
+    // label_values的个数必须与label_names一致；返回的指针在Family的生命周期内有效
+    T* WithLabels(const std::vector<std::string>& label_values) {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto& metric = metrics_[label_values];
+        if (!metric) {
+            metric.reset(factory_());
+        }
+        return metric.get();
+    }
+
+    template <class F>
+    void ForEach(F fn) const {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (const auto& m : metrics_) {
+            fn(m.first, *m.second);
+        }
+    }
+
+    const std::string& Name() const { return name_; }
+    const std::string& Help() const { return help_; }
+    const std::vector<std::string>& LabelNames() const { return label_names_; }
+
+private:
+    const std::string name_;
+    const std::string help_;
+    const std::vector<std::string> label_names_;
+    const Factory factory_;
+
+    std::map<std::vector<std::string>, std::unique_ptr<T>> metrics_;
+    mutable std::mutex mu_;
+};
+
+using CounterFamily = Family<Counter>;
+using GaugeFamily = Family<Gauge>;
+using HistogramFamily = Family<Histogram>;
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+// 抓取时由collector直接输出的指标（如从/proc或rocksdb实时读取的值）
+class Writer {
+public:
+    explicit Writer(std::string* out) : out_(out) {}
+
+    void Header(const std::string& name, const std::string& help, const char* type);
+    void Sample(const std::string& name, const Labels& labels, double value);
+    void Sample(const std::string& name, const Labels& labels, uint64_t value);
+    void Sample(const std::string& name, const Labels& labels, int64_t value);
+
+private:
+    void appendName(const std::string& name, const Labels& labels);
+
+    std::string* out_;
+};
+
+class Registry {
+public:
+    Registry() = default;
+    ~Registry() = default;
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    // 进程内全局的registry
+    static Registry* Default();
+
+    // 同名的family只创建一次
+    CounterFamily* AddCounter(const std::string& name, const std::string& help,
+                              const std::vector<std::string>& label_names = {});
+    GaugeFamily* AddGauge(const std::string& name, const std::string& help,
+                          const std::vector<std::string>& label_names = {});
+    HistogramFamily* AddHistogram(const std::string& name, const std::string& help,
+                                  const std::vector<std::string>& label_names,
+                                  const std::vector<uint64_t>& bounds, double scale);
+
+    // collector在Render时调用，不能在其中调用AddCollector/RemoveCollector
+    using Collector = std::function<void(Writer*)>;
+    // 返回id用于移除，RemoveCollector返回后collector不会再被调用
+    uint64_t AddCollector(Collector collector);
+    void RemoveCollector(uint64_t id);
+
+    // 输出prometheus文本格式
+    std::string Render() const;
+
+private:
+    std::map<std::string, std::unique_ptr<CounterFamily>> counters_;
+    std::map<std::string, std::unique_ptr<GaugeFamily>> gauges_;
+    std::map<std::string, std::unique_ptr<HistogramFamily>> histograms_;
+    mutable std::mutex mu_;
+
+    std::map<uint64_t, Collector> collectors_;
+    uint64_t next_collector_id_ = 1;
+    mutable std::mutex collect_mu_;
+};
+
+}  // namespace metrics
+}  // namespace monitor
+}  // namespace sharkstore
@@ -0,0 +1,185 @@
+#include "proc_collector.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sstream>
+#include <vector>
+
+namespace sharkstore {
+namespace monitor {
+
+bool ParseProcSelfStat(const std::string& content, ProcSelfStat* stat) {
+    // 进程名中可能有空格和括号，从最后一个')'之后开始解析
+    auto pos = content.rfind(')');
+    if (pos == std::string::npos) {
+        return false;
+    }
+    std::istringstream ss(content.substr(pos + 1));
+    std::vector<std::string> fields;
+    std::string field;
+    while (ss >> field && fields.size() < 22) {
+        fields.push_back(field);
+    }
+    // fields[0]是第3个字段(state)
+    if (fields.size() < 22) {
+        return false;
+    }
+    stat->utime_ticks = strtoull(fields[11].c_str(), nullptr, 10);
+    stat->stime_ticks = strtoull(fields[12].c_str(), nullptr, 10);
+    stat->num_threads = strtoull(fields[17].c_str(), nullptr, 10);
+    stat->start_ticks = strtoull(fields[19].c_str(), nullptr, 10);
+    stat->vsize = strtoull(fields[20].c_str(), nullptr, 10);
+    stat->rss_pages = strtoull(fields[21].c_str(), nullptr, 10);
+    return true;
+}
+
+bool ParseProcCPUStat(const std::string& content, ProcCPUStat* stat, uint64_t* boot_time) {
+    bool found = false;
+    std::istringstream ss(content);
+    std::string line;
+    while (std::getline(ss, line)) {
+        if (line.compare(0, 4, "cpu ") == 0) {
+            std::istringstream ls(line.substr(4));
+            // user nice system idle iowait irq softirq steal，guest已经计入user
+            uint64_t values[8] = {0};
+            for (int i = 0; i < 8 && (ls >> values[i]); ++i) {
+            }
+            stat->total_ticks = 0;
+            for (auto v : values) {
+                stat->total_ticks += v;
+            }
+            stat->idle_ticks = values[3] + values[4];
+            found = true;
+        } else if (line.compare(0, 6, "btime ") == 0) {
+            *boot_time = strtoull(line.c_str() + 6, nullptr, 10);
+        }
+    }
+    return found;
+}
+
+bool ParseProcIO(const std::string& content, uint64_t* read_bytes, uint64_t* write_bytes) {
+    int found = 0;
+    std::istringstream ss(content);
+    std::string name;
+    uint64_t value = 0;
+    while (ss >> name >> value) {
+        if (name == "read_bytes:") {
+            *read_bytes = value;
+            ++found;
+        } else if (name == "write_bytes:") {
+            *write_bytes = value;
+            ++found;
+        }
+    }
+    return found == 2;
+}
+
+ProcCollector::ProcCollector(std::string proc_root)
+    : proc_root_(std::move(proc_root)),
+      clock_ticks_(sysconf(_SC_CLK_TCK)),
+      page_size_(sysconf(_SC_PAGESIZE)) {}
+
+bool ProcCollector::readFile(const std::string& name, std::string* content) const {
+    auto path = proc_root_ + "/" + name;
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    content->clear();
+    char buf[4096];
+    while (true) {
+        auto n = ::read(fd, buf, sizeof(buf));
+        if (n <= 0) {
+            ::close(fd);
+            return n == 0;
+        }
+        content->append(buf, static_cast<size_t>(n));
+    }
+}
+
+uint64_t ProcCollector::countOpenFDs() const {
+    auto path = proc_root_ + "/self/fd";
+    auto dir = ::opendir(path.c_str());
+    if (dir == nullptr) {
+        return 0;
+    }
+    uint64_t count = 0;
+    struct dirent* ent = nullptr;
+    while ((ent = ::readdir(dir)) != nullptr) {
+        if (ent->d_name[0] != '.') ++count;
+    }
+    ::closedir(dir);
+    // 不包括opendir自己打开的fd
+    return count > 0 ? count - 1 : 0;
+}
+
+void ProcCollector::Collect(metrics::Writer* writer) {
+    std::string content;
+    ProcSelfStat self;
+    ProcCPUStat cpu;
+    uint64_t boot_time = 0;
+    bool has_self = readFile("self/stat", &content) && ParseProcSelfStat(content, &self);
+    bool has_cpu = readFile("stat", &content) && ParseProcCPUStat(content, &cpu, &boot_time);
+    auto ticks = static_cast<double>(clock_ticks_ > 0 ? clock_ticks_ : 100);
+
+    if (has_self) {
+        writer->Header("process_cpu_seconds_total", "Total user and system CPU time spent in seconds.", "counter");
+        writer->Sample("process_cpu_seconds_total", {}, (self.utime_ticks + self.stime_ticks) / ticks);
+        writer->Header("process_resident_memory_bytes", "Resident memory size in bytes.", "gauge");
+        writer->Sample("process_resident_memory_bytes", {},
+                       self.rss_pages * static_cast<uint64_t>(page_size_));
+        writer->Header("process_virtual_memory_bytes", "Virtual memory size in bytes.", "gauge");
+        writer->Sample("process_virtual_memory_bytes", {}, self.vsize);
+        writer->Header("process_threads", "Number of OS threads in the process.", "gauge");
+        writer->Sample("process_threads", {}, self.num_threads);
+        if (boot_time > 0) {
+            writer->Header("process_start_time_seconds", "Start time of the process since unix epoch in seconds.", "gauge");
+            writer->Sample("process_start_time_seconds", {}, boot_time + self.start_ticks / ticks);
+        }
+    }
+
+    writer->Header("process_open_fds", "Number of open file descriptors.", "gauge");
+    writer->Sample("process_open_fds", {}, countOpenFDs());
+
+    uint64_t read_bytes = 0, write_bytes = 0;
+    if (readFile("self/io", &content) && ParseProcIO(content, &read_bytes, &write_bytes)) {
+        writer->Header("process_io_read_bytes_total", "Bytes read from storage by the process.", "counter");
+        writer->Sample("process_io_read_bytes_total", {}, read_bytes);
+        writer->Header("process_io_write_bytes_total", "Bytes written to storage by the process.", "counter");
+        writer->Sample("process_io_write_bytes_total", {}, write_bytes);
+    }
+
+    if (has_cpu) {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto proc_ticks = self.utime_ticks + self.stime_ticks;
+        if (last_cpu_.total_ticks > 0 && cpu.total_ticks > last_cpu_.total_ticks) {
+            auto total = static_cast<double>(cpu.total_ticks - last_cpu_.total_ticks);
+            auto idle = cpu.idle_ticks >= last_cpu_.idle_ticks ? cpu.idle_ticks - last_cpu_.idle_ticks : 0;
+            writer->Header("node_cpu_usage_ratio", "Machine CPU usage since the last scrape.", "gauge");
+            writer->Sample("node_cpu_usage_ratio", {}, idle >= total ? 0.0 : (total - idle) / total);
+            if (has_self && proc_ticks >= last_proc_ticks_) {
+                writer->Header("process_cpu_usage_ratio",
+                               "Share of machine CPU used by the process since the last scrape.", "gauge");
+                writer->Sample("process_cpu_usage_ratio", {}, (proc_ticks - last_proc_ticks_) / total);
+            }
+        }
+        last_cpu_ = cpu;
+        last_proc_ticks_ = proc_ticks;
+    }
+
+    if (readFile("loadavg", &content)) {
+        std::istringstream ss(content);
+        double load[3] = {0};
+        if (ss >> load[0] >> load[1] >> load[2]) {
+            writer->Header("node_load", "System load average.", "gauge");
+            writer->Sample("node_load", {{"period", "1m"}}, load[0]);
+            writer->Sample("node_load", {{"period", "5m"}}, load[1]);
+            writer->Sample("node_load", {{"period", "15m"}}, load[2]);
+        }
+    }
+}
+
+}  // namespace monitor
+}  // namespace sharkstore
@@ -0,0 +1,59 @@
+_Pragma("once");
+
+#include <mutex>
+#include <string>
+
+#include "metrics.h"
+
+namespace sharkstore {
+namespace monitor {
+
+// /proc/self/stat中用到的字段
+struct ProcSelfStat {
+    uint64_t utime_ticks = 0;
+    uint64_t stime_ticks = 0;
+    uint64_t num_threads = 0;
+    uint64_t start_ticks = 0;  // 系统启动后的时间
+    uint64_t vsize = 0;        // 字节
+    uint64_t rss_pages = 0;
+};
+
+// /proc/stat第一行(所有cpu)
+struct ProcCPUStat {
+    uint64_t total_ticks = 0;
+    uint64_t idle_ticks = 0;  // idle + iowait
+};
+
+bool ParseProcSelfStat(const std::string& content, ProcSelfStat* stat);
+bool ParseProcCPUStat(const std::string& content, ProcCPUStat* stat, uint64_t* boot_time);
+// 解析/proc/self/io中的read_bytes/write_bytes
+bool ParseProcIO(const std::string& content, uint64_t* read_bytes, uint64_t* write_bytes);
+
+// 抓取时从/proc读取进程和机器的状态：只读文件，不sleep、不fork子进程
+// cpu使用率按两次抓取之间的增量计算，第一次抓取不输出
+class ProcCollector {
+public:
+    explicit ProcCollector(std::string proc_root = "/proc");
+    ~ProcCollector() = default;
+
+    ProcCollector(const ProcCollector&) = delete;
+    ProcCollector& operator=(const ProcCollector&) = delete;
+
+    void Collect(metrics::Writer* writer);
+
+private:
+    bool readFile(const std::string& name, std::string* content) const;
+    uint64_t countOpenFDs() const;
+
+private:
+    const std::string proc_root_;
+    const long clock_ticks_;
+    const long page_size_;
+
+    std::mutex mu_;
+    ProcCPUStat last_cpu_;
+    uint64_t last_proc_ticks_ = 0;
+};
+
+}  // namespace monitor
+}  // namespace sharkstore
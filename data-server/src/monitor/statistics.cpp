@@ -13,7 +13,9 @@
 
 #include "statistics.h"
 
+#include <ctype.h>
 #include <inttypes.h>
+#include <algorithm>
 
 namespace sharkstore {
 namespace monitor {
@@ -33,8 +35,20 @@ const char *HistogramTypeName(HistogramType type) {
     }
 }
 
+Statistics::Statistics() {
+    auto family = metrics::Registry::Default()->AddHistogram(
+        "sharkstore_ds_stage_duration_seconds", "Request duration by processing stage.",
+        {"stage"}, metrics::LatencyBucketsUsec(), 1e-6);
+    for (uint32_t i = 0; i < kHistogramTypeNum; ++i) {
+        std::string stage = HistogramTypeName(static_cast<HistogramType>(i));
+        std::transform(stage.begin(), stage.end(), stage.begin(), ::tolower);
+        exported_[i] = family->WithLabels({stage});
+    }
+}
+
 void Statistics::PushTime(HistogramType type, uint64_t time) {
     histograms_[static_cast<uint32_t>(type)].Add(time);
+    exported_[static_cast<uint32_t>(type)]->Observe(time);
 }
 
 void Statistics::GetData(HistogramType type, HistogramData *data) {
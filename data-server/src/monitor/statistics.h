@@ -15,6 +15,7 @@ _Pragma("once");
 
 #include <mutex>
 #include "histogram.h"
+#include "metrics.h"
 
 namespace sharkstore {
 namespace monitor {
@@ -33,6 +34,8 @@ static constexpr uint32_t kHistogramTypeNum = static_cast<uint32_t>(HistogramTyp
 
 class Statistics {
 public:
+    Statistics();
+
     void PushTime(HistogramType type, uint64_t time);
 
     void GetData(HistogramType type, HistogramData *data);
@@ -44,6 +47,8 @@ public:
 
 private:
     Histogram histograms_[kHistogramTypeNum];
+    // 导出到metrics::Registry的累计值，不随Reset清零
+    metrics::Histogram *exported_[kHistogramTypeNum];
     mutable std::mutex aggregate_lock_;
 };
 
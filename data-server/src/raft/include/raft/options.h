@@ -10,6 +10,12 @@ _Pragma("once");
 namespace sharkstore {
 namespace raft {
 
+// raft网络传输压缩算法
+enum class CompressionType : uint8_t {
+    kNone = 0,
+    kZstd = 1,  // 需要编译时开启ENABLE_ZSTD
+};
+
 struct TransportOptions {
     // 进程内网络传输, 测试
     bool use_inprocess_transport = false;
@@ -29,6 +35,15 @@ struct TransportOptions {
     // 接收IO线程数量(Server端)
     size_t recv_io_threads = 4;
 
+    // 到每个节点的日志复制连接数量
+    // 选举、心跳和快照消息另外各有一个单独的连接
+    size_t connection_pool_size = 2;
+
+    // 日志复制和快照数据的压缩算法，接收端总是能够解压
+    CompressionType compression = CompressionType::kNone;
+    // 一帧数据小于该大小时不压缩
+    size_t compress_threshold = 4 * 1024;
+
     Status Validate() const;
 };
 
@@ -56,6 +71,12 @@ struct RaftServerOptions {
     // 是否启用raft pre-vote特性
     bool enable_pre_vote = true;
 
+    // 是否启用check-quorum：
+    // 1) leader一个选举周期内没有收到大多数副本的消息就退为follower
+    // 2) 一个选举周期内收到过leader消息的节点不响应更高term的(预)投票，leader转移除外
+    // 与pre-vote一起使用，隔离后恢复的节点不会打断正常的leader
+    bool enable_check_quorum = true;
+
     // 当learner复制进度追上以后，是否自动提升learner为可投票成员
     bool auto_promote_learner = true;
     // learner跟leader的日志差距小于下面条件中的任意一个就算是进度追上了
@@ -90,13 +111,23 @@ struct RaftServerOptions {
     // raft一致性队列长度
     size_t consensus_queue_capacity = 100000;
 
+    // 同一个raft的提案合并成一个batch，最多多少条、多少字节
+    int max_batch_entries = 64;
+    size_t max_batch_bytes = 256 * 1024;
+    // 一致性线程繁忙时，未满的batch最多推迟多久处理，用于积攒更多的提案
+    // 设置为0则不推迟
+    std::chrono::microseconds max_batch_delay = std::chrono::microseconds(500);
+
     // 在raft线程里就地apply，不放到apply线程里异步应用
     bool apply_in_place = true;
-    // apply线程数量
+    // apply线程池的线程数量，各range按序apply，不同range之间并行
     uint8_t apply_threads_num = 4;
-    // apply队列长度
+    // 单个range异步apply积压的日志条数上限，超过后新的提案返回Busy
     size_t apply_queue_capacity = 100000;
 
+    // 已封存的日志文件mmap只读访问，所有映射的总字节数上限，0表示不使用mmap
+    size_t log_mmap_budget = 256 * 1024 * 1024;
+
     TransportOptions transport_options;
     SnapshotOptions snapshot_options;
 
@@ -122,6 +153,11 @@ struct RaftOptions {
     size_t log_file_size = 1024 * 1024 * 16;
     // 最多保留多少个日志文件，超过就截断旧数据
     size_t max_log_files = 5;
+    // 日志文件每次预分配的空间大小，0表示不预分配
+    size_t log_preallocate_size = 1024 * 1024;
+    // 截断后保留待复用的日志文件个数，0表示直接删除
+    // 每个raft各自保留，会多占用recycle_log_files * log_file_size的磁盘空间
+    size_t recycle_log_files = 0;
     // 启动时检测到日志损坏是否运行继续启动
     bool allow_log_corrupt = false;
     // 日志创建时的起始index
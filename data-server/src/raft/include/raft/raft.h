@@ -19,8 +19,13 @@ public:
     virtual void GetLeaderTerm(uint64_t* leader, uint64_t* term) const = 0;
     virtual bool IsLeader() const = 0;
 
+    // 本节点立即发起选举，不受其他副本的leader租约限制
     virtual Status TryToLeader() = 0;
 
+    // 把leader转移给node_id节点，只在本节点是leader时有效
+    // 目标的日志追上后通知其立即选举，一个选举周期内没有完成则放弃
+    virtual Status TransferLeader(uint64_t node_id) = 0;
+
     virtual Status Submit(std::string& cmd) = 0;
     virtual Status ChangeMemeber(const ConfChange& conf) = 0;
 
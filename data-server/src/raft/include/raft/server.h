@@ -34,6 +34,9 @@ public:
     virtual std::shared_ptr<Raft> FindRaft(uint64_t id) const = 0;
 
     virtual void GetStatus(ServerStatus* status) const = 0;
+
+    // 心跳中收到的其他节点的leader分布，key: node_id
+    virtual void GetNodeLoads(std::map<uint64_t, NodeLoad>* loads) const = 0;
 };
 
 std::unique_ptr<RaftServer> CreateRaftServer(const RaftServerOptions& ops);
@@ -1,6 +1,7 @@
 _Pragma("once");
 
 #include <stdint.h>
+#include <chrono>
 #include <string>
 #include <map>
 
@@ -13,6 +14,20 @@ struct ServerStatus {
     uint64_t total_snap_applying = 0;
     uint64_t total_snap_sending = 0;
     uint64_t total_rafts_count = 0;
+
+    // 网络传输压缩统计
+    uint64_t compress_raw_bytes = 0;  // 压缩前字节数
+    uint64_t compress_out_bytes = 0;  // 压缩后字节数
+    uint64_t compress_usecs = 0;      // 压缩累计耗时
+    uint64_t decompress_usecs = 0;    // 解压累计耗时
+};
+
+// 节点上的leader分布，由节点间的心跳交换
+struct NodeLoad {
+    uint64_t leader_count = 0;
+    uint64_t raft_count = 0;
+    // 最近一次收到的时间
+    std::chrono::steady_clock::time_point update_time;
 };
 
 struct ReplicaStatus {
@@ -34,6 +49,8 @@ struct RaftStatus {
     uint64_t index = 0;  // log index
     uint64_t commit = 0;
     uint64_t applied = 0;
+    // 异步apply时，已提交但还未被状态机应用的日志条数
+    uint64_t apply_pending = 0;
     std::string state;
     // key: node_id
     std::map<uint64_t, ReplicaStatus> replicas;
@@ -0,0 +1,88 @@
+#include "apply_scheduler.h"
+
+#include <assert.h>
+#include "base/util.h"
+#include "logger.h"
+#include "raft_exception.h"
+#include "raft_impl.h"
+#include "server_impl.h"
+
+namespace sharkstore {
+namespace raft {
+namespace impl {
+
+ApplyScheduler::ApplyScheduler(RaftServerImpl* server, size_t threads_num,
+                               size_t batch_size)
+    : server_(server), batch_size_(batch_size), running_(true) {
+    assert(server_ != nullptr);
+    assert(threads_num > 0);
+    assert(batch_size_ > 0);
+
+    for (size_t i = 0; i < threads_num; ++i) {
+        threads_.emplace_back(std::bind(&ApplyScheduler::run, this));
+        // 设置线程名称
+        std::string name = std::string("raft-apply:") + std::to_string(i);
+        AnnotateThread(threads_.back().native_handle(), name.c_str());
+    }
+}
+
+ApplyScheduler::~ApplyScheduler() { Shutdown(); }
+
+void ApplyScheduler::Schedule(const std::shared_ptr<RaftImpl>& raft) {
+    if (!running_) return;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        ready_.push_back(raft);
+        ++ready_count_;
+    }
+    cv_.notify_one();
+}
+
+void ApplyScheduler::Shutdown() {
+    bool expected = true;
+    if (!running_.compare_exchange_strong(expected, false)) {
+        return;
+    }
+    // 唤醒所有工作线程
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        ready_.clear();
+        ready_count_ = 0;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+void ApplyScheduler::run() {
+    while (true) {
+        std::shared_ptr<RaftImpl> raft;
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            cv_.wait(lock, [this] { return !running_ || !ready_.empty(); });
+            if (!running_) return;
+            raft = std::move(ready_.front());
+            ready_.pop_front();
+            --ready_count_;
+        }
+
+        bool more = false;
+        try {
+            more = raft->DrainApply(batch_size_);
+        } catch (RaftException& e) {
+            LOG_ERROR("raft[%llu] throw an exception when apply: %s. removed.",
+                      raft->Id(), e.what());
+            server_->RemoveRaft(raft->Id());
+            continue;
+        }
+        if (more) {
+            // 还有未处理完的，放到队尾，先让其他raft执行
+            Schedule(raft);
+        }
+    }
+}
+
+} /* namespace impl */
+} /* namespace raft */
+} /* namespace sharkstore */
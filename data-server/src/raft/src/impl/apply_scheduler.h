@@ -0,0 +1,58 @@
+_Pragma("once");
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sharkstore {
+namespace raft {
+namespace impl {
+
+class RaftImpl;
+class RaftServerImpl;
+
+// 异步apply调度
+// 每个raft有自己的有序apply队列（在RaftImpl中），有待apply数据时把raft放入就绪队列，
+// 由线程池中任意空闲线程取出处理。同一个raft同一时刻只在一个线程中apply，保证顺序；
+// 不同raft之间并行，一个range的慢apply不会影响其他range
+class ApplyScheduler {
+public:
+    // batch_size: 每次调度单个raft最多apply多少条，之后放回就绪队列末尾让其他raft执行
+    ApplyScheduler(RaftServerImpl* server, size_t threads_num, size_t batch_size);
+    ~ApplyScheduler();
+
+    ApplyScheduler(const ApplyScheduler&) = delete;
+    ApplyScheduler& operator=(const ApplyScheduler&) = delete;
+
+    // raft从空闲变为有数据待apply时调用，同一个raft不会重复放入
+    void Schedule(const std::shared_ptr<RaftImpl>& raft);
+
+    void Shutdown();
+
+    // 就绪队列中等待调度的raft数量
+    size_t ReadyCount() const { return ready_count_; }
+
+private:
+    void run();
+
+private:
+    RaftServerImpl* server_ = nullptr;
+    const size_t batch_size_ = 0;
+
+    std::atomic<bool> running_{false};
+    std::vector<std::thread> threads_;
+
+    // 需要跨生产者的FIFO：放回队尾的raft必须排在其间新就绪的raft后面
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::deque<std::shared_ptr<RaftImpl>> ready_;
+    std::atomic<size_t> ready_count_{0};
+};
+
+} /* namespace impl */
+} /* namespace raft */
+} /* namespace sharkstore */
@@ -1,5 +1,6 @@
 _Pragma("once");
 
+#include "apply_scheduler.h"
 #include "snapshot/manager.h"
 #include "transport/transport.h"
 #include "work_thread.h"
@@ -10,7 +11,7 @@ namespace impl {
 
 struct RaftContext {
     WorkThread *consensus_thread = nullptr;
-    WorkThread *apply_thread = nullptr;
+    ApplyScheduler *apply_scheduler = nullptr;
     SnapshotManager *snapshot_manager = nullptr;
     transport::Transport *msg_sender = nullptr;
 };
@@ -1,6 +1,7 @@
 _Pragma("once");
 
 #include <exception>
+#include <stdexcept>
 
 #include "base/status.h"
 
@@ -1,5 +1,6 @@
 #include "raft_fsm.h"
 
+#include <algorithm>
 #include <random>
 #include <sstream>
 
@@ -46,13 +47,6 @@ void RaftFsm::takeEntries(MessagePtr& msg, std::vector<EntryPtr>& ents) {
     }
 }
 
-void RaftFsm::putEntries(MessagePtr& msg, const std::vector<EntryPtr>& ents) {
-    for (const auto& e : ents) {
-        auto p = msg->add_entries();
-        p->CopyFrom(*e);  // must copy
-    }
-}
-
 Status RaftFsm::loadState(const pb::HardState& state) {
     // 全空
     if (state.commit() == 0 && state.term() == 0 && state.vote() == 0) {
@@ -97,13 +91,11 @@ Status RaftFsm::recoverCommit() {
 }
 
 Status RaftFsm::start() {
-    // 初始化随机函数(选举超时)
-    unsigned seed = static_cast<unsigned>(
-        std::chrono::system_clock::now().time_since_epoch().count() * node_id_);
+    // 初始化随机函数(选举超时)，同一节点上同时创建的各组也要互不相关
+    std::random_device rd;
+    std::seed_seq seed{rd(), static_cast<unsigned>(node_id_), static_cast<unsigned>(id_)};
     std::default_random_engine engine(seed);
-    std::uniform_int_distribution<unsigned> distribution(sops_.election_tick,
-                                                         sops_.election_tick * 2);
-    random_func_ = std::bind(distribution, engine);
+    random_func_ = std::bind(std::uniform_int_distribution<unsigned>(), engine);
 
     // 初始化raft日志
     if (rops_.use_memory_storage) {
@@ -114,6 +106,8 @@ Status RaftFsm::start() {
         storage::DiskStorage::Options ops;
         ops.log_file_size = rops_.log_file_size;
         ops.max_log_files = rops_.max_log_files;
+        ops.preallocate_size = rops_.log_preallocate_size;
+        ops.recycle_log_files = rops_.recycle_log_files;
         ops.allow_corrupt_startup = rops_.allow_log_corrupt;
         ops.initial_first_index = rops_.initial_first_index;
         storage_ = std::shared_ptr<storage::Storage>(
@@ -223,26 +217,15 @@ bool RaftFsm::stepIngoreTerm(MessagePtr& msg) {
             tick_func_();
             return true;
 
-        case pb::LOCAL_MSG_HUP: {
-            if (state_ != FsmState::kLeader && electable()) {
-                std::vector<EntryPtr> ents;
-                Status s = raft_log_->slice(raft_log_->applied() + 1,
-                                            raft_log_->committed() + 1, kNoLimit, &ents);
-                if (!s.ok()) {
-                    throw RaftException(
-                        std::string("[Step] unexpected error when getting "
-                                    "unapplied entries:") +
-                        s.ToString());
-                }
+        case pb::LOCAL_MSG_HUP:
+            hup(sops_.enable_pre_vote, msg->transfer());
+            return true;
 
-                if (numOfPendingConf(ents) != 0) {
-                    LOG_INFO("raft[%llu] pending conf exist. campaign forbidden", id_);
-                } else {
-                    campaign(sops_.enable_pre_vote);
-                }
+        case pb::LOCAL_MSG_TRANSFER:
+            if (state_ == FsmState::kLeader) {
+                transferLeader(msg->to());
             }
             return true;
-        }
 
         case pb::LOCAL_MSG_PROP:
             step_func_(msg);
@@ -267,6 +250,27 @@ bool RaftFsm::stepIngoreTerm(MessagePtr& msg) {
     }
 }
 
+void RaftFsm::hup(bool pre_vote, bool transfer) {
+    if (state_ == FsmState::kLeader || !electable()) {
+        return;
+    }
+
+    std::vector<EntryPtr> ents;
+    Status s = raft_log_->slice(raft_log_->applied() + 1, raft_log_->committed() + 1,
+                                kNoLimit, &ents);
+    if (!s.ok()) {
+        throw RaftException(std::string("[Step] unexpected error when getting "
+                                        "unapplied entries:") +
+                            s.ToString());
+    }
+
+    if (numOfPendingConf(ents) != 0) {
+        LOG_INFO("raft[%llu] pending conf exist. campaign forbidden", id_);
+    } else {
+        campaign(pre_vote, transfer);
+    }
+}
+
 void RaftFsm::stepLowTerm(MessagePtr& msg) {
     if (msg->type() == pb::PRE_VOTE_REQUEST) {
         LOG_INFO("raft[%lu] [logterm: %lu, index: %lu, vote: %lu] "
@@ -284,11 +288,13 @@ void RaftFsm::stepLowTerm(MessagePtr& msg) {
         resp->set_to(msg->from());
         resp->set_reject(true);
         send(resp);
-    } else if (sops_.enable_pre_vote && msg->type() == pb::APPEND_ENTRIES_REQUEST) {
+    } else if ((sops_.enable_pre_vote || sops_.enable_check_quorum) &&
+               msg->type() == pb::APPEND_ENTRIES_REQUEST) {
         // 收到了来自低term leader(APPEND只会由leader发出)的消息，原因可能是
         // 1) 来源leader被分区出去
         // 2) 本节点选举增加了term，因为启用了PreVote，不会随意提升term
-        // 两种情况让来源leader退位是安全的
+        // 3) 启用了check-quorum，来源leader的投票请求在租约内被忽略，它的term升不上来
+        // 这几种情况让来源leader退位都是安全的
         // 如果它是一个被网络延迟的消息，我们的回复里log_term和commit都是0
         // 也不会干扰正常leader的复制，让leader错误以为前面发起的某次复制是成功的
 
@@ -377,6 +383,17 @@ void RaftFsm::Step(MessagePtr& msg) {
 
     // 高term，先变为follower再处理msg
     if (msg->term() > term_) {
+        if ((msg->type() == pb::PRE_VOTE_REQUEST || msg->type() == pb::VOTE_REQUEST) &&
+            inLease(msg)) {
+            LOG_INFO("raft[%llu] [logterm: %llu, index: %llu, vote: %llu] ignore %s "
+                     "from %llu [logterm: %llu, index: %llu] at term %llu: lease is "
+                     "not expired (remaining ticks: %u)",
+                     id_, raft_log_->lastTerm(), raft_log_->lastIndex(), vote_for_,
+                     MessageType_Name(msg->type()).c_str(), msg->from(), msg->log_term(),
+                     msg->log_index(), term_, sops_.election_tick - election_elapsed_);
+            return;
+        }
+
         if (msg->type() == pb::PRE_VOTE_REQUEST ||
             (msg->type() == pb::PRE_VOTE_RESPONSE && !msg->reject())) {
             // 1) prevote请求的term是来源自身的term+1，不是其真正的term
@@ -652,6 +669,10 @@ void RaftFsm::removePeer(const Peer& peer) {
         sending_snap_.reset();
     }
 
+    if (peer.node_id == lead_transferee_) {
+        abortLeaderTransfer();
+    }
+
     learners_.erase(peer.node_id);
     replicas_.erase(peer.node_id);
     if (peer.node_id == node_id_) {
@@ -714,7 +735,12 @@ void RaftFsm::send(MessagePtr& msg) {
         msg->set_term(term_);
     }
 
-    sending_msgs_.push_back(msg);
+    sending_msgs_.emplace_back(msg);
+}
+
+void RaftFsm::send(MessagePtr& msg, std::vector<EntryPtr>&& ents) {
+    send(msg);
+    sending_msgs_.back().ents = std::move(ents);
 }
 
 void RaftFsm::reset(uint64_t term, bool is_leader) {
@@ -728,6 +754,8 @@ void RaftFsm::reset(uint64_t term, bool is_leader) {
     heartbeat_elapsed_ = 0;
     votes_.clear();
     pending_conf_ = false;
+    lead_transferee_ = 0;
+    transfer_elapsed_ = 0;
 
     abortSendSnap();
     abortApplySnap();
@@ -754,10 +782,32 @@ void RaftFsm::reset(uint64_t term, bool is_leader) {
 }
 
 void RaftFsm::resetRandomizedElectionTimeout() {
-    rand_election_tick_ = random_func_();
+    // 选举超时在(election_tick, 2*election_tick]之间，从election_tick+1开始，
+    // 其他副本的leader租约在这时已经过期，不会忽略本节点的投票请求
+    // 各组的心跳是按节点合并的，同一个节点故障后各组的follower几乎同时开始计时，
+    // 所以组内的各副本按在组内的次序(随组id轮换)各占一段区间，段内再随机：
+    // 组内副本不会在同一个tick发起选举而分票，共享故障节点的各组也分散到不同的节点和tick
+    const unsigned range = sops_.election_tick;
+    unsigned offset = random_func_() % range;
+    auto self = replicas_.find(node_id_);
+    if (replicas_.size() > 1 && self != replicas_.end()) {
+        auto n = static_cast<unsigned>(replicas_.size());
+        auto rank = static_cast<unsigned>(
+            (std::distance(replicas_.begin(), self) + id_) % n);
+        unsigned start = rank * range / n;
+        unsigned width = std::max((rank + 1) * range / n - start, 1U);
+        offset = (start + random_func_() % width) % range;
+    }
+    rand_election_tick_ = sops_.election_tick + 1 + offset;
     LOG_DEBUG("raft[%llu] election tick reset to %d", id_, rand_election_tick_);
 }
 
+bool RaftFsm::inLease(const MessagePtr& msg) const {
+    // leader转移或者外部指定发起的选举不受租约限制
+    return sops_.enable_check_quorum && !msg->transfer() && leader_ != 0 &&
+           election_elapsed_ < sops_.election_tick;
+}
+
 bool RaftFsm::pastElectionTimeout() const {
     return election_elapsed_ >= rand_election_tick_;
 }
@@ -32,6 +32,8 @@ public:
     void GetReady(Ready* rd);
 
     std::tuple<uint64_t, uint64_t> GetLeaderTerm() const;
+    // 正在转移leader的目标节点，0表示没有转移
+    uint64_t GetLeadTransferee() const { return lead_transferee_; }
 
     pb::HardState GetHardState() const;
     Status Persist(bool persist_hardstate);
@@ -45,7 +47,6 @@ public:
 private:
     static int numOfPendingConf(const std::vector<EntryPtr>& ents);
     static void takeEntries(MessagePtr& msg, std::vector<EntryPtr>& ents);
-    static void putEntries(MessagePtr& msg, const std::vector<EntryPtr>& ents);
 
     Status start();
     Status loadState(const pb::HardState& state);
@@ -55,7 +56,11 @@ private:
 
     // 返回true表示消息处理完成
     bool stepIngoreTerm(MessagePtr& msg);
+    // 没有未应用的成员变更时发起选举，transfer表示由leader转移或者外部指定触发
+    void hup(bool pre_vote, bool transfer);
     void stepLowTerm(MessagePtr& msg);
+    // 是否还在leader的租约内，租约内不响应更高term的(预)投票请求
+    bool inLease(const MessagePtr& msg) const;
     void stepVote(MessagePtr& msg, bool pre_vote);
 
     bool hasReplica(uint64_t node) const;
@@ -70,6 +75,8 @@ private:
 
     // send填充msg的 id, from, term字段，然后放到待发送队列里
     void send(MessagePtr& msg);
+    // 发送append消息，ents跟本地日志共享，不拷贝进msg
+    void send(MessagePtr& msg, std::vector<EntryPtr>&& ents);
 
     void reset(uint64_t term, bool is_leader);
     void resetRandomizedElectionTimeout();
@@ -91,12 +98,17 @@ private:
     void appendEntry(const std::vector<EntryPtr>& ents);
     std::shared_ptr<SendSnapTask> newSendSnapTask(uint64_t to, uint64_t* snap_index);
     void checkCaughtUp();
+    void transferLeader(uint64_t to);
+    void sendTimeoutNow(uint64_t to);
+    void abortLeaderTransfer();
+    // 最近一个选举周期内是否收到过大多数副本的消息
+    bool quorumActive() const;
 
 private:
     void becomeCandidate();
     void becomePreCandidate();
     void stepCandidate(MessagePtr& msg);
-    void campaign(bool pre);
+    void campaign(bool pre, bool transfer);
     int poll(bool pre, uint64_t node_id, bool vote);
 
 private:
@@ -141,7 +153,13 @@ private:
     std::function<void(MessagePtr&)> step_func_;
     std::function<void()> tick_func_;
 
-    std::vector<MessagePtr> sending_msgs_;
+    // 正在转移leader的目标节点，转移期间leader不接受新的提案
+    uint64_t lead_transferee_ = 0;
+    unsigned transfer_elapsed_ = 0;
+    // 本轮选举是否不受租约限制(leader转移或外部指定)，预选举通过后的正式选举沿用
+    bool campaign_transfer_ = false;
+
+    std::vector<SendingMessage> sending_msgs_;
     std::shared_ptr<SendSnapTask> sending_snap_;
 
     std::shared_ptr<ApplySnapTask> applying_snap_;
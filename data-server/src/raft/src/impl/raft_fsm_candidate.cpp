@@ -71,7 +71,7 @@ void RaftFsm::stepCandidate(MessagePtr& msg) {
 
             if (grants == quorum()) {  // 收到大多数投票
                 if (pre) {
-                    campaign(false);
+                    campaign(false, campaign_transfer_);
                 } else {
                     becomeLeader();
                     bcastAppend();
@@ -87,17 +87,18 @@ void RaftFsm::stepCandidate(MessagePtr& msg) {
     }
 }
 
-void RaftFsm::campaign(bool pre) {
+void RaftFsm::campaign(bool pre, bool transfer) {
     if (pre) {
         becomePreCandidate();
     } else {
         becomeCandidate();
     }
+    campaign_transfer_ = transfer;
 
     // 可能只有一个成员
     if (poll(pre, node_id_, true) == quorum()) {
         if (pre) {
-            campaign(false);
+            campaign(false, transfer);
         } else {
             becomeLeader();
         }
@@ -121,6 +122,7 @@ void RaftFsm::campaign(bool pre) {
         msg->set_to(r.first);
         msg->set_log_index(li);
         msg->set_log_term(lt);
+        msg->set_transfer(transfer);
         send(msg);
     }
 }
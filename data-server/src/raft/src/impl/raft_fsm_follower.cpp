@@ -48,6 +48,13 @@ void RaftFsm::stepFollower(MessagePtr& msg) {
             handleSnapshot(msg);
             return;
 
+        case pb::TIMEOUT_NOW:
+            // leader转移，日志已经追上，跳过预选举
+            LOG_INFO("raft[%llu] received timeout now from %llu at term %llu", id_,
+                     msg->from(), term_);
+            hup(false, true);
+            return;
+
         case pb::LOCAL_SNAPSHOT_STATUS:
             if (!applying_snap_ || applying_snap_->GetContext().uuid != msg->snapshot().uuid()) {
                 return;
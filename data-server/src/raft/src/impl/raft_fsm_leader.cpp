@@ -49,6 +49,12 @@ void RaftFsm::becomeLeader() {
 
 void RaftFsm::stepLeader(MessagePtr& msg) {
     if (msg->type() == pb::LOCAL_MSG_PROP) {
+        if (lead_transferee_ != 0) {
+            LOG_DEBUG("raft[%llu] transferring leader to %llu at term %llu; dropping "
+                      "proposal.",
+                      id_, lead_transferee_, term_);
+            return;
+        }
         if (replicas_.find(node_id_) != replicas_.end() && msg->entries_size() > 0) {
             std::vector<EntryPtr> ents;
             takeEntries(msg, ents);
@@ -126,6 +132,11 @@ void RaftFsm::stepLeader(MessagePtr& msg) {
                     } else if (old_paused) {
                         sendAppend(msg->from(), pr);
                     }
+                    // 转移目标的日志追上了
+                    if (msg->from() == lead_transferee_ &&
+                        pr.match() == raft_log_->lastIndex()) {
+                        sendTimeoutNow(msg->from());
+                    }
                 }
             }
             return;
@@ -202,6 +213,25 @@ void RaftFsm::tickHeartbeat() {
         }
     });
 
+    // 一个选举周期内没有完成转移，恢复接受提案
+    if (lead_transferee_ != 0 && ++transfer_elapsed_ >= sops_.election_tick) {
+        LOG_WARN("raft[%llu] transfer leader to %llu timeout at term %llu", id_,
+                 lead_transferee_, term_);
+        abortLeaderTransfer();
+    }
+
+    // 被隔离的leader退位，不再接受提案，客户端可以尽快找到新leader
+    if (sops_.enable_check_quorum && ++election_elapsed_ >= sops_.election_tick) {
+        election_elapsed_ = 0;
+        if (!quorumActive()) {
+            LOG_WARN("raft[%llu] stepped down to follower since quorum is not active "
+                     "at term %llu",
+                     id_, term_);
+            becomeFollower(term_, 0);
+            return;
+        }
+    }
+
     if (heartbeat_elapsed_ >= sops_.heartbeat_tick) {
         heartbeat_elapsed_ = 0;
 
@@ -212,6 +242,55 @@ void RaftFsm::tickHeartbeat() {
     }
 }
 
+bool RaftFsm::quorumActive() const {
+    int active = 0;
+    for (const auto& r : replicas_) {
+        if (r.first == node_id_ || r.second->inactive_ticks() < sops_.election_tick) {
+            ++active;
+        }
+    }
+    return active >= quorum();
+}
+
+void RaftFsm::transferLeader(uint64_t to) {
+    if (to == node_id_) {
+        return;
+    }
+    auto it = replicas_.find(to);
+    if (it == replicas_.end()) {
+        LOG_WARN("raft[%llu] transfer leader to %llu failed: not a normal replica", id_,
+                 to);
+        return;
+    }
+    if (lead_transferee_ == to) {
+        return;
+    }
+
+    LOG_INFO("raft[%llu] start transfer leader to %llu at term %llu", id_, to, term_);
+
+    lead_transferee_ = to;
+    transfer_elapsed_ = 0;
+    Replica& pr = *(it->second);
+    if (pr.match() == raft_log_->lastIndex()) {
+        sendTimeoutNow(to);
+    } else {
+        // 先把日志复制过去，追上后再通知选举
+        sendAppend(to, pr);
+    }
+}
+
+void RaftFsm::sendTimeoutNow(uint64_t to) {
+    MessagePtr msg(new pb::Message);
+    msg->set_type(pb::TIMEOUT_NOW);
+    msg->set_to(to);
+    send(msg);
+}
+
+void RaftFsm::abortLeaderTransfer() {
+    lead_transferee_ = 0;
+    transfer_elapsed_ = 0;
+}
+
 bool RaftFsm::maybeCommit() {
     std::vector<uint64_t> matches;
     matches.reserve(replicas_.size());
@@ -282,12 +361,11 @@ void RaftFsm::sendAppend(uint64_t to, Replica& pr) {
         msg->set_log_index(pr.next() - 1);  // prev log index
         msg->set_log_term(term);            // prev log term
         msg->set_commit(raft_log_->committed());
-        putEntries(msg, ents);
 
-        if (msg->entries_size() > 0) {
+        if (!ents.empty()) {
             switch (pr.state()) {
                 case ReplicaState::kReplicate: {
-                    uint64_t last = msg->entries(msg->entries_size() - 1).index();
+                    uint64_t last = ents.back()->index();
                     pr.update(last);
                     pr.inflight().add(last);
                     break;
@@ -302,7 +380,7 @@ void RaftFsm::sendAppend(uint64_t to, Replica& pr) {
                         ReplicateStateName(pr.state()));
             }
         }
-        send(msg);
+        send(msg, std::move(ents));
     }
 }
 
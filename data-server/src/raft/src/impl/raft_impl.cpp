@@ -36,10 +36,27 @@ Status RaftImpl::TryToLeader() {
         return Status(Status::kShutdownInProgress, "raft is removed",
                       std::to_string(ops_.id));
     }
-    // 发送选举消息
+    // 发送选举消息，主动发起的选举不受其他副本的leader租约限制
     MessagePtr msg(new pb::Message);
     msg->set_type(pb::LOCAL_MSG_HUP);
     msg->set_from(sops_.node_id);
+    msg->set_transfer(true);
+    RecvMsg(msg);
+    return Status::OK();
+}
+
+Status RaftImpl::TransferLeader(uint64_t node_id) {
+    if (stopped_) {
+        return Status(Status::kShutdownInProgress, "raft is removed",
+                      std::to_string(ops_.id));
+    }
+    if (!IsLeader()) {
+        return Status(Status::kNotLeader, "transfer leader", std::to_string(ops_.id));
+    }
+    MessagePtr msg(new pb::Message);
+    msg->set_type(pb::LOCAL_MSG_TRANSFER);
+    msg->set_from(sops_.node_id);
+    msg->set_to(node_id);
     RecvMsg(msg);
     return Status::OK();
 }
@@ -49,15 +66,27 @@ void RaftImpl::post(const std::function<void()>& f) {
     w.owner = ops_.id;
     w.stopped = &stopped_;
     w.f0 = f;
-    ctx_.consensus_thread->post(w);
+    ctx_.consensus_thread->post(std::move(w));
 }
 
-bool RaftImpl::tryPost(const std::function<void()>& f) {
+void RaftImpl::postStep(MessagePtr msg) {
     Work w;
+    w.type = Work::kStep;
     w.owner = ops_.id;
     w.stopped = &stopped_;
-    w.f0 = f;
-    return ctx_.consensus_thread->tryPost(w);
+    w.raft = shared_from_this();
+    w.msg = std::move(msg);
+    ctx_.consensus_thread->post(std::move(w));
+}
+
+bool RaftImpl::tryPostStep(MessagePtr msg) {
+    Work w;
+    w.type = Work::kStep;
+    w.owner = ops_.id;
+    w.stopped = &stopped_;
+    w.raft = shared_from_this();
+    w.msg = std::move(msg);
+    return ctx_.consensus_thread->tryPost(std::move(w));
 }
 
 Status RaftImpl::Submit(std::string& cmd) {
@@ -66,9 +95,18 @@ Status RaftImpl::Submit(std::string& cmd) {
                       std::to_string(ops_.id));
     }
 
-    if (ctx_.consensus_thread->submit(
-            ops_.id, &stopped_,
-            std::bind(&RaftImpl::Step, shared_from_this(), std::placeholders::_1), cmd)) {
+    if (lead_transferee_ != 0) {
+        return Status(Status::kBusy, "transferring leader",
+                      std::to_string(lead_transferee_));
+    }
+
+    if (!sops_.apply_in_place && apply_pending_ >= sops_.apply_queue_capacity) {
+        return Status(Status::kBusy, "too many entries waiting to apply",
+                      std::to_string(apply_pending_));
+    }
+
+    if (ctx_.consensus_thread->submit(ops_.id, &stopped_, shared_from_this(),
+                                          &proposals_, cmd)) {
         return Status::OK();
     } else {
         return Status(Status::kBusy);
@@ -91,7 +129,7 @@ Status RaftImpl::ChangeMemeber(const ConfChange& conf) {
     entry->set_type(pb::ENTRY_CONF_CHANGE);
     entry->mutable_data()->swap(str);
 
-    if (tryPost(std::bind(&RaftImpl::Step, shared_from_this(), msg))) {
+    if (tryPostStep(msg)) {
         return Status::OK();
     } else {
         return Status(Status::kBusy);
@@ -117,7 +155,7 @@ void RaftImpl::RecvMsg(MessagePtr msg) {
 #endif
     if (stopped_) return;
 
-    if (!tryPost(std::bind(&RaftImpl::Step, shared_from_this(), msg))) {
+    if (!tryPostStep(msg)) {
         LOG_DEBUG("raft[%llu] discard a msg. type: %s from %llu, term: %llu", ops_.id,
                   pb::MessageType_Name(msg->type()).c_str(), msg->from(), msg->term());
     }
@@ -159,8 +197,12 @@ void RaftImpl::Step(MessagePtr msg) {
 }
 
 void RaftImpl::sendMessages() {
-    for (auto m : ready_.msgs) {
-        ctx_.msg_sender->SendMessage(m);
+    for (auto& m : ready_.msgs) {
+        if (m.ents.empty()) {
+            ctx_.msg_sender->SendMessage(m.msg);
+        } else {
+            ctx_.msg_sender->SendMessage(m.msg, m.ents);
+        }
     }
 }
 
@@ -198,6 +240,27 @@ void RaftImpl::applySnapshot() {
     apply_opt.wait_data_timeout_secs = 10;
     task->SetOptions(apply_opt);
 
+    if (sops_.apply_in_place) {
+        dispatchApplySnapshot(task);
+        return;
+    }
+
+    // 异步apply时，快照排在之前提交的日志后面，等它们应用完再开始
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(apply_mu_);
+        apply_queue_.push_back(ApplyItem{nullptr, task});
+        if (!apply_scheduled_) {
+            apply_scheduled_ = true;
+            schedule = true;
+        }
+    }
+    if (schedule) {
+        ctx_.apply_scheduler->Schedule(shared_from_this());
+    }
+}
+
+void RaftImpl::dispatchApplySnapshot(const std::shared_ptr<ApplySnapTask>& task) {
     auto s = ctx_.snapshot_manager->Dispatch(task);
     if (!s.ok()) {
         SnapResult result;
@@ -209,6 +272,8 @@ void RaftImpl::applySnapshot() {
 // 应用
 void RaftImpl::apply() {
     const auto& ents = ready_.committed_entries;
+    if (ents.empty()) return;
+
     for (const auto& e : ents) {
         if (e->type() == pb::ENTRY_CONF_CHANGE) {
             auto s = fsm_->applyConfChange(e);
@@ -222,19 +287,59 @@ void RaftImpl::apply() {
         if (sops_.apply_in_place) {
             // 同步应用
             smApply(e);
+        }
+    }
+
+    if (!sops_.apply_in_place) {
+        // 异步应用，放入本raft的apply队列，不阻塞consensus线程
+        assert(ctx_.apply_scheduler != nullptr);
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(apply_mu_);
+            for (const auto& e : ents) {
+                apply_queue_.push_back(ApplyItem{e, nullptr});
+            }
+            apply_pending_ += ents.size();
+            if (!apply_scheduled_) {
+                apply_scheduled_ = true;
+                schedule = true;
+            }
+        }
+        if (schedule) {
+            ctx_.apply_scheduler->Schedule(shared_from_this());
+        }
+    }
+
+    fsm_->raft_log_->appliedTo(fsm_->raft_log_->committed());
+}
+
+bool RaftImpl::DrainApply(size_t max_count) {
+    for (size_t i = 0; i < max_count; ++i) {
+        ApplyItem item;
+        {
+            std::lock_guard<std::mutex> lock(apply_mu_);
+            if (apply_queue_.empty()) {
+                apply_scheduled_ = false;
+                return false;
+            }
+            item = std::move(apply_queue_.front());
+            apply_queue_.pop_front();
+        }
+
+        if (item.snap != nullptr) {
+            if (!stopped_) dispatchApplySnapshot(item.snap);
         } else {
-            // 异步应用
-            assert(ctx_.apply_thread != nullptr);
-            Work w;
-            w.owner = ops_.id;
-            w.stopped = &stopped_;
-            w.f0 = std::bind(&RaftImpl::smApply, shared_from_this(), e);
-            ctx_.apply_thread->waitPost(w);
+            if (!stopped_) smApply(item.entry);
+            --apply_pending_;
         }
     }
-    if (!ents.empty()) {
-        fsm_->raft_log_->appliedTo(fsm_->raft_log_->committed());
+
+    std::lock_guard<std::mutex> lock(apply_mu_);
+    if (apply_queue_.empty()) {
+        apply_scheduled_ = false;
+        return false;
     }
+    return true;
 }
 
 // 持久化
@@ -259,6 +364,7 @@ void RaftImpl::publish() {
         bulletin_board_.PublishLeaderTerm(leader, term);
         leader_changed = true;
     }
+    lead_transferee_ = fsm_->GetLeadTransferee();
 
     // 更新成员
     if (conf_changed_) {
@@ -298,7 +404,7 @@ void RaftImpl::ReportSnapSendResult(const SnapContext& ctx, const SnapResult& re
     resp->set_reject(!result.status.ok());
     resp->mutable_snapshot()->set_uuid(ctx.uuid);
 
-    post(std::bind(&RaftImpl::Step, shared_from_this(), resp));
+    postStep(resp);
 }
 
 void RaftImpl::ReportSnapApplyResult(const SnapContext& ctx, const SnapResult& result) {
@@ -322,7 +428,7 @@ void RaftImpl::ReportSnapApplyResult(const SnapContext& ctx, const SnapResult& r
     resp->set_reject(!result.status.ok());
     resp->mutable_snapshot()->set_uuid(ctx.uuid);
 
-    post(std::bind(&RaftImpl::Step, shared_from_this(), resp));
+    postStep(resp);
 }
 
 void RaftImpl::smApply(const EntryPtr& e) {
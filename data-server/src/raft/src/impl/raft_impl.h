@@ -1,6 +1,8 @@
 _Pragma("once");
 
+#include <deque>
 #include <list>
+#include <mutex>
 #include "raft/options.h"
 #include "raft/raft.h"
 
@@ -28,8 +30,10 @@ public:
 
     void Stop();
     bool IsStopped() const override { return stopped_; }
+    uint64_t Id() const { return ops_.id; }
 
     Status TryToLeader() override;
+    Status TransferLeader(uint64_t node_id) override;
 
     Status Submit(std::string& cmd) override;
     Status ChangeMemeber(const ConfChange& conf) override;
@@ -40,7 +44,10 @@ public:
         bulletin_board_.LeaderTerm(leader, term);
     }
 
-    void GetStatus(RaftStatus* status) const override { bulletin_board_.Status(status); }
+    void GetStatus(RaftStatus* status) const override {
+        bulletin_board_.Status(status);
+        status->apply_pending = apply_pending_;
+    }
 
     void GetPeers(std::vector<Peer>* peers) const { bulletin_board_.Peers(peers); }
 
@@ -57,6 +64,10 @@ public:
     void Tick(MessagePtr msg);
     void Step(MessagePtr msg);
 
+    // 由apply线程调用，按顺序处理异步apply队列，最多max_count项
+    // 返回true表示队列中还有未处理的
+    bool DrainApply(size_t max_count);
+
     void ReportSnapSendResult(const SnapContext& ctx, const SnapResult& result);
     void ReportSnapApplyResult(const SnapContext& ctx, const SnapResult& result);
 
@@ -64,9 +75,11 @@ private:
     void initPublish();
 
     void post(const std::function<void()>& f);
-    bool tryPost(const std::function<void()>& f);
+    void postStep(MessagePtr msg);
+    bool tryPostStep(MessagePtr msg);
 
     void smApply(const EntryPtr& e);
+    void dispatchApplySnapshot(const std::shared_ptr<ApplySnapTask>& task);
 
     void sendMessages();
     void sendSnapshot();
@@ -84,6 +97,8 @@ private:
     const RaftContext ctx_;
 
     std::atomic<bool> stopped_ = {false};
+    // 待处理的提案，由consensus_thread取出合并
+    ProposalQueue proposals_;
 
     BulletinBoard bulletin_board_;
 
@@ -93,6 +108,20 @@ private:
     pb::HardState prev_hard_state_;
     bool conf_changed_ = false;
     std::atomic<uint64_t> tick_count_ = {0};
+    // leader转移期间fsm会丢弃提案，Submit直接返回忙
+    std::atomic<uint64_t> lead_transferee_ = {0};
+
+    // 异步apply队列中的一项，日志或者快照，按提交顺序处理
+    struct ApplyItem {
+        EntryPtr entry;
+        std::shared_ptr<ApplySnapTask> snap;
+    };
+    std::deque<ApplyItem> apply_queue_;
+    // 是否已经交给ApplyScheduler（在就绪队列中或者正在apply）
+    bool apply_scheduled_ = false;
+    std::mutex apply_mu_;
+    // 队列中还未应用的日志条数
+    std::atomic<uint64_t> apply_pending_ = {0};
 };
 
 } /* namespace impl */
@@ -255,7 +255,7 @@ void limitSize(std::vector<EntryPtr>& ents, uint64_t max_size) {
 
     uint64_t size = 0;
     for (auto it = ents.begin(); it != ents.end(); ++it) {
-        size += (*it)->ByteSizeLong();
+        size += (*it)->GetCachedSize();
         if (size > max_size) {
             if (it != ents.begin()) {  // 至少留一个
                 ents.erase(it, ents.end());
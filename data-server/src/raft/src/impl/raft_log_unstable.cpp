@@ -1,15 +1,26 @@
 #include "raft_log_unstable.h"
 
 #include <sstream>
+#include "base/mem_tracker.h"
 #include "raft_exception.h"
 
 namespace sharkstore {
 namespace raft {
 namespace impl {
 
+// 所有raft的unstable日志共用一个统计节点
+static MemTracker* unstableTracker() {
+    static MemTracker* tracker = new MemTracker("raft_unstable", MemTracker::Root());
+    return tracker;
+}
+
+static int64_t entrySize(const EntryPtr& e) {
+    return static_cast<int64_t>(sizeof(pb::Entry) + e->data().size());
+}
+
 UnstableLog::UnstableLog(uint64_t offset) : offset_(offset) {}
 
-UnstableLog::~UnstableLog() {}
+UnstableLog::~UnstableLog() { clear(); }
 
 bool UnstableLog::maybeLastIndex(uint64_t* last_index) const {
     if (!entries_.empty()) {
@@ -41,13 +52,20 @@ void UnstableLog::stableTo(uint64_t index, uint64_t term) {
     }
 
     if (gt == term && index >= offset_) {
-        entries_.erase(entries_.begin(), entries_.begin() + (index - offset_ + 1));
+        auto end = entries_.begin() + (index - offset_ + 1);
+        int64_t released = 0;
+        for (auto it = entries_.begin(); it != end; ++it) {
+            released += entrySize(*it);
+        }
+        entries_.erase(entries_.begin(), end);
+        bytes_ -= released;
+        unstableTracker()->Release(released);
         offset_ = index + 1;
     }
 }
 
 void UnstableLog::restore(uint64_t index) {
-    entries_.clear();
+    clear();
     offset_ = index + 1;
 }
 
@@ -55,19 +73,44 @@ void UnstableLog::truncateAndAppend(const std::vector<EntryPtr>& ents) {
     uint64_t after = ents[0]->index();
     if (after == offset_ + static_cast<uint64_t>(entries_.size())) {
         // 直接拼接
-        std::copy(ents.begin(), ents.end(), std::back_inserter(entries_));
+        append(ents);
     } else if (after <= offset_) {
         // 全部冲突，清空
-        entries_.clear();
-        std::copy(ents.begin(), ents.end(), std::back_inserter(entries_));
+        clear();
+        append(ents);
         offset_ = after;
     } else {
         // 部分冲突，截断到冲突位置
         while (!entries_.empty() && entries_.back()->index() >= after) {
-            entries_.pop_back();
+            popBack();
         }
-        std::copy(ents.begin(), ents.end(), std::back_inserter(entries_));
+        append(ents);
+    }
+}
+
+void UnstableLog::append(const std::vector<EntryPtr>& ents) {
+    int64_t added = 0;
+    for (const auto& e : ents) {
+        // 共享给日志写线程和transport之前计算好编码大小，之后只读
+        e->ByteSizeLong();
+        added += entrySize(e);
+        entries_.push_back(e);
     }
+    bytes_ += added;
+    unstableTracker()->Consume(added);
+}
+
+void UnstableLog::popBack() {
+    auto size = entrySize(entries_.back());
+    entries_.pop_back();
+    bytes_ -= size;
+    unstableTracker()->Release(size);
+}
+
+void UnstableLog::clear() {
+    entries_.clear();
+    unstableTracker()->Release(bytes_);
+    bytes_ = 0;
 }
 
 void UnstableLog::slice(uint64_t lo, uint64_t hi, std::vector<EntryPtr>* ents) const {
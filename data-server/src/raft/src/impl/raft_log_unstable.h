@@ -18,6 +18,8 @@ public:
     UnstableLog& operator=(const UnstableLog&) = delete;
 
     uint64_t offset() const { return offset_; }
+    // entries_占用的内存大小（估算）
+    int64_t bytes() const { return bytes_; }
 
     bool maybeLastIndex(uint64_t* last_index) const;
     bool maybeTerm(uint64_t index, uint64_t* term) const;
@@ -32,9 +34,14 @@ public:
 private:
     void mustCheckOutOfBounds(uint64_t lo, uint64_t hi) const;
 
+    void append(const std::vector<EntryPtr>& ents);
+    void popBack();
+    void clear();
+
 private:
     uint64_t offset_ = 0;  // 起始日志的index
     std::deque<EntryPtr> entries_;
+    int64_t bytes_ = 0;
 };
 
 } /* namespace impl */
@@ -1,6 +1,8 @@
 #include "raft_types.h"
 
 #include <sstream>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 
 namespace sharkstore {
 namespace raft {
@@ -133,11 +135,38 @@ Status DecodeConfChange(const std::string& pb_str, ConfChange* cc) {
     return Status::OK();
 }
 
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+static const uint32_t kEntriesTag = WireFormatLite::MakeTag(
+    pb::Message::kEntriesFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+
+size_t EntriesByteSize(const std::vector<EntryPtr>& ents) {
+    size_t total = 0;
+    for (const auto& e : ents) {
+        size_t size = static_cast<size_t>(e->GetCachedSize());
+        total += CodedOutputStream::VarintSize32(kEntriesTag) +
+                 CodedOutputStream::VarintSize32(static_cast<uint32_t>(size)) + size;
+    }
+    return total;
+}
+
+uint8_t* SerializeEntriesToArray(const std::vector<EntryPtr>& ents, uint8_t* target) {
+    for (const auto& e : ents) {
+        target = CodedOutputStream::WriteTagToArray(kEntriesTag, target);
+        target = CodedOutputStream::WriteVarint32ToArray(
+            static_cast<uint32_t>(e->GetCachedSize()), target);
+        target = e->SerializeWithCachedSizesToArray(target);
+    }
+    return target;
+}
+
 bool IsLocalMsg(MessagePtr& msg) {
     switch (msg->type()) {
         case pb::LOCAL_MSG_HUP:
         case pb::LOCAL_MSG_PROP:
         case pb::LOCAL_MSG_TICK:
+        case pb::LOCAL_MSG_TRANSFER:
             return true;
         default:
             return false;
@@ -2,6 +2,7 @@ _Pragma("once");
 
 #include <chrono>
 #include <memory>
+#include <vector>
 #include "base/status.h"
 #include "raft/types.h"
 
@@ -13,10 +14,25 @@ namespace impl {
 
 static const uint64_t kNoLimit = std::numeric_limits<uint64_t>::max();
 
+// 日志条目进入raft log时(UnstableLog::append)计算一次编码大小，之后在raft、
+// 日志写线程、transport发送线程之间共享只读，各处只用GetCachedSize()，
+// 不能再调用ByteSizeLong(会写缓存的大小，多线程并发写有数据竞争)
 using EntryPtr = std::shared_ptr<pb::Entry>;
 using MessagePtr = std::shared_ptr<pb::Message>;
 using TimePoint = std::chrono::time_point<std::chrono::steady_clock>;
 
+// 待发送的消息
+// append消息的日志条目跟本地日志共享，不拷贝进msg，由transport编码时直接拼接到消息体
+struct SendingMessage {
+    MessagePtr msg;
+    std::vector<EntryPtr> ents;
+
+    SendingMessage() = default;
+    explicit SendingMessage(const MessagePtr& m) : msg(m) {}
+    SendingMessage(const MessagePtr& m, std::vector<EntryPtr>&& es)
+        : msg(m), ents(std::move(es)) {}
+};
+
 enum class FsmState { kFollower = 0, kCandidate, kLeader, kPreCandidate };
 
 std::string FsmStateName(FsmState state);
@@ -33,6 +49,12 @@ Status DecodePeer(const pb::Peer& pb_peer, Peer* peer);
 Status EncodeConfChange(const ConfChange& cc, std::string* pb_str);
 Status DecodeConfChange(const std::string& pb_str, ConfChange* cc);
 
+// ents作为Message的entries字段编码后的大小，使用各条目已缓存的编码大小
+size_t EntriesByteSize(const std::vector<EntryPtr>& ents);
+// 把ents编码成Message的entries字段写到target
+// 跟Message编码后的数据拼接在一起即为完整的Message
+uint8_t* SerializeEntriesToArray(const std::vector<EntryPtr>& ents, uint8_t* target);
+
 bool IsLocalMsg(MessagePtr& msg);
 bool IsResponseMsg(MessagePtr& msg);
 
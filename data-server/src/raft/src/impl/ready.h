@@ -13,7 +13,7 @@ struct Ready {
     std::vector<EntryPtr> committed_entries;
 
     // msgs to send
-    std::vector<MessagePtr> msgs;
+    std::vector<SendingMessage> msgs;
 
     // snapshot to send
     std::shared_ptr<SendSnapTask> send_snap;
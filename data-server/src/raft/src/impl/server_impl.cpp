@@ -2,10 +2,13 @@
 
 #include <thread>
 
+#include "apply_scheduler.h"
 #include "logger.h"
 #include "raft_exception.h"
 #include "raft_impl.h"
 #include "snapshot/manager.h"
+#include "storage/log_file.h"
+#include "transport/compression.h"
 #include "transport/fast_transport.h"
 #include "transport/inprocess_transport.h"
 #include "transport/transport.h"
@@ -14,6 +17,9 @@ namespace sharkstore {
 namespace raft {
 namespace impl {
 
+// apply线程每次调度一个range最多应用的条数
+static const size_t kApplyBatchSize = 64;
+
 RaftServerImpl::RaftServerImpl(const RaftServerOptions& ops) : ops_(ops) {
     tick_msg_.reset(new pb::Message);
     tick_msg_->set_type(pb::LOCAL_MSG_TICK);
@@ -25,9 +31,6 @@ RaftServerImpl::~RaftServerImpl() {
     for (auto t: consensus_threads_) {
         delete t;
     }
-    for (auto t : apply_threads_) {
-        delete t;
-    }
 }
 
 Status RaftServerImpl::Start() {
@@ -36,31 +39,35 @@ Status RaftServerImpl::Start() {
         return status;
     }
 
+    storage::LogFile::SetMmapBudget(ops_.log_mmap_budget);
+
     // 初始化raft工作线程池
+    BatchOptions batch_ops;
+    batch_ops.max_entries = ops_.max_batch_entries;
+    batch_ops.max_bytes = ops_.max_batch_bytes;
+    batch_ops.max_delay = ops_.max_batch_delay;
     for (int i = 0; i < ops_.consensus_threads_num; ++i) {
         auto t = new WorkThread(this, ops_.consensus_queue_capacity,
-                                std::string("raft-worker:") + std::to_string(i));
+                                std::string("raft-worker:") + std::to_string(i),
+                                batch_ops);
         consensus_threads_.push_back(t);
     }
     LOG_INFO("raft[server] %d consensus threads start. queue capacity=%d",
              ops_.consensus_threads_num, ops_.consensus_queue_capacity);
 
-    // 初始化apply工作线程池
-    for (int i = 0; i < ops_.apply_threads_num; ++i) {
-        auto t = new WorkThread(this, ops_.apply_queue_capacity,
-                                std::string("raft-apply:") + std::to_string(i));
-        apply_threads_.push_back(t);
+    // 初始化apply线程池
+    if (!ops_.apply_in_place) {
+        apply_scheduler_.reset(
+            new ApplyScheduler(this, ops_.apply_threads_num, kApplyBatchSize));
+        LOG_INFO("raft[server] %d apply threads start. range apply capacity=%d",
+                 ops_.apply_threads_num, ops_.apply_queue_capacity);
     }
-    LOG_INFO("raft[server] %d apply threads start. queue capacity=%d",
-             ops_.apply_threads_num, ops_.apply_queue_capacity);
 
     // start transport
     if (ops_.transport_options.use_inprocess_transport) {
         transport_.reset(new transport::InProcessTransport(ops_.node_id));
     } else {
-        transport_.reset(new transport::FastTransport(ops_.transport_options.resolver,
-                                                  ops_.transport_options.send_io_threads,
-                                                  ops_.transport_options.recv_io_threads));
+        transport_.reset(new transport::FastTransport(ops_.transport_options));
     }
     status = transport_->Start(
         ops_.transport_options.listen_ip, ops_.transport_options.listen_port,
@@ -91,8 +98,8 @@ Status RaftServerImpl::Stop() {
         t->shutdown();
     }
 
-    for (auto& t : apply_threads_) {
-        t->shutdown();
+    if (apply_scheduler_ != nullptr) {
+        apply_scheduler_->Shutdown();
     }
 
     if (snapshot_manager_ != nullptr) {
@@ -131,7 +138,7 @@ Status RaftServerImpl::CreateRaft(const RaftOptions& ops, std::shared_ptr<Raft>*
     ctx.snapshot_manager = snapshot_manager_.get();
     ctx.consensus_thread = consensus_threads_[counter % consensus_threads_.size()];
     if (!ops_.apply_in_place) {
-        ctx.apply_thread = apply_threads_[counter % apply_threads_.size()];
+        ctx.apply_scheduler = apply_scheduler_.get();
     }
 
     std::shared_ptr<RaftImpl> r;
@@ -236,6 +243,34 @@ void RaftServerImpl::GetStatus(ServerStatus* status) const {
     status->total_snap_sending = snapshot_manager_->SendingCount();
     status->total_snap_applying = snapshot_manager_->ApplyingCount();
     status->total_rafts_count  = raftSize();
+    transport_->GetStatus(status);
+}
+
+void RaftServerImpl::GetNodeLoads(std::map<uint64_t, NodeLoad>* loads) const {
+    std::lock_guard<std::mutex> lock(loads_mu_);
+    *loads = node_loads_;
+}
+
+void RaftServerImpl::fillHeartbeatContext(pb::HeartbeatContext* ctx) const {
+    auto load = ctx->mutable_load();
+    load->set_leader_count(leader_count_);
+    load->set_raft_count(raftSize());
+    ctx->set_compressions(transport::LocalCompressions());
+    ctx->set_features(transport::LocalFeatures());
+}
+
+void RaftServerImpl::updatePeerContext(uint64_t node_id, const pb::HeartbeatContext& ctx) {
+    // 旧版本的节点不带compressions和features字段，不会向其发送压缩数据和合并的帧
+    transport_->SetPeerCapabilities(node_id, ctx.compressions(), ctx.features());
+
+    if (!ctx.has_load()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(loads_mu_);
+    auto& load = node_loads_[node_id];
+    load.leader_count = ctx.load().leader_count();
+    load.raft_count = ctx.load().raft_count();
+    load.update_time = std::chrono::steady_clock::now();
 }
 
 void RaftServerImpl::onMessage(MessagePtr& msg) {
@@ -263,6 +298,8 @@ void RaftServerImpl::onHeartbeatReq(MessagePtr& msg) {
     resp->set_type(pb::HEARTBEAT_RESPONSE);
     resp->set_from(ops_.node_id);
     resp->set_to(msg->from());
+    fillHeartbeatContext(resp->mutable_hb_ctx());
+    updatePeerContext(msg->from(), msg->hb_ctx());
 
     const auto& ids = msg->hb_ctx().ids();
     for (auto it = ids.begin(); it != ids.end(); ++it) {
@@ -283,6 +320,8 @@ void RaftServerImpl::onHeartbeatReq(MessagePtr& msg) {
 }
 
 void RaftServerImpl::onHeartbeatResp(MessagePtr& msg) {
+    updatePeerContext(msg->from(), msg->hb_ctx());
+
     const auto& ids = msg->hb_ctx().ids();
     for (auto it = ids.begin(); it != ids.end(); ++it) {
         uint64_t id = *it;
@@ -301,9 +340,11 @@ void RaftServerImpl::onHeartbeatResp(MessagePtr& msg) {
 void RaftServerImpl::sendHeartbeat(const RaftMapType& rafts) {
     std::map<uint64_t, std::set<uint64_t>> ctxs;
 
+    uint64_t leader_count = 0;
     for (auto& kv : rafts) {
         auto& r = kv.second;
         if (r->IsLeader()) {
+            ++leader_count;
             std::vector<Peer> peers;
             r->GetPeers(&peers);
             for (auto& p : peers) {
@@ -314,6 +355,7 @@ void RaftServerImpl::sendHeartbeat(const RaftMapType& rafts) {
             }
         }
     }
+    leader_count_ = leader_count;
 
     for (auto& kv : ctxs) {
         MessagePtr msg(new pb::Message);
@@ -323,6 +365,7 @@ void RaftServerImpl::sendHeartbeat(const RaftMapType& rafts) {
         for (auto id : kv.second) {
             msg->mutable_hb_ctx()->add_ids(id);
         }
+        fillHeartbeatContext(msg->mutable_hb_ctx());
         transport_->SendMessage(msg);
     }
 }
@@ -366,17 +409,38 @@ void RaftServerImpl::printMetrics() {
         consensus_metrics += "]";
         LOG_INFO("raft[metric] consensus queue size: %s", consensus_metrics.c_str());
 
-        // print apply queue size
-        if (!ops_.apply_in_place) {
-            std::string apply_metrics = "[";
-            for (size_t i = 0; i < apply_threads_.size(); ++i) {
-                apply_metrics += std::to_string(apply_threads_[i]->size());
-                if (i != apply_threads_.size() - 1) {
-                    apply_metrics += ", ";
+        // print proposal batch size
+        uint64_t total_batches = 0, total_entries = 0;
+        for (auto t : consensus_threads_) {
+            uint64_t batches = 0, entries = 0;
+            t->collectBatchStats(&batches, &entries);
+            total_batches += batches;
+            total_entries += entries;
+        }
+        if (total_batches > 0) {
+            LOG_INFO("raft[metric] proposal batches: %lu, entries: %lu, avg batch size: %.2f",
+                     total_batches, total_entries,
+                     static_cast<double>(total_entries) / total_batches);
+        }
+
+        // print apply backlog
+        if (apply_scheduler_ != nullptr) {
+            uint64_t total_pending = 0, max_pending = 0, max_id = 0;
+            {
+                sharkstore::shared_lock<sharkstore::shared_mutex> lock(rafts_mu_);
+                for (const auto& r : all_rafts_) {
+                    RaftStatus status;
+                    r.second->GetStatus(&status);
+                    total_pending += status.apply_pending;
+                    if (status.apply_pending > max_pending) {
+                        max_pending = status.apply_pending;
+                        max_id = r.first;
+                    }
                 }
             }
-            apply_metrics += "]";
-            LOG_INFO("raft[metric] apply queue size: %s", apply_metrics.c_str());
+            LOG_INFO("raft[metric] apply ready rafts: %lu, pending entries: %lu, "
+                     "max pending: %lu (raft[%lu])",
+                     apply_scheduler_->ReadyCount(), total_pending, max_pending, max_id);
         }
     }
 }
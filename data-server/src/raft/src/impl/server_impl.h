@@ -1,6 +1,8 @@
 _Pragma("once");
 
 #include <atomic>
+#include <map>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -15,6 +17,7 @@ namespace impl {
 
 class RaftImpl;
 class WorkThread;
+class ApplyScheduler;
 class SnapshotManager;
 
 namespace transport {
@@ -40,6 +43,7 @@ public:
     std::shared_ptr<Raft> FindRaft(uint64_t id) const override;
 
     void GetStatus(ServerStatus* status) const override;
+    void GetNodeLoads(std::map<uint64_t, NodeLoad>* loads) const override;
 
 private:
     using RaftMapType = std::unordered_map<uint64_t, std::shared_ptr<RaftImpl>>;
@@ -51,6 +55,9 @@ private:
     void onMessage(MessagePtr& msg);
     void onHeartbeatReq(MessagePtr& msg);
     void onHeartbeatResp(MessagePtr& msg);
+    // 心跳请求和回应中交换节点负载和解压能力
+    void fillHeartbeatContext(pb::HeartbeatContext* ctx) const;
+    void updatePeerContext(uint64_t node_id, const pb::HeartbeatContext& ctx);
 
     void stepTick(const RaftMapType& rafts);
     void printMetrics();
@@ -65,11 +72,16 @@ private:
     uint64_t create_count_ = 0;
     mutable sharkstore::shared_mutex rafts_mu_;
 
+    // 本节点是leader的raft个数，每次发送心跳时统计
+    std::atomic<uint64_t> leader_count_ = {0};
+    std::map<uint64_t, NodeLoad> node_loads_;
+    mutable std::mutex loads_mu_;
+
     std::unique_ptr<transport::Transport> transport_;
     std::unique_ptr<SnapshotManager> snapshot_manager_;
 
     std::vector<WorkThread*> consensus_threads_;
-    std::vector<WorkThread*> apply_threads_;
+    std::unique_ptr<ApplyScheduler> apply_scheduler_;
 
     MessagePtr tick_msg_;
     // TODO: more tick threads or put ticks into consensus_threads
@@ -62,6 +62,7 @@ void ApplySnapTask::run(SnapResult* result) {
 
         // 应用数据块
         size_t bytes = data->ByteSizeLong();
+        ScopedMemConsume mem(memTracker(), bytes);
         result->status = applyData(data, over);
         if (!result->status.ok()) {
             return;
@@ -79,6 +79,7 @@ void SendSnapTask::run(SnapResult* result) {
 
         // 发送
         size_t size = msg->ByteSizeLong();
+        ScopedMemConsume mem(memTracker(), size);
         result->status = conn->Send(msg);
         if (!result->status.ok()) {
             return;
@@ -3,6 +3,7 @@ _Pragma("once");
 #include <atomic>
 #include <memory>
 
+#include "base/mem_tracker.h"
 #include "types.h"
 
 namespace sharkstore {
@@ -48,6 +49,12 @@ public:
 protected:
     virtual void run(SnapResult *result) = 0;
 
+    // 所有快照任务正在发送或应用的数据块共用一个内存统计节点
+    static MemTracker* memTracker() {
+        static MemTracker* tracker = new MemTracker("raft_snapshot", MemTracker::Root());
+        return tracker;
+    }
+
 private:
     const SnapContext context_;
     const std::string id_; // unique task id
@@ -1,10 +1,13 @@
 #include "log_file.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <algorithm>
 #include <fstream>
+#include <random>
 #include "base/util.h"
 
 #include "../logger.h"
@@ -16,6 +19,32 @@ namespace impl {
 namespace storage {
 
 static const size_t kLogWriteBufSize = 1024 * 16;
+// 写缓冲超过此大小时，写入文件后释放多余的内存
+static const size_t kMaxRetainedBufSize = kLogWriteBufSize * 4;
+
+// 日志文件mmap的总字节数及上限
+static std::atomic<size_t> g_mmap_budget = {256 * 1024 * 1024};
+static std::atomic<size_t> g_mmap_bytes = {0};
+
+static_assert(sizeof(Header) == 64, "log header must be 64 bytes");
+static_assert(sizeof(Footer) == 64, "log footer must be 64 bytes");
+
+// 持久化文件所在目录，保证新建和重命名的文件在宕机后可见
+static Status syncDir(const std::string& file_path) {
+    auto pos = file_path.rfind('/');
+    std::string dir = (pos == std::string::npos) ? "." : file_path.substr(0, pos);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (-1 == fd) {
+        return Status(Status::kIOError, "open dir " + dir, strErrno(errno));
+    }
+    int ret = ::fsync(fd);
+    int err = errno;
+    ::close(fd);
+    if (ret != 0) {
+        return Status(Status::kIOError, "sync dir " + dir, strErrno(err));
+    }
+    return Status::OK();
+}
 
 LogFile::LogFile(const std::string& path, uint64_t seq, uint64_t index, bool readonly) :
     seq_(seq),
@@ -23,7 +52,7 @@ LogFile::LogFile(const std::string& path, uint64_t seq, uint64_t index, bool rea
     file_path_(makeFilePath(path, seq, index)),
     readonly_(readonly) {
     if (!readonly_) {
-        write_buf_.resize(kLogWriteBufSize);
+        write_buf_.reserve(kLogWriteBufSize);
     }
 }
 
@@ -33,54 +62,123 @@ std::string LogFile::makeFilePath(const std::string& path, uint64_t seq, uint64_
     return JoinFilePath({path, makeLogFileName(seq, index)});
 }
 
-Status LogFile::Open(bool allow_corrupt, bool last_one) {
+uint64_t LogFile::newEpoch() {
+    std::random_device rd;
+    uint64_t epoch = (static_cast<uint64_t>(rd()) << 32) | rd();
+    return epoch == 0 ? 1 : epoch;
+}
+
+Status LogFile::Open(bool allow_corrupt, bool last_one, uint64_t last_index) {
     // open fd
-    int oflag = readonly_ ? O_RDONLY : (O_CREAT | O_APPEND | O_RDWR);
+    int oflag = readonly_ ? O_RDONLY : (O_CREAT | O_RDWR);
     fd_ = ::open(file_path_.c_str(), oflag, 0644);
     if (-1 == fd_) {
         return Status(Status::kIOError, "open", strErrno(errno));
     }
 
-    // open write stream
-    if (!readonly_) {
-        writer_ = ::fdopen(fd_, "a+");
-        if (NULL == writer_) {
-            return Status(Status::kIOError, "fdopen", strErrno(errno));
-        }
-        if (::setvbuf(writer_, write_buf_.data(), _IOFBF, write_buf_.size()) != 0) {
-            return Status(Status::kIOError, "setvbuf", strErrno(errno));
-        }
-    }
-
     // get file size
     struct stat sb;
     memset(&sb, 0, sizeof(sb));
     int ret = fstat(fd_, &sb);
     if (-1 == ret) {
         return Status(Status::kIOError, "stat", strErrno(errno));
-    } else {
-        file_size_ = sb.st_size;
     }
+    alloc_size_ = sb.st_size;
+    file_size_ = alloc_size_;
 
     if (file_size_ == 0) {  // 新建文件或者空文件
-        return Status::OK();
+        if (readonly_) {
+            return Status::OK();
+        }
+        epoch_ = newEpoch();
+        base_epoch_ = epoch_;
+        return initHeader();
+    }
+
+    auto s = readHeader();
+    if (!s.ok()) {
+        return Status(Status::kCorruption, std::string("read log header ") + file_path_,
+                      s.ToString());
+    }
+    if (!last_one) {
+        sealed_ = true;
+        if (last_index >= index_) {
+            // 启动时不解析索引，减少日志文件很多时的打开时间
+            lazy_last_index_ = last_index;
+            index_loaded_.store(false, std::memory_order_release);
+            return Status::OK();
+        }
+        s = loadIndexes();
+        if (!s.ok()) {
+            return Status(Status::kCorruption,
+                          std::string("open log index ") + file_path_, s.ToString());
+        }
     } else {
-        if (!last_one) {
-            auto s = loadIndexes();
-            if (!s.ok()) {
-                return Status(Status::kCorruption,
-                              std::string("open log index ") + file_path_, s.ToString());
-            }
-        } else {
-            auto s = recover(allow_corrupt);
-            if (!s.ok()) {
-                return Status(Status::kCorruption,
-                              std::string("recover log file ") + file_path_,
-                              s.ToString());
+        s = recover(allow_corrupt);
+        if (!s.ok()) {
+            return Status(Status::kCorruption,
+                          std::string("recover log file ") + file_path_, s.ToString());
+        }
+    }
+    return Status::OK();
+}
+
+Status LogFile::Create(const std::string& recycled_path) {
+    if (readonly_) {
+        return Status(Status::kNotSupported, "create", "read only");
+    }
+
+    uint64_t old_epoch = 0;
+    uint64_t old_base_epoch = 0;
+    if (!recycled_path.empty()) {
+        // 复用回收的文件，已经分配好的磁盘空间不需要再次分配
+        if (::rename(recycled_path.c_str(), file_path_.c_str()) != 0) {
+            return Status(Status::kIOError, "rename " + recycled_path, strErrno(errno));
+        }
+        fd_ = ::open(file_path_.c_str(), O_RDWR);
+        if (-1 == fd_) {
+            return Status(Status::kIOError, "open", strErrno(errno));
+        }
+        Header header;
+        auto ret = ::pread(fd_, &header, sizeof(header), 0);
+        if (ret == static_cast<ssize_t>(sizeof(header))) {
+            header.Decode();
+            if (header.Validate().ok()) {
+                old_epoch = header.epoch;
+                old_base_epoch = header.base_epoch != 0 ? header.base_epoch : old_epoch;
             }
         }
-        return Status::OK();
+    } else {
+        fd_ = ::open(file_path_.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+        if (-1 == fd_) {
+            return Status(Status::kIOError, "open", strErrno(errno));
+        }
+    }
+
+    struct stat sb;
+    memset(&sb, 0, sizeof(sb));
+    if (fstat(fd_, &sb) == -1) {
+        return Status(Status::kIOError, "stat", strErrno(errno));
     }
+    alloc_size_ = sb.st_size;
+
+    // 复用的文件换一个epoch，旧数据的crc就校验不过了
+    if (old_epoch != 0) {
+        epoch_ = old_epoch + 1;
+        base_epoch_ = old_base_epoch;
+    } else {
+        epoch_ = newEpoch();
+        base_epoch_ = epoch_;
+    }
+    auto s = initHeader();
+    if (!s.ok()) {
+        return s;
+    }
+    s = reserve(file_size_ + sizeof(Record));
+    if (!s.ok()) {
+        return s;
+    }
+    return syncDir(file_path_);
 }
 
 Status LogFile::Sync() {
@@ -88,7 +186,13 @@ Status LogFile::Sync() {
     if (!s.ok()) {
         return s;
     }
-    if (::fsync(fd_) == -1) {
+#ifdef __APPLE__
+    int ret = ::fsync(fd_);
+#else
+    // 预分配后文件大小一般不变，fdatasync不需要再写inode元数据
+    int ret = ::fdatasync(fd_);
+#endif
+    if (ret == -1) {
         return Status(Status::kIOError, "sync log file", strErrno(errno));
     } else {
         return Status::OK();
@@ -96,13 +200,20 @@ Status LogFile::Sync() {
 }
 
 Status LogFile::Close() {
-    if (fd_ > 0) {
-        int ret = (writer_ != nullptr) ? ::fclose(writer_) : ::close(fd_);
+    unmap();
+    if (fd_ >= 0) {
+        Status s;
+        if (!readonly_) {
+            s = Flush();
+        }
+        int ret = ::close(fd_);
+        fd_ = -1;
+        if (!s.ok()) {
+            return s;
+        }
         if (ret != 0) {
             return Status(Status::kIOError, "close", strErrno(errno));
         }
-        writer_ = nullptr;
-        fd_ = -1;
     }
     return Status::OK();
 }
@@ -120,32 +231,50 @@ Status LogFile::Destroy() {
     }
 }
 
+int LogFile::LogSize() const {
+    if (!Loaded()) {
+        return static_cast<int>(lazy_last_index_ - index_ + 1);
+    }
+    return static_cast<int>(log_index_.Size());
+}
+
+uint64_t LogFile::LastIndex() const {
+    return Loaded() ? log_index_.Last() : lazy_last_index_;
+}
+
 Status LogFile::Get(uint64_t index, EntryPtr* e) const {
+    auto s = ensureIndexes();
+    if (!s.ok()) return s;
+
     // TODO: check index
     uint32_t offset = log_index_.Offset(index);
     assert(offset < file_size_);
     Record rec;
-    std::vector<char> payload;
-    auto s = readRecord(offset, &rec, &payload);
+    const char* payload = nullptr;
+    std::vector<char> buf;
+    s = viewRecord(offset, &rec, &payload, &buf);
     if (!s.ok()) return s;
     if (rec.type != RecordType::kLogEntry) {
         return Status(Status::kCorruption, "read log entry", "invalid record type");
     }
 
     EntryPtr entry(new impl::pb::Entry);
-    // TODO: check crc
-    if (!entry->ParseFromArray(payload.data(), static_cast<int>(payload.size()))) {
+    if (!entry->ParseFromArray(payload, static_cast<int>(rec.size))) {
         return Status(Status::kCorruption, "read log entry", "deserizial failed");
     }
     if (entry->index() != index) {
         return Status(Status::kCorruption, "inconsisent entry index",
                       std::to_string(entry->index()));
     }
+    entry->ByteSizeLong();  // 返回前缓存编码大小，之后只读共享
     *e = entry;
     return Status::OK();
 }
 
 Status LogFile::Term(uint64_t index, uint64_t* term) const {
+    auto s = ensureIndexes();
+    if (!s.ok()) return s;
+
     // TODO: check index
     *term = log_index_.Term(index);
     return Status::OK();
@@ -173,7 +302,8 @@ Status LogFile::Append(const EntryPtr& e) {
         }
     }
     uint32_t offset = static_cast<uint32_t>(file_size_);
-    auto s = writeRecord(RecordType::kLogEntry, *e);
+    auto s = writeRecord(RecordType::kLogEntry, *e,
+                         static_cast<uint32_t>(e->GetCachedSize()));
     if (!s.ok()) {
         return s;
     } else {
@@ -187,13 +317,34 @@ Status LogFile::Flush() {
     if (readonly_) {
         return Status(Status::kNotSupported, "flush", "read-only");
     }
-    assert(writer_ != nullptr);
-    int ret = ::fflush(writer_);
-    if (ret == 0) {
+    if (write_buf_.empty()) {
         return Status::OK();
-    } else {
-        return Status(Status::kIOError, "fflush", strErrno(errno));
     }
+
+    off_t offset = file_size_ - static_cast<off_t>(write_buf_.size());
+    if (!Legacy()) {
+        // 在有效数据后面写一个空的记录头作为结束标记，恢复时遇到即停止，
+        // 避免把截断前或者复用文件中残留的记录当作有效数据，下次写入时会被覆盖
+        write_buf_.resize(write_buf_.size() + sizeof(Record), '\0');
+    }
+    auto s = reserve(offset + static_cast<off_t>(write_buf_.size()));
+    if (s.ok()) {
+        s = writeAt(write_buf_.data(), write_buf_.size(), offset);
+    }
+    if (!s.ok()) {
+        if (!Legacy()) {
+            write_buf_.resize(write_buf_.size() - sizeof(Record));
+        }
+        return s;
+    }
+
+    write_buf_.clear();
+    if (write_buf_.capacity() > kMaxRetainedBufSize) {
+        std::vector<char> buf;
+        buf.reserve(kLogWriteBufSize);
+        write_buf_.swap(buf);
+    }
+    return Status::OK();
 }
 
 Status LogFile::Rotate() {
@@ -202,10 +353,14 @@ Status LogFile::Rotate() {
     }
 
     uint32_t offset = static_cast<uint32_t >(file_size_);
-    std::vector<char> buf;
     pb::LogIndex pb_index;
     log_index_.Serialize(&pb_index);
-    auto s = writeRecord(RecordType::kIndex, pb_index);
+    auto s = writeRecord(RecordType::kIndex, pb_index,
+                         static_cast<uint32_t>(pb_index.ByteSizeLong()));
+    if (!s.ok()) {
+        return s;
+    }
+    s = Flush();
     if (!s.ok()) {
         return s;
     }
@@ -213,10 +368,95 @@ Status LogFile::Rotate() {
     if (!s.ok()) {
         return s;
     }
-    return Sync();
+    s = Sync();
+    if (!s.ok()) {
+        return s;
+    }
+    sealed_ = true;
+    return Status::OK();
+}
+
+Status LogFile::initHeader() {
+    Header header;
+    memcpy(header.magic, kLogFileMagic, sizeof(header.magic));
+    header.version = kLogCurrentVersion;
+    header.seq = seq_;
+    header.index = index_;
+    header.epoch = epoch_;
+    header.base_epoch = base_epoch_;
+    header.Encode();
+
+    version_ = kLogCurrentVersion;
+    sealed_ = false;
+    log_index_.Clear();
+    write_buf_.assign(reinterpret_cast<const char*>(&header),
+                      reinterpret_cast<const char*>(&header) + sizeof(header));
+    file_size_ = sizeof(header);
+    return Status::OK();
+}
+
+Status LogFile::readHeader() {
+    Header header;
+    if (file_size_ >= static_cast<off_t>(sizeof(header))) {
+        auto ret = ::pread(fd_, &header, sizeof(header), 0);
+        if (ret == -1) {
+            return Status(Status::kIOError, "read log header", strErrno(errno));
+        } else if (ret < static_cast<ssize_t>(sizeof(header))) {
+            return Status(Status::kCorruption, "insufficient log file size",
+                          std::to_string(ret));
+        }
+    }
+    // 旧版本的文件没有文件头，开头是记录类型
+    if (strncmp(header.magic, kLogFileMagic, strlen(kLogFileMagic)) != 0) {
+        version_ = kLogLegacyVersion;
+        epoch_ = 0;
+        base_epoch_ = 0;
+        return Status::OK();
+    }
+
+    header.Decode();
+    auto s = header.Validate();
+    if (!s.ok()) {
+        return s;
+    }
+    if (header.seq != seq_ || header.index != index_) {
+        return Status(Status::kCorruption, "inconsistent log header",
+                      std::to_string(header.seq) + "-" + std::to_string(header.index));
+    }
+    version_ = header.version;
+    epoch_ = header.epoch;
+    base_epoch_ = header.base_epoch;
+    return Status::OK();
+}
+
+Status LogFile::ensureIndexes() const {
+    if (Loaded()) {
+        return Status::OK();
+    }
+
+    std::lock_guard<std::mutex> lock(index_mu_);
+    if (Loaded()) {
+        return Status::OK();
+    }
+    auto s = loadIndexes();
+    if (!s.ok()) {
+        log_index_.Clear();
+        return Status(Status::kCorruption, std::string("load log index ") + file_path_,
+                      s.ToString());
+    }
+    if (log_index_.Last() != lazy_last_index_) {
+        s = Status(Status::kCorruption,
+                   std::string("inconsistent log last index ") + file_path_,
+                   std::to_string(log_index_.Last()) + " != " +
+                       std::to_string(lazy_last_index_));
+        log_index_.Clear();
+        return s;
+    }
+    index_loaded_.store(true, std::memory_order_release);
+    return Status::OK();
 }
 
-Status LogFile::loadIndexes() {
+Status LogFile::loadIndexes() const {
     // 读取索引offset
     uint32_t index_offset;
     auto s = readFooter(&index_offset);
@@ -224,14 +464,15 @@ Status LogFile::loadIndexes() {
 
     // 读索引数据
     Record rec;
-    std::vector<char> payload;
-    s = readRecord(index_offset, &rec, &payload);
+    const char* payload = nullptr;
+    std::vector<char> buf;
+    s = viewRecord(index_offset, &rec, &payload, &buf);
     if (!s.ok()) {
         return Status(Status::kCorruption, "read log index",
                       std::to_string(index_offset));
     }
     // 解析索引数据
-    s = log_index_.ParseFrom(rec, payload);
+    s = log_index_.ParseFrom(rec, payload, rec.size);
     if (!s.ok()) {
         return s;
     }
@@ -241,7 +482,6 @@ Status LogFile::loadIndexes() {
             Status::kCorruption, "inconsistent log first index",
             std::to_string(log_index_.First()) + " != " + std::to_string(index_));
     }
-
     return Status::OK();
 };
 
@@ -253,6 +493,15 @@ Status LogFile::traverse(uint32_t& offset) {
         s = readRecord(offset, &rec, &payload);
         if (s.code() == Status::kEndofFile) {
             return Status::OK();
+        } else if (!s.ok() && !Legacy() && s.code() == Status::kCorruption &&
+                   atLogEnd(offset, rec, payload)) {
+            return Status::OK();
+        } else if (!s.ok() && !Legacy() && s.code() == Status::kCorruption &&
+                   tornTail(offset, rec)) {
+            LOG_WARN("[raft log] %s stop recovering at offset %u: torn record",
+                     file_path_.c_str(), offset);
+            torn_tail_ = true;
+            return Status::OK();
         } else if (!s.ok()) {
             return Status(Status::kCorruption,
                           "read record at offset " + std::to_string(offset),
@@ -277,10 +526,16 @@ Status LogFile::traverse(uint32_t& offset) {
                 log_index_.Append(e.index(), e.term(), offset);
             }
         } else if (rec.type == RecordType::kIndex) {
+            if (!Legacy()) {
+                // 已经写了索引的最后一个文件，所有日志已经遍历到了，
+                // 从索引的位置开始继续写，下次Rotate时重新写入索引和footer
+                return Status::OK();
+            }
             log_index_.Clear();
             auto s = loadIndexes();
             if (s.ok()) {
                 // TODO: 可以load的跟遍历的index作个对比
+                sealed_ = true;
                 return Status::OK();
             } else {
                 return Status(Status::kCorruption,
@@ -299,6 +554,49 @@ Status LogFile::traverse(uint32_t& offset) {
     return Status::OK();
 }
 
+bool LogFile::atLogEnd(uint32_t offset, const Record& rec,
+                       const std::vector<char>& payload) const {
+    // Flush时写在有效数据后面的结束标记
+    if (rec.type == 0 && rec.size == 0 && rec.crc == 0) {
+        return true;
+    }
+    // 记录头或者数据被文件末尾截断，最后一次写入没有写完
+    if (offset + sizeof(Record) > static_cast<uint64_t>(file_size_) ||
+        offset + sizeof(Record) + rec.size > static_cast<uint64_t>(file_size_)) {
+        LOG_INFO("[raft log] %s stop recovering at offset %u: truncated record",
+                 file_path_.c_str(), offset);
+        return true;
+    }
+    // 复用的文件中之前某一次使用时写入的记录，crc以当时的epoch为种子
+    if ((rec.type == RecordType::kLogEntry || rec.type == RecordType::kIndex) &&
+        payload.size() == rec.size) {
+        uint64_t generations = base_epoch_ != 0 ? epoch_ - base_epoch_ : 1;
+        for (uint64_t i = 1; i <= generations; ++i) {
+            if (recordCRC(epoch_ - i, rec.type, payload.data(), rec.size) == rec.crc) {
+                LOG_INFO("[raft log] %s stop recovering at offset %u: record of epoch %llu",
+                         file_path_.c_str(), offset, epoch_ - i);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool LogFile::tornTail(uint32_t offset, const Record& rec) const {
+    if (rec.type != RecordType::kLogEntry && rec.type != RecordType::kIndex) {
+        return false;
+    }
+    // 记录头完整而数据没写完，后面是预分配的零或者复用前的旧记录；
+    // 后面还有当前epoch的有效记录时是中间的数据损坏
+    uint64_t next = offset + sizeof(Record) + rec.size;
+    if (next + sizeof(Record) > static_cast<uint64_t>(file_size_)) {
+        return true;
+    }
+    Record next_rec;
+    std::vector<char> next_payload;
+    return !readRecord(static_cast<off_t>(next), &next_rec, &next_payload).ok();
+}
+
 Status LogFile::backup() {
     std::string bak_path = file_path_ + ".bak." + std::to_string(time(NULL));
     try {
@@ -315,7 +613,7 @@ Status LogFile::backup() {
 }
 
 Status LogFile::recover(bool allow_corrupt) {
-    uint32_t offset = 0;
+    uint32_t offset = Legacy() ? 0 : sizeof(Header);
     auto s = traverse(offset);
     if (!s.ok()) {
         if (!allow_corrupt) {
@@ -325,40 +623,72 @@ Status LogFile::recover(bool allow_corrupt) {
             if (!s.ok()) {
                 return s;
             }
-            int ret = ::ftruncate(fd_, offset);
-            if (-1 == ret) {
-                return Status(Status::kIOError, "truncate log file", strErrno(errno));
+            s = cutAt(offset);
+            if (!s.ok()) {
+                return s;
             }
-            file_size_ = offset;
             LOG_WARN("[raft log] truncate(offset: %d) and backup corrupt log: %s", offset,
-                     file_path_.c_str(), offset);
+                     file_path_.c_str());
+        }
+    } else if (torn_tail_ && !readonly_) {
+        // 在不完整的记录处写入结束标记，后续从这里开始写
+        torn_tail_ = false;
+        return cutAt(offset);
+    } else if (!Legacy()) {
+        // 有效数据的末尾，后续从这里开始写
+        file_size_ = offset;
+    }
+    return Status::OK();
+}
+
+Status LogFile::cutAt(uint32_t offset) {
+    if (Legacy()) {
+        int ret = ::ftruncate(fd_, offset);
+        if (-1 == ret) {
+            return Status(Status::kIOError, "truncate log file", strErrno(errno));
+        }
+        alloc_size_ = offset;
+    } else if (offset + sizeof(Record) <= static_cast<uint64_t>(alloc_size_)) {
+        // 保留预分配的空间，写入结束标记
+        char end[sizeof(Record)] = {'\0'};
+        auto s = writeAt(end, sizeof(end), offset);
+        if (!s.ok()) {
+            return s;
         }
     }
+    file_size_ = offset;
     return Status::OK();
 }
 
 Status LogFile::readFooter(uint32_t* index_offset) const {
-    if (file_size_ < static_cast<int64_t>(sizeof(Footer))) {
+    // footer总是位于文件的最末尾
+    if (alloc_size_ < static_cast<int64_t>(sizeof(Footer))) {
         return Status(Status::kCorruption, "insufficient log file size",
-                      std::to_string(file_size_));
+                      std::to_string(alloc_size_));
     }
 
     // 读取footer
     Footer footer;
     memset(&footer, 0, sizeof(footer));
-    auto ret = ::pread(fd_, &footer, sizeof(footer), file_size_ - sizeof(footer));
+    auto ret = ::pread(fd_, &footer, sizeof(footer), alloc_size_ - sizeof(footer));
     if (ret == -1) {
         return Status(Status::kIOError, "read log footer", strErrno(errno));
     } else if (ret < static_cast<ssize_t>(sizeof(footer))) {
         return Status(Status::kCorruption, "insufficient log file size",
-                      std::to_string(file_size_));
+                      std::to_string(alloc_size_));
     }
     footer.Decode();
     auto s = footer.Validate();
     if (!s.ok()) return s;
 
+    // 复用的文件末尾可能残留上一次的footer
+    if (!Legacy() && footer.epoch != epoch_) {
+        return Status(Status::kCorruption, "log footer epoch mismatch",
+                      std::to_string(footer.epoch));
+    }
+
     // 检查index offset是否有效
-    if (footer.index_offset >= file_size_ - sizeof(footer)) {
+    if (footer.index_offset >= alloc_size_ - sizeof(footer)) {
         return Status(Status::kCorruption, "invalid footer index offset",
                       std::to_string(footer.index_offset));
     }
@@ -368,17 +698,23 @@ Status LogFile::readFooter(uint32_t* index_offset) const {
 }
 
 Status LogFile::writeFooter(uint32_t index_offset) {
+    assert(write_buf_.empty());
+
     Footer footer;
     strncpy(footer.magic, kLogFileMagic, strlen(kLogFileMagic));
+    footer.version = version_;
     footer.index_offset = index_offset;
+    footer.epoch = epoch_;
     footer.Encode();
 
-    auto ret = ::fwrite(&footer, sizeof(footer), 1, writer_);
-    if (ret != 1) {
-        return Status(Status::kIOError, "write footer", strErrno(errno));
+    // 写在文件的最末尾，预分配的空间足够时不改变文件大小
+    off_t offset = std::max(file_size_, alloc_size_ - static_cast<off_t>(sizeof(footer)));
+    auto s = writeAt(reinterpret_cast<const char*>(&footer), sizeof(footer), offset);
+    if (!s.ok()) {
+        return Status(Status::kIOError, "write footer", s.ToString());
     }
 
-    file_size_ += sizeof(footer);
+    file_size_ = offset + sizeof(footer);
 
     return Status::OK();
 }
@@ -397,10 +733,9 @@ Status LogFile::readRecord(off_t offset, Record* rec, std::vector<char>* payload
     }
     rec->Decode();
 
-    // 检查payload的大小有没超过文件末尾
-    if (offset + sizeof(Record) + rec->size > static_cast<uint64_t>(file_size_)) {
-        return Status(Status::kCorruption, "log size too large",
-                      std::to_string(rec->size));
+    auto s = checkRecordHeader(offset, *rec, file_size_);
+    if (!s.ok()) {
+        return s;
     }
 
     // 读payload数据
@@ -413,29 +748,130 @@ Status LogFile::readRecord(off_t offset, Record* rec, std::vector<char>* payload
                       std::to_string(ret));
     }
 
+    return checkRecordCRC(offset, *rec, payload->data());
+}
+
+Status LogFile::viewRecord(off_t offset, Record* rec, const char** payload,
+                           std::vector<char>* buf) const {
+    const char* base = mapping();
+    if (base == nullptr) {
+        auto s = readRecord(offset, rec, buf);
+        *payload = buf->data();
+        return s;
+    }
+
+    if (offset + sizeof(Record) > map_size_) {
+        return Status(Status::kCorruption, "insufficient log record size",
+                      std::to_string(map_size_ - offset));
+    }
+    memcpy(rec, base + offset, sizeof(Record));
+    rec->Decode();
+    auto s = checkRecordHeader(offset, *rec, static_cast<off_t>(map_size_));
+    if (!s.ok()) {
+        return s;
+    }
+    *payload = base + offset + sizeof(Record);
+    return checkRecordCRC(offset, *rec, *payload);
+}
+
+Status LogFile::checkRecordHeader(off_t offset, const Record& rec, off_t limit) const {
+    if (!Legacy() && rec.type != RecordType::kLogEntry && rec.type != RecordType::kIndex) {
+        return Status(Status::kCorruption, "invalid record type", std::to_string(rec.type));
+    }
+    // 检查payload的大小有没超过文件末尾
+    if (offset + sizeof(Record) + rec.size > static_cast<uint64_t>(limit)) {
+        return Status(Status::kCorruption, "log size too large", std::to_string(rec.size));
+    }
     return Status::OK();
 }
 
-Status LogFile::writeRecord(RecordType type, const ::google::protobuf::Message& msg) {
-    uint32_t size = static_cast<uint32_t>(msg.ByteSizeLong());
-    std::vector<char> buf;
-    buf.resize(size + sizeof(Record));
-    Record* rec = (Record*)(buf.data());
-    rec->type = type;
-    rec->crc = 0;
-    rec->size = size;
-    rec->Encode();
-    if (!msg.SerializeToArray(rec->payload, size)) {
-        return Status(Status::kCorruption, "serialize log record", "pb return false");
+Status LogFile::checkRecordCRC(off_t offset, const Record& rec, const char* payload) const {
+    if (!Legacy() && recordCRC(epoch_, rec.type, payload, rec.size) != rec.crc) {
+        return Status(Status::kCorruption, "log record crc mismatch", std::to_string(offset));
     }
+    return Status::OK();
+}
 
-    auto ret = ::fwrite(buf.data(), buf.size(), 1, writer_);
-    if (ret != 1) {
-        return Status(Status::kIOError, "write record", strErrno(errno));
+void LogFile::SetMmapBudget(size_t bytes) { g_mmap_budget = bytes; }
+
+size_t LogFile::MmapBytes() { return g_mmap_bytes.load(); }
+
+const char* LogFile::mapping() const {
+    auto state = map_state_.load(std::memory_order_acquire);
+    if (state == kMapped) {
+        return map_addr_;
+    } else if (state == kMapFailed || !sealed_ || file_size_ == 0) {
+        return nullptr;
     }
 
-    file_size_ += buf.size();
+    std::lock_guard<std::mutex> lock(map_mu_);
+    state = map_state_.load(std::memory_order_relaxed);
+    if (state != kUnmapped) {
+        return state == kMapped ? map_addr_ : nullptr;
+    }
 
+    // 映射的大小计入预算，超出时本次用pread读取，之后有空余预算再映射
+    size_t size = static_cast<size_t>(file_size_);
+    auto used = g_mmap_bytes.load();
+    do {
+        if (used + size > g_mmap_budget.load()) {
+            return nullptr;
+        }
+    } while (!g_mmap_bytes.compare_exchange_weak(used, used + size));
+
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED) {
+        g_mmap_bytes -= size;
+        LOG_WARN("[raft log] mmap %s failed: %s", file_path_.c_str(), strErrno(errno).c_str());
+        map_state_.store(kMapFailed, std::memory_order_release);
+        return nullptr;
+    }
+    map_addr_ = static_cast<const char*>(addr);
+    map_size_ = size;
+    map_state_.store(kMapped, std::memory_order_release);
+    return map_addr_;
+}
+
+void LogFile::unmap() {
+    std::lock_guard<std::mutex> lock(map_mu_);
+    if (map_state_.load(std::memory_order_relaxed) == kMapped) {
+        ::munmap(const_cast<char*>(map_addr_), map_size_);
+        g_mmap_bytes -= map_size_;
+        map_addr_ = nullptr;
+        map_size_ = 0;
+    }
+    map_state_.store(kUnmapped, std::memory_order_release);
+}
+
+void LogFile::AdviseSequential() const {
+    if (mapping() != nullptr) {
+        ::madvise(const_cast<char*>(map_addr_), map_size_, MADV_SEQUENTIAL);
+    }
+}
+
+void LogFile::ReleaseMapped() const {
+    if (Mapped()) {
+        ::madvise(const_cast<char*>(map_addr_), map_size_, MADV_DONTNEED);
+    }
+}
+
+Status LogFile::writeRecord(RecordType type, const ::google::protobuf::Message& msg,
+                            uint32_t size) {
+    size_t total = size + sizeof(Record);
+    size_t pos = write_buf_.size();
+    write_buf_.resize(pos + total);
+    Record* rec = (Record*)(write_buf_.data() + pos);
+    msg.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t*>(rec->payload));
+    rec->type = type;
+    rec->size = size;
+    rec->crc = recordCRC(epoch_, type, rec->payload, size);
+    rec->Encode();
+
+    file_size_ += total;
+
+    if (write_buf_.size() >= kLogWriteBufSize) {
+        return Flush();
+    }
     return Status::OK();
 }
 
@@ -444,36 +880,93 @@ Status LogFile::Truncate(uint64_t index) {
         return Status(Status::kNotSupported, "truncate", "read only");
     }
 
+    auto s = ensureIndexes();
+    if (!s.ok()) {
+        return s;
+    }
     if (log_index_.Empty() || log_index_.Last() < index) {
         return Status::OK();
     }
 
+    // 截断后文件会被继续追加，不再是封存状态
+    unmap();
+    sealed_ = false;
+
+    s = Flush();
+    if (!s.ok()) {
+        return s;
+    }
+
     uint32_t offset = log_index_.Offset(index);
     assert(offset < file_size_);
-    int ret = ::ftruncate(fd_, offset);
-    if (ret == -1) {
-        return Status(Status::kIOError, "truncate log", strErrno(errno));
-    } else {
-        log_index_.Truncate(index);
-        file_size_ = offset;
+    s = cutAt(offset);
+    if (!s.ok()) {
+        return Status(Status::kIOError, "truncate log", s.ToString());
+    }
+    log_index_.Truncate(index);
+    return Status::OK();
+}
+
+Status LogFile::reserve(off_t end) {
+    if (preallocate_size_ == 0 || end <= alloc_size_) {
         return Status::OK();
     }
+#ifdef __linux__
+    off_t new_size = alloc_size_;
+    while (new_size < end) {
+        new_size += preallocate_size_;
+    }
+    // 一次扩展一段，避免每次写入都改变文件大小
+    if (::fallocate(fd_, 0, alloc_size_, new_size - alloc_size_) != 0) {
+        if (errno == EOPNOTSUPP) {
+            LOG_WARN("[raft log] %s: fallocate not supported, disable preallocate",
+                     file_path_.c_str());
+            preallocate_size_ = 0;
+            return Status::OK();
+        }
+        return Status(Status::kIOError, "fallocate", strErrno(errno));
+    }
+    alloc_size_ = new_size;
+#else
+    preallocate_size_ = 0;
+#endif
+    return Status::OK();
+}
+
+Status LogFile::writeAt(const char* data, size_t len, off_t offset) {
+    size_t written = 0;
+    while (written < len) {
+        auto ret = ::pwrite(fd_, data + written, len - written, offset + written);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            return Status(Status::kIOError, "write log file", strErrno(errno));
+        }
+        written += ret;
+    }
+    alloc_size_ = std::max(alloc_size_, static_cast<off_t>(offset + len));
+    return Status::OK();
 }
 
 #ifndef NDEBUG
 void LogFile::TEST_Append_RandomData() {
+    auto s = Flush();
+    assert(s.ok());
     std::string data = randomString(10);
-    auto ret = ::write(fd_, data.data(), data.length());
-    assert(ret == static_cast<ssize_t>(data.length()));
+    s = writeAt(data.data(), data.size(), file_size_);
+    assert(s.ok());
     file_size_ += data.size();
 }
 
 void LogFile::TEST_Truncate_RandomLen() {
-    if (file_size_ > 0) {
-        int offset = randomInt() % file_size_;
+    auto s = Flush();
+    assert(s.ok());
+    off_t start = Legacy() ? 0 : sizeof(Header);
+    if (file_size_ > start) {
+        off_t offset = start + randomInt() % (file_size_ - start);
         int ret = ::ftruncate(fd_, offset);
         assert(ret == 0);
         file_size_ = offset;
+        alloc_size_ = offset;
     }
 }
 
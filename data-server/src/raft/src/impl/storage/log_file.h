@@ -1,6 +1,8 @@
 _Pragma("once");
 
 #include <stdint.h>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include "base/status.h"
 
@@ -23,7 +25,11 @@ public:
     LogFile(const LogFile&) = delete;
     LogFile& operator=(const LogFile&) = delete;
 
-    Status Open(bool allow_corrupt, bool last_one = false);
+    // 打开已有的日志文件，文件不存在或者为空时新建
+    // 非最后一个文件且last_index已知（非0）时，延迟到第一次读取时再加载索引
+    Status Open(bool allow_corrupt, bool last_one = false, uint64_t last_index = 0);
+    // 新建日志文件，recycled_path非空时复用回收的旧文件
+    Status Create(const std::string& recycled_path = "");
     Status Sync();
     Status Close();
     Status Destroy();
@@ -32,14 +38,33 @@ public:
     uint64_t Index() const { return index_; }
     const std::string& Path() const { return file_path_; }
     uint64_t FileSize() const { return file_size_; }
-    int LogSize() const { return log_index_.Size(); }  // 日志条目个数
-    uint64_t LastIndex() const { return log_index_.Last(); }
+    // 文件空间不足时每次预分配的大小，0表示不预分配
+    void SetPreallocateSize(size_t size) { preallocate_size_ = size; }
+
+    // 旧版本格式的文件，只读不再追加
+    bool Legacy() const { return version_ < kLogCurrentVersion; }
+    // 已经写入索引和footer
+    bool Sealed() const { return sealed_; }
+    int LogSize() const;  // 日志条目个数
+    uint64_t LastIndex() const;
+    // 索引是否已经加载
+    bool Loaded() const { return index_loaded_.load(std::memory_order_acquire); }
 
     Status Get(uint64_t index, EntryPtr* e) const;
     Status Term(uint64_t index, uint64_t* term) const;
 
+    // 已封存的文件只读mmap，批量顺序读取（追赶日志）时提示内核预读，
+    // 读完后释放映射占用的物理页
+    void AdviseSequential() const;
+    void ReleaseMapped() const;
+    bool Mapped() const { return map_state_.load(std::memory_order_acquire) == kMapped; }
+
+    // 所有日志文件mmap映射的总字节数上限（进程内共享），0表示不使用mmap
+    static void SetMmapBudget(size_t bytes);
+    static size_t MmapBytes();
+
     Status Append(const EntryPtr& e);
-    Status Flush();  // 一次写入的最后一条日志写完需要Flush
+    Status Flush();  // 一次写入的最后一条日志写完需要Flush，写入缓冲中的数据
     Status Rotate();
     Status Truncate(uint64_t index);
 
@@ -53,15 +78,41 @@ private:
     static std::string makeFilePath(const std::string& path, uint64_t seq,
                                     uint64_t index);
 
-    Status loadIndexes();
+    static uint64_t newEpoch();
+
+    Status initHeader();
+    Status readHeader();
+    Status loadIndexes() const;
+    // 延迟打开的文件，第一次使用时加载索引
+    Status ensureIndexes() const;
     Status traverse(uint32_t& offset);
     Status backup();
     Status recover(bool allow_corrupt);
+    Status cutAt(uint32_t offset);
+    // 读取失败的记录是否为有效日志的末尾：结束标记、被文件末尾截断或者复用前残留的旧记录
+    bool atLogEnd(uint32_t offset, const Record& rec, const std::vector<char>& payload) const;
+    // crc错误的记录后面没有有效的记录，是写入时崩溃留下的不完整记录
+    bool tornTail(uint32_t offset, const Record& rec) const;
 
     Status readFooter(uint32_t* index_ofset) const;
     Status writeFooter(uint32_t index_offset);
     Status readRecord(off_t offset, Record* rec, std::vector<char>* payload) const;
-    Status writeRecord(RecordType type, const ::google::protobuf::Message& msg);
+    // 已映射时payload直接指向映射的内存，否则读到buf中
+    Status viewRecord(off_t offset, Record* rec, const char** payload,
+                      std::vector<char>* buf) const;
+    Status checkRecordHeader(off_t offset, const Record& rec, off_t limit) const;
+    Status checkRecordCRC(off_t offset, const Record& rec, const char* payload) const;
+    // size为msg已缓存的编码大小
+    Status writeRecord(RecordType type, const ::google::protobuf::Message& msg,
+                       uint32_t size);
+
+    // 确保文件空间足够写入到end，不够时预分配
+    Status reserve(off_t end);
+    Status writeAt(const char* data, size_t len, off_t offset);
+
+    // 返回封存文件的只读映射，未封存、超出预算或者映射失败时返回nullptr
+    const char* mapping() const;
+    void unmap();
 
 private:
     const uint64_t seq_ = 0;    // 日志文件的序号
@@ -70,11 +121,31 @@ private:
     const bool readonly_ = false;
 
     int fd_ = -1;
+    uint16_t version_ = kLogCurrentVersion;
+    uint64_t epoch_ = 0;
+    uint64_t base_epoch_ = 0;
+    bool sealed_ = false;
+    // 恢复时遇到了不完整的最后一条记录，需要截断
+    bool torn_tail_ = false;
+    // 有效数据的末尾，包括还在写缓冲中未写入文件的
     off_t file_size_ = 0;
-    FILE* writer_ = nullptr;
+    // 文件的实际大小，包括预分配的部分
+    off_t alloc_size_ = 0;
+    size_t preallocate_size_ = 0;
+    // 写缓冲，对应文件中[file_size_ - write_buf_.size(), file_size_)
     std::vector<char> write_buf_;
 
-    LogIndex log_index_;
+    // 延迟加载索引的文件，加载前由调用方给出最后一条日志的index
+    uint64_t lazy_last_index_ = 0;
+    mutable std::atomic<bool> index_loaded_ = {true};
+    mutable std::mutex index_mu_;
+    mutable LogIndex log_index_;
+
+    enum MapState { kUnmapped = 0, kMapped, kMapFailed };
+    mutable std::atomic<int> map_state_ = {kUnmapped};
+    mutable std::mutex map_mu_;
+    mutable const char* map_addr_ = nullptr;
+    mutable size_t map_size_ = 0;
 };
 
 } /* namespace storage */
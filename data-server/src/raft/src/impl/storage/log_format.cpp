@@ -6,6 +6,7 @@
 #include <sstream>
 #include <regex>
 
+#include <fastcommon/hash.h>
 #include "base/byte_order.h"
 
 namespace sharkstore {
@@ -60,14 +61,25 @@ bool parseLogFileName(const std::string &name, uint64_t &seq,
     return true;
 }
 
-void Footer::Encode() {
-    version = htobe16(version);
-    index_offset = htobe32(index_offset);
+std::string makeFreeLogFileName(uint64_t id) {
+    std::stringstream s;
+    s << std::hex << std::setfill('0') << std::setw(16) << id;
+    s << ".free";
+    return s.str();
 }
 
-void Footer::Decode() {
-    version = be16toh(version);
-    index_offset = be32toh(index_offset);
+bool parseFreeLogFileName(const std::string& name, uint64_t& id) {
+    if (name.size() != 16 + strlen(".free") || name.substr(16) != ".free") {
+        return false;
+    }
+    for (int i = 0; i < 16; ++i) {
+        char c = name[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+    id = std::stoull(name.substr(0, 16), 0, 16);
+    return true;
 }
 
 static std::string formatMagic(const char magic[4]) {
@@ -80,6 +92,46 @@ static std::string formatMagic(const char magic[4]) {
     return result;
 }
 
+void Header::Encode() {
+    version = htobe16(version);
+    seq = htobe64(seq);
+    index = htobe64(index);
+    epoch = htobe64(epoch);
+    base_epoch = htobe64(base_epoch);
+}
+
+void Header::Decode() {
+    version = be16toh(version);
+    seq = be64toh(seq);
+    index = be64toh(index);
+    epoch = be64toh(epoch);
+    base_epoch = be64toh(base_epoch);
+}
+
+Status Header::Validate() const {
+    if (strncmp(magic, kLogFileMagic, strlen(kLogFileMagic)) != 0) {
+        return Status(Status::kCorruption, "invalid log header",
+                      std::string("magic: ") + formatMagic(magic));
+    }
+    if (version < kLogCurrentVersion) {
+        return Status(Status::kCorruption, "invalid log header version",
+                      std::to_string(version));
+    }
+    return Status::OK();
+}
+
+void Footer::Encode() {
+    version = htobe16(version);
+    index_offset = htobe32(index_offset);
+    epoch = htobe64(epoch);
+}
+
+void Footer::Decode() {
+    version = be16toh(version);
+    index_offset = be32toh(index_offset);
+    epoch = be64toh(epoch);
+}
+
 Status Footer::Validate() const {
     if (strncmp(magic, kLogFileMagic, strlen(kLogFileMagic)) != 0) {
         return Status(Status::kCorruption, "invalid log footer",
@@ -99,7 +151,20 @@ void Record::Encode() {
 
 void Record::Decode() {
     size = be32toh(size);
-    crc = be32toh(size);
+    crc = be32toh(crc);
+}
+
+uint32_t recordCRC(uint64_t epoch, RecordType type, const char* payload, uint32_t size) {
+    char head[sizeof(epoch) + sizeof(type) + sizeof(size)];
+    uint64_t be_epoch = htobe64(epoch);
+    uint32_t be_size = htobe32(size);
+    memcpy(head, &be_epoch, sizeof(be_epoch));
+    memcpy(head + sizeof(be_epoch), &type, sizeof(type));
+    memcpy(head + sizeof(be_epoch) + sizeof(type), &be_size, sizeof(be_size));
+
+    int crc = CRC32_ex(head, sizeof(head), CRC32_XINIT);
+    crc = CRC32_ex(payload, static_cast<int>(size), crc);
+    return static_cast<uint32_t>(CRC32_FINAL(crc));
 }
 
 } /* namespace storage */
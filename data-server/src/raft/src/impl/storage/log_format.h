@@ -13,18 +13,48 @@ namespace storage {
 // 如0000000000000003-0000000000000012.log,
 // 前缀为十六进制的文件序号和起始日志offset)
 
-static const uint16_t kLogCurrentVersion = 1;
+// 版本1: 没有文件头，记录不校验crc
+// 版本2: 文件开头有固定64字节的Header，记录的crc以文件的epoch作为种子，
+//        文件被回收复用后epoch加1，残留的旧数据以当前epoch校验不通过、
+//        以[base_epoch, epoch)中的某个epoch校验通过，恢复时视为日志末尾
+static const uint16_t kLogLegacyVersion = 1;
+static const uint16_t kLogCurrentVersion = 2;
 static const char* kLogFileMagic = "\x99\xA3\xB8\xDE";
 
 std::string makeLogFileName(uint64_t seq, uint64_t index);
 bool parseLogFileName(const std::string& name, uint64_t& seq, uint64_t& index);
 
+// 回收待复用的日志文件名，如0000000000000003.free
+std::string makeFreeLogFileName(uint64_t id);
+bool parseFreeLogFileName(const std::string& name, uint64_t& id);
+
+// 版本2的文件头，固定64字节
+struct Header {
+    char magic[4] = {'\0'};
+    uint16_t version = kLogCurrentVersion;
+    uint64_t seq = 0;
+    uint64_t index = 0;
+    uint64_t epoch = 0;
+    // 文件第一次创建时的epoch，之后每次复用加1，为0表示未记录
+    uint64_t base_epoch = 0;
+    char reserved[26] = {'\0'};
+
+    // convert to big-endian when write to file
+    void Encode();
+    // conver to host-endian when read from file
+    void Decode();
+
+    Status Validate() const;
+
+} __attribute__((packed));
+
 // 固定64字节
 struct Footer {
     char magic[4] = {'\0'};
     uint16_t version = kLogCurrentVersion;
     uint32_t index_offset = 0;
-    char reserved[54] = {'\0'};
+    uint64_t epoch = 0;  // 版本2以上有效，跟文件头的epoch一致
+    char reserved[46] = {'\0'};
 
     // convert to big-endian when write to file
     void Encode();
@@ -50,6 +80,9 @@ struct Record {
 
 } __attribute__((packed));
 
+// 计算记录的crc，包括类型、大小和数据，以文件epoch作为种子
+uint32_t recordCRC(uint64_t epoch, RecordType type, const char* payload, uint32_t size);
+
 } /* namespace storage */
 } /* namespace impl */
 } /* namespace raft */
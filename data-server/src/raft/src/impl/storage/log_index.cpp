@@ -9,20 +9,30 @@ LogIndex::LogIndex() {}
 
 LogIndex::~LogIndex() {}
 
-Status LogIndex::ParseFrom(const Record& rec, const std::vector<char>& payload) {
+Status LogIndex::ParseFrom(const Record& rec, const char* payload, size_t size) {
     if (rec.type != RecordType::kIndex) {
         return Status(Status::kCorruption, "invalid log index record type",
                       std::to_string(rec.type));
     }
 
     pb::LogIndex idx;
-    if (!idx.ParseFromArray(payload.data(), payload.size())) {
+    if (!idx.ParseFromArray(payload, static_cast<int>(size))) {
         return Status(Status::kCorruption, "parse log index", "pb::ParseFromArray");
     }
 
-    items_.clear();
+    Clear();
+    items_.reserve(idx.items_size());
     for (int i = 0; i < idx.items_size(); ++i) {
-        items_.emplace(idx.items(i).index(), idx.items(i));
+        const auto& item = idx.items(i);
+        if (i == 0) {
+            first_ = item.index();
+        } else if (item.index() != first_ + i) {
+            Clear();
+            return Status(Status::kCorruption, "discontinuous log index",
+                          std::to_string(item.index()) + " != " +
+                              std::to_string(first_ + i));
+        }
+        items_.push_back(Item{item.term(), item.offset()});
     }
 
     return Status::OK();
@@ -30,14 +40,17 @@ Status LogIndex::ParseFrom(const Record& rec, const std::vector<char>& payload)
 
 void LogIndex::Serialize(pb::LogIndex* pb_msg) {
     pb_msg->clear_items();
-    for (const auto& pair : items_) {
-        pb_msg->add_items()->CopyFrom(pair.second);
+    for (size_t i = 0; i < items_.size(); ++i) {
+        auto item = pb_msg->add_items();
+        item->set_index(first_ + i);
+        item->set_term(items_[i].term);
+        item->set_offset(items_[i].offset);
     }
 }
 
 uint64_t LogIndex::First() const {
     if (!items_.empty()) {
-        return items_.cbegin()->first;
+        return first_;
     } else {
         return 0;
     }
@@ -45,25 +58,23 @@ uint64_t LogIndex::First() const {
 
 uint64_t LogIndex::Last() const {
     if (!items_.empty()) {
-        return items_.crbegin()->first;
+        return first_ + items_.size() - 1;
     } else {
         return 0;
     }
 }
 
 uint64_t LogIndex::Term(uint64_t index) const {
-    auto it = items_.find(index);
-    if (it != items_.cend()) {
-        return it->second.term();
+    if (index >= first_ && index - first_ < items_.size()) {
+        return items_[index - first_].term;
     } else {
         return 0;
     }
 }
 
 uint32_t LogIndex::Offset(uint64_t index) const {
-    auto it = items_.find(index);
-    if (it != items_.cend()) {
-        return it->second.offset();
+    if (index >= first_ && index - first_ < items_.size()) {
+        return items_[index - first_].offset;
     } else {
         return 0;
     }
@@ -71,23 +82,24 @@ uint32_t LogIndex::Offset(uint64_t index) const {
 
 void LogIndex::Append(uint64_t index, uint64_t term, uint32_t offset) {
     assert(items_.empty() || Last() + 1 == index);
-    pb::IndexItem item;
-    item.set_index(index);
-    item.set_term(term);
-    item.set_offset(offset);
-    items_.emplace(index, item);
+    if (items_.empty()) {
+        first_ = index;
+    }
+    items_.push_back(Item{term, offset});
 }
 
 void LogIndex::Truncate(uint64_t index) {
-    auto it = items_.find(index);
-    if (it != items_.end()) {
-        items_.erase(it, items_.end());
+    if (index >= first_ && index - first_ < items_.size()) {
+        items_.resize(index - first_);
     }
 }
 
-void LogIndex::Clear() { items_.clear(); }
+void LogIndex::Clear() {
+    first_ = 0;
+    items_.clear();
+}
 
 } /* namespace storage */
 } /* namespace impl */
 } /* namespace raft */
-} /* namespace sharkstore */
\ No newline at end of file
+} /* namespace sharkstore */
@@ -1,7 +1,7 @@
 _Pragma("once");
 
 #include <stdint.h>
-#include <map>
+#include <vector>
 #include "base/status.h"
 
 #include "../raft.pb.h"
@@ -21,7 +21,7 @@ public:
     LogIndex& operator=(const LogIndex&) = delete;
 
     // 从Record中还原
-    Status ParseFrom(const Record& rec, const std::vector<char>& payload);
+    Status ParseFrom(const Record& rec, const char* payload, size_t size);
     void Serialize(pb::LogIndex* pb_msg);
 
     size_t Size() const { return items_.size(); }
@@ -37,7 +37,14 @@ public:
     void Clear();
 
 private:
-    std::map<uint64_t, pb::IndexItem> items_;
+    struct Item {
+        uint64_t term;
+        uint32_t offset;
+    };
+
+    // 日志index是连续的，按下标存放，第i项对应first_ + i
+    uint64_t first_ = 0;
+    std::vector<Item> items_;
 };
 
 } /* namespace storage */
@@ -11,6 +11,7 @@
 #include "../logger.h"
 #include "base/util.h"
 #include "log_file.h"
+#include "log_format.h"
 
 namespace sharkstore {
 namespace raft {
@@ -131,6 +132,7 @@ Status DiskStorage::checkLogsValidate(const std::map<uint64_t, uint64_t>& logs)
 
 Status DiskStorage::listLogs(std::map<uint64_t, uint64_t>* logs) {
     logs->clear();
+    free_files_.clear();
 
     DIR* dir = ::opendir(path_.c_str());
     if (NULL == dir) {
@@ -153,6 +155,11 @@ Status DiskStorage::listLogs(std::map<uint64_t, uint64_t>* logs) {
         if (ent->d_type == DT_REG || ent->d_type == DT_UNKNOWN) {
             uint64_t seq = 0;
             uint64_t offset = 0;
+            if (parseFreeLogFileName(ent->d_name, seq)) {
+                free_files_.push_back(JoinFilePath({path_, ent->d_name}));
+                next_free_id_ = std::max(next_free_id_, seq + 1);
+                continue;
+            }
             if (!parseLogFileName(ent->d_name, seq, offset)) {
                 continue;
             }
@@ -179,8 +186,8 @@ Status DiskStorage::openLogs() {
         if (ops_.readonly) {
             return Status(Status::kCorruption, "open logs", "no log file");
         }
-        auto f = new LogFile(path_, 1, trunc_meta_.index() + 1);
-        s = f->Open(ops_.allow_corrupt_startup);
+        LogFile* f = nullptr;
+        s = createLogFile(1, trunc_meta_.index() + 1, &f);
         if (!s.ok()) {
             return s;
         }
@@ -189,7 +196,14 @@ Status DiskStorage::openLogs() {
         size_t count = 0;
         for (auto it = logs.begin(); it != logs.end(); ++it) {
             auto f = new LogFile(path_, it->first, it->second, ops_.readonly);
-            s = f->Open(ops_.allow_corrupt_startup, count == logs.size() - 1);
+            f->SetPreallocateSize(std::min(ops_.preallocate_size, ops_.log_file_size));
+            bool last_one = (count == logs.size() - 1);
+            uint64_t last_index = 0;
+            if (!last_one && ops_.lazy_load_index) {
+                // 文件是连续的，最后一条日志就是下一个文件起始index的前一条
+                last_index = std::next(it)->second - 1;
+            }
+            s = f->Open(ops_.allow_corrupt_startup, last_one, last_index);
             if (!s.ok()) {
                 return s;
             } else {
@@ -203,6 +217,62 @@ Status DiskStorage::openLogs() {
     auto last = log_files_.back();
     last_index_ = (last->LogSize() == 0) ? (last->Index() - 1) : last->LastIndex();
 
+    // 旧版本格式或者已经写了索引的文件不再追加，新建一个文件继续写
+    if (!ops_.readonly && (last->Legacy() || last->Sealed())) {
+        uint64_t seq = last->Seq() + 1;
+        if (last->LogSize() == 0) {
+            seq = last->Seq();
+            s = last->Destroy();
+            delete last;
+            log_files_.pop_back();
+        } else if (!last->Sealed()) {
+            s = last->Rotate();
+        }
+        if (!s.ok()) {
+            return s;
+        }
+        LogFile* f = nullptr;
+        s = createLogFile(seq, last_index_ + 1, &f);
+        if (!s.ok()) {
+            return s;
+        }
+        log_files_.push_back(f);
+    }
+
+    return Status::OK();
+}
+
+Status DiskStorage::createLogFile(uint64_t seq, uint64_t index, LogFile** file) {
+    std::string recycled;
+    if (!free_files_.empty()) {
+        recycled = free_files_.back();
+        free_files_.pop_back();
+    }
+    auto f = new LogFile(path_, seq, index);
+    f->SetPreallocateSize(std::min(ops_.preallocate_size, ops_.log_file_size));
+    auto s = f->Create(recycled);
+    if (!s.ok()) {
+        delete f;
+        return s;
+    }
+    *file = f;
+    return Status::OK();
+}
+
+Status DiskStorage::removeLogFile(LogFile* f) {
+    if (f->Legacy() || free_files_.size() >= ops_.recycle_log_files) {
+        return f->Destroy();
+    }
+    // 放入回收池，之后新建日志文件时复用已经分配的磁盘空间
+    auto s = f->Close();
+    if (!s.ok()) {
+        return s;
+    }
+    std::string free_path = JoinFilePath({path_, makeFreeLogFileName(next_free_id_++)});
+    if (::rename(f->Path().c_str(), free_path.c_str()) != 0) {
+        return Status(Status::kIOError, "rename " + f->Path(), strErrno(errno));
+    }
+    free_files_.push_back(free_path);
     return Status::OK();
 }
 
@@ -243,8 +313,8 @@ Status DiskStorage::tryRotate() {
         if (!s.ok()) {
             return s;
         }
-        auto newf = new LogFile(path_, f->Seq() + 1, last_index_ + 1);
-        s = newf->Open(false);
+        LogFile* newf = nullptr;
+        s = createLogFile(f->Seq() + 1, last_index_ + 1, &newf);
         if (!s.ok()) {
             return s;
         }
@@ -389,23 +459,35 @@ Status DiskStorage::Entries(uint64_t lo, uint64_t hi, uint64_t max_size,
         return Status(Status::kNotFound, "locate file", std::to_string(lo));
     }
 
+    // 批量读取（副本追赶日志）时顺序读已封存的文件，读完一个释放一个
+    bool bulk = hi - lo > 1;
+    if (bulk) {
+        (*it)->AdviseSequential();
+    }
+
     uint64_t size = 0;
     Status s;
     for (uint64_t index = lo; index < hi; ++index) {
         auto f = *it;
         if (index > f->LastIndex()) {
+            if (bulk) {
+                f->ReleaseMapped();
+            }
             ++it; // switch next file
             if (it == log_files_.cend()) {
                 break;
             } else {
                 f = *it;
+                if (bulk) {
+                    f->AdviseSequential();
+                }
             }
         }
 
         EntryPtr e;
         s = f->Get(index, &e);
         if (!s.ok()) return s;
-        size += e->ByteSizeLong();
+        size += e->GetCachedSize();
         if (size > max_size) {
             if (entries->empty()) {  // 至少一条
                 entries->push_back(e);
@@ -422,7 +504,7 @@ Status DiskStorage::truncateOld(uint64_t index) {
     while (log_files_.size() > 1) {
         auto f = log_files_[0];
         if (f->LastIndex() <= index) {
-            auto s = f->Destroy();
+            auto s = removeLogFile(f);
             if (!s.ok()) return s;
             delete f;
             log_files_.erase(log_files_.begin());
@@ -439,7 +521,7 @@ Status DiskStorage::truncateNew(uint64_t index) {
     while (!log_files_.empty()) {
         auto last = log_files_.back();
         if (last->Index() > index) {
-            s = last->Destroy();
+            s = removeLogFile(last);
             if (!s.ok()) return s;
             delete last;
             log_files_.pop_back();
@@ -465,7 +547,7 @@ Status DiskStorage::truncateNew(uint64_t index) {
 Status DiskStorage::truncateAll() {
     Status s;
     for (auto it = log_files_.begin(); it != log_files_.end(); ++it) {
-        s = (*it)->Destroy();
+        s = removeLogFile(*it);
         if (!s.ok()) {
             return s;
         }
@@ -473,8 +555,8 @@ Status DiskStorage::truncateAll() {
     }
     log_files_.clear();
 
-    LogFile* f = new LogFile(path_, 1, trunc_meta_.index() + 1);
-    s = f->Open(false);
+    LogFile* f = nullptr;
+    s = createLogFile(1, trunc_meta_.index() + 1, &f);
     if (!s.ok()) {
         return s;
     }
@@ -20,6 +20,12 @@ public:
         // 最多保留多少个日志文件，超过此数则截断旧文件
         size_t max_log_files = std::numeric_limits<size_t>::max();
 
+        // 日志文件空间不足时每次预分配的大小，0表示不预分配
+        size_t preallocate_size = 1024 * 1024;
+
+        // 截断后保留待复用的日志文件个数，0表示不复用直接删除
+        size_t recycle_log_files = 0;
+
         // 启动时检测到文件损坏是否继续，若是则备份可以正常打开工作
         bool allow_corrupt_startup = false;
 
@@ -31,6 +37,9 @@ public:
 
         // 只读模式打开
         bool readonly = false;
+
+        // 打开时只恢复最后一个日志文件，其他文件的索引在第一次读取时加载
+        bool lazy_load_index = true;
     };
 
     DiskStorage(uint64_t id, const std::string& path, const Options& ops);
@@ -61,6 +70,7 @@ public:
     Status Destroy(bool backup = false) override;
 
     size_t FilesCount() const { return log_files_.size(); }
+    size_t FreeFilesCount() const { return free_files_.size(); }
 
 // for tests
 #ifndef NDEBUG
@@ -78,6 +88,11 @@ private:
     Status openLogs();
     Status closeLogs();
 
+    // 新建日志文件，优先复用回收的文件
+    Status createLogFile(uint64_t seq, uint64_t index, LogFile** file);
+    // 删除日志文件，回收池未满时放入回收池
+    Status removeLogFile(LogFile* f);
+
     // 截断旧日志
     Status truncateOld(uint64_t index);
     // 截断最新的日志
@@ -101,6 +116,10 @@ private:
     std::vector<LogFile*> log_files_;
     uint64_t last_index_ = 0;
 
+    // 回收待复用的日志文件
+    std::vector<std::string> free_files_;
+    uint64_t next_free_id_ = 1;
+
     std::atomic<bool> destroyed_ = {false};
 };
 
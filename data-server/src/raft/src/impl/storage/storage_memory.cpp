@@ -44,7 +44,7 @@ Status MemoryStorage::Entries(uint64_t lo, uint64_t hi, uint64_t max_size,
     for (auto it = entries_.begin() + (lo - trunc_index_ - 1); it != entries_.end();
          ++it) {
         if ((*it)->index() >= hi) break;
-        size += (*it)->ByteSizeLong();
+        size += (*it)->GetCachedSize();
         if (size > max_size) {
             if (count == 0) {  // 大小限制至少返回一个
                 ents->push_back(*it);
@@ -0,0 +1,178 @@
+#include "compression.h"
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include "../logger.h"
+
+namespace sharkstore {
+namespace raft {
+namespace impl {
+namespace transport {
+
+#ifdef USE_ZSTD
+// 解压后一帧的最大大小，防止错误的头部导致分配过大的内存
+static const size_t kMaxDecompressedSize = 256 * 1024 * 1024;
+
+// 压缩级别，raft传输优先考虑速度
+static const int kZstdLevel = 1;
+
+static uint64_t elapsedUsecs(const std::chrono::steady_clock::time_point& start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+}
+#endif
+
+void CompressStats::Fill(ServerStatus* status) const {
+    status->compress_raw_bytes = raw_bytes;
+    status->compress_out_bytes = compressed_bytes;
+    status->compress_usecs = compress_usecs;
+    status->decompress_usecs = decompress_usecs;
+}
+
+Compressor::Compressor(CompressionType type, size_t threshold, CompressStats* stats)
+    : type_(type), threshold_(threshold), stats_(stats) {
+#ifdef USE_ZSTD
+    if (type_ == CompressionType::kZstd) {
+        cctx_ = ZSTD_createCCtx();
+    }
+#endif
+}
+
+Compressor::~Compressor() {
+#ifdef USE_ZSTD
+    ZSTD_freeCCtx(cctx_);
+#endif
+}
+
+bool Compressor::ShouldCompress(size_t len) const {
+#ifdef USE_ZSTD
+    return type_ == CompressionType::kZstd && cctx_ != nullptr && len >= threshold_;
+#else
+    return false;
+#endif
+}
+
+size_t Compressor::Bound(size_t len) const {
+#ifdef USE_ZSTD
+    return ZSTD_compressBound(len);
+#else
+    return len;
+#endif
+}
+
+size_t Compressor::Compress(const char* src, size_t len, char* dst, size_t cap,
+                            char* flags) {
+#ifdef USE_ZSTD
+    auto start = std::chrono::steady_clock::now();
+    size_t ret = ZSTD_compressCCtx(cctx_, dst, cap, src, len, kZstdLevel);
+    stats_->compress_usecs += elapsedUsecs(start);
+    stats_->raw_bytes += len;
+    if (ZSTD_isError(ret)) {
+        LOG_WARN("raft[Compressor] zstd compress failed: %s", ZSTD_getErrorName(ret));
+        stats_->compressed_bytes += len;
+        return 0;
+    }
+    if (ret >= len) {
+        stats_->compressed_bytes += len;
+        return 0;
+    }
+    stats_->compressed_bytes += ret;
+    *flags |= kFrameFlagZstd;
+    return ret;
+#else
+    return 0;
+#endif
+}
+
+static uint32_t compressionBit(CompressionType type) {
+    return 1u << static_cast<uint32_t>(type);
+}
+
+uint32_t LocalCompressions() {
+#ifdef USE_ZSTD
+    return compressionBit(CompressionType::kZstd);
+#else
+    return 0;
+#endif
+}
+
+uint32_t LocalFeatures() {
+    return kFeatureBatchFrame;
+}
+
+void PeerCapabilities::Set(uint64_t node_id, uint32_t compressions, uint32_t features) {
+    {
+        sharkstore::shared_lock<sharkstore::shared_mutex> lock(mu_);
+        auto it = peers_.find(node_id);
+        if (it != peers_.end() && it->second.compressions == compressions &&
+            it->second.features == features) {
+            return;
+        }
+    }
+    std::unique_lock<sharkstore::shared_mutex> lock(mu_);
+    auto& cap = peers_[node_id];
+    cap.compressions = compressions;
+    cap.features = features;
+}
+
+bool PeerCapabilities::SupportsCompression(uint64_t node_id, CompressionType type) const {
+    sharkstore::shared_lock<sharkstore::shared_mutex> lock(mu_);
+    auto it = peers_.find(node_id);
+    return it != peers_.end() && (it->second.compressions & compressionBit(type)) != 0;
+}
+
+bool PeerCapabilities::SupportsFeature(uint64_t node_id, TransportFeature feature) const {
+    sharkstore::shared_lock<sharkstore::shared_mutex> lock(mu_);
+    auto it = peers_.find(node_id);
+    return it != peers_.end() && (it->second.features & feature) != 0;
+}
+
+bool DecompressFrame(char flags, const char* data, size_t len, const char** out,
+                     size_t* out_len, CompressStats* stats) {
+    if ((flags & kFrameFlagZstd) == 0) {
+        *out = data;
+        *out_len = len;
+        return true;
+    }
+#ifdef USE_ZSTD
+    struct DCtxHolder {
+        ZSTD_DCtx* dctx = ZSTD_createDCtx();
+        ~DCtxHolder() { ZSTD_freeDCtx(dctx); }
+    };
+    static thread_local DCtxHolder holder;
+    static thread_local std::vector<char> buf;
+
+    auto size = ZSTD_getFrameContentSize(data, len);
+    if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR ||
+        size > kMaxDecompressedSize) {
+        LOG_ERROR("raft[Decompress] invalid zstd frame content size: %llu",
+                  static_cast<unsigned long long>(size));
+        return false;
+    }
+    if (buf.size() < size) {
+        buf.resize(size);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t ret = ZSTD_decompressDCtx(holder.dctx, buf.data(), size, data, len);
+    stats->decompress_usecs += elapsedUsecs(start);
+    if (ZSTD_isError(ret) || ret != size) {
+        LOG_ERROR("raft[Decompress] zstd decompress failed: %s",
+                  ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "size mismatch");
+        return false;
+    }
+    *out = buf.data();
+    *out_len = ret;
+    return true;
+#else
+    LOG_ERROR("raft[Decompress] received zstd frame, but zstd is not compiled in.");
+    return false;
+#endif
+}
+
+} /* namespace transport */
+} /* namespace impl */
+} /* namespace raft */
+} /* namespace sharkstore */
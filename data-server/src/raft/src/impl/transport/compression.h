@@ -0,0 +1,96 @@
+_Pragma("once");
+
+#include <atomic>
+#include <map>
+#include <string>
+#include "base/shared_mutex.h"
+#include "raft/options.h"
+#include "raft/status.h"
+
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace sharkstore {
+namespace raft {
+namespace impl {
+namespace transport {
+
+// 帧头部flags中标识body经过zstd压缩
+static const char kFrameFlagZstd = 1 << 1;
+
+struct CompressStats {
+    std::atomic<uint64_t> raw_bytes{0};         // 尝试压缩的原始字节数
+    std::atomic<uint64_t> compressed_bytes{0};  // 其中实际发送的字节数，压缩失败的按原始大小
+    std::atomic<uint64_t> compress_usecs{0};
+    std::atomic<uint64_t> decompress_usecs{0};
+
+    void Fill(ServerStatus* status) const;
+};
+
+// 压缩帧的body，非线程安全，每个发送线程/连接各用一个
+class Compressor {
+public:
+    Compressor(CompressionType type, size_t threshold, CompressStats* stats);
+    ~Compressor();
+
+    Compressor(const Compressor&) = delete;
+    Compressor& operator=(const Compressor&) = delete;
+
+    // 小于阈值的数据不压缩
+    bool ShouldCompress(size_t len) const;
+
+    // 压缩后最大可能的大小
+    size_t Bound(size_t len) const;
+
+    // 压缩到dst，返回压缩后大小，flags为需要设置到帧头部的标识
+    // 失败或者压缩后没有变小返回0，调用方应该发送原始数据
+    size_t Compress(const char* src, size_t len, char* dst, size_t cap, char* flags);
+
+private:
+    const CompressionType type_;
+    const size_t threshold_ = 0;
+    CompressStats* stats_ = nullptr;
+#ifdef USE_ZSTD
+    ZSTD_CCtx* cctx_ = nullptr;
+#endif
+};
+
+// 本节点能够解压的算法，每个CompressionType占一位，通过心跳通告给其他节点
+uint32_t LocalCompressions();
+
+// 传输层的可选特性，每个占一位，同样通过心跳通告
+enum TransportFeature : uint32_t {
+    kFeatureBatchFrame = 1u << 0,  // 能够解析合并了多条消息的帧(kBatchMessageFuncID)
+};
+
+// 本节点支持的传输特性
+uint32_t LocalFeatures();
+
+// 其他节点通告的解压能力和传输特性，没有通告过的节点按旧版本处理：
+// 不发送压缩数据，每条消息单独一帧
+class PeerCapabilities {
+public:
+    void Set(uint64_t node_id, uint32_t compressions, uint32_t features);
+    bool SupportsCompression(uint64_t node_id, CompressionType type) const;
+    bool SupportsFeature(uint64_t node_id, TransportFeature feature) const;
+
+private:
+    struct Capability {
+        uint32_t compressions = 0;
+        uint32_t features = 0;
+    };
+
+    std::map<uint64_t, Capability> peers_;
+    mutable sharkstore::shared_mutex mu_;
+};
+
+// 根据帧头部的flags解压body，未压缩的帧直接返回true且out保持不变
+// 解压缓冲区是线程局部的，下次调用前有效
+bool DecompressFrame(char flags, const char* data, size_t len, const char** out,
+                     size_t* out_len, CompressStats* stats);
+
+} /* namespace transport */
+} /* namespace impl */
+} /* namespace raft */
+} /* namespace sharkstore */
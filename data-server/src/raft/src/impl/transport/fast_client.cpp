@@ -1,6 +1,7 @@
 #include "fast_client.h"
 
-#include <mutex>
+#include <google/protobuf/io/coded_stream.h>
+#include "base/util.h"
 #include "common/ds_proto.h"
 #include "frame/sf_logger.h"
 
@@ -9,15 +10,29 @@ namespace raft {
 namespace impl {
 namespace transport {
 
-FastClient::FastClient(const sf_socket_thread_config_t &cfg,
-                       const std::shared_ptr<NodeResolver> &resolver)
-    : config_(cfg), resolver_(resolver), msg_id_(1) {
+using google::protobuf::io::CodedOutputStream;
+
+// 合并后一帧的最大大小，超过时拆成多帧发送
+static const size_t kMaxFrameBodySize = 4 * 1024 * 1024;
+// 连接失败后的重试间隔
+static const std::chrono::milliseconds kReconnectInterval(1000);
+
+FastClient::FastClient(const sf_socket_thread_config_t &cfg, const TransportOptions &ops,
+                       CompressStats *stats, const PeerCapabilities *peers)
+    : config_(cfg),
+      resolver_(ops.resolver),
+      conn_pool_size_(ops.connection_pool_size > 0 ? ops.connection_pool_size : 1),
+      compression_(ops.compression),
+      peer_caps_(peers),
+      msg_id_(1),
+      running_(false) {
     memset(&status_, 0, sizeof(status_));
+    for (uint32_t ch = 0; ch < kLaneAppend + conn_pool_size_; ++ch) {
+        flushers_.emplace_back(new Flusher(ch, ops, stats));
+    }
 }
 
-FastClient::~FastClient() {
-    // TODO:
-}
+FastClient::~FastClient() { stopFlush(); }
 
 static void client_recv_done(request_buff_t *request, void *args) {
     // TODO:
@@ -39,104 +54,301 @@ Status FastClient::Initialize() {
         return Status(Status::kUnknown, "start raft fast client",
                       std::string("ret: ") + std::to_string(ret));
     }
+
+    running_ = true;
+    connect_thr_.reset(new std::thread([this] { connectRoutine(); }));
+    AnnotateThread(connect_thr_->native_handle(), "raft-connect");
+    for (auto &f : flushers_) {
+        auto fp = f.get();
+        f->thr.reset(new std::thread([this, fp] { flushRoutine(fp); }));
+        char name[16] = {'\0'};
+        snprintf(name, 16, "raft-flush:%u", fp->channel);
+        AnnotateThread(f->thr->native_handle(), name);
+    }
+
     return Status::OK();
 }
 
-void FastClient::Shutdown() { dataserver::common::SocketBase::Stop(); }
+void FastClient::Shutdown() {
+    stopFlush();
+    dataserver::common::SocketBase::Stop();
+}
+
+void FastClient::stopFlush() {
+    running_ = false;
+    for (auto &f : flushers_) {
+        {
+            std::lock_guard<std::mutex> lock(f->mu);
+        }
+        f->cond.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(connect_mu_);
+    }
+    connect_cond_.notify_all();
+
+    for (auto &f : flushers_) {
+        if (f->thr && f->thr->joinable()) {
+            f->thr->join();
+        }
+    }
+    if (connect_thr_ && connect_thr_->joinable()) {
+        connect_thr_->join();
+    }
+}
 
 void FastClient::SendMessage(MessagePtr &msg) {
+    static const std::vector<EntryPtr> kNoEntries;
+    SendMessage(msg, kNoEntries);
+}
+
+void FastClient::SendMessage(MessagePtr &msg, const std::vector<EntryPtr> &ents) {
     if (msg->to() == 0) {
         FLOG_ERROR(
             "raft[FastClient] invalid target node(0), type: %s, id: %lu, term: %lu",
             pb::MessageType_Name(msg->type()).c_str(), msg->id(), msg->term());
     }
 
-    int64_t sid = getSession(msg->to());
-    if (sid > 0) {
-        send(sid, msg);
-    } else {
-        FLOG_ERROR("raft[FastClient] could not get a connection to %lu", msg->to());
+    auto f = flushers_[selectChannel(*msg)].get();
+    PendingMessage pm;
+    pm.msg = msg;
+    pm.ents = ents;
+
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(f->mu);
+        if (!running_) return;
+        notify = f->pending.empty();
+        f->pending[msg->to()].push_back(std::move(pm));
+    }
+    if (notify) {
+        f->cond.notify_one();
     }
 }
 
-int64_t FastClient::getSession(uint64_t to) {
+uint32_t FastClient::selectChannel(const pb::Message &msg) const {
+    switch (msg.type()) {
+        case pb::VOTE_REQUEST:
+        case pb::VOTE_RESPONSE:
+        case pb::PRE_VOTE_REQUEST:
+        case pb::PRE_VOTE_RESPONSE:
+        case pb::HEARTBEAT_REQUEST:
+        case pb::HEARTBEAT_RESPONSE:
+            return kLaneControl;
+        case pb::SNAPSHOT_REQUEST:
+        case pb::SNAPSHOT_ACK:
+            return kLaneSnapshot;
+        default:
+            // 同一个raft的消息总是走同一个连接，保证顺序
+            return kLaneAppend + static_cast<uint32_t>(msg.id() % conn_pool_size_);
+    }
+}
+
+int64_t FastClient::findSession(const ChannelKey &key) const {
+    sharkstore::shared_lock<sharkstore::shared_mutex> locker(mu_);
+    auto it = sessions_.find(key);
+    return it != sessions_.end() ? it->second : 0;
+}
+
+void FastClient::removeSession(const ChannelKey &key) {
+    std::unique_lock<sharkstore::shared_mutex> locker(mu_);
+    sessions_.erase(key);
+}
+
+void FastClient::asyncConnect(const ChannelKey &key) {
     {
-        sharkstore::shared_lock<sharkstore::shared_mutex> locker(mu_);
-        auto it = sessions_.find(to);
-        if (it != sessions_.end()) {
-            return it->second;
+        std::lock_guard<std::mutex> lock(connect_mu_);
+        if (!running_ || connecting_.count(key) > 0) return;
+        auto it = connect_failures_.find(key);
+        if (it != connect_failures_.end() &&
+            std::chrono::steady_clock::now() - it->second < kReconnectInterval) {
+            return;
+        }
+        connecting_.insert(key);
+        connect_que_.push_back(key);
+    }
+    connect_cond_.notify_one();
+}
+
+void FastClient::connectRoutine() {
+    while (true) {
+        ChannelKey key;
+        {
+            std::unique_lock<std::mutex> lock(connect_mu_);
+            connect_cond_.wait(lock,
+                               [this] { return !running_ || !connect_que_.empty(); });
+            if (!running_) return;
+            key = connect_que_.front();
+            connect_que_.pop_front();
+        }
+
+        bool ok = connect(key);
+
+        std::lock_guard<std::mutex> lock(connect_mu_);
+        connecting_.erase(key);
+        if (ok) {
+            connect_failures_.erase(key);
+        } else {
+            connect_failures_[key] = std::chrono::steady_clock::now();
         }
     }
+}
 
+bool FastClient::connect(const ChannelKey &key) {
     // get remote ip and port
+    uint64_t to = key.second;
     std::string ip;
     int port = 0;
     std::string addr = resolver_->GetNodeAddress(to);
     if (addr.empty()) {
-        return 0;
+        FLOG_ERROR("raft[FastClient] could not resolve address of %lu", to);
+        return false;
     }
     auto pos = addr.find(':');
     if (pos != std::string::npos) {
         ip = addr.substr(0, pos);
         port = atoi(addr.substr(pos + 1).c_str());
     } else {
-        return 0;
+        FLOG_ERROR("raft[FastClient] invalid address of %lu: %s", to, addr.c_str());
+        return false;
     }
 
-    std::unique_lock<sharkstore::shared_mutex> locker(mu_);
-    auto it = sessions_.find(to);
-    if (it != sessions_.end()) {
-        return it->second;
-    }
     auto id = sf_connect_session_get(&thread_info_, ip.c_str(), port);
     if (id > 0) {
-        FLOG_INFO("raft[FastClient] connect to %s:%d success. sid=%ld", ip.c_str(), port,
-                  id);
-        sessions_.emplace(to, id);
+        FLOG_INFO("raft[FastClient] connect to %s:%d success. channel=%u, sid=%ld",
+                  ip.c_str(), port, key.first, id);
+        std::unique_lock<sharkstore::shared_mutex> locker(mu_);
+        sessions_[key] = id;
+        return true;
     } else {
         FLOG_ERROR("raft[FastClient] connect failed to %s:%d", ip.c_str(), port);
+        return false;
     }
-    return id;
 }
 
-void FastClient::removeSession(uint64_t to) {
-    std::unique_lock<sharkstore::shared_mutex> locker(mu_);
-    sessions_.erase(to);
+void FastClient::flushRoutine(Flusher *f) {
+    while (true) {
+        std::map<uint64_t, PendingQueue> pending;
+        {
+            std::unique_lock<std::mutex> lock(f->mu);
+            f->cond.wait(lock, [this, f] { return !running_ || !f->pending.empty(); });
+            if (!running_) return;
+            pending.swap(f->pending);
+        }
+        for (auto &p : pending) {
+            flush(f, p.first, p.second);
+        }
+    }
 }
 
-void FastClient::send(int64_t sid, MessagePtr &msg) {
-    size_t body_len = msg->ByteSizeLong();
-    size_t data_len = sizeof(ds_proto_header_t) + body_len;
+void FastClient::flush(Flusher *f, uint64_t to, PendingQueue &que) {
+    ChannelKey key(f->channel, to);
+    int64_t sid = findSession(key);
+    if (sid <= 0) {
+        // 连接建立之前的消息直接丢弃，由raft超时重发
+        FLOG_DEBUG("raft[FastClient] no connection to %lu(channel=%u), drop %lu messages",
+                   to, f->channel, que.size());
+        asyncConnect(key);
+        return;
+    }
 
-    response_buff_t *response = new_response_buff(data_len);
+    // 按kMaxFrameBodySize切分，每段合并成一帧
+    // 对方没有通告支持合并帧(旧版本)时每条消息单独一帧
+    bool batch = peer_caps_->SupportsFeature(to, kFeatureBatchFrame);
+    size_t begin = 0, body_len = 0;
+    for (size_t i = 0; i < que.size(); ++i) {
+        auto &pm = que[i];
+        // msg只属于这次发送，在这里计算大小；共享的ents只读取已缓存的大小
+        pm.size = pm.msg->ByteSizeLong() + EntriesByteSize(pm.ents);
+        size_t framed = CodedOutputStream::VarintSize32(static_cast<uint32_t>(pm.size)) + pm.size;
+        if (i > begin && (!batch || body_len + framed > kMaxFrameBodySize)) {
+            sendFrame(f, sid, key, que, begin, i, body_len);
+            begin = i;
+            body_len = 0;
+        }
+        body_len += framed;
+    }
+    if (begin < que.size()) {
+        sendFrame(f, sid, key, que, begin, que.size(), body_len);
+    }
+}
+
+void FastClient::sendFrame(Flusher *f, int64_t sid, const ChannelKey &key,
+                           PendingQueue &que, size_t begin, size_t end, size_t body_len) {
+    // 只有一条消息时按单条消息的格式发送，不带长度前缀
+    bool single = (end - begin == 1);
+    if (single) {
+        body_len = que[begin].size;
+    }
+
+    // 需要压缩时先编码到临时缓冲区，再压缩到发送缓冲区
+    bool compress = f->compressor.ShouldCompress(body_len) &&
+                    peer_caps_->SupportsCompression(key.second, compression_);
+    size_t buff_len = compress ? f->compressor.Bound(body_len) : body_len;
+    response_buff_t *response =
+        new_response_buff(static_cast<int>(sizeof(ds_proto_header_t) + buff_len));
+    char *out = response->buff + sizeof(ds_proto_header_t);
+    if (compress) {
+        if (f->compress_buf.size() < body_len) {
+            f->compress_buf.resize(body_len);
+        }
+        out = f->compress_buf.data();
+    }
+
+    // 日志条目直接编码到发送缓冲区，拼接在msg之后
+    auto body = reinterpret_cast<uint8_t *>(out);
+    auto p = body;
+    for (size_t i = begin; i < end; ++i) {
+        auto &pm = que[i];
+        if (!single) {
+            p = CodedOutputStream::WriteVarint32ToArray(static_cast<uint32_t>(pm.size), p);
+        }
+        p = SerializeEntriesToArray(pm.ents, pm.msg->SerializeWithCachedSizesToArray(p));
+    }
+    if (static_cast<size_t>(p - body) != body_len) {
+        FLOG_ERROR("raft[FastClient] serialize %lu messages to %lu failed.", end - begin,
+                   key.second);
+        delete_response_buff(response);
+        return;
+    }
+
+    char flags = 0;
+    if (compress) {
+        auto dst = response->buff + sizeof(ds_proto_header_t);
+        size_t clen = f->compressor.Compress(out, body_len, dst, buff_len, &flags);
+        if (clen > 0) {
+            body_len = clen;
+        } else {
+            // 压缩效果不好，发送原始数据
+            memcpy(dst, out, body_len);
+        }
+    }
 
     // 填充头部
     ds_header_t header;
+    memset(&header, 0, sizeof(header));
     header.magic_number = DS_PROTO_MAGIC_NUMBER;
-    header.body_len = body_len;
+    header.body_len = static_cast<int>(body_len);
     header.msg_id = msg_id_.fetch_add(1);
     header.version = DS_PROTO_VERSION_CURRENT;
     header.msg_type = DS_PROTO_FID_RPC_RESP;
-    header.func_id = 100;
+    header.func_id = single ? kSingleMessageFuncID : kBatchMessageFuncID;
     header.proto_type = 1;
+    header.flags = flags;
     ds_serialize_header(&header, (ds_proto_header_t *)(response->buff));
 
     response->session_id = sid;
-    response->buff_len = data_len;
-
-    if (msg->SerializeToArray(response->buff + sizeof(ds_proto_header_t), body_len)) {
-        int ret = dataserver::common::SocketBase::Send(response);
-        if (ret != 0) {
-            FLOG_ERROR("raft[FastClient] send to %lu failed. ret=%d, sid=%ld", msg->to(),
-                       ret, sid);
-            removeSession(msg->to());
-        }
-    } else {
-        delete_response_buff(response);
+    response->buff_len = static_cast<int>(sizeof(ds_proto_header_t) + body_len);
+
+    int ret = dataserver::common::SocketBase::Send(response);
+    if (ret != 0) {
+        FLOG_ERROR("raft[FastClient] send to %lu failed. ret=%d, sid=%ld", key.second, ret,
+                   sid);
+        removeSession(key);
     }
 }
 
 } /* namespace transport */
 } /* namespace impl */
 } /* namespace raft */
-} /* namespace sharkstore */
\ No newline at end of file
+} /* namespace sharkstore */
@@ -1,22 +1,36 @@
 _Pragma("once");
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
 #include "base/shared_mutex.h"
 #include "base/status.h"
 #include "common/socket_base.h"
 #include "raft/node_resolver.h"
+#include "raft/options.h"
 
 #include "../raft_types.h"
+#include "compression.h"
 
 namespace sharkstore {
 namespace raft {
 namespace impl {
 namespace transport {
 
+// 单条消息的帧func_id
+static const uint16_t kSingleMessageFuncID = 100;
+// 多条消息合并成一帧的func_id，body为多个(varint长度 + 消息)
+static const uint16_t kBatchMessageFuncID = 101;
+
 class FastClient : public dataserver::common::SocketBase {
 public:
-    FastClient(const sf_socket_thread_config_t& cfg,
-               const std::shared_ptr<NodeResolver>& resolver);
+    FastClient(const sf_socket_thread_config_t& cfg, const TransportOptions& ops,
+               CompressStats* stats, const PeerCapabilities* peers);
     ~FastClient();
 
     FastClient(const FastClient&) = delete;
@@ -26,22 +40,86 @@ public:
     void Shutdown();
 
     void SendMessage(MessagePtr& msg);
+    void SendMessage(MessagePtr& msg, const std::vector<EntryPtr>& ents);
 
 private:
-    int64_t getSession(uint64_t to);
-    void removeSession(uint64_t to);
+    // 不同类型的消息走不同的连接，避免选举、心跳排在大量日志复制后面
+    enum Lane : uint32_t {
+        kLaneControl = 0,   // 选举、心跳
+        kLaneSnapshot = 1,  // 快照请求及回应
+        kLaneAppend = 2,    // 日志复制，按raft id分散到多个连接上
+    };
+
+    // (通道, 目标节点), 通道 = lane + append连接的序号
+    using ChannelKey = std::pair<uint32_t, uint64_t>;
+
+    struct PendingMessage {
+        MessagePtr msg;
+        std::vector<EntryPtr> ents;
+        size_t size = 0;  // 序列化后的大小，在发送线程中计算
+    };
+    using PendingQueue = std::vector<PendingMessage>;
+
+    // 每个通道一个发送线程，各通道之间互不阻塞
+    // 同一个raft发往各个节点的消息在同一个通道上，共享的日志条目只在一个线程中编码
+    struct Flusher {
+        Flusher(uint32_t ch, const TransportOptions& ops, CompressStats* stats)
+            : channel(ch), compressor(ops.compression, ops.compress_threshold, stats) {}
+
+        const uint32_t channel = 0;
+        // 待发送的消息，发送线程每次把发往同一节点的消息合并成一帧发出
+        std::map<uint64_t, PendingQueue> pending;
+        std::mutex mu;
+        std::condition_variable cond;
+        std::unique_ptr<std::thread> thr;
 
-    void send(int64_t sid, MessagePtr& msg);
+        // 只在本通道的发送线程中使用
+        Compressor compressor;
+        std::vector<char> compress_buf;
+    };
+
+    uint32_t selectChannel(const pb::Message& msg) const;
+
+    int64_t findSession(const ChannelKey& key) const;
+    void removeSession(const ChannelKey& key);
+    // 在连接线程中建立连接，发送线程不会阻塞在解析地址和connect上
+    void asyncConnect(const ChannelKey& key);
+    void connectRoutine();
+    bool connect(const ChannelKey& key);
+
+    void flushRoutine(Flusher* f);
+    void stopFlush();
+    void flush(Flusher* f, uint64_t to, PendingQueue& que);
+    void sendFrame(Flusher* f, int64_t sid, const ChannelKey& key, PendingQueue& que,
+                   size_t begin, size_t end, size_t body_len);
 
 private:
     sf_socket_thread_config_t config_;
     sf_socket_status_t status_;
     std::shared_ptr<NodeResolver> resolver_;
+    // 每个节点的日志复制流量分散到几个连接上
+    const size_t conn_pool_size_ = 1;
+    const CompressionType compression_;
+    // 只向通告过支持的节点发送压缩数据和合并的帧
+    const PeerCapabilities* peer_caps_ = nullptr;
 
     std::atomic<int64_t> msg_id_;
 
-    std::unordered_map<uint64_t, int64_t> sessions_;
+    std::map<ChannelKey, int64_t> sessions_;
     mutable sharkstore::shared_mutex mu_;
+
+    // 下标为通道号
+    std::vector<std::unique_ptr<Flusher>> flushers_;
+    std::atomic<bool> running_;
+
+    // 等待建立连接的通道
+    std::set<ChannelKey> connecting_;
+    // 上次连接失败的时间，一段时间内不再重试
+    std::map<ChannelKey, std::chrono::steady_clock::time_point> connect_failures_;
+    std::deque<ChannelKey> connect_que_;
+    std::mutex connect_mu_;
+    std::condition_variable connect_cond_;
+    std::unique_ptr<std::thread> connect_thr_;
 };
 
 } /* namespace transport */
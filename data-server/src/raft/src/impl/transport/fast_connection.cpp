@@ -14,6 +14,10 @@ namespace raft {
 namespace impl {
 namespace transport {
 
+FastConnection::FastConnection(CompressionType compression, size_t compress_threshold,
+                               CompressStats* stats)
+    : compressor_(compression, compress_threshold, stats) {}
+
 FastConnection::~FastConnection() { this->Close(); }
 
 Status FastConnection::Open(const std::string& ip, uint16_t port) {
@@ -50,28 +54,47 @@ Status FastConnection::Close() {
 
 Status FastConnection::Send(MessagePtr& msg) {
     size_t body_len = msg->ByteSizeLong();
-    size_t data_len = sizeof(ds_proto_header_t) + body_len;
+    bool compress = compressor_.ShouldCompress(body_len);
+    size_t cap = compress ? compressor_.Bound(body_len) : body_len;
+
+    // 压缩时msg先编码到buf_尾部，再压缩到头部之后
+    size_t need = sizeof(ds_proto_header_t) + cap + (compress ? body_len : 0);
+    if (buf_.size() < need) {
+        buf_.resize(need);
+    }
+    char* buf = buf_.data();
+    char* body = buf + sizeof(ds_proto_header_t);
+    char* raw = compress ? body + cap : body;
 
-    std::vector<char> buf_vec(data_len, '0');
-    char* buf = buf_vec.data();
+    if (!msg->SerializeToArray(raw, static_cast<int>(body_len))) {
+        return Status(Status::kCorruption, "serialize snapshot msg",
+                      "SerializeToArray return false");
+    }
+
+    char flags = 0;
+    if (compress) {
+        size_t clen = compressor_.Compress(raw, body_len, body, cap, &flags);
+        if (clen > 0) {
+            body_len = clen;
+        } else {
+            memcpy(body, raw, body_len);
+        }
+    }
 
     ds_header_t header;
     memset(&header, 0, sizeof(header));
     header.magic_number = DS_PROTO_MAGIC_NUMBER;
-    header.body_len = body_len;
+    header.body_len = static_cast<int>(body_len);
     static std::atomic<uint64_t> msgid(1);
     header.msg_id = msgid.fetch_add(1);
     header.version = DS_PROTO_VERSION_CURRENT;
     header.msg_type = DS_PROTO_FID_RPC_RESP;
     header.func_id = 100;
     header.proto_type = 1;
+    header.flags = flags;
     ds_serialize_header(&header, (ds_proto_header_t*)(buf));
 
-    if (!msg->SerializeToArray(buf + sizeof(ds_proto_header_t), body_len)) {
-        return Status(Status::kCorruption, "serialize snapshot msg",
-                      "SerializeToArray return false");
-    }
-
+    size_t data_len = sizeof(ds_proto_header_t) + body_len;
     int ret = ::send(sockfd_, buf, data_len, 0);
     if (ret <= 0) {
         return Status(Status::kIOError, "send to socket", strErrno(errno));
@@ -1,5 +1,6 @@
 _Pragma("once");
 
+#include "compression.h"
 #include "transport.h"
 
 namespace sharkstore {
@@ -9,7 +10,8 @@ namespace transport {
 
 class FastConnection : public Connection {
 public:
-    FastConnection() = default;
+    FastConnection(CompressionType compression, size_t compress_threshold,
+                   CompressStats* stats);
     ~FastConnection();
 
     Status Open(const std::string& ip, uint16_t port);
@@ -18,6 +20,9 @@ public:
 
 private:
     int sockfd_ = -1;
+    // 快照数据块边读边压缩发送
+    Compressor compressor_;
+    std::vector<char> buf_;
 };
 
 } /* namespace transport */
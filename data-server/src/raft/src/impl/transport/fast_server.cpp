@@ -1,16 +1,19 @@
 #include "fast_server.h"
 
+#include <google/protobuf/io/coded_stream.h>
 #include "common/ds_proto.h"
 #include "frame/sf_logger.h"
 
+#include "fast_client.h"
+
 namespace sharkstore {
 namespace raft {
 namespace impl {
 namespace transport {
 
 FastServer::FastServer(const sf_socket_thread_config_t& config,
-                       const MessageHandler& handler)
-    : config_(config), handler_(handler) {
+                       const MessageHandler& handler, CompressStats* stats)
+    : config_(config), handler_(handler), compress_stats_(stats) {
     memset(&status_, 0, sizeof(status_));
 }
 
@@ -56,11 +59,24 @@ void FastServer::handleTask(request_buff_t* task) {
     ds_proto_header_t* proto_header = (ds_proto_header_t*)(task->buff);
     ds_unserialize_header(proto_header, &header);
 
-    if (header.body_len > 0) {
+    if (header.body_len <= 0) {
+        return;
+    }
+
+    // 压缩过的帧先解压
+    const char* data = nullptr;
+    size_t len = 0;
+    if (!DecompressFrame(header.flags, task->buff + sizeof(ds_proto_header_t),
+                         header.body_len, &data, &len, compress_stats_)) {
+        return;
+    }
+
+    auto body = reinterpret_cast<const uint8_t*>(data);
+    if (header.func_id == kBatchMessageFuncID) {
+        handleBatch(body, static_cast<int>(len));
+    } else {
         MessagePtr msg(new pb::Message);
-        bool ret =
-            msg->ParseFromArray(task->buff + sizeof(ds_proto_header_t), header.body_len);
-        if (ret) {
+        if (msg->ParseFromArray(body, static_cast<int>(len))) {
             handler_(msg);
         } else {
             FLOG_ERROR("raft[FastServer] prase protobuf message failed.");
@@ -68,6 +84,27 @@ void FastServer::handleTask(request_buff_t* task) {
     }
 }
 
+void FastServer::handleBatch(const uint8_t* data, int len) {
+    // 合并的帧: 多个(varint长度 + 消息)
+    google::protobuf::io::CodedInputStream input(data, len);
+    input.PushLimit(len);
+    while (input.BytesUntilLimit() > 0) {
+        uint32_t size = 0;
+        if (!input.ReadVarint32(&size)) {
+            FLOG_ERROR("raft[FastServer] read batch message size failed.");
+            return;
+        }
+        auto limit = input.PushLimit(static_cast<int>(size));
+        MessagePtr msg(new pb::Message);
+        if (!msg->ParseFromCodedStream(&input) || !input.ConsumedEntireMessage()) {
+            FLOG_ERROR("raft[FastServer] prase protobuf batch message failed.");
+            return;
+        }
+        input.PopLimit(limit);
+        handler_(msg);
+    }
+}
+
 void FastServer::sendDoneCallback(response_buff_t* task, int err) {
     // TODO: log
 }
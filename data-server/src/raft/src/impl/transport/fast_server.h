@@ -1,6 +1,7 @@
 _Pragma("once");
 
 #include "common/socket_base.h"
+#include "compression.h"
 #include "transport.h"
 
 namespace sharkstore {
@@ -11,7 +12,7 @@ namespace transport {
 class FastServer : public dataserver::common::SocketBase {
 public:
     FastServer(const sf_socket_thread_config_t& config,
-               const MessageHandler& handler);
+               const MessageHandler& handler, CompressStats* stats);
     ~FastServer();
 
     FastServer(const FastServer&) = delete;
@@ -25,12 +26,14 @@ private:
     friend void fastserver_send_done_cb(response_buff_t*, void*, int);
 
     void handleTask(request_buff_t* task);
+    void handleBatch(const uint8_t* data, int len);
     void sendDoneCallback(response_buff_t* task, int err);
 
 private:
     sf_socket_thread_config_t config_;
     sf_socket_status_t status_;
     MessageHandler handler_;
+    CompressStats* compress_stats_ = nullptr;
 };
 
 } /* namespace transport */
@@ -9,10 +9,7 @@ namespace raft {
 namespace impl {
 namespace transport {
 
-FastTransport::FastTransport(const std::shared_ptr<NodeResolver>& resolver,
-                             size_t send_threads, size_t recv_threads)
-    : resolver_(resolver),
-      recv_threads_num_(recv_threads) {}
+FastTransport::FastTransport(const TransportOptions& ops) : ops_(ops) {}
 
 FastTransport::~FastTransport() {
     delete server_;
@@ -25,7 +22,7 @@ Status FastTransport::Start(const std::string& listen_ip, uint16_t listen_port,
     sf_socket_thread_config_t srv_config;
     memset(&srv_config, 0, sizeof(srv_config));
     srv_config.accept_threads = 1;
-    srv_config.event_recv_threads = recv_threads_num_;
+    srv_config.event_recv_threads = ops_.recv_io_threads;
     srv_config.recv_buff_size = 128 * 1024;
 
     const char* ip = listen_ip.empty() ? "0.0.0.0" : listen_ip.c_str();
@@ -33,14 +30,14 @@ Status FastTransport::Start(const std::string& listen_ip, uint16_t listen_port,
     srv_config.port = listen_port;
 
     strcpy(srv_config.thread_name_prefix, "raft");
-    server_ = new FastServer(srv_config, handler);
+    server_ = new FastServer(srv_config, handler, &compress_stats_);
 
     // new client
     sf_socket_thread_config_t cli_config;
     memset(&cli_config, 0, sizeof(cli_config));
-    cli_config.event_send_threads = 1;
+    cli_config.event_send_threads = ops_.send_io_threads;
     strcpy(cli_config.thread_name_prefix, "raft");
-    client_ = new FastClient(cli_config, resolver_);
+    client_ = new FastClient(cli_config, ops_, &compress_stats_, &peer_caps_);
 
     auto s = server_->Initialize();
     if (!s.ok()) {
@@ -56,11 +53,15 @@ void FastTransport::Shutdown() {
 
 void FastTransport::SendMessage(MessagePtr& msg) { client_->SendMessage(msg); }
 
+void FastTransport::SendMessage(MessagePtr& msg, const std::vector<EntryPtr>& ents) {
+    client_->SendMessage(msg, ents);
+}
+
 Status FastTransport::GetConnection(uint64_t to,
                                     std::shared_ptr<Connection>* conn) {
     std::string ip;
     uint16_t port = 0;
-    std::string addr = resolver_->GetNodeAddress(to);
+    std::string addr = ops_.resolver->GetNodeAddress(to);
     auto pos = addr.find(':');
     if (pos != std::string::npos) {
         ip.assign(addr.substr(0, pos));
@@ -70,7 +71,12 @@ Status FastTransport::GetConnection(uint64_t to,
                       std::to_string(to));
     }
 
-    auto c = std::make_shared<FastConnection>();
+    // 对方不支持时快照数据不压缩
+    auto compression = peer_caps_.SupportsCompression(to, ops_.compression)
+                           ? ops_.compression
+                           : CompressionType::kNone;
+    auto c = std::make_shared<FastConnection>(compression, ops_.compress_threshold,
+                                              &compress_stats_);
     auto s = c->Open(ip, port);
     if (!s.ok()) return s;
 
@@ -78,6 +84,15 @@ Status FastTransport::GetConnection(uint64_t to,
     return Status::OK();
 }
 
+void FastTransport::SetPeerCapabilities(uint64_t node_id, uint32_t compressions,
+                                        uint32_t features) {
+    peer_caps_.Set(node_id, compressions, features);
+}
+
+void FastTransport::GetStatus(ServerStatus* status) const {
+    compress_stats_.Fill(status);
+}
+
 } /* namespace transport */
 } /* namespace impl */
 } /* namespace raft */
@@ -2,7 +2,9 @@ _Pragma("once");
 
 #include "common/socket_server.h"
 #include "raft/node_resolver.h"
+#include "raft/options.h"
 
+#include "compression.h"
 #include "transport.h"
 
 namespace sharkstore {
@@ -15,8 +17,7 @@ class FastClient;
 
 class FastTransport : public Transport {
 public:
-    FastTransport(const std::shared_ptr<NodeResolver>& resolver,
-                  size_t send_threads_num, size_t recv_threads_num);
+    explicit FastTransport(const TransportOptions& ops);
     ~FastTransport();
 
     Status Start(const std::string& listen_ip, uint16_t listen_port,
@@ -25,13 +26,19 @@ public:
     void Shutdown() override;
 
     void SendMessage(MessagePtr& msg) override;
+    void SendMessage(MessagePtr& msg, const std::vector<EntryPtr>& ents) override;
 
     Status GetConnection(uint64_t to,
                          std::shared_ptr<Connection>* conn) override;
 
+    void SetPeerCapabilities(uint64_t node_id, uint32_t compressions, uint32_t features) override;
+
+    void GetStatus(ServerStatus* status) const override;
+
 private:
-    std::shared_ptr<NodeResolver> resolver_;
-    const size_t recv_threads_num_ = 0;
+    const TransportOptions ops_;
+    CompressStats compress_stats_;
+    PeerCapabilities peer_caps_;
 
     FastServer* server_ = nullptr;
     FastClient* client_ = nullptr;
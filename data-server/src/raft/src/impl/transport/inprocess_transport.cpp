@@ -1,5 +1,7 @@
 #include "inprocess_transport.h"
 
+#include <algorithm>
+
 namespace sharkstore {
 namespace raft {
 namespace impl {
@@ -61,12 +63,34 @@ void InProcessTransport::MsgHub::unregister(uint64_t node_id) {
 void InProcessTransport::MsgHub::send(const MessagePtr& msg) {
     std::shared_ptr<MailBox> box;
     sharkstore::shared_lock<sharkstore::shared_mutex> lock(mu_);
+    if (isolated_nodes_.count(msg->from()) > 0 || isolated_nodes_.count(msg->to()) > 0 ||
+        partitions_.count(std::minmax(msg->from(), msg->to())) > 0) {
+        return;
+    }
     auto it = mail_boxes_.find(msg->to());
     if (it != mail_boxes_.end()) {
         it->second->send(msg);
     }
 }
 
+void InProcessTransport::MsgHub::isolate(uint64_t node_id, bool isolated) {
+    std::unique_lock<sharkstore::shared_mutex> lock(mu_);
+    if (isolated) {
+        isolated_nodes_.insert(node_id);
+    } else {
+        isolated_nodes_.erase(node_id);
+    }
+}
+
+void InProcessTransport::MsgHub::partition(uint64_t a, uint64_t b, bool partitioned) {
+    std::unique_lock<sharkstore::shared_mutex> lock(mu_);
+    if (partitioned) {
+        partitions_.insert(std::minmax(a, b));
+    } else {
+        partitions_.erase(std::minmax(a, b));
+    }
+}
+
 InProcessTransport::MsgHub InProcessTransport::msg_hub_;
 
 InProcessTransport::InProcessTransport(uint64_t node_id)
@@ -100,6 +124,22 @@ void InProcessTransport::Shutdown() {
 
 void InProcessTransport::SendMessage(MessagePtr& msg) { msg_hub_.send(msg); }
 
+void InProcessTransport::SendMessage(MessagePtr& msg, const std::vector<EntryPtr>& ents) {
+    // 进程内直接投递Message，日志条目需要拷贝一份
+    for (const auto& e : ents) {
+        msg->add_entries()->CopyFrom(*e);
+    }
+    msg_hub_.send(msg);
+}
+
+void InProcessTransport::Isolate(uint64_t node_id, bool isolated) {
+    msg_hub_.isolate(node_id, isolated);
+}
+
+void InProcessTransport::Partition(uint64_t a, uint64_t b, bool partitioned) {
+    msg_hub_.partition(a, b, partitioned);
+}
+
 Status InProcessTransport::GetConnection(uint64_t to,
                                          std::shared_ptr<Connection>* conn) {
     auto c = std::make_shared<InProcessConn>(this);
@@ -4,6 +4,7 @@ _Pragma("once");
 #include <condition_variable>
 #include <mutex>
 #include <queue>
+#include <set>
 #include <thread>
 
 #include "base/shared_mutex.h"
@@ -24,9 +25,15 @@ public:
     void Shutdown() override;
 
     void SendMessage(MessagePtr& msg) override;
+    void SendMessage(MessagePtr& msg, const std::vector<EntryPtr>& ents) override;
 
     Status GetConnection(uint64_t to, std::shared_ptr<Connection>* conn) override;
 
+    // 故障注入：隔离节点后丢弃所有发往和来自该节点的消息，用于模拟节点暂停或网络分区
+    static void Isolate(uint64_t node_id, bool isolated);
+    // 故障注入：断开两个节点之间的连接，双向丢弃消息，用于模拟部分分区
+    static void Partition(uint64_t a, uint64_t b, bool partitioned);
+
 private:
     void recvRoutine();
 
@@ -69,9 +76,14 @@ private:
         std::shared_ptr<MailBox> regist(uint64_t node_id);
         void unregister(uint64_t node_id);
         void send(const MessagePtr& msg);
+        void isolate(uint64_t node_id, bool isolated);
+        void partition(uint64_t a, uint64_t b, bool partitioned);
 
     private:
         std::map<uint64_t, std::shared_ptr<MailBox>> mail_boxes_;
+        std::set<uint64_t> isolated_nodes_;
+        // 断开的连接，较小的节点id在前
+        std::set<std::pair<uint64_t, uint64_t>> partitions_;
         mutable sharkstore::shared_mutex mu_;
     };
 
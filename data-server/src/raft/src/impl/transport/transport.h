@@ -2,6 +2,7 @@ _Pragma("once");
 
 #include <functional>
 #include "base/status.h"
+#include "raft/status.h"
 #include "../raft_types.h"
 
 namespace sharkstore {
@@ -39,8 +40,18 @@ public:
 
     virtual void SendMessage(MessagePtr& msg) = 0;
 
+    // 发送append消息，ents跟本地日志共享，编码时直接拼接到msg的entries字段
+    virtual void SendMessage(MessagePtr& msg, const std::vector<EntryPtr>& ents) = 0;
+
     // 需要单独建立一个连接用来发快照
     virtual Status GetConnection(uint64_t to, std::shared_ptr<Connection>* conn) = 0;
+
+    // 其他节点通过心跳通告的能力
+    // compressions按CompressionType取位，features按TransportFeature取位
+    virtual void SetPeerCapabilities(uint64_t node_id, uint32_t compressions, uint32_t features) {}
+
+    // 填充传输相关的统计
+    virtual void GetStatus(ServerStatus* status) const {}
 };
 
 } /* namespace transport */
@@ -1,29 +1,70 @@
 #include "work_thread.h"
 
 #include <assert.h>
+#include <algorithm>
 #include <thread>
 #include "base/util.h"
 #include "logger.h"
 #include "raft_exception.h"
+#include "raft_impl.h"
 #include "server_impl.h"
 
 namespace sharkstore {
 namespace raft {
 namespace impl {
 
+// 队列预分配的任务数，blocks用完后会回收复用
+static const size_t kPreallocWorks = 1024;
+
+ProposalQueue::ProposalQueue() : head_(new Node), tail_(head_.load()) {}
+
+ProposalQueue::~ProposalQueue() {
+    while (tail_ != nullptr) {
+        Node* next = tail_->next.load();
+        delete tail_;
+        tail_ = next;
+    }
+}
+
+void ProposalQueue::push(Node* n) {
+    Node* prev = head_.exchange(n);
+    prev->next.store(n, std::memory_order_release);
+}
+
+ProposalQueue::Node* ProposalQueue::pop() {
+    // tail_是已经取出的哑节点，数据在它的下一个节点里
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+        return nullptr;
+    }
+    // 把next的数据换到旧的哑节点里返回，next成为新的哑节点
+    Node* n = tail_;
+    n->cmd.swap(next->cmd);
+    n->next.store(nullptr, std::memory_order_relaxed);
+    tail_ = next;
+    return n;
+}
+
 void Work::Do() {
     if (!(*stopped)) {
-        if (msg == nullptr) {
-            f0();
-        } else {
-            f1(msg);
+        switch (type) {
+            case kStep:
+                raft->Step(msg);
+                break;
+            default:
+                f0();
+                break;
         }
     }
 }
 
 WorkThread::WorkThread(RaftServerImpl* server, size_t queue_capcity,
-                       const std::string& name)
-    : server_(server), capacity_(queue_capcity), running_(true) {
+                       const std::string& name, const BatchOptions& batch_ops)
+    : server_(server),
+      capacity_(queue_capcity),
+      batch_ops_(batch_ops),
+      running_(true),
+      queue_(std::min(queue_capcity, kPreallocWorks)) {
     assert(server_ != nullptr);
     assert(capacity_ > 0);
 
@@ -34,114 +75,213 @@ WorkThread::WorkThread(RaftServerImpl* server, size_t queue_capcity,
 
 WorkThread::~WorkThread() { shutdown(); }
 
+bool WorkThread::reserve() {
+    if (size_.fetch_add(1) >= capacity_) {
+        size_.fetch_sub(1);
+        return false;
+    }
+    return true;
+}
+
+void WorkThread::enqueue(Work&& w) { queue_.enqueue(std::move(w)); }
+
 bool WorkThread::submit(uint64_t owner, std::atomic<bool>* stopped,
-                        const std::function<void(MessagePtr&)>& f1,
+                        const std::shared_ptr<RaftImpl>& raft, ProposalQueue* props,
                         std::string& cmd) {
-    MessagePtr msg(new pb::Message);
-    msg->set_type(pb::LOCAL_MSG_PROP);
+    if (!running_) return false;
 
-    bool notify = false;
-    {
-        std::lock_guard<std::mutex> lock(mu_);
-        if (!running_) return false;
+    if (proposals_.fetch_add(1) >= capacity_) {
+        proposals_.fetch_sub(1);
+        return false;
+    }
 
-        auto it = batch_pos_.find(owner);
-        if (it != batch_pos_.end() &&
-            it->second->entries_size() < kMaxBatchSize) {
-            // 可以合并
-            auto entry = it->second->add_entries();
-            entry->set_type(pb::ENTRY_NORMAL);
-            entry->mutable_data()->swap(cmd);
-        } else if (queue_.size() >= capacity_) {
-            return false;
-        } else {
-            // 不能合并，new一个
-            auto entry = msg->add_entries();
-            entry->set_type(pb::ENTRY_NORMAL);
-            entry->mutable_data()->swap(cmd);
-            Work w;
-            w.owner = owner;
-            w.stopped = stopped;
-            w.f1 = f1;
-            w.msg = msg;
-            queue_.push(w);
-            batch_pos_[owner] = msg;
-            notify = true;
-        }
+    auto n = new ProposalQueue::Node;
+    n->cmd.swap(cmd);
+    props->bytes_ += n->cmd.size();
+    // 先计数再入队，工作线程看到pending_为0时一定已经取完
+    ++props->pending_;
+    props->push(n);
+
+    // 已经有占位任务的话，提案会在它出队时一起取走
+    if (!props->scheduled_.exchange(true)) {
+        Work w;
+        w.type = Work::kStep;
+        w.owner = owner;
+        w.stopped = stopped;
+        w.raft = raft;
+        w.props = props;
+        schedule(w);
     }
-    if (notify) {
-        cv_.notify_one();
+    return true;
+}
+
+void WorkThread::schedule(const Work& w) {
+    w.props->schedule_time_ = std::chrono::steady_clock::now();
+    // 每个range最多一个占位任务，不占用队列容量
+    post(Work(w));
+}
+
+bool WorkThread::tryPost(Work&& w) {
+    if (!running_) return false;
+    if (!reserve()) {
+        return false;
     }
+    enqueue(std::move(w));
     return true;
 }
 
-bool WorkThread::tryPost(const Work& w) {
-    {
-        std::lock_guard<std::mutex> lock(mu_);
-        if (!running_) return false;
-        if (queue_.size() >= capacity_) {
-            return false;
-        } else {
-            queue_.push(w);
+void WorkThread::post(Work&& w) {
+    if (!running_) return;
+    ++size_;
+    enqueue(std::move(w));
+}
+
+void WorkThread::waitPost(Work&& w) {
+    while (running_) {
+        if (reserve()) {
+            enqueue(std::move(w));
+            return;
         }
+        // 先登记再检查一次，避免错过消费线程的唤醒
+        ++space_waiters_;
+        if (size_ >= capacity_) {
+            space_sema_.wait(10 * 1000);
+        }
+        --space_waiters_;
     }
-    cv_.notify_one();
-    return true;
 }
 
-void WorkThread::post(const Work& w) {
-    {
-        std::lock_guard<std::mutex> lock(mu_);
-        if (!running_) return;
-        queue_.push(w);
+void WorkThread::shutdown() {
+    bool expected = true;
+    if (!running_.compare_exchange_strong(expected, false)) {
+        return;
     }
-    cv_.notify_one();
+    // 唤醒工作线程和waitPost的等待者
+    queue_.enqueue(Work());
+    space_sema_.signal(space_waiters_.load());
+    thr_->join();
 }
 
-void WorkThread::waitPost(const Work& w) {
-    std::unique_lock<std::mutex> lock(mu_);
-    while (queue_.size() >= capacity_ && running_) {
-        cv_.wait(lock);
+bool WorkThread::isProposal(const Work& w) { return w.props != nullptr; }
+
+bool WorkThread::isBatchFull(const ProposalQueue& q) const {
+    return q.pending_ >= static_cast<size_t>(batch_ops_.max_entries) ||
+           q.bytes_ >= batch_ops_.max_bytes;
+}
+
+bool WorkThread::shouldDefer(const ProposalQueue& q) const {
+    // 队列里除了当前batch和被推迟的没有其他任务，说明负载不高，立即处理
+    if (size_ <= deferred_.size() + 1) {
+        return false;
     }
+    if (isBatchFull(q)) {
+        return false;
+    }
+    return std::chrono::steady_clock::now() - q.schedule_time_ < batch_ops_.max_delay;
+}
 
-    if (running_) {
-        queue_.push(w);
-        lock.unlock();
-        cv_.notify_one();
+bool WorkThread::dequeue(Work* w) {
+    if (deferred_.empty()) {
+        queue_.wait_dequeue(*w);
+        return true;
     }
+    // 队列里只剩推迟的batch，不再等待
+    if (size_ <= deferred_.size()) {
+        return false;
+    }
+    // 最多等到最早推迟的batch到期
+    auto wait = std::chrono::duration_cast<std::chrono::microseconds>(
+        deferred_.front().deadline - std::chrono::steady_clock::now());
+    return wait.count() > 0 && queue_.wait_dequeue_timed(*w, wait.count());
 }
 
-void WorkThread::shutdown() {
-    {
-        std::unique_lock<std::mutex> lock(mu_);
-        if (!running_) return;
-        running_ = false;
+bool WorkThread::closeBatch(Work* w) {
+    ProposalQueue* q = w->props;
+
+    MessagePtr msg(new pb::Message);
+    msg->set_type(pb::LOCAL_MSG_PROP);
+    size_t bytes = 0;
+    while (msg->entries_size() < batch_ops_.max_entries && bytes < batch_ops_.max_bytes) {
+        auto n = q->pop();
+        if (n == nullptr) break;
+        bytes += n->cmd.size();
+        auto entry = msg->add_entries();
+        entry->set_type(pb::ENTRY_NORMAL);
+        entry->mutable_data()->swap(n->cmd);
+        delete n;
     }
-    cv_.notify_one();
-    thr_->join();
+    size_t count = msg->entries_size();
+    q->bytes_ -= bytes;
+    q->pending_ -= count;
+    proposals_ -= count;
+
+    // 还有剩余的提案（包括正在入队的），重新放一个占位任务
+    // 否则清除标记后再检查一次，避免和提交线程同时判断时漏掉
+    if (q->pending_ > 0) {
+        schedule(*w);
+    } else {
+        q->scheduled_ = false;
+        if (q->pending_ > 0 && !q->scheduled_.exchange(true)) {
+            schedule(*w);
+        }
+    }
+
+    if (count == 0) {
+        return false;
+    }
+    w->msg = std::move(msg);
+    ++prop_batches_;
+    prop_entries_ += count;
+    return true;
 }
 
 bool WorkThread::pull(Work* w) {
-    std::unique_lock<std::mutex> lock(mu_);
+    while (true) {
+        if (!running_) return false;
 
-    while (queue_.empty() && running_) {
-        cv_.wait(lock);
-    }
-    if (!running_) return false;
-    *w = queue_.front();
-    queue_.pop();
-
-    if (w->msg != nullptr && w->msg->type() == pb::LOCAL_MSG_PROP) {
-        assert(w->owner != 0);
-        auto it = batch_pos_.find(w->owner);
-        if (it != batch_pos_.end() && it->second == w->msg) {
-            assert(it->second->type() == pb::LOCAL_MSG_PROP);
-            batch_pos_.erase(it);
+        if (!ready_.empty()) {
+            *w = std::move(ready_.front());
+            ready_.pop_front();
+        } else if (!dequeue(w)) {
+            // 最早推迟的batch到期或者没有其他任务了
+            *w = std::move(deferred_.front().work);
+            deferred_.pop_front();
+        } else {
+            if (!running_) return false;
+
+            // 负载高时先处理其他任务，还在合并中的batch推迟处理
+            if (isProposal(*w) && shouldDefer(*w->props)) {
+                auto deadline = w->props->schedule_time_ + batch_ops_.max_delay;
+                deferred_.push_back(DeferredWork{std::move(*w), deadline});
+                continue;
+            }
+
+            // 同一个range之前被推迟的batch先处理，当前任务排在它之后
+            if (w->owner != 0) {
+                auto it = std::find_if(
+                    deferred_.begin(), deferred_.end(),
+                    [w](const DeferredWork& d) { return d.work.owner == w->owner; });
+                if (it != deferred_.end()) {
+                    ready_.push_back(std::move(*w));
+                    *w = std::move(it->work);
+                    deferred_.erase(it);
+                }
+            }
         }
+
+        // 提交线程还没入队完成，占位任务已经重新放回队列
+        if (isProposal(*w) && !closeBatch(w)) {
+            --size_;
+            continue;
+        }
+        break;
     }
 
-    lock.unlock();
-    cv_.notify_one();  // 通知队列已经不再满了
+    --size_;
+    // 通知队列已经不再满了
+    if (space_waiters_ > 0) {
+        space_sema_.signal();
+    }
     return true;
 }
 
@@ -164,9 +304,11 @@ void WorkThread::run() {
     }
 }
 
-int WorkThread::size() const {
-    std::lock_guard<std::mutex> lock(mu_);
-    return queue_.size();
+int WorkThread::size() const { return static_cast<int>(size_.load()); }
+
+void WorkThread::collectBatchStats(uint64_t* batches, uint64_t* entries) {
+    *batches = prop_batches_.exchange(0);
+    *entries = prop_entries_.exchange(0);
 }
 
 } /* namespace impl */
@@ -1,13 +1,13 @@
 _Pragma("once");
 
 #include <atomic>
-#include <condition_variable>
+#include <chrono>
+#include <deque>
 #include <memory>
-#include <mutex>
-#include <queue>
+#include <string>
 #include <thread>
 #include <functional>
-#include <unordered_map>
+#include "lk_queue/blockingconcurrentqueue.h"
 #include "raft_types.h"
 
 namespace sharkstore {
@@ -17,16 +17,69 @@ namespace impl {
 class RaftImpl;
 class RaftServerImpl;
 
-static const int kMaxBatchSize = 64;
+// 提案合并的限制
+struct BatchOptions {
+    // 单个batch最多多少条
+    int max_entries = 64;
+    // 单个batch最大字节数
+    size_t max_bytes = 256 * 1024;
+    // 队列中还有其他任务时，未满的batch最多延迟多久处理，以积攒更多的提案
+    std::chrono::microseconds max_delay = std::chrono::microseconds(500);
+};
+
+// 单个range待处理的提案，多个提交线程无锁入队，只有工作线程出队
+// 同一个提交线程的提案保持先后顺序
+class ProposalQueue {
+public:
+    ProposalQueue();
+    ~ProposalQueue();
+
+    ProposalQueue(const ProposalQueue&) = delete;
+    ProposalQueue& operator=(const ProposalQueue&) = delete;
+
+private:
+    friend class WorkThread;
+
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        std::string cmd;
+    };
+
+    void push(Node* n);
+    // 生产者入队到一半时可能暂时取不到
+    Node* pop();
+
+private:
+    std::atomic<Node*> head_;
+    Node* tail_ = nullptr;
+
+    // 已提交还未取出的提案数和字节数
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> bytes_{0};
+    // 工作队列里是否已经有该range的占位任务
+    std::atomic<bool> scheduled_{false};
+    // 占位任务入队的时间
+    std::chrono::steady_clock::time_point schedule_time_;
+};
 
+// 工作线程的任务
+// 常见的Step任务直接记录raft和消息，不经过std::function，入队时不需要额外分配内存
 struct Work {
+    enum Type : uint8_t {
+        kFunc = 0,  // 执行f0
+        kStep,      // raft->Step(msg)
+    };
+
+    Type type = kFunc;
     uint64_t owner = 0;
     std::atomic<bool>* stopped = nullptr;
 
-    std::function<void()> f0;
+    std::shared_ptr<RaftImpl> raft;
+    MessagePtr msg;
+    // 提案占位任务，出队时才从队列取出提案组成msg
+    ProposalQueue* props = nullptr;
 
-    std::function<void(MessagePtr&)> f1;
-    MessagePtr msg = nullptr;
+    std::function<void()> f0;
 
     void Do();
 };
@@ -34,36 +87,87 @@ struct Work {
 class WorkThread {
 public:
     WorkThread(RaftServerImpl* server, size_t queue_capcity,
-               const std::string& name = "raft-worker");
+               const std::string& name = "raft-worker",
+               const BatchOptions& batch_ops = BatchOptions());
     ~WorkThread();
 
     WorkThread(const WorkThread&) = delete;
     WorkThread& operator=(const WorkThread&) = delete;
 
+    // 提交提案，不加锁；队列中的提案总数达到容量时返回false
     bool submit(uint64_t owner, std::atomic<bool>* stopped,
-                const std::function<void(MessagePtr&)>& f1, std::string& cmd);
-
-    bool tryPost(const Work& w);
-    void post(const Work& w);
-    void waitPost(const Work& w);
+                const std::shared_ptr<RaftImpl>& raft, ProposalQueue* props,
+                std::string& cmd);
+
+    // 队列满时返回false
+    bool tryPost(Work&& w);
+    // 不检查队列容量
+    void post(Work&& w);
+    // 队列满时阻塞等待
+    void waitPost(Work&& w);
     void shutdown();
     int size() const;
 
+    // 获取并清零提案batch统计
+    void collectBatchStats(uint64_t* batches, uint64_t* entries);
+
 private:
+    // 推迟处理的batch，只在工作线程中访问
+    struct DeferredWork {
+        Work work;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    static bool isProposal(const Work& w);
+    bool isBatchFull(const ProposalQueue& q) const;
+    // 是否推迟处理当前还在合并中的batch
+    bool shouldDefer(const ProposalQueue& q) const;
+    // 取出一个任务，不包括推迟的batch
+    bool dequeue(Work* w);
+    // 从w所属range的提案队列取出一个batch，之后的提案排到下一个batch
+    // 没有取到提案时返回false
+    bool closeBatch(Work* w);
+    // 提案占位任务入队
+    void schedule(const Work& w);
+
+    // 占用一个队列位置，队列满时返回false
+    bool reserve();
+    void enqueue(Work&& w);
+
     bool pull(Work* w);
     void run();
 
 private:
+    typedef moodycamel::details::mpmc_sema::LightweightSemaphore Semaphore;
+
     RaftServerImpl* server_ = nullptr;
     const size_t capacity_ = 0;
+    const BatchOptions batch_ops_;
 
     std::unique_ptr<std::thread> thr_;
-    bool running_ = false;
-    std::queue<Work> queue_;
-    // 记录每个range最近一条LOCAL_MSG_PROP消息，便于batch合并
-    std::unordered_map<uint64_t, MessagePtr> batch_pos_;
-    mutable std::mutex mu_;
-    std::condition_variable cv_;
+    std::atomic<bool> running_{false};
+
+    // 无锁队列，同一个生产线程入队的任务保持先后顺序
+    moodycamel::BlockingConcurrentQueue<Work> queue_;
+    // 队列中的任务数（包括已占位还未入队的），用于限制队列容量
+    std::atomic<size_t> size_{0};
+    // 被推迟的batch放在本地列表，而不是放回队尾，避免打乱同一个range的任务顺序
+    // 同一个range的后续任务出队时，先处理它之前被推迟的batch
+    std::deque<DeferredWork> deferred_;
+    // 已经出队，排在推迟的batch之后处理的任务
+    std::deque<Work> ready_;
+
+    // waitPost时等待队列空闲
+    std::atomic<int> space_waiters_{0};
+    Semaphore space_sema_;
+
+    // 所有range已提交还未取出的提案数，用于限制提案占用的内存
+    // 提案放在各自range的ProposalQueue里，每个range在queue_里最多只有一个占位任务
+    std::atomic<size_t> proposals_{0};
+
+    // 提案batch统计
+    std::atomic<uint64_t> prop_batches_{0};
+    std::atomic<uint64_t> prop_entries_{0};
 };
 
 } /* namespace impl */
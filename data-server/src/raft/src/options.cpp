@@ -21,6 +21,16 @@ Status TransportOptions::Validate() const {
         return Status(Status::kInvalidArgument, "raft transport options",
                       "recv_io_threads");
     }
+    if (connection_pool_size == 0) {
+        return Status(Status::kInvalidArgument, "raft transport options",
+                      "connection_pool_size");
+    }
+#ifndef USE_ZSTD
+    if (compression == CompressionType::kZstd) {
+        return Status(Status::kNotSupported, "raft transport options",
+                      "zstd compression is not compiled in");
+    }
+#endif
     return Status::OK();
 }
 
@@ -80,6 +90,14 @@ Status RaftServerOptions::Validate() const {
         return Status(Status::kInvalidArgument, "raft server options",
                       "consensus queue capacity");
     }
+    if (max_batch_entries <= 0) {
+        return Status(Status::kInvalidArgument, "raft server options",
+                      "max batch entries");
+    }
+    if (max_batch_bytes == 0) {
+        return Status(Status::kInvalidArgument, "raft server options",
+                      "max batch bytes");
+    }
 
     if (!apply_in_place) {
         if (apply_threads_num == 0) {
@@ -28,6 +28,7 @@ RaftStatus& RaftStatus::operator=(RaftStatus&& s) {
         index = std::move(s.index);
         commit = std::move(s.commit);
         applied = std::move(s.applied);
+        apply_pending = std::move(s.apply_pending);
         state = std::move(s.state);
         replicas = std::move(s.replicas);
     }
@@ -43,6 +44,7 @@ std::string RaftStatus::ToString() const {
        << "\"index\": " << index << ", "
        << "\"commit\": " << commit << ", "
        << "\"applied\": " << applied << ", "
+       << "\"apply_pending\": " << apply_pending << ", "
        << "\"state\": "
        << "\"" << state << "\", "
        << "\"replicas\":";
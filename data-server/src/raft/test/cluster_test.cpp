@@ -23,6 +23,8 @@ void run_node(uint64_t node_id) {
     ops.node_id = node_id;
     ops.tick_interval = std::chrono::milliseconds(100);
     ops.election_tick = 5;
+    // 一半节点使用异步apply
+    ops.apply_in_place = (node_id % 2 == 0);
     ops.transport_options.use_inprocess_transport = true;
 
     auto rs = CreateRaftServer(ops);
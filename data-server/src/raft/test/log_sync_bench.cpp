@@ -0,0 +1,115 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "base/util.h"
+#include "raft/src/impl/storage/storage_disk.h"
+
+// 每写一条日志sync一次，对比不预分配、预分配、预分配加回收复用三种方式的写入延迟
+// 结果取决于文件系统，需要在实际的数据盘上运行（tmpfs上sync没有开销）
+//
+// 用法: log_sync_bench [dir] [entries] [entry_size]
+
+using namespace sharkstore;
+using namespace sharkstore::raft::impl;
+using namespace sharkstore::raft::impl::storage;
+
+static std::string g_dir = "/tmp";
+static size_t g_entries = 20000;
+static size_t g_entry_size = 256;
+
+struct Mode {
+    const char* name;
+    size_t preallocate_size;
+    size_t recycle_log_files;
+};
+
+static DiskStorage::Options makeOptions(const Mode& mode) {
+    DiskStorage::Options ops;
+    ops.log_file_size = 1024 * 1024;  // 较小的文件，让轮转和回收多发生几次
+    ops.max_log_files = 2;
+    ops.preallocate_size = mode.preallocate_size;
+    ops.recycle_log_files = mode.recycle_log_files;
+    ops.always_sync = true;
+    return ops;
+}
+
+static void bench(const std::string& root, const Mode& mode) {
+    auto path = JoinFilePath({root, mode.name});
+    DiskStorage ds(1, path, makeOptions(mode));
+    auto s = ds.Open();
+    if (!s.ok()) {
+        std::cerr << "open " << path << " failed: " << s.ToString() << std::endl;
+        ::exit(1);
+    }
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(g_entries);
+    for (uint64_t i = 1; i <= g_entries; ++i) {
+        EntryPtr e(new pb::Entry);
+        e->set_index(i);
+        e->set_term(1);
+        e->set_type(pb::ENTRY_NORMAL);
+        e->set_data(std::string(g_entry_size, 'a'));
+        e->ByteSizeLong();
+
+        auto begin = std::chrono::steady_clock::now();
+        s = ds.StoreEntries(std::vector<EntryPtr>{e});
+        auto end = std::chrono::steady_clock::now();
+        if (!s.ok()) {
+            std::cerr << "store entry " << i << " failed: " << s.ToString() << std::endl;
+            ::exit(1);
+        }
+        latencies.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
+        // 已应用的日志超出max_log_files后截断，截断的文件进入回收池
+        ds.AppliedTo(i);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    int64_t total = 0;
+    for (auto l : latencies) {
+        total += l;
+    }
+    auto percentile = [&](double p) {
+        return latencies[std::min(latencies.size() - 1,
+                                  static_cast<size_t>(latencies.size() * p))];
+    };
+    std::cout << mode.name << ": avg " << total / static_cast<int64_t>(latencies.size())
+              << "us, p50 " << percentile(0.5) << "us, p99 " << percentile(0.99)
+              << "us, max " << latencies.back() << "us" << std::endl;
+
+    ds.Destroy();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) g_dir = argv[1];
+    if (argc > 2) g_entries = std::stoul(argv[2]);
+    if (argc > 3) g_entry_size = std::stoul(argv[3]);
+
+    std::string tmpl = JoinFilePath({g_dir, "sharkstore_raft_sync_bench_XXXXXX"});
+    std::vector<char> path(tmpl.begin(), tmpl.end());
+    path.push_back('\0');
+    char* tmp = mkdtemp(path.data());
+    if (tmp == NULL) {
+        std::cerr << "mkdtemp failed" << std::endl;
+        return 1;
+    }
+    std::string root(tmp);
+
+    const Mode modes[] = {
+        {"no_prealloc", 0, 0},
+        {"prealloc", 1024 * 1024, 0},
+        {"prealloc_recycle", 1024 * 1024, 2},
+    };
+    for (const auto& mode : modes) {
+        bench(root, mode);
+    }
+
+    RemoveDirAll(root.c_str());
+    return 0;
+}
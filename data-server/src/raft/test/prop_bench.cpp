@@ -0,0 +1,172 @@
+#include <sys/resource.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "raft/raft.h"
+#include "raft/server.h"
+
+// 多个线程向多个range并发提交提案，测试单个consensus线程的提案吞吐，
+// 检查同一个提交线程的提案是否按顺序apply，以及低负载时的cpu占用
+//
+// 用法: prop_bench [ranges] [producers] [ops_per_producer]
+
+using namespace sharkstore;
+using namespace sharkstore::raft;
+
+static int g_ranges = 8;
+static int g_producers = 8;
+static int g_ops = 50000;
+
+// 提案格式为 "提交线程:序号"，每个提交线程在每个range上的序号从1开始连续递增
+class OrderStateMachine : public StateMachine {
+public:
+    Status Apply(const std::string& cmd, uint64_t index) override {
+        auto pos = cmd.find(':');
+        auto producer = std::stoull(cmd.substr(0, pos));
+        auto seq = std::stoull(cmd.substr(pos + 1));
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            auto& last = last_seqs_[producer];
+            if (seq != last + 1) {
+                ++disorder_;
+            }
+            last = seq;
+        }
+        ++applied_;
+        return Status::OK();
+    }
+
+    Status ApplyMemberChange(const ConfChange&, uint64_t) override {
+        return Status::OK();
+    }
+    void OnReplicateError(const std::string&, const Status&) override {}
+    void OnLeaderChange(uint64_t, uint64_t) override {}
+    std::shared_ptr<Snapshot> GetSnapshot() override { return nullptr; }
+    Status ApplySnapshotStart(const std::string&) override { return Status::OK(); }
+    Status ApplySnapshotData(const std::vector<std::string>&) override {
+        return Status::OK();
+    }
+    Status ApplySnapshotFinish(uint64_t) override { return Status::OK(); }
+
+    uint64_t Applied() const { return applied_; }
+    uint64_t Disorder() const { return disorder_; }
+
+private:
+    std::mutex mu_;
+    std::map<uint64_t, uint64_t> last_seqs_;
+    std::atomic<uint64_t> applied_ = {0};
+    std::atomic<uint64_t> disorder_ = {0};
+};
+
+static double cpuSeconds() {
+    struct rusage r;
+    getrusage(RUSAGE_SELF, &r);
+    return r.ru_utime.tv_sec + r.ru_stime.tv_sec +
+           (r.ru_utime.tv_usec + r.ru_stime.tv_usec) / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) g_ranges = std::stoi(argv[1]);
+    if (argc > 2) g_producers = std::stoi(argv[2]);
+    if (argc > 3) g_ops = std::stoi(argv[3]);
+
+    RaftServerOptions ops;
+    ops.node_id = 1;
+    ops.consensus_threads_num = 1;
+    ops.apply_threads_num = 1;
+    ops.transport_options.use_inprocess_transport = true;
+    ops.tick_interval = std::chrono::milliseconds(10);
+    ops.election_tick = 2;
+
+    auto rs = CreateRaftServer(ops);
+    auto s = rs->Start();
+    if (!s.ok()) {
+        std::cerr << "start raft server failed: " << s.ToString() << std::endl;
+        return 1;
+    }
+
+    std::vector<std::shared_ptr<Raft>> rafts;
+    std::vector<std::shared_ptr<OrderStateMachine>> sms;
+    for (int i = 1; i <= g_ranges; ++i) {
+        auto sm = std::make_shared<OrderStateMachine>();
+        RaftOptions ro;
+        ro.id = i;
+        ro.statemachine = sm;
+        ro.use_memory_storage = true;
+        Peer p;
+        p.node_id = 1;
+        p.peer_id = 1;
+        ro.peers.push_back(p);
+
+        std::shared_ptr<Raft> r;
+        s = rs->CreateRaft(ro, &r);
+        if (!s.ok()) {
+            std::cerr << "create raft " << i << " failed: " << s.ToString() << std::endl;
+            return 1;
+        }
+        rafts.push_back(r);
+        sms.push_back(sm);
+    }
+    for (auto& r : rafts) {
+        while (!r->IsLeader()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+    auto applied = [&sms] {
+        uint64_t total = 0;
+        for (auto& sm : sms) total += sm->Applied();
+        return total;
+    };
+
+    // 高负载吞吐
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < g_producers; ++p) {
+        threads.emplace_back([&rafts, p] {
+            std::vector<uint64_t> seqs(g_ranges, 0);
+            for (int i = 0; i < g_ops; ++i) {
+                int r = (i + p) % g_ranges;
+                std::string cmd = std::to_string(p) + ":" + std::to_string(++seqs[r]);
+                // 队列满时重试
+                while (!rafts[r]->Submit(cmd).ok()) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    uint64_t expected = static_cast<uint64_t>(g_producers) * g_ops;
+    while (applied() < expected) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    uint64_t disorder = 0;
+    for (auto& sm : sms) disorder += sm->Disorder();
+    std::cout << "throughput: " << static_cast<uint64_t>(expected / secs)
+              << " ops/s, out of order: " << disorder << std::endl;
+
+    // 低负载cpu占用: 单个线程每200us提交一个提案，持续2秒
+    double cpu_begin = cpuSeconds();
+    auto light_begin = std::chrono::steady_clock::now();
+    uint64_t seq = 0;
+    while (std::chrono::steady_clock::now() - light_begin < std::chrono::seconds(2)) {
+        std::string cmd = std::to_string(g_producers) + ":" + std::to_string(++seq);
+        rafts[0]->Submit(cmd);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    std::cout << "light load cpu: " << (cpuSeconds() - cpu_begin) / 2 * 100 << "%"
+              << std::endl;
+
+    rafts.clear();
+    rs->Stop();
+    return disorder == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/util.h"
+#include "raft/src/impl/storage/storage_disk.h"
+
+// 模拟大量range的节点重启，对比打开raft日志时全部加载索引和延迟加载索引的耗时
+//
+// 用法: recover_bench [ranges] [entries_per_range] [threads]
+
+using namespace sharkstore;
+using namespace sharkstore::raft::impl;
+using namespace sharkstore::raft::impl::storage;
+
+static size_t g_ranges = 50000;
+static size_t g_entries = 200;
+static size_t g_threads = 8;
+
+static DiskStorage::Options makeOptions(bool lazy) {
+    DiskStorage::Options ops;
+    ops.log_file_size = 1024 * 4;  // 每个range生成多个日志文件
+    ops.max_log_files = std::numeric_limits<size_t>::max();
+    ops.preallocate_size = 0;
+    ops.recycle_log_files = 0;
+    ops.lazy_load_index = lazy;
+    return ops;
+}
+
+static std::string rangePath(const std::string& root, size_t id) {
+    return JoinFilePath({root, std::to_string(id)});
+}
+
+// 在threads个线程中对[0, g_ranges)执行f，返回耗时
+template <class Func>
+static std::chrono::milliseconds parallelFor(Func f) {
+    auto begin = std::chrono::steady_clock::now();
+    std::atomic<size_t> pos = {0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < g_threads; ++i) {
+        threads.emplace_back([&] {
+            while (true) {
+                auto id = pos.fetch_add(1);
+                if (id >= g_ranges) return;
+                f(id);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - begin);
+}
+
+static void prepare(const std::string& root) {
+    auto took = parallelFor([&](size_t id) {
+        DiskStorage ds(id, rangePath(root, id), makeOptions(true));
+        auto s = ds.Open();
+        if (!s.ok()) {
+            std::cerr << "open range " << id << " failed: " << s.ToString() << std::endl;
+            ::exit(1);
+        }
+        std::vector<EntryPtr> entries;
+        for (uint64_t i = 1; i <= g_entries; ++i) {
+            EntryPtr e(new pb::Entry);
+            e->set_index(i);
+            e->set_term(1);
+            e->set_type(pb::ENTRY_NORMAL);
+            e->set_data(std::string(64, 'a'));
+            e->ByteSizeLong();
+            entries.push_back(e);
+        }
+        s = ds.StoreEntries(entries);
+        if (!s.ok()) {
+            std::cerr << "store range " << id << " failed: " << s.ToString() << std::endl;
+            ::exit(1);
+        }
+        ds.Close();
+    });
+    std::cout << "prepare " << g_ranges << " ranges took " << took.count() << "ms"
+              << std::endl;
+}
+
+static void bench(const std::string& root, bool lazy) {
+    std::atomic<size_t> files = {0};
+    auto took = parallelFor([&](size_t id) {
+        DiskStorage ds(id, rangePath(root, id), makeOptions(lazy));
+        auto s = ds.Open();
+        if (!s.ok()) {
+            std::cerr << "reopen range " << id << " failed: " << s.ToString() << std::endl;
+            ::exit(1);
+        }
+        files += ds.FilesCount();
+        uint64_t last = 0;
+        ds.LastIndex(&last);
+        if (last != g_entries) {
+            std::cerr << "range " << id << " unexpected last index " << last << std::endl;
+            ::exit(1);
+        }
+        ds.Close();
+    });
+    std::cout << (lazy ? "lazy" : "eager") << " open " << g_ranges << " ranges (" << files
+              << " log files) took " << took.count() << "ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) g_ranges = std::stoul(argv[1]);
+    if (argc > 2) g_entries = std::stoul(argv[2]);
+    if (argc > 3) g_threads = std::stoul(argv[3]);
+
+    char path[] = "/tmp/sharkstore_raft_recover_bench_XXXXXX";
+    char* tmp = mkdtemp(path);
+    if (tmp == NULL) {
+        std::cerr << "mkdtemp failed" << std::endl;
+        return 1;
+    }
+    std::string root(tmp);
+
+    prepare(root);
+    // 先跑一遍预热page cache，两种方式读到的是同样的缓存状态
+    bench(root, false);
+    bench(root, false);
+    bench(root, true);
+
+    RemoveDirAll(root.c_str());
+    return 0;
+}
@@ -0,0 +1,440 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "raft/raft.h"
+#include "raft/server.h"
+#include "raft/statemachine.h"
+#include "raft/src/impl/transport/inprocess_transport.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+using namespace sharkstore::raft;
+using sharkstore::raft::impl::transport::InProcessTransport;
+
+// 与server_impl.cpp中的kApplyBatchSize一致
+static const size_t kApplyBatchSize = 64;
+
+// 所有状态机共享的apply事件记录，用来检查全局的apply顺序
+struct ApplyEvent {
+    uint64_t node_id;
+    uint64_t range_id;
+    uint64_t number;  // 快照事件为0
+};
+
+class Recorder {
+public:
+    void Add(const ApplyEvent& e) {
+        std::lock_guard<std::mutex> lock(mu_);
+        events_.push_back(e);
+    }
+
+    std::vector<ApplyEvent> Events() const {
+        std::lock_guard<std::mutex> lock(mu_);
+        return events_;
+    }
+
+private:
+    mutable std::mutex mu_;
+    std::vector<ApplyEvent> events_;
+};
+
+// 要求number连续递增的状态机，关闭闸门后Apply阻塞，用来制造apply积压
+class GateStateMachine : public StateMachine {
+public:
+    GateStateMachine(uint64_t node_id, uint64_t range_id, Recorder* recorder)
+        : node_id_(node_id), range_id_(range_id), recorder_(recorder) {}
+
+    void CloseGate() {
+        std::lock_guard<std::mutex> lock(mu_);
+        gate_open_ = false;
+    }
+
+    void OpenGate() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            gate_open_ = true;
+        }
+        cond_.notify_all();
+    }
+
+    // 等待有Apply阻塞在闸门上
+    bool WaitBlocked(size_t timeout_ms = 5000) {
+        std::unique_lock<std::mutex> lock(mu_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                              [this] { return blocked_; });
+    }
+
+    bool WaitNumber(uint64_t number, size_t timeout_ms = 5000) {
+        std::unique_lock<std::mutex> lock(mu_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                              [this, number] { return number_ == number; });
+    }
+
+    uint64_t Applied() {
+        std::lock_guard<std::mutex> lock(mu_);
+        return applied_;
+    }
+
+    Status Apply(const std::string& cmd, uint64_t index) override {
+        auto num = std::stoull(cmd);
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            blocked_ = !gate_open_;
+            cond_.notify_all();
+            cond_.wait(lock, [this] { return gate_open_; });
+            blocked_ = false;
+
+            if (number_ + 1 != num) {
+                return Status(Status::kCorruption, "discontinuous number",
+                              std::to_string(number_) + "-" + std::to_string(num));
+            }
+            number_ = num;
+            applied_ = index;
+            recorder_->Add(ApplyEvent{node_id_, range_id_, num});
+        }
+        cond_.notify_all();
+        return Status::OK();
+    }
+
+    Status ApplyMemberChange(const ConfChange&, uint64_t) override {
+        return Status::OK();
+    }
+
+    void OnReplicateError(const std::string& cmd, const Status& status) override {}
+
+    void OnLeaderChange(uint64_t leader, uint64_t term) override {}
+
+    std::shared_ptr<raft::Snapshot> GetSnapshot() override {
+        std::lock_guard<std::mutex> lock(mu_);
+        return std::make_shared<Snapshot>(number_, applied_);
+    }
+
+    Status ApplySnapshotStart(const std::string& context) override {
+        recorder_->Add(ApplyEvent{node_id_, range_id_, 0});
+        return Status::OK();
+    }
+
+    Status ApplySnapshotData(const std::vector<std::string>& datas) override {
+        for (const auto& data : datas) {
+            snaping_number_ = std::stoull(data);
+        }
+        return Status::OK();
+    }
+
+    Status ApplySnapshotFinish(uint64_t index) override {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            number_ = snaping_number_;
+            applied_ = index;
+        }
+        cond_.notify_all();
+        return Status::OK();
+    }
+
+private:
+    class Snapshot : public raft::Snapshot {
+    public:
+        Snapshot(uint64_t number, uint64_t applied)
+            : number_(number), applied_(applied) {}
+
+        Status Next(std::string* data, bool* over) override {
+            if (sent_) {
+                *over = true;
+            } else {
+                data->assign(std::to_string(number_));
+                *over = false;
+                sent_ = true;
+            }
+            return Status::OK();
+        }
+
+        Status Context(std::string* c) override { return Status::OK(); }
+        uint64_t ApplyIndex() override { return applied_; }
+        void Close() override {}
+
+    private:
+        const uint64_t number_;
+        const uint64_t applied_;
+        bool sent_ = false;
+    };
+
+private:
+    const uint64_t node_id_ = 0;
+    const uint64_t range_id_ = 0;
+    Recorder* recorder_ = nullptr;
+
+    uint64_t number_ = 0;
+    uint64_t applied_ = 0;
+    uint64_t snaping_number_ = 0;
+    bool gate_open_ = true;
+    bool blocked_ = false;
+    std::mutex mu_;
+    std::condition_variable cond_;
+};
+
+// 异步apply（apply_in_place=false）的进程内集群
+class ApplySchedulerTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        for (uint64_t i = 1; i <= servers_.size(); ++i) {
+            InProcessTransport::Isolate(i, false);
+        }
+        // 断言失败时可能还有apply阻塞在闸门上
+        for (auto& kv : sms_) {
+            kv.second->OpenGate();
+        }
+        rafts_.clear();
+        for (auto& rs : servers_) {
+            rs->Stop();
+        }
+    }
+
+    void startServers(uint64_t node_num, uint8_t apply_threads,
+                      size_t apply_queue_capacity = 100000) {
+        for (uint64_t i = 1; i <= node_num; ++i) {
+            RaftServerOptions ops;
+            ops.node_id = i;
+            ops.tick_interval = std::chrono::milliseconds(50);
+            ops.election_tick = 5;
+            ops.apply_in_place = false;
+            ops.apply_threads_num = apply_threads;
+            ops.apply_queue_capacity = apply_queue_capacity;
+            ops.transport_options.use_inprocess_transport = true;
+            auto rs = CreateRaftServer(ops);
+            ASSERT_TRUE(rs->Start().ok());
+            servers_.push_back(std::move(rs));
+        }
+    }
+
+    // 在所有节点上创建range
+    void createRange(uint64_t range_id) {
+        std::vector<Peer> peers;
+        for (uint64_t i = 1; i <= servers_.size(); ++i) {
+            Peer p;
+            p.node_id = i;
+            p.peer_id = i;
+            peers.push_back(p);
+        }
+        for (uint64_t i = 1; i <= servers_.size(); ++i) {
+            auto sm = std::make_shared<GateStateMachine>(i, range_id, &recorder_);
+            RaftOptions rops;
+            rops.id = range_id;
+            rops.statemachine = sm;
+            rops.use_memory_storage = true;
+            rops.peers = peers;
+            std::shared_ptr<Raft> r;
+            ASSERT_TRUE(servers_[i - 1]->CreateRaft(rops, &r).ok());
+            rafts_[{i, range_id}] = r;
+            sms_[{i, range_id}] = sm;
+        }
+    }
+
+    uint64_t waitLeader(uint64_t range_id) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            for (uint64_t i = 1; i <= servers_.size(); ++i) {
+                if (raft(i, range_id).IsLeader()) return i;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return 0;
+    }
+
+    // 等待节点上已提交的日志都进入了apply队列
+    bool waitPending(uint64_t node_id, uint64_t range_id, uint64_t pending) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            RaftStatus status;
+            raft(node_id, range_id).GetStatus(&status);
+            if (status.apply_pending >= pending) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+    Raft& raft(uint64_t node_id, uint64_t range_id) {
+        return *rafts_[{node_id, range_id}];
+    }
+
+    GateStateMachine& sm(uint64_t node_id, uint64_t range_id) {
+        return *sms_[{node_id, range_id}];
+    }
+
+    Status submit(uint64_t node_id, uint64_t range_id, uint64_t number) {
+        std::string cmd = std::to_string(number);
+        return raft(node_id, range_id).Submit(cmd);
+    }
+
+protected:
+    Recorder recorder_;
+    std::vector<std::unique_ptr<RaftServer>> servers_;
+    std::map<std::pair<uint64_t, uint64_t>, std::shared_ptr<Raft>> rafts_;
+    std::map<std::pair<uint64_t, uint64_t>, std::shared_ptr<GateStateMachine>> sms_;
+};
+
+TEST_F(ApplySchedulerTest, PerRangeOrder) {
+    const uint64_t kRangeNum = 8;
+    const uint64_t kCount = 1000;
+    startServers(1, 4);
+    for (uint64_t r = 1; r <= kRangeNum; ++r) {
+        createRange(r);
+        ASSERT_EQ(waitLeader(r), 1U);
+    }
+
+    // range1阻塞在apply上，不影响其他range
+    sm(1, 1).CloseGate();
+    for (uint64_t n = 1; n <= kCount; ++n) {
+        for (uint64_t r = 1; r <= kRangeNum; ++r) {
+            ASSERT_TRUE(submit(1, r, n).ok());
+        }
+    }
+    for (uint64_t r = 2; r <= kRangeNum; ++r) {
+        ASSERT_TRUE(sm(1, r).WaitNumber(kCount));
+    }
+    ASSERT_TRUE(sm(1, 1).WaitBlocked());
+
+    sm(1, 1).OpenGate();
+    ASSERT_TRUE(sm(1, 1).WaitNumber(kCount));
+
+    // 每个range内按提交顺序apply
+    std::map<uint64_t, uint64_t> last;
+    for (const auto& e : recorder_.Events()) {
+        ASSERT_EQ(e.number, last[e.range_id] + 1) << "range " << e.range_id;
+        last[e.range_id] = e.number;
+    }
+    ASSERT_EQ(last.size(), kRangeNum);
+}
+
+TEST_F(ApplySchedulerTest, YieldAfterBatch) {
+    startServers(1, 1);
+    createRange(1);
+    createRange(2);
+    ASSERT_EQ(waitLeader(1), 1U);
+    ASSERT_EQ(waitLeader(2), 1U);
+
+    // 唯一的apply线程阻塞在range1的第一条上，之后的都积压在队列中
+    sm(1, 1).CloseGate();
+    ASSERT_TRUE(submit(1, 1, 1).ok());
+    ASSERT_TRUE(sm(1, 1).WaitBlocked());
+    const uint64_t kCount = kApplyBatchSize * 3;
+    for (uint64_t n = 2; n <= kCount; ++n) {
+        ASSERT_TRUE(submit(1, 1, n).ok());
+    }
+    ASSERT_TRUE(waitPending(1, 1, kCount));
+
+    // range2排到range1后面
+    ASSERT_TRUE(submit(1, 2, 1).ok());
+    ASSERT_TRUE(waitPending(1, 2, 1));
+
+    sm(1, 1).OpenGate();
+    ASSERT_TRUE(sm(1, 1).WaitNumber(kCount));
+    ASSERT_TRUE(sm(1, 2).WaitNumber(1));
+
+    // range1处理完一批后让出线程，range2不用等range1全部apply完
+    auto events = recorder_.Events();
+    size_t pos = 0;
+    while (pos < events.size() && events[pos].range_id != 2) {
+        ++pos;
+    }
+    ASSERT_EQ(pos, kApplyBatchSize);
+}
+
+TEST_F(ApplySchedulerTest, SnapshotAfterPending) {
+    startServers(3, 1);
+    createRange(1);
+    auto leader = waitLeader(1);
+    ASSERT_NE(leader, 0U);
+    auto follower = leader % 3 + 1;
+
+    uint64_t number = 0;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(submit(leader, 1, ++number).ok());
+    }
+    for (uint64_t i = 1; i <= 3; ++i) {
+        ASSERT_TRUE(sm(i, 1).WaitNumber(number));
+    }
+
+    // follower上已提交的日志积压在apply队列中
+    sm(follower, 1).CloseGate();
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(submit(leader, 1, ++number).ok());
+    }
+    ASSERT_TRUE(sm(follower, 1).WaitBlocked());
+    ASSERT_TRUE(waitPending(follower, 1, 50));
+    auto pending_end = number;
+
+    // 隔离follower期间leader截断日志，恢复后follower只能通过快照追上
+    InProcessTransport::Isolate(follower, true);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(submit(leader, 1, ++number).ok());
+    }
+    ASSERT_TRUE(sm(leader, 1).WaitNumber(number));
+    raft(leader, 1).Truncate(sm(leader, 1).Applied());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    InProcessTransport::Isolate(follower, false);
+
+    // 快照排在积压的日志后面，闸门打开前不能开始应用
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    for (const auto& e : recorder_.Events()) {
+        ASSERT_FALSE(e.node_id == follower && e.number == 0);
+    }
+
+    sm(follower, 1).OpenGate();
+    ASSERT_TRUE(sm(follower, 1).WaitNumber(number, 15000));
+
+    // follower先按序apply完积压的日志，再应用快照
+    uint64_t last = 0;
+    bool snapshot = false;
+    for (const auto& e : recorder_.Events()) {
+        if (e.node_id != follower) continue;
+        if (e.number == 0) {
+            ASSERT_EQ(last, pending_end);
+            snapshot = true;
+        } else {
+            ASSERT_FALSE(snapshot);
+            ASSERT_EQ(e.number, last + 1);
+            last = e.number;
+        }
+    }
+    ASSERT_TRUE(snapshot);
+}
+
+TEST_F(ApplySchedulerTest, BusyAtCapacity) {
+    const size_t kCapacity = 100;
+    startServers(1, 1, kCapacity);
+    createRange(1);
+    ASSERT_EQ(waitLeader(1), 1U);
+
+    sm(1, 1).CloseGate();
+    uint64_t number = 1;
+    ASSERT_TRUE(submit(1, 1, number).ok());
+    ASSERT_TRUE(sm(1, 1).WaitBlocked());
+
+    // 积压到上限后新的提案直接返回Busy
+    Status s;
+    for (size_t i = 0; i < kCapacity * 10; ++i) {
+        s = submit(1, 1, number + 1);
+        if (!s.ok()) break;
+        ++number;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(s.code(), Status::kBusy) << s.ToString();
+    ASSERT_GE(number, kCapacity);
+
+    // apply追上后恢复接受提案
+    sm(1, 1).OpenGate();
+    ASSERT_TRUE(sm(1, 1).WaitNumber(number));
+    ASSERT_TRUE(submit(1, 1, ++number).ok());
+    ASSERT_TRUE(sm(1, 1).WaitNumber(number));
+}
+
+}  // namespace
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "base/util.h"
+#include "raft/src/impl/transport/compression.h"
+#include "test_util.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+using namespace sharkstore::raft;
+using namespace sharkstore::raft::impl;
+using namespace sharkstore::raft::impl::transport;
+
+TEST(Compression, Disabled) {
+    CompressStats stats;
+    Compressor c(CompressionType::kNone, 0, &stats);
+    ASSERT_FALSE(c.ShouldCompress(1024 * 1024));
+
+    std::string data = randomString(1000);
+    const char* out = nullptr;
+    size_t out_len = 0;
+    ASSERT_TRUE(DecompressFrame(0, data.data(), data.size(), &out, &out_len, &stats));
+    ASSERT_EQ(out, data.data());
+    ASSERT_EQ(out_len, data.size());
+}
+
+#ifdef USE_ZSTD
+TEST(Compression, Zstd) {
+    CompressStats stats;
+    Compressor c(CompressionType::kZstd, 100, &stats);
+    ASSERT_FALSE(c.ShouldCompress(99));
+    ASSERT_TRUE(c.ShouldCompress(100));
+
+    std::string data;
+    for (int i = 0; i < 100; ++i) {
+        data += "{\"key\": \"" + std::to_string(i) + "\", \"value\": \"sharkstore\"}";
+    }
+    std::vector<char> buf(c.Bound(data.size()));
+    char flags = 0;
+    size_t clen = c.Compress(data.data(), data.size(), buf.data(), buf.size(), &flags);
+    ASSERT_GT(clen, 0U);
+    ASSERT_LT(clen, data.size());
+    ASSERT_TRUE((flags & kFrameFlagZstd) != 0);
+    ASSERT_EQ(stats.raw_bytes, data.size());
+    ASSERT_EQ(stats.compressed_bytes, clen);
+
+    const char* out = nullptr;
+    size_t out_len = 0;
+    ASSERT_TRUE(DecompressFrame(flags, buf.data(), clen, &out, &out_len, &stats));
+    ASSERT_EQ(std::string(out, out_len), data);
+
+    // 损坏的数据
+    buf[clen / 2] ^= 0xff;
+    ASSERT_FALSE(DecompressFrame(flags, buf.data(), clen / 2, &out, &out_len, &stats));
+
+    ServerStatus status;
+    stats.Fill(&status);
+    ASSERT_EQ(status.compress_raw_bytes, data.size());
+    ASSERT_EQ(status.compress_out_bytes, clen);
+}
+
+TEST(Compression, Incompressible) {
+    CompressStats stats;
+    Compressor c(CompressionType::kZstd, 100, &stats);
+
+    // 压缩后没有变小，按原始数据发送，但同样计入统计
+    std::mt19937 rng(1);
+    std::string data;
+    for (int i = 0; i < 4096; ++i) {
+        data.push_back(static_cast<char>(rng()));
+    }
+    std::vector<char> buf(c.Bound(data.size()));
+    char flags = 0;
+    ASSERT_EQ(c.Compress(data.data(), data.size(), buf.data(), buf.size(), &flags), 0U);
+    ASSERT_EQ(flags, 0);
+    ASSERT_EQ(stats.raw_bytes, data.size());
+    ASSERT_EQ(stats.compressed_bytes, data.size());
+}
+#endif
+
+TEST(Compression, PeerCapabilities) {
+    PeerCapabilities peers;
+    // 没有通告过的节点
+    ASSERT_FALSE(peers.SupportsCompression(1, CompressionType::kZstd));
+    ASSERT_FALSE(peers.SupportsFeature(1, kFeatureBatchFrame));
+
+    peers.Set(1, LocalCompressions(), LocalFeatures());
+#ifdef USE_ZSTD
+    ASSERT_TRUE(peers.SupportsCompression(1, CompressionType::kZstd));
+#else
+    ASSERT_FALSE(peers.SupportsCompression(1, CompressionType::kZstd));
+#endif
+    ASSERT_TRUE(peers.SupportsFeature(1, kFeatureBatchFrame));
+    ASSERT_FALSE(peers.SupportsCompression(2, CompressionType::kZstd));
+    ASSERT_FALSE(peers.SupportsFeature(2, kFeatureBatchFrame));
+
+    // 对方降级到不支持的版本
+    peers.Set(1, 0, 0);
+    ASSERT_FALSE(peers.SupportsCompression(1, CompressionType::kZstd));
+    ASSERT_FALSE(peers.SupportsFeature(1, kFeatureBatchFrame));
+}
+
+} /* namespace  */
@@ -301,6 +301,61 @@ TEST_F(StorageTest, KeepCount) {
     ASSERT_TRUE(s.ok()) << s.ToString();
 }
 
+TEST_F(StorageTest, Recycle) {
+    ops_.recycle_log_files = 2;
+    LimitMaxLogs(3);
+
+    uint64_t lo = 1, hi = 100;
+    std::vector<EntryPtr> to_writes;
+    RandomEntries(lo, hi, 256, &to_writes);
+    auto s = storage_->StoreEntries(to_writes);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    storage_->AppliedTo(99);
+
+    // 触发旧日志文件删除，删除的文件进入回收池，数量有上限
+    for (uint64_t i = 100; i < 200; ++i) {
+        s = storage_->StoreEntries(std::vector<EntryPtr>{RandomEntry(i, 256)});
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        storage_->AppliedTo(i);
+        ASSERT_LE(storage_->FreeFilesCount(), 2);
+    }
+    auto free_count = storage_->FreeFilesCount();
+    ASSERT_GT(free_count, 0);
+
+    uint64_t first = 0;
+    s = storage_->FirstIndex(&first);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    std::vector<EntryPtr> ents;
+    bool compacted = false;
+    s = storage_->Entries(first, 200, std::numeric_limits<uint64_t>::max(), &ents,
+                          &compacted);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_FALSE(compacted);
+
+    // 重启后回收池中的文件仍然可用，且不影响已有日志
+    ReOpen();
+    ASSERT_EQ(storage_->FreeFilesCount(), free_count);
+    std::vector<EntryPtr> ents2;
+    s = storage_->Entries(first, 200, std::numeric_limits<uint64_t>::max(), &ents2,
+                          &compacted);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_FALSE(compacted);
+    s = Equal(ents, ents2);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+
+    // 截断后重新写入，复用回收的文件
+    storage_->AppliedTo(199);
+    s = storage_->Truncate(199);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    s = storage_->StoreEntries(std::vector<EntryPtr>{RandomEntry(200, 256)});
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_LE(storage_->FreeFilesCount(), 2);
+    uint64_t last = 0;
+    s = storage_->LastIndex(&last);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(last, 200);
+}
+
 TEST_F(StorageTest, Destroy) {
     uint64_t lo = 1, hi = 100;
     std::vector<EntryPtr> to_writes;
@@ -0,0 +1,379 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "raft/raft.h"
+#include "raft/server.h"
+#include "raft/statemachine.h"
+#include "raft/src/impl/transport/inprocess_transport.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+using namespace sharkstore::raft;
+using sharkstore::raft::impl::transport::InProcessTransport;
+using Clock = std::chrono::steady_clock;
+
+static const uint64_t kNodeNum = 3;
+static const uint64_t kGroupNum = 8;
+static const unsigned kElectionTick = 5;
+static const std::chrono::milliseconds kTickInterval(50);
+static const auto kElectionTimeout = kTickInterval * kElectionTick;
+
+// 记录已应用的命令
+class ProbeStateMachine : public StateMachine {
+public:
+    bool WaitApplied(const std::string& cmd, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mu_);
+        return cond_.wait_for(lock, timeout, [&] { return applied_.count(cmd) > 0; });
+    }
+
+    Status Apply(const std::string& cmd, uint64_t index) override {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            applied_.insert(cmd);
+        }
+        cond_.notify_all();
+        return Status::OK();
+    }
+
+    Status ApplyMemberChange(const ConfChange&, uint64_t) override { return Status::OK(); }
+    void OnReplicateError(const std::string&, const Status&) override {}
+    void OnLeaderChange(uint64_t, uint64_t) override {}
+    std::shared_ptr<Snapshot> GetSnapshot() override { return nullptr; }
+    Status ApplySnapshotStart(const std::string&) override { return Status::OK(); }
+    Status ApplySnapshotData(const std::vector<std::string>&) override { return Status::OK(); }
+    Status ApplySnapshotFinish(uint64_t) override { return Status::OK(); }
+
+private:
+    std::set<std::string> applied_;
+    std::mutex mu_;
+    std::condition_variable cond_;
+};
+
+// 三个节点上的多个raft组，心跳按节点合并，一个节点故障会同时影响所有组
+class ElectionFaultTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::vector<Peer> peers;
+        for (uint64_t i = 1; i <= kNodeNum; ++i) {
+            Peer p;
+            p.node_id = i;
+            p.peer_id = i;
+            peers.push_back(p);
+        }
+
+        for (uint64_t i = 1; i <= kNodeNum; ++i) {
+            RaftServerOptions ops;
+            ops.node_id = i;
+            ops.tick_interval = kTickInterval;
+            ops.election_tick = kElectionTick;
+            ops.transport_options.use_inprocess_transport = true;
+            auto rs = CreateRaftServer(ops);
+            ASSERT_TRUE(rs->Start().ok());
+
+            std::vector<std::shared_ptr<Raft>> rafts;
+            std::vector<std::shared_ptr<ProbeStateMachine>> sms;
+            for (uint64_t g = 1; g <= kGroupNum; ++g) {
+                auto sm = std::make_shared<ProbeStateMachine>();
+                RaftOptions rops;
+                rops.id = g;
+                rops.statemachine = sm;
+                rops.use_memory_storage = true;
+                rops.peers = peers;
+                std::shared_ptr<Raft> r;
+                ASSERT_TRUE(rs->CreateRaft(rops, &r).ok());
+                rafts.push_back(r);
+                sms.push_back(sm);
+            }
+
+            servers_.push_back(std::move(rs));
+            rafts_.push_back(rafts);
+            sms_.push_back(sms);
+        }
+    }
+
+    void TearDown() override {
+        for (uint64_t i = 1; i <= kNodeNum; ++i) {
+            InProcessTransport::Isolate(i, false);
+            for (uint64_t j = i + 1; j <= kNodeNum; ++j) {
+                InProcessTransport::Partition(i, j, false);
+            }
+        }
+        rafts_.clear();
+        for (auto& rs : servers_) {
+            rs->Stop();
+        }
+    }
+
+    Raft& raft(uint64_t node_id, uint64_t group) { return *rafts_[node_id - 1][group - 1]; }
+
+    // 参与判断的节点一致认可的leader，没有时返回0
+    uint64_t leaderOf(uint64_t group, uint64_t* term = nullptr) {
+        uint64_t leader = 0, leader_term = 0;
+        for (uint64_t i = 1; i <= kNodeNum; ++i) {
+            if (ignored_.count(i) > 0) continue;
+            uint64_t l = 0, t = 0;
+            raft(i, group).GetLeaderTerm(&l, &t);
+            if (l == 0 || (leader != 0 && (l != leader || t != leader_term))) {
+                return 0;
+            }
+            leader = l;
+            leader_term = t;
+        }
+        if (leader == 0 || ignored_.count(leader) > 0 || !raft(leader, group).IsLeader()) {
+            return 0;
+        }
+        if (term != nullptr) *term = leader_term;
+        return leader;
+    }
+
+    bool waitLeaders(std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        auto deadline = Clock::now() + timeout;
+        while (Clock::now() < deadline) {
+            bool ok = true;
+            for (uint64_t g = 1; g <= kGroupNum && ok; ++g) {
+                ok = leaderOf(g) != 0;
+            }
+            if (ok) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    }
+
+    // 通过当前leader写入一条命令并等待应用
+    bool write(uint64_t group) {
+        auto leader = leaderOf(group);
+        if (leader == 0) return false;
+        auto id = std::to_string(++seq_);
+        // Submit会取走cmd的内容
+        auto cmd = id;
+        if (!raft(leader, group).Submit(cmd).ok()) return false;
+        return sms_[leader - 1][group - 1]->WaitApplied(id, std::chrono::milliseconds(100));
+    }
+
+    // 恢复的节点在追上之前仍然不参与判断leader
+    void isolate(uint64_t node_id, bool isolated) {
+        InProcessTransport::Isolate(node_id, isolated);
+        if (isolated) {
+            ignored_.insert(node_id);
+        }
+    }
+
+    // 等待恢复的节点认可所有组现在的leader
+    void waitRejoin(uint64_t node_id, const std::vector<uint64_t>& leaders,
+                    const std::vector<uint64_t>& terms) {
+        auto deadline = Clock::now() + std::chrono::seconds(5);
+        for (uint64_t g = 1; g <= kGroupNum; ++g) {
+            uint64_t l = 0, t = 0;
+            while (Clock::now() < deadline) {
+                raft(node_id, g).GetLeaderTerm(&l, &t);
+                if (l == leaders[g] && t == terms[g]) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            ASSERT_EQ(l, leaders[g]) << "group " << g;
+            ASSERT_EQ(t, terms[g]) << "group " << g;
+        }
+        ignored_.erase(node_id);
+    }
+
+    void moveLeadersTo(uint64_t node_id) {
+        for (uint64_t g = 1; g <= kGroupNum; ++g) {
+            auto leader = leaderOf(g);
+            ASSERT_NE(leader, 0U);
+            if (leader != node_id) {
+                ASSERT_TRUE(raft(leader, g).TransferLeader(node_id).ok());
+            }
+        }
+        auto deadline = Clock::now() + std::chrono::seconds(5);
+        for (uint64_t g = 1; g <= kGroupNum; ++g) {
+            while (leaderOf(g) != node_id && Clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            ASSERT_EQ(leaderOf(g), node_id);
+        }
+    }
+
+    void snapshotTerms(std::vector<uint64_t>* leaders, std::vector<uint64_t>* terms) {
+        leaders->assign(kGroupNum + 1, 0);
+        terms->assign(kGroupNum + 1, 0);
+        for (uint64_t g = 1; g <= kGroupNum; ++g) {
+            (*leaders)[g] = leaderOf(g, &(*terms)[g]);
+        }
+    }
+
+protected:
+    std::vector<std::unique_ptr<RaftServer>> servers_;
+    std::vector<std::vector<std::shared_ptr<Raft>>> rafts_;
+    std::vector<std::vector<std::shared_ptr<ProbeStateMachine>>> sms_;
+    std::set<uint64_t> ignored_;
+    uint64_t seq_ = 0;
+};
+
+// follower暂停后恢复，不论期间有没有写入，都不能打断现有的leader
+TEST_F(ElectionFaultTest, FollowerRejoin) {
+    ASSERT_TRUE(waitLeaders());
+    moveLeadersTo(2);
+
+    std::vector<uint64_t> leaders, terms;
+    snapshotTerms(&leaders, &terms);
+
+    isolate(1, true);
+    auto deadline = Clock::now() + kElectionTimeout * 6;
+    while (Clock::now() < deadline) {
+        // 一半的组有写入，隔离节点的日志落后；另一半空闲，日志一样新
+        for (uint64_t g = 2; g <= kGroupNum; g += 2) {
+            ASSERT_TRUE(write(g));
+        }
+        std::this_thread::sleep_for(kTickInterval);
+    }
+    // 预选举不提升term
+    for (uint64_t g = 1; g <= kGroupNum; ++g) {
+        uint64_t l = 0, t = 0;
+        raft(1, g).GetLeaderTerm(&l, &t);
+        ASSERT_EQ(t, terms[g]);
+    }
+
+    isolate(1, false);
+    deadline = Clock::now() + kElectionTimeout * 6;
+    while (Clock::now() < deadline) {
+        for (uint64_t g = 1; g <= kGroupNum; ++g) {
+            uint64_t term = 0;
+            ASSERT_EQ(leaderOf(g, &term), leaders[g]) << "group " << g;
+            ASSERT_EQ(term, terms[g]) << "group " << g;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    for (uint64_t g = 1; g <= kGroupNum; ++g) {
+        ASSERT_TRUE(write(g));
+    }
+    waitRejoin(1, leaders, terms);
+}
+
+// 节点1只和leader断开，仍然能联系到节点3：节点3在租约内不响应节点1的预投票，
+// 节点1不会提升term，也就不会通过节点3打断leader
+TEST_F(ElectionFaultTest, PartialPartition) {
+    ASSERT_TRUE(waitLeaders());
+    moveLeadersTo(2);
+
+    std::vector<uint64_t> leaders, terms;
+    snapshotTerms(&leaders, &terms);
+
+    InProcessTransport::Partition(1, 2, true);
+    ignored_.insert(1);
+    auto deadline = Clock::now() + kElectionTimeout * 6;
+    while (Clock::now() < deadline) {
+        for (uint64_t g = 1; g <= kGroupNum; ++g) {
+            uint64_t term = 0;
+            ASSERT_EQ(leaderOf(g, &term), leaders[g]) << "group " << g;
+            ASSERT_EQ(term, terms[g]) << "group " << g;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    for (uint64_t g = 1; g <= kGroupNum; ++g) {
+        uint64_t l = 0, t = 0;
+        raft(1, g).GetLeaderTerm(&l, &t);
+        ASSERT_EQ(t, terms[g]);
+        ASSERT_TRUE(write(g));
+    }
+
+    InProcessTransport::Partition(1, 2, false);
+    waitRejoin(1, leaders, terms);
+}
+
+// 所有组的leader所在节点暂停，统计各组的写入不可用时间，以及节点恢复后是否再次中断
+TEST_F(ElectionFaultTest, LeaderPause) {
+    ASSERT_TRUE(waitLeaders());
+    moveLeadersTo(1);
+    for (uint64_t g = 1; g <= kGroupNum; ++g) {
+        ASSERT_TRUE(write(g));
+    }
+
+    auto start = Clock::now();
+    isolate(1, true);
+    std::vector<std::chrono::milliseconds> unavailable(kGroupNum + 1);
+    std::set<uint64_t> pending;
+    for (uint64_t g = 1; g <= kGroupNum; ++g) {
+        pending.insert(g);
+    }
+    auto deadline = start + std::chrono::seconds(5);
+    while (!pending.empty() && Clock::now() < deadline) {
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (write(*it)) {
+                unavailable[*it] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    Clock::now() - start);
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(pending.empty());
+
+    // 新leader分散在剩下的两个节点上
+    std::map<uint64_t, int> leader_count;
+    std::vector<uint64_t> leaders, terms;
+    snapshotTerms(&leaders, &terms);
+    std::chrono::milliseconds max_unavailable(0), total(0);
+    for (uint64_t g = 1; g <= kGroupNum; ++g) {
+        ++leader_count[leaders[g]];
+        max_unavailable = std::max(max_unavailable, unavailable[g]);
+        total += unavailable[g];
+        // 最长选举超时加上预选举和选举的往返
+        ASSERT_LT(unavailable[g], kElectionTimeout * 4) << "group " << g;
+    }
+    ASSERT_EQ(leader_count.count(1), 0U);
+    ASSERT_EQ(leader_count.size(), 2U);
+
+    // 被隔离的leader一个选举周期内联系不上大多数副本，自己退位
+    deadline = start + kElectionTimeout * 3;
+    bool stepped_down = false;
+    while (!stepped_down && Clock::now() < deadline) {
+        stepped_down = true;
+        for (uint64_t g = 1; g <= kGroupNum; ++g) {
+            stepped_down = stepped_down && !raft(1, g).IsLeader();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(stepped_down);
+
+    // 恢复后持续写入，leader和term都不变
+    isolate(1, false);
+    auto resume = Clock::now();
+    std::chrono::milliseconds max_gap(0);
+    std::vector<Clock::time_point> last_write(kGroupNum + 1, resume);
+    while (Clock::now() - resume < kElectionTimeout * 6) {
+        for (uint64_t g = 1; g <= kGroupNum; ++g) {
+            uint64_t term = 0;
+            ASSERT_EQ(leaderOf(g, &term), leaders[g]) << "group " << g;
+            ASSERT_EQ(term, terms[g]) << "group " << g;
+            if (write(g)) {
+                auto now = Clock::now();
+                max_gap = std::max(max_gap, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                now - last_write[g]));
+                last_write[g] = now;
+            }
+        }
+    }
+
+    std::cout << "leader pause: max unavailable " << max_unavailable.count() << " ms, avg "
+              << total.count() / kGroupNum << " ms, new leaders";
+    for (const auto& kv : leader_count) {
+        std::cout << " node" << kv.first << "=" << kv.second;
+    }
+    std::cout << "; after resume max write gap " << max_gap.count() << " ms" << std::endl;
+    ASSERT_LT(max_gap, kElectionTimeout);
+    waitRejoin(1, leaders, terms);
+}
+
+}  // namespace
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "raft/raft.h"
+#include "raft/server.h"
+#include "raft/src/impl/transport/inprocess_transport.h"
+#include "raft/test/number_statemachine.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+using namespace sharkstore::raft;
+using sharkstore::raft::impl::transport::InProcessTransport;
+
+static const uint64_t kNodeNum = 3;
+
+// 进程内传输的三节点集群
+class LeaderTransferTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::vector<Peer> peers;
+        for (uint64_t i = 1; i <= kNodeNum; ++i) {
+            Peer p;
+            p.node_id = i;
+            p.peer_id = i;
+            peers.push_back(p);
+        }
+
+        for (uint64_t i = 1; i <= kNodeNum; ++i) {
+            RaftServerOptions ops;
+            ops.node_id = i;
+            ops.tick_interval = std::chrono::milliseconds(50);
+            ops.election_tick = 5;
+            ops.transport_options.use_inprocess_transport = true;
+            auto rs = CreateRaftServer(ops);
+            ASSERT_TRUE(rs->Start().ok());
+
+            auto sm = std::make_shared<raft::test::NumberStateMachine>(i);
+            RaftOptions rops;
+            rops.id = 1;
+            rops.statemachine = sm;
+            rops.use_memory_storage = true;
+            rops.peers = peers;
+            std::shared_ptr<Raft> r;
+            ASSERT_TRUE(rs->CreateRaft(rops, &r).ok());
+
+            servers_.push_back(std::move(rs));
+            rafts_.push_back(r);
+            sms_.push_back(sm);
+        }
+    }
+
+    void TearDown() override {
+        for (uint64_t i = 1; i <= kNodeNum; ++i) {
+            for (uint64_t j = i + 1; j <= kNodeNum; ++j) {
+                InProcessTransport::Partition(i, j, false);
+            }
+        }
+        rafts_.clear();
+        for (auto& rs : servers_) {
+            rs->Stop();
+        }
+    }
+
+    // 等待所有节点看到同一个leader，expect不为0时等待leader变为expect
+    uint64_t waitLeader(uint64_t expect = 0) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            uint64_t leader = 0, term = 0;
+            rafts_[0]->GetLeaderTerm(&leader, &term);
+            bool agreed = leader != 0 && (expect == 0 || leader == expect);
+            for (const auto& r : rafts_) {
+                uint64_t l = 0, t = 0;
+                r->GetLeaderTerm(&l, &t);
+                agreed = agreed && l == leader;
+            }
+            if (agreed && rafts_[leader - 1]->IsLeader()) {
+                return leader;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return 0;
+    }
+
+    Raft& raft(uint64_t node_id) { return *rafts_[node_id - 1]; }
+
+    uint64_t term(uint64_t node_id) {
+        uint64_t leader = 0, term = 0;
+        raft(node_id).GetLeaderTerm(&leader, &term);
+        return term;
+    }
+
+protected:
+    std::vector<std::unique_ptr<RaftServer>> servers_;
+    std::vector<std::shared_ptr<Raft>> rafts_;
+    std::vector<std::shared_ptr<raft::test::NumberStateMachine>> sms_;
+};
+
+TEST_F(LeaderTransferTest, Transfer) {
+    auto leader = waitLeader();
+    ASSERT_NE(leader, 0U);
+
+    uint64_t number = 0;
+    for (int round = 0; round < 4; ++round) {
+        // 转移前的日志需要先复制到目标
+        for (int i = 0; i < 100; ++i) {
+            std::string cmd = std::to_string(++number);
+            ASSERT_TRUE(raft(leader).Submit(cmd).ok());
+        }
+        auto to = leader % kNodeNum + 1;
+        auto old_term = term(leader);
+        ASSERT_FALSE(raft(to).TransferLeader(leader).ok());
+        ASSERT_TRUE(raft(leader).TransferLeader(to).ok());
+
+        // 目标直接发起选举，只经过一个term
+        ASSERT_EQ(waitLeader(to), to);
+        ASSERT_EQ(term(to), old_term + 1);
+        leader = to;
+    }
+
+    std::string cmd = std::to_string(++number);
+    ASSERT_TRUE(raft(leader).Submit(cmd).ok());
+    for (const auto& sm : sms_) {
+        ASSERT_TRUE(sm->WaitNumber(number).ok());
+    }
+}
+
+TEST_F(LeaderTransferTest, NotReplica) {
+    auto leader = waitLeader();
+    ASSERT_NE(leader, 0U);
+
+    ASSERT_TRUE(raft(leader).TransferLeader(kNodeNum + 1).ok());
+    ASSERT_TRUE(raft(leader).TransferLeader(leader).ok());
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    ASSERT_EQ(waitLeader(), leader);
+
+    // 不影响之后的提案
+    std::string cmd = "1";
+    ASSERT_TRUE(raft(leader).Submit(cmd).ok());
+    for (const auto& sm : sms_) {
+        ASSERT_TRUE(sm->WaitNumber(1).ok());
+    }
+}
+
+TEST_F(LeaderTransferTest, BusyWhileTransferring) {
+    auto leader = waitLeader();
+    ASSERT_NE(leader, 0U);
+    auto to = leader % kNodeNum + 1;
+
+    // 目标收不到TimeoutNow，转移一直挂起直到超时
+    InProcessTransport::Partition(leader, to, true);
+    ASSERT_TRUE(raft(leader).TransferLeader(to).ok());
+
+    // 转移期间fsm会丢弃提案，Submit需要直接返回错误而不是让请求挂起
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::string cmd = "1";
+    ASSERT_EQ(raft(leader).Submit(cmd).code(), Status::kBusy);
+
+    // 一个选举周期后放弃转移，恢复接受提案
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    InProcessTransport::Partition(leader, to, false);
+    ASSERT_EQ(waitLeader(), leader);
+    ASSERT_TRUE(raft(leader).Submit(cmd).ok());
+    for (const auto& sm : sms_) {
+        ASSERT_TRUE(sm->WaitNumber(1).ok());
+    }
+}
+
+TEST_F(LeaderTransferTest, NodeLoad) {
+    auto leader = waitLeader();
+    ASSERT_NE(leader, 0U);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    // leader从心跳回应中得到follower的负载，follower从心跳请求中得到leader的
+    for (uint64_t i = 1; i <= kNodeNum; ++i) {
+        std::map<uint64_t, NodeLoad> loads;
+        servers_[i - 1]->GetNodeLoads(&loads);
+        if (i == leader) {
+            ASSERT_EQ(loads.size(), kNodeNum - 1);
+        } else {
+            ASSERT_EQ(loads.size(), 1U);
+        }
+        for (const auto& kv : loads) {
+            ASSERT_NE(kv.first, i);
+            ASSERT_EQ(kv.second.raft_count, 1U);
+            ASSERT_EQ(kv.second.leader_count, kv.first == leader ? 1U : 0U);
+        }
+    }
+}
+
+}  // namespace
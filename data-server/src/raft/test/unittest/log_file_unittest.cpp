@@ -1,4 +1,6 @@
+#include <fcntl.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
 #include "base/util.h"
 #include "raft/src/impl/storage/log_file.h"
@@ -37,7 +39,8 @@ protected:
             delete log_file_;
         }
         if (!tmp_dir_.empty()) {
-            std::remove(tmp_dir_.c_str());
+            // 可能还有损坏时留下的备份文件
+            sharkstore::RemoveDirAll(tmp_dir_.c_str());
         }
     }
 
@@ -50,11 +53,38 @@ protected:
         ASSERT_TRUE(s.ok()) << s.ToString();
     }
 
+    // 直接改写日志文件的内容，模拟磁盘上的损坏
+    void OverWrite(const std::string& path, off_t offset, const std::string& data) {
+        int fd = ::open(path.c_str(), O_WRONLY);
+        ASSERT_NE(fd, -1);
+        ASSERT_EQ(::pwrite(fd, data.data(), data.size(), offset),
+                  static_cast<ssize_t>(data.size()));
+        ::close(fd);
+    }
+
+    std::string ReadAt(const std::string& path, off_t offset, size_t size) {
+        std::string data(size, '\0');
+        int fd = ::open(path.c_str(), O_RDONLY);
+        EXPECT_NE(fd, -1);
+        EXPECT_EQ(::pread(fd, &data[0], size, offset), static_cast<ssize_t>(size));
+        ::close(fd);
+        return data;
+    }
+
 protected:
     std::string tmp_dir_;
     LogFile* log_file_{nullptr};
 };
 
+// 序列化后大小固定的日志，方便计算记录在文件中的offset
+static EntryPtr FixedEntry(uint64_t index) {
+    auto e = RandomEntry(index, 100);
+    e->set_term(1);
+    e->set_type(sharkstore::raft::impl::pb::ENTRY_NORMAL);
+    e->ByteSizeLong();
+    return e;
+}
+
 TEST(LogFormat, FileName) {
     auto filename = makeLogFileName(9, 18);
     ASSERT_EQ(filename, "0000000000000009-0000000000000012.log");
@@ -172,4 +202,323 @@ TEST_F(LogFileTest, Recover) {
     }
 }
 
+TEST_F(LogFileTest, LazyLoad) {
+    std::vector<EntryPtr> entries;
+    for (uint64_t i = 1; i <= 10; ++i) {
+        auto e = RandomEntry(i);
+        entries.push_back(e);
+        auto s = log_file_->Append(e);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    auto s = log_file_->Rotate();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+
+    // 打开时不加载索引，第一次读取时加载
+    log_file_ = new LogFile(tmp_dir_, 1, 1);
+    s = log_file_->Open(false, false, 10);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_FALSE(log_file_->Loaded());
+    ASSERT_EQ(log_file_->LastIndex(), 10);
+    ASSERT_EQ(log_file_->LogSize(), 10);
+    for (uint64_t i = 1; i <= 10; ++i) {
+        EntryPtr e;
+        s = log_file_->Get(i, &e);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        ASSERT_TRUE(log_file_->Loaded());
+        s = Equal(e, entries[i - 1]);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+
+    // 给出的last index跟索引不一致
+    log_file_ = new LogFile(tmp_dir_, 1, 1);
+    s = log_file_->Open(false, false, 11);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    uint64_t term = 0;
+    s = log_file_->Term(5, &term);
+    ASSERT_EQ(s.code(), Status::kCorruption) << s.ToString();
+    ASSERT_FALSE(log_file_->Loaded());
+}
+
+TEST_F(LogFileTest, Mmap) {
+    std::vector<EntryPtr> entries;
+    for (uint64_t i = 1; i <= 10; ++i) {
+        auto e = RandomEntry(i);
+        entries.push_back(e);
+        auto s = log_file_->Append(e);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    auto s = log_file_->Rotate();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+
+    auto check = [&] {
+        for (uint64_t i = 1; i <= 10; ++i) {
+            EntryPtr e;
+            auto s = log_file_->Get(i, &e);
+            ASSERT_TRUE(s.ok()) << s.ToString();
+            s = Equal(e, entries[i - 1]);
+            ASSERT_TRUE(s.ok()) << s.ToString();
+        }
+    };
+
+    // 封存的文件读取时映射，映射的大小计入预算
+    auto used = LogFile::MmapBytes();
+    ReOpen(false);
+    check();
+    ASSERT_TRUE(log_file_->Mapped());
+    ASSERT_EQ(LogFile::MmapBytes(), used + log_file_->FileSize());
+    log_file_->AdviseSequential();
+    log_file_->ReleaseMapped();
+    check();
+
+    // 关闭时释放映射
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(LogFile::MmapBytes(), used);
+
+    // 超出预算时不映射，仍然可以读取
+    LogFile::SetMmapBudget(0);
+    ReOpen(false);
+    ASSERT_FALSE(log_file_->Mapped());
+    check();
+    ASSERT_FALSE(log_file_->Mapped());
+    LogFile::SetMmapBudget(256 * 1024 * 1024);
+    check();
+    ASSERT_TRUE(log_file_->Mapped());
+
+    // 截断后不再映射
+    s = log_file_->Truncate(5);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_FALSE(log_file_->Mapped());
+    ASSERT_FALSE(log_file_->Sealed());
+    ASSERT_EQ(LogFile::MmapBytes(), used);
+    ASSERT_EQ(log_file_->LastIndex(), 4);
+}
+
+TEST_F(LogFileTest, TruncateNotResurrect) {
+    // 相同大小的日志，覆盖写后原来后面的日志在文件中仍然完整
+    std::vector<EntryPtr> entries;
+    for (uint64_t i = 1; i <= 10; ++i) {
+        auto e = RandomEntry(i, 100);
+        e->set_term(1);
+        e->set_type(sharkstore::raft::impl::pb::ENTRY_NORMAL);
+        e->ByteSizeLong();
+        entries.push_back(e);
+        auto s = log_file_->Append(e);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    auto s = log_file_->Sync();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+
+    auto e = RandomEntry(5, 100);
+    e->set_term(1);
+    e->set_type(sharkstore::raft::impl::pb::ENTRY_NORMAL);
+    e->ByteSizeLong();
+    entries[4] = e;
+    s = log_file_->Append(e);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    s = log_file_->Sync();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+
+    // 被截断的6-10不能被恢复出来
+    ReOpen(true);
+    ASSERT_EQ(log_file_->LastIndex(), 5);
+    for (uint64_t i = 1; i <= 5; ++i) {
+        EntryPtr e;
+        auto s = log_file_->Get(i, &e);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        s = Equal(e, entries[i - 1]);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+}
+
+TEST_F(LogFileTest, Recycle) {
+    for (uint64_t i = 1; i <= 10; ++i) {
+        auto s = log_file_->Append(RandomEntry(i));
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    auto s = log_file_->Rotate();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+    auto old_path = tmp_dir_ + "/" + makeLogFileName(1, 1);
+    auto free_path = tmp_dir_ + "/" + makeFreeLogFileName(1);
+    ASSERT_EQ(std::rename(old_path.c_str(), free_path.c_str()), 0);
+
+    // 复用旧文件，里面残留的日志和footer不能被当作有效数据
+    log_file_ = new LogFile(tmp_dir_, 2, 1);
+    s = log_file_->Create(free_path);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    std::vector<EntryPtr> entries;
+    for (uint64_t i = 1; i <= 3; ++i) {
+        auto e = RandomEntry(i);
+        entries.push_back(e);
+        s = log_file_->Append(e);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    s = log_file_->Sync();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+
+    log_file_ = new LogFile(tmp_dir_, 2, 1);
+    s = log_file_->Open(false, true);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(log_file_->LogSize(), 3);
+    ASSERT_EQ(log_file_->LastIndex(), 3);
+    for (uint64_t i = 1; i <= 3; ++i) {
+        EntryPtr e;
+        auto s = log_file_->Get(i, &e);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        s = Equal(e, entries[i - 1]);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+}
+
+TEST_F(LogFileTest, CorruptRecord) {
+    for (uint64_t i = 1; i <= 10; ++i) {
+        auto s = log_file_->Append(FixedEntry(i));
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    auto s = log_file_->Sync();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    auto path = log_file_->Path();
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+
+    // 第5条记录的数据被改写，crc校验不过，后面还有有效的记录，不能当作日志末尾
+    size_t rec_size = sizeof(Record) + FixedEntry(1)->ByteSizeLong();
+    off_t corrupt_offset = sizeof(Header) + 4 * rec_size + sizeof(Record) + 1;
+    auto data = ReadAt(path, corrupt_offset, 1);
+    OverWrite(path, corrupt_offset, std::string(1, static_cast<char>(data[0] ^ 0xff)));
+    log_file_ = new LogFile(tmp_dir_, 1, 1);
+    s = log_file_->Open(false, true);
+    ASSERT_FALSE(s.ok());
+    ASSERT_EQ(s.code(), Status::kCorruption);
+    delete log_file_;
+
+    // 允许损坏时备份并从损坏的记录处截断
+    log_file_ = new LogFile(tmp_dir_, 1, 1);
+    s = log_file_->Open(true, true);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(log_file_->LastIndex(), 4);
+    s = log_file_->Append(FixedEntry(5));
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ReOpen(true);
+    ASSERT_EQ(log_file_->LastIndex(), 5);
+}
+
+TEST_F(LogFileTest, TornTail) {
+    for (uint64_t i = 1; i <= 10; ++i) {
+        auto s = log_file_->Append(FixedEntry(i));
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    auto s = log_file_->Sync();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    auto path = log_file_->Path();
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+
+    // 写最后一条记录时崩溃：记录头完整，数据的后半部分还是预分配的零
+    size_t payload_size = FixedEntry(1)->ByteSizeLong();
+    off_t last_offset = sizeof(Header) + 9 * (sizeof(Record) + payload_size);
+    off_t torn_offset = last_offset + sizeof(Record) + payload_size / 2;
+    OverWrite(path, torn_offset, std::string(payload_size - payload_size / 2, '\0'));
+
+    // 不允许损坏也能打开，截断不完整的记录
+    log_file_ = new LogFile(tmp_dir_, 1, 1);
+    s = log_file_->Open(false, true);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(log_file_->LastIndex(), 9);
+    ASSERT_EQ(log_file_->FileSize(), static_cast<uint64_t>(last_offset));
+    ReOpen(true);
+    ASSERT_EQ(log_file_->LastIndex(), 9);
+
+    // 从截断的位置继续写
+    for (uint64_t i = 10; i <= 12; ++i) {
+        s = log_file_->Append(FixedEntry(i));
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    ReOpen(true);
+    ASSERT_EQ(log_file_->LastIndex(), 12);
+    EntryPtr e;
+    s = log_file_->Get(10, &e);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(e->index(), 10U);
+}
+
+TEST_F(LogFileTest, RecycleStaleRecord) {
+    for (uint64_t i = 1; i <= 10; ++i) {
+        auto s = log_file_->Append(FixedEntry(i));
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    auto s = log_file_->Rotate();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+    auto old_path = tmp_dir_ + "/" + makeLogFileName(1, 1);
+    auto free_path = tmp_dir_ + "/" + makeFreeLogFileName(1);
+    ASSERT_EQ(std::rename(old_path.c_str(), free_path.c_str()), 0);
+
+    // 新写入3条同样大小的记录，第4条的位置是上一次使用时写入的完整记录
+    size_t rec_size = sizeof(Record) + FixedEntry(1)->ByteSizeLong();
+    off_t stale_offset = sizeof(Header) + 3 * rec_size;
+    auto stale = ReadAt(free_path, stale_offset, sizeof(Record));
+    log_file_ = new LogFile(tmp_dir_, 2, 1);
+    s = log_file_->Create(free_path);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    for (uint64_t i = 1; i <= 3; ++i) {
+        s = log_file_->Append(FixedEntry(i));
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    s = log_file_->Sync();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    auto path = log_file_->Path();
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+
+    // 结束标记没有写下去（写入时崩溃），旧记录的crc以之前的epoch为种子，视为日志末尾
+    OverWrite(path, stale_offset, stale);
+    log_file_ = new LogFile(tmp_dir_, 2, 1);
+    s = log_file_->Open(false, true);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(log_file_->LastIndex(), 3);
+
+    // 不封存直接回收再复用一次，两次之前写入的记录同样视为日志末尾
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+    ASSERT_EQ(std::rename(path.c_str(), free_path.c_str()), 0);
+    log_file_ = new LogFile(tmp_dir_, 3, 1);
+    s = log_file_->Create(free_path);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    for (uint64_t i = 1; i <= 3; ++i) {
+        s = log_file_->Append(FixedEntry(i));
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    s = log_file_->Sync();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    path = log_file_->Path();
+    s = log_file_->Close();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    delete log_file_;
+
+    OverWrite(path, stale_offset, stale);
+    log_file_ = new LogFile(tmp_dir_, 3, 1);
+    s = log_file_->Open(false, true);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(log_file_->LastIndex(), 3);
+}
+
 }  // namespace
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "base/mem_tracker.h"
 #include "raft/src/impl/raft_log_unstable.h"
 #include "test_util.h"
 
@@ -107,4 +108,49 @@ TEST(UnstableLog, Append) {
     ASSERT_TRUE(s.ok()) << s.ToString();
 }
 
+TEST(UnstableLog, MemTrack) {
+    auto root = sharkstore::MemTracker::Root();
+    auto base = root->Usage();
+
+    auto sumBytes = [](const std::vector<EntryPtr>& ents) {
+        int64_t total = 0;
+        for (const auto& e : ents) {
+            total += sizeof(pb::Entry) + e->data().size();
+        }
+        return total;
+    };
+
+    {
+        UnstableLog log(100);
+        std::vector<EntryPtr> ents1;
+        RandomEntries(100, 200, 64, &ents1);
+        log.truncateAndAppend(ents1);
+        ASSERT_EQ(log.bytes(), sumBytes(ents1));
+        ASSERT_EQ(root->Usage() - base, log.bytes());
+
+        // 部分冲突
+        std::vector<EntryPtr> ents2;
+        RandomEntries(150, 160, 64, &ents2);
+        log.truncateAndAppend(ents2);
+        std::vector<EntryPtr> ents;
+        log.entries(&ents);
+        ASSERT_EQ(log.bytes(), sumBytes(ents));
+
+        log.stableTo(120, ents[20]->term());
+        ents.clear();
+        log.entries(&ents);
+        ASSERT_EQ(log.bytes(), sumBytes(ents));
+        ASSERT_EQ(root->Usage() - base, log.bytes());
+
+        log.restore(500);
+        ASSERT_EQ(log.bytes(), 0);
+        ASSERT_EQ(root->Usage(), base);
+
+        log.truncateAndAppend(ents1);
+        ASSERT_GT(root->Usage(), base);
+    }
+    // 析构时释放
+    ASSERT_EQ(root->Usage(), base);
+}
+
 }  // namespace
@@ -58,6 +58,7 @@ EntryPtr RandomEntry(uint64_t index, int data_size) {
     e->set_type((randomInt() % 2 == 0) ? sharkstore::raft::impl::pb::ENTRY_NORMAL
                                        : sharkstore::raft::impl::pb::ENTRY_CONF_CHANGE);
     e->set_data(randomString(data_size));
+    e->ByteSizeLong();
     return e;
 }
 
@@ -16,7 +16,7 @@ namespace raft { class RaftServer; }
 namespace dataserver {
 
 namespace master { class Worker; }
-namespace storage { class MetaStore; }
+namespace storage { class MetaStore; class Compactor; }
 namespace common { class SocketSession; }
 namespace watch { class WatchServer; }
 
@@ -38,6 +38,7 @@ public:
     virtual master::Worker* MasterClient() = 0;
     virtual raft::RaftServer* RaftServer() = 0;
     virtual storage::MetaStore* MetaStore() = 0;
+    virtual storage::Compactor* Compactor() = 0;
     virtual common::SocketSession* SocketSession() = 0;
     virtual RangeStats* Statistics() = 0;
     virtual watch::WatchServer* WatchServer() = 0;
@@ -54,6 +55,9 @@ public:
     // split
     virtual Status SplitRange(uint64_t range_id,
             const raft_cmdpb::SplitRequest &req, uint64_t raft_index) = 0;
+    // 一次创建所有新range，新range和原range的meta在同一个batch里持久化
+    virtual Status BatchSplitRange(uint64_t range_id,
+            const raft_cmdpb::BatchSplitRequest &req, uint64_t raft_index) = 0;
 };
 
 }  // namespace range
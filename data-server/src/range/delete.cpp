@@ -42,9 +42,10 @@ void Range::Delete(common::ProtoMessage *msg, kvrpcpb::DsDeleteRequest &req) {
 
     RANGE_LOG_DEBUG("Delete begin");
 
-    if (!CheckWriteable()) {
+    Status::Code reject_code = Status::kOk;
+    if (!AcceptWrite(&reject_code)) {
         auto resp = new kvrpcpb::DsKvDeleteResponse;
-        resp->mutable_resp()->set_code(Status::kNoLeftSpace);
+        resp->mutable_resp()->set_code(reject_code);
         return SendError(msg, req.header(), resp, nullptr);
     }
 
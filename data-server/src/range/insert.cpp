@@ -23,9 +23,10 @@ void Range::Insert(common::ProtoMessage *msg, kvrpcpb::DsInsertRequest &req) {
         return SendError(msg, req.header(), resp, err);
     }
 
-    if (!CheckWriteable()) {
+    Status::Code reject_code = Status::kOk;
+    if (!AcceptWrite(&reject_code)) {
         auto resp = new kvrpcpb::DsInsertResponse;
-        resp->mutable_resp()->set_code(Status::kNoLeftSpace);
+        resp->mutable_resp()->set_code(reject_code);
         return SendError(msg, req.header(), resp, nullptr);
     }
 
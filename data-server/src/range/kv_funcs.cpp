@@ -5,6 +5,7 @@
 #include "server/range_server.h"
 
 #include "range_logger.h"
+#include "storage/compactor.h"
 
 namespace sharkstore {
 namespace dataserver {
@@ -12,13 +13,17 @@ namespace range {
 
 using namespace sharkstore::monitor;
 
+// 区间内的key全部被删除且个数达到该值时，用一个DeleteRange代替逐个删除
+static const size_t kRangeDeleteMinKeys = 100;
+
 void Range::KVSet(common::ProtoMessage *msg, kvrpcpb::DsKvSetRequest &req) {
     context_->Statistics()->PushTime(HistogramType::kQWait,
             get_micro_second() - msg->begin_time);
 
-    if (!CheckWriteable()) {
+    Status::Code reject_code = Status::kOk;
+    if (!AcceptWrite(&reject_code)) {
         auto resp = new kvrpcpb::DsKvSetResponse;
-        resp->mutable_resp()->set_code(Status::kNoLeftSpace);
+        resp->mutable_resp()->set_code(reject_code);
         return SendError(msg, req.header(), resp, nullptr);
     }
 
@@ -115,7 +120,7 @@ void Range::KVGet(common::ProtoMessage *msg, kvrpcpb::DsKvGetRequest &req) {
     RANGE_LOG_DEBUG("KVGet begin");
     do {
         auto &key = req.req().key();
-        if (!VerifyLeader(err)) {
+        if (!VerifyReadable(req.header(), err)) {
             RANGE_LOG_WARN("KVGet error: %s", err->message().c_str());
             break;
         }
@@ -126,7 +131,7 @@ void Range::KVGet(common::ProtoMessage *msg, kvrpcpb::DsKvGetRequest &req) {
 
         auto resp = ds_resp->mutable_resp();
         auto btime = get_micro_second();
-        auto ret = store_->Get(req.req().key(), resp->mutable_value());
+        auto ret = store_->Get(req.req().key(), resp->mutable_value(), ReadVersion(req.header()));
 
         context_->Statistics()->PushTime(HistogramType::kStore,
                                        get_micro_second() - btime);
@@ -144,9 +149,10 @@ void Range::KVBatchSet(common::ProtoMessage *msg,
     context_->Statistics()->PushTime(HistogramType::kQWait,
                                    get_micro_second() - msg->begin_time);
 
-    if (!CheckWriteable()) {
+    Status::Code reject_code = Status::kOk;
+    if (!AcceptWrite(&reject_code)) {
         auto resp = new kvrpcpb::DsKvBatchSetResponse;
-        resp->mutable_resp()->set_code(Status::kNoLeftSpace);
+        resp->mutable_resp()->set_code(reject_code);
         return SendError(msg, req.header(), resp, nullptr);
     }
 
@@ -286,9 +292,10 @@ void Range::KVDelete(common::ProtoMessage *msg,
     context_->Statistics()->PushTime(HistogramType::kQWait,
                                    get_micro_second() - msg->begin_time);
 
-    if (!CheckWriteable()) {
+    Status::Code reject_code = Status::kOk;
+    if (!AcceptWrite(&reject_code)) {
         auto resp = new kvrpcpb::DsKvDeleteResponse;
-        resp->mutable_resp()->set_code(Status::kNoLeftSpace);
+        resp->mutable_resp()->set_code(reject_code);
         return SendError(msg, req.header(), resp, nullptr);
     }
 
@@ -361,9 +368,10 @@ void Range::KVBatchDelete(common::ProtoMessage *msg,
                                    get_micro_second() - msg->begin_time);
     errorpb::Error *err = nullptr;
 
-    if (!CheckWriteable()) {
+    Status::Code reject_code = Status::kOk;
+    if (!AcceptWrite(&reject_code)) {
         auto resp = new kvrpcpb::DsKvBatchDeleteResponse;
-        resp->mutable_resp()->set_code(Status::kNoLeftSpace);
+        resp->mutable_resp()->set_code(reject_code);
         return SendError(msg, req.header(), resp, nullptr);
     }
 
@@ -461,9 +469,10 @@ void Range::KVRangeDelete(common::ProtoMessage *msg,
     context_->Statistics()->PushTime(HistogramType::kQWait,
                                    get_micro_second() - msg->begin_time);
 
-    if (!CheckWriteable()) {
+    Status::Code reject_code = Status::kOk;
+    if (!AcceptWrite(&reject_code)) {
         auto resp = new kvrpcpb::DsKvRangeDeleteResponse;
-        resp->mutable_resp()->set_code(Status::kNoLeftSpace);
+        resp->mutable_resp()->set_code(reject_code);
         return SendError(msg, req.header(), resp, nullptr);
     }
 
@@ -515,13 +524,16 @@ Status Range::ApplyKVRangeDelete(const raft_cmdpb::Command &cmd) {
             RANGE_LOG_WARN("KVRangeDelet error: %s", err->message().c_str());
             break;
         }
+        // mvcc模式下删除是写入新版本，旧版本过了gc窗口才能回收，不需要马上compaction
+        bool compact = !store_->IsMvcc();
 
         if (req.case_() == kvrpcpb::EC_Exists ||
             req.case_() == kvrpcpb::EC_AnyCase) {
             std::unique_ptr<storage::Iterator> iterator(
                 store_->NewIterator(start, limit));
             int maxCount = checkMaxCount(req.max_count());
-            std::vector<std::string> delKeys(maxCount);
+            std::vector<std::string> delKeys;
+            delKeys.reserve(std::min(maxCount, 1024));
 
             for (int i = 0; iterator->Valid() && i < maxCount; ++i) {
                 delKeys.push_back(std::move(iterator->key()));
@@ -532,10 +544,24 @@ Status Range::ApplyKVRangeDelete(const raft_cmdpb::Command &cmd) {
                 last_key = delKeys[delKeys.size() - 1];
             }
 
-            ret = store_->BatchDelete(delKeys);
             affected_keys = delKeys.size();
+            if (!iterator->Valid() && delKeys.size() >= kRangeDeleteMinKeys) {
+                ret = store_->RangeDelete(start, limit);
+                if (ret.ok() && compact) {
+                    context_->Compactor()->ScheduleRangeDeleted(start, limit);
+                }
+            } else {
+                ret = store_->BatchDelete(delKeys);
+                if (ret.ok() && compact && !delKeys.empty()) {
+                    context_->Compactor()->ScheduleKeysDeleted(delKeys.front(), last_key,
+                                                               delKeys.size());
+                }
+            }
         } else {
             ret = store_->RangeDelete(start, limit);
+            if (ret.ok() && compact) {
+                context_->Compactor()->ScheduleRangeDeleted(start, limit);
+            }
         }
 
         context_->Statistics()->PushTime(HistogramType::kStore,
@@ -561,10 +587,17 @@ void Range::KVScan(common::ProtoMessage *msg, kvrpcpb::DsKvScanRequest &req) {
 
     errorpb::Error *err = nullptr;
     auto ds_resp = new kvrpcpb::DsKvScanResponse;
+    if (!VerifyReadable(req.header(), err)) {
+        RANGE_LOG_WARN("KVScan error: %s", err->message().c_str());
+        common::SetResponseHeader(req.header(), ds_resp->mutable_header(), err);
+        context_->SocketSession()->Send(msg, ds_resp);
+        return;
+    }
+
     auto start = std::max(req.req().start(), start_key_);
     auto limit = std::min(req.req().limit(), meta_.GetEndKey());
     std::unique_ptr<storage::Iterator> iterator(
-        store_->NewIterator(start, limit));
+        store_->NewIterator(start, limit, ReadVersion(req.header())));
 
     int max_count = checkMaxCount(req.req().max_count());
     auto resp = ds_resp->mutable_resp();
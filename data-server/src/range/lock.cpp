@@ -147,7 +147,7 @@ void Range::Lock(common::ProtoMessage *msg, kvrpcpb::DsLockRequest &req) {
     }
 }
 
-Status Range::ApplyLock(const raft_cmdpb::Command &cmd) {
+Status Range::ApplyLock(const raft_cmdpb::Command &cmd, uint64_t index) {
     RANGE_LOG_DEBUG("apply lock: %s", cmd.DebugString().c_str());
     Status ret;
     errorpb::Error *err = nullptr;
@@ -210,6 +210,8 @@ Status Range::ApplyLock(const raft_cmdpb::Command &cmd) {
         }
         delete val;
 
+        // 以加锁的日志index作为fencing token
+        lock_table_.OnAcquire(req.key(), req.value(), index);
 
         RANGE_LOG_INFO("ApplyLock: lock [%s] is locked by %s", req.key().c_str(), req.value().by().c_str());
     } while (false);
@@ -252,6 +254,10 @@ void Range::LockUpdate(common::ProtoMessage *msg,
             break;
         }
 
+        if (LockRenew(msg, req, encode_key)) {
+            return;
+        }
+
         auto ret = SubmitCmd(msg, req.header(), [&req](raft_cmdpb::Command &cmd) {
             cmd.set_cmd_type(raft_cmdpb::CmdType::LockUpdate);
             cmd.set_allocated_lock_update_req(req.release_req());
@@ -270,6 +276,89 @@ void Range::LockUpdate(common::ProtoMessage *msg,
     }
 }
 
+bool Range::LockRenew(common::ProtoMessage *msg, kvrpcpb::DsLockUpdateRequest &req,
+                      const std::string &encode_key) {
+    kvrpcpb::LockValue current;
+    auto result = lock_table_.Renew(req.req(), &current);
+    if (result == LockTable::RenewResult::kNotFound) {
+        if (!LockTableReady()) {
+            return false;
+        }
+        // 先取generation再读存储，读取期间有apply修改锁表则放弃加载
+        auto generation = lock_table_.Generation();
+        std::unique_ptr<kvrpcpb::LockValue> val(LockGet(encode_key));
+        if (val == nullptr) {
+            return false;
+        }
+        if (!lock_table_.Load(req.req().key(), *val, apply_index_, generation)) {
+            return false;
+        }
+        result = lock_table_.Renew(req.req(), &current);
+    }
+
+    auto resp = new kvrpcpb::DsLockUpdateResponse;
+    switch (result) {
+        case LockTable::RenewResult::kOK:
+            resp->mutable_resp()->set_code(LOCK_OK);
+            break;
+        case LockTable::RenewResult::kIDMismatch:
+            RANGE_LOG_WARN("LockUpdate error: lock [%s] can not update with id %s != %s",
+                           req.req().key().c_str(), req.req().id().c_str(), current.id().c_str());
+            resp->mutable_resp()->set_code(LOCK_ID_MISMATCHED);
+            resp->mutable_resp()->set_error("wrong id: " + current.id());
+            resp->mutable_resp()->set_value(current.value());
+            resp->mutable_resp()->set_update_time(current.update_time());
+            break;
+        default:
+            delete resp;
+            return false;
+    }
+
+    RANGE_LOG_DEBUG("LockUpdate: lock [%s] renewed in memory", req.req().key().c_str());
+    common::SetResponseHeader(req.header(), resp->mutable_header());
+    context_->SocketSession()->Send(msg, resp);
+    return true;
+}
+
+bool Range::LockTableReady() {
+    auto ready_index = lock_table_.ReadyIndex();
+    if (ready_index == 0) {
+        // 成为leader时日志中已有的条目都apply之后，存储中的锁才是最新的
+        raft::RaftStatus status;
+        raft_->GetStatus(&status);
+        lock_table_.SetReadyIndex(status.index);
+        ready_index = lock_table_.ReadyIndex();
+    }
+    return ready_index != 0 && apply_index_ >= ready_index;
+}
+
+void Range::CheckpointLocks() {
+    if (lock_table_.DirtyCount() == 0) {
+        return;
+    }
+
+    std::vector<kvrpcpb::LockUpdateRequest> reqs;
+    lock_table_.CollectDirty(kLockCheckpointBatch, &reqs);
+    for (auto &req : reqs) {
+        raft_cmdpb::Command cmd;
+        // node_id为0，没有等待的请求，apply时不回复
+        cmd.mutable_cmd_id()->set_node_id(0);
+        cmd.mutable_cmd_id()->set_seq(submit_queue_.GetSeq());
+        cmd.set_cmd_type(raft_cmdpb::CmdType::LockUpdate);
+        meta_.GetEpoch(cmd.mutable_verify_epoch());
+        cmd.mutable_lock_update_req()->Swap(&req);
+
+        auto ret = Submit(cmd);
+        if (!ret.ok()) {
+            // 一般是已经不是leader，锁表随后会被清空
+            RANGE_LOG_WARN("checkpoint lock [%s] failed: %s",
+                           cmd.lock_update_req().key().c_str(), ret.ToString().c_str());
+            break;
+        }
+    }
+    RANGE_LOG_DEBUG("checkpoint %zu lock renewals", reqs.size());
+}
+
 Status Range::ApplyLockUpdate(const raft_cmdpb::Command &cmd) {
     RANGE_LOG_DEBUG("apply lock update: %s", cmd.DebugString().c_str());
     Status ret;
@@ -277,6 +366,8 @@ Status Range::ApplyLockUpdate(const raft_cmdpb::Command &cmd) {
     auto atime = get_micro_second();
 
     auto &req = cmd.lock_update_req();
+    // node_id为0的是leader持久化内存续约的命令，只更新续约信息
+    bool checkpoint = cmd.cmd_id().node_id() == 0;
     auto resp = new (kvrpcpb::DsLockUpdateResponse);
     do {
         auto &epoch = cmd.verify_epoch();
@@ -307,20 +398,21 @@ Status Range::ApplyLockUpdate(const raft_cmdpb::Command &cmd) {
             resp->mutable_resp()->set_update_time(val->update_time());
             break;
         }
-        val->set_update_time(getticks() + req.update_time());
-        if (req.update_value().size() != 0) {
-            val->set_value(req.update_value());
-        }
-
         auto btime = get_micro_second();
 
         std::string value_buf;
         int64_t version = 0;
         std::string extend("");
 
-        val->set_value(req.update_value());
-        val->set_update_time(req.update_time());
-        val->set_by(req.by());
+        if (!checkpoint) {
+            val->set_value(req.update_value());
+            val->set_update_time(req.update_time());
+            val->set_by(req.by());
+        } else if (req.update_time() >= val->update_time()) {
+            // 不修改value，收集续约之后复制的修改不会被旧的value覆盖
+            val->set_update_time(req.update_time());
+            val->set_by(req.by());
+        }
         lock::EncodeValue(&value_buf,
                          version, *val, &extend);
 
@@ -339,6 +431,7 @@ Status Range::ApplyLockUpdate(const raft_cmdpb::Command &cmd) {
             auto len = encode_key.size() + req.ByteSizeLong();
             CheckSplit(len);
         }
+        lock_table_.OnUpdate(req.key(), *val, checkpoint);
         delete val;
 
         RANGE_LOG_INFO("ApplyLockUpdate: lock [%s] is update", req.key().c_str());
@@ -346,7 +439,9 @@ Status Range::ApplyLockUpdate(const raft_cmdpb::Command &cmd) {
 
     if (cmd.cmd_id().node_id() == node_id_) {
         ReplySubmit(cmd, resp, err, atime);
-    } else if (err != nullptr) {
+    } else {
+        // 包括leader持久化续约的命令
+        delete resp;
         delete err;
     }
     return ret;
@@ -440,6 +535,7 @@ Status Range::ApplyUnlock(const raft_cmdpb::Command &cmd) {
             break;
         }
         delete val;
+        lock_table_.OnRelease(req.key());
 
         RANGE_LOG_INFO("ApplyUnlock: lock [%s] is unlock by %s", EncodeToHexString(req.key()).c_str(), req.by().c_str());
 
@@ -553,6 +649,7 @@ Status Range::ApplyUnlockForce(const raft_cmdpb::Command &cmd) {
             break;
         }
         delete val;
+        lock_table_.OnRelease(req.key());
 
         RANGE_LOG_INFO("ApplyForceUnlock: lock [%s] is unlock by %s", EncodeToHexString(req.key()).c_str(), req.by().c_str());
 
@@ -0,0 +1,234 @@
+#include "lock_table.h"
+
+#include "frame/sf_util.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace range {
+
+LockTable::LockTable(MemTracker* mem_parent) :
+    mem_tracker_("lock_table", mem_parent != nullptr ? mem_parent : MemTracker::Root()) {
+}
+
+LockTable::~LockTable() {
+    std::lock_guard<std::mutex> lock(mu_);
+    clear();
+}
+
+void LockTable::Enable() {
+    std::lock_guard<std::mutex> lock(mu_);
+    clear();
+    enabled_ = true;
+    ++generation_;
+}
+
+void LockTable::Disable() {
+    std::lock_guard<std::mutex> lock(mu_);
+    clear();
+    enabled_ = false;
+    ++generation_;
+}
+
+bool LockTable::Enabled() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return enabled_;
+}
+
+void LockTable::OnAcquire(const std::string& key, const kvrpcpb::LockValue& value,
+                          uint64_t fence) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!enabled_) return;
+
+    ++generation_;
+    auto it = locks_.find(key);
+    if (it == locks_.end()) {
+        it = locks_.emplace(key, Entry()).first;
+    } else if (it->second.dirty) {
+        it->second.dirty = false;
+        --dirty_count_;
+    }
+    setValue(it, value);
+    it->second.fence = fence;
+}
+
+void LockTable::OnUpdate(const std::string& key, const kvrpcpb::LockValue& value,
+                         bool checkpoint) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!enabled_) return;
+
+    ++generation_;
+    auto it = locks_.find(key);
+    if (it == locks_.end()) {
+        return;
+    }
+    if (!it->second.dirty) {
+        setValue(it, value);
+    } else if (checkpoint) {
+        // 收集之后又有续约还未持久化，保留续约信息
+        kvrpcpb::LockValue merged(value);
+        merged.set_update_time(it->second.value.update_time());
+        merged.set_by(it->second.value.by());
+        setValue(it, merged);
+    } else {
+        it->second.dirty = false;
+        --dirty_count_;
+        setValue(it, value);
+    }
+}
+
+void LockTable::OnRelease(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!enabled_) return;
+
+    ++generation_;
+    auto it = locks_.find(key);
+    if (it != locks_.end()) {
+        erase(it);
+    }
+}
+
+uint64_t LockTable::ReadyIndex() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return ready_index_;
+}
+
+void LockTable::SetReadyIndex(uint64_t index) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (enabled_ && ready_index_ == 0) {
+        ready_index_ = index;
+    }
+}
+
+uint64_t LockTable::Generation() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return generation_;
+}
+
+bool LockTable::Load(const std::string& key, const kvrpcpb::LockValue& value, uint64_t fence,
+                     uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!enabled_ || generation != generation_) {
+        return false;
+    }
+    auto ret = locks_.emplace(key, Entry());
+    if (ret.second) {
+        setValue(ret.first, value);
+        ret.first->second.fence = fence;
+    }
+    return true;
+}
+
+LockTable::RenewResult LockTable::Renew(const kvrpcpb::LockUpdateRequest& req,
+                                        kvrpcpb::LockValue* current) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!enabled_) {
+        return RenewResult::kNeedReplicate;
+    }
+
+    auto it = locks_.find(req.key());
+    if (it == locks_.end()) {
+        return RenewResult::kNotFound;
+    }
+    auto& entry = it->second;
+    if (expired(entry)) {
+        // 交给raft，apply时按照不存在处理
+        erase(it);
+        return RenewResult::kNeedReplicate;
+    }
+    if (entry.value.id() != req.id()) {
+        current->CopyFrom(entry.value);
+        return RenewResult::kIDMismatch;
+    }
+    if (entry.value.value() != req.update_value()) {
+        return RenewResult::kNeedReplicate;
+    }
+
+    // 与ApplyLockUpdate的修改保持一致
+    entry.value.set_update_time(req.update_time());
+    entry.value.set_by(req.by());
+    if (!entry.dirty) {
+        entry.dirty = true;
+        ++dirty_count_;
+    }
+    return RenewResult::kOK;
+}
+
+size_t LockTable::CollectDirty(size_t max_count, std::vector<kvrpcpb::LockUpdateRequest>* reqs) {
+    std::lock_guard<std::mutex> lock(mu_);
+    size_t count = 0;
+    for (auto it = locks_.begin(); it != locks_.end() && dirty_count_ > 0 && count < max_count;) {
+        auto& entry = it->second;
+        if (!entry.dirty) {
+            ++it;
+            continue;
+        }
+        if (expired(entry)) {
+            erase(it++);
+            continue;
+        }
+        kvrpcpb::LockUpdateRequest req;
+        req.set_key(it->first);
+        req.set_id(entry.value.id());
+        req.set_update_time(entry.value.update_time());
+        req.set_by(entry.value.by());
+        reqs->push_back(std::move(req));
+
+        entry.dirty = false;
+        --dirty_count_;
+        ++count;
+        ++it;
+    }
+    return count;
+}
+
+bool LockTable::Get(const std::string& key, Entry* entry) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = locks_.find(key);
+    if (it == locks_.end()) {
+        return false;
+    }
+    *entry = it->second;
+    return true;
+}
+
+size_t LockTable::Size() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return locks_.size();
+}
+
+size_t LockTable::DirtyCount() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return dirty_count_;
+}
+
+void LockTable::clear() {
+    ready_index_ = 0;
+    locks_.clear();
+    dirty_count_ = 0;
+    mem_tracker_.Set(0);
+}
+
+void LockTable::setValue(EntryMap::iterator it, const kvrpcpb::LockValue& value) {
+    auto& entry = it->second;
+    entry.value.CopyFrom(value);
+    auto bytes = static_cast<int64_t>(sizeof(Entry) + it->first.size() + value.ByteSizeLong());
+    mem_tracker_.Consume(bytes - entry.mem_bytes);
+    entry.mem_bytes = bytes;
+}
+
+void LockTable::erase(EntryMap::iterator it) {
+    if (it->second.dirty) {
+        --dirty_count_;
+    }
+    mem_tracker_.Release(it->second.mem_bytes);
+    locks_.erase(it);
+}
+
+bool LockTable::expired(const Entry& entry) const {
+    auto delete_time = entry.value.delete_time();
+    return delete_time > 0 && delete_time <= getticks();
+}
+
+}  // namespace range
+}  // namespace dataserver
+}  // namespace sharkstore
@@ -0,0 +1,100 @@
+_Pragma("once");
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/mem_tracker.h"
+#include "proto/gen/kvrpcpb.pb.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace range {
+
+// leader上常驻内存的锁表
+//
+// 锁的获取和释放仍然通过raft复制，只有持锁者的续约（不修改value的LockUpdate）
+// 直接在内存中完成，标记为dirty后由leader定时批量通过raft持久化。
+// 表只在leader上启用，新leader从空表开始，第一次续约时从存储中加载。
+class LockTable {
+public:
+    struct Entry {
+        kvrpcpb::LockValue value;
+        // 加锁时的raft日志index（从存储加载的为加载时的apply index）
+        // 同一个key重新加锁时单调递增，用作fencing token
+        uint64_t fence = 0;
+        // 有未持久化的续约
+        bool dirty = false;
+        int64_t mem_bytes = 0;
+    };
+
+    enum class RenewResult {
+        kOK = 0,
+        kNotFound,       // 表中没有，需要从存储中加载
+        kIDMismatch,     // 锁被其他id持有
+        kNeedReplicate,  // 修改了value，需要走raft
+    };
+
+    explicit LockTable(MemTracker* mem_parent = nullptr);
+    ~LockTable();
+
+    LockTable(const LockTable&) = delete;
+    LockTable& operator=(const LockTable&) = delete;
+
+    // 成为leader时启用，失去leader时停用，两者都会清空表
+    void Enable();
+    void Disable();
+    bool Enabled() const;
+
+    // 以下在leader apply成功后调用，同步内存中的状态，表未启用时忽略
+    void OnAcquire(const std::string& key, const kvrpcpb::LockValue& value, uint64_t fence);
+    // checkpoint为持久化续约的命令，内存中有之后的续约时保留；
+    // 其他更新以复制的值为准，并清除未持久化的续约
+    void OnUpdate(const std::string& key, const kvrpcpb::LockValue& value, bool checkpoint);
+    void OnRelease(const std::string& key);
+
+    // 新leader需要apply到ready index之后才能从存储中加载，保证读到的是最新状态
+    // 为0表示还没有设置
+    uint64_t ReadyIndex() const;
+    void SetReadyIndex(uint64_t index);
+
+    // 每次apply修改表都会递增，用来检测从存储加载期间是否有并发的apply
+    uint64_t Generation() const;
+    // 从存储中加载，期间有并发修改（generation变化）时放弃，返回是否加载成功
+    bool Load(const std::string& key, const kvrpcpb::LockValue& value, uint64_t fence,
+              uint64_t generation);
+
+    // 在内存中续约，结果为kIDMismatch时current返回当前持有者的值
+    RenewResult Renew(const kvrpcpb::LockUpdateRequest& req, kvrpcpb::LockValue* current);
+
+    // 取出最多max_count个待持久化的续约，并清除dirty标记
+    // 只带续约信息(update_time、by)，不带value
+    size_t CollectDirty(size_t max_count, std::vector<kvrpcpb::LockUpdateRequest>* reqs);
+
+    bool Get(const std::string& key, Entry* entry) const;
+    size_t Size() const;
+    size_t DirtyCount() const;
+
+private:
+    using EntryMap = std::unordered_map<std::string, Entry>;
+
+    void clear();
+    void setValue(EntryMap::iterator it, const kvrpcpb::LockValue& value);
+    void erase(EntryMap::iterator it);
+    bool expired(const Entry& entry) const;
+
+private:
+    bool enabled_ = false;
+    uint64_t ready_index_ = 0;
+    uint64_t generation_ = 0;
+    size_t dirty_count_ = 0;
+    EntryMap locks_;
+    mutable std::mutex mu_;
+
+    MemTracker mem_tracker_;
+};
+
+}  // namespace range
+}  // namespace dataserver
+}  // namespace sharkstore
@@ -124,7 +124,7 @@ Status Range::ApplyMemberChange(const raft::ConfChange &cc, uint64_t index) {
     }
 
     apply_index_ = index;
-    auto s = context_->MetaStore()->SaveApplyIndex(id_, apply_index_);
+    auto s = saveApplyIndex(apply_index_);
     if (!s.ok()) {
         RANGE_LOG_ERROR("save apply index error %s", s.ToString().c_str());
         return s;
@@ -1,11 +1,15 @@
 #include "range.h"
+#include <algorithm>
 #include <common/ds_config.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 
 #include "common/ds_config.h"
 #include "frame/sf_util.h"
 #include "master/worker.h"
 #include "server/range_server.h"
 #include "server/run_status.h"
+#include "storage/compactor.h"
 #include "storage/meta_store.h"
 
 #include "snapshot.h"
@@ -19,15 +23,25 @@ static const int kDownPeerThresholdSecs = 50;
 // 磁盘使用率大于百分之92停写
 static const uint64_t kStopWriteFsUsagePercent = 92;
 
+// 所有range的内存统计节点的父节点
+static MemTracker* rangesMemTracker() {
+    static MemTracker* tracker = new MemTracker("range", MemTracker::Root());
+    return tracker;
+}
+
 Range::Range(RangeContext* context, const metapb::Range &meta) :
 	context_(context),
 	node_id_(context_->GetNodeID()),
 	id_(meta.id()),
 	start_key_(meta.start_key()),
 	meta_(meta),
+	mem_tracker_(std::to_string(meta.id()), rangesMemTracker()),
+	lock_table_(&mem_tracker_),
+	submit_queue_(&mem_tracker_),
 	store_(new storage::Store(meta, context->DBInstance())) {
     eventBuffer = new watch::CEventBuffer(ds_config.watch_config.buffer_map_size,
-                                        ds_config.watch_config.buffer_queue_size);
+                                        ds_config.watch_config.buffer_queue_size,
+                                        &mem_tracker_);
 }
 
 
@@ -41,16 +55,62 @@ Status Range::Initialize(uint64_t leader, uint64_t log_start_index) {
     if (!s.ok()) {
         return Status(Status::kCorruption, "load applied", s.ToString());
     }
+    s = loadMvccVersion();
+    if (!s.ok()) {
+        return s;
+    }
 
     // 创建起始日志之前的日志都算作被应用过的
     if (log_start_index > 1 && log_start_index - 1 > apply_index_) {
         apply_index_ = log_start_index - 1;
-        s = context_->MetaStore()->SaveApplyIndex(id_, apply_index_);
+        s = saveApplyIndex(apply_index_);
         if (!s.ok()) {
             return Status(Status::kCorruption, "save applied", s.ToString());
         }
     }
 
+    return startRaft(leader, log_start_index);
+}
+
+Status Range::Recover(uint64_t apply_index) {
+    apply_index_ = apply_index;
+    auto s = loadMvccVersion();
+    if (!s.ok()) {
+        return s;
+    }
+    return startRaft(0, 0);
+}
+
+Status Range::saveApplyIndex(uint64_t index) {
+    if (store_->IsMvcc()) {
+        return context_->MetaStore()->SaveApplyIndex(id_, index, mvcc_version_);
+    }
+    return context_->MetaStore()->SaveApplyIndex(id_, index);
+}
+
+Status Range::loadMvccVersion() {
+    uint64_t version = 0;
+    auto s = context_->MetaStore()->LoadMvccVersion(id_, &version);
+    if (!s.ok()) {
+        return Status(Status::kCorruption, "load mvcc version", s.ToString());
+    }
+    mvcc_version_ = version;
+    return Status::OK();
+}
+
+Status Range::seedMvccVersion(uint64_t new_range_id) {
+    if (!store_->IsMvcc()) {
+        return Status::OK();
+    }
+    uint64_t version = 0;
+    auto s = context_->MetaStore()->LoadMvccVersion(new_range_id, &version);
+    if (!s.ok() || version >= mvcc_version_) {
+        return s;
+    }
+    return context_->MetaStore()->SaveMvccVersion(new_range_id, mvcc_version_);
+}
+
+Status Range::startRaft(uint64_t leader, uint64_t log_start_index) {
     // 初始化raft
     raft::RaftOptions options;
     options.id = id_;
@@ -59,6 +119,8 @@ Status Range::Initialize(uint64_t leader, uint64_t log_start_index) {
     options.statemachine = shared_from_this();
     options.log_file_size = ds_config.raft_config.log_file_size;
     options.max_log_files = ds_config.raft_config.max_log_files;
+    options.log_preallocate_size = ds_config.raft_config.log_preallocate_size;
+    options.recycle_log_files = ds_config.raft_config.recycle_log_files;
     options.allow_log_corrupt = ds_config.raft_config.allow_log_corrupt > 0;
     options.initial_first_index = log_start_index;
     options.storage_path = JoinFilePath(std::vector<std::string>{
@@ -81,7 +143,7 @@ Status Range::Initialize(uint64_t leader, uint64_t log_start_index) {
     }
 
     // create raft group
-    s = context_->RaftServer()->CreateRaft(options, &raft_);
+    auto s = context_->RaftServer()->CreateRaft(options, &raft_);
     if (!s.ok()) {
         return Status(Status::kInvalidArgument, "create raft", s.ToString());
     }
@@ -117,6 +179,33 @@ void Range::Heartbeat() {
 
     // clear async apply expired task
     ClearExpiredContext();
+
+    if (is_leader_) {
+        CheckpointLocks();
+        ProposeLeaderTime();
+    }
+}
+
+void Range::ProposeLeaderTime() {
+    if (!ds_config.range_config.leader_time_tick) {
+        return;
+    }
+    // 最近一个心跳周期内提交过命令，follower已经能拿到较新的leader_time
+    auto interval_ms = static_cast<int64_t>(ds_config.hb_config.range_interval) * 1000;
+    if (getticks() - last_propose_time_ < interval_ms) {
+        return;
+    }
+
+    raft_cmdpb::Command cmd;
+    // node_id为0，没有等待的请求，apply时不回复
+    cmd.mutable_cmd_id()->set_node_id(0);
+    cmd.mutable_cmd_id()->set_seq(submit_queue_.GetSeq());
+    cmd.set_cmd_type(raft_cmdpb::CmdType::LeaderTime);
+    meta_.GetEpoch(cmd.mutable_verify_epoch());
+    auto ret = Submit(cmd);
+    if (!ret.ok()) {
+        RANGE_LOG_WARN("propose leader time failed: %s", ret.ToString().c_str());
+    }
 }
 
 bool Range::PushHeartBeatMessage() {
@@ -180,6 +269,22 @@ bool Range::PushHeartBeatMessage() {
     stats->set_keys_written(store_stat.keys_write_per_sec);
     stats->set_bytes_written(store_stat.bytes_write_per_sec);
 
+    storage::HotKeysStat hot_keys;
+    store_->CollectHotKeys(&hot_keys, true);
+    auto add_hot_keys = [](const std::vector<storage::HotKey>& keys,
+                           google::protobuf::RepeatedPtrField<mspb::HotKey>* pb_keys) {
+        for (const auto& hk : keys) {
+            auto pb = pb_keys->Add();
+            pb->set_key(hk.key);
+            pb->set_count(hk.count);
+            pb->set_error(hk.error);
+        }
+    };
+    add_hot_keys(hot_keys.read_keys, stats->mutable_hot_read_keys());
+    add_hot_keys(hot_keys.write_keys, stats->mutable_hot_write_keys());
+    add_hot_keys(hot_keys.read_prefixes, stats->mutable_hot_read_prefixes());
+    add_hot_keys(hot_keys.write_prefixes, stats->mutable_hot_write_prefixes());
+
     context_->MasterClient()->AsyncRangeHeartbeat(req);
 
     return true;
@@ -192,7 +297,7 @@ Status Range::Apply(const raft_cmdpb::Command &cmd, uint64_t index) {
 
     switch (cmd.cmd_type()) {
         case raft_cmdpb::CmdType::Lock:
-            return ApplyLock(cmd);
+            return ApplyLock(cmd, index);
         case raft_cmdpb::CmdType::LockUpdate:
             return ApplyLockUpdate(cmd);
         case raft_cmdpb::CmdType::Unlock:
@@ -222,12 +327,38 @@ Status Range::Apply(const raft_cmdpb::Command &cmd, uint64_t index) {
             return ApplyWatchPut(cmd, index);
         case raft_cmdpb::CmdType::KvWatchDel:
             return ApplyWatchDel(cmd, index);
+        case raft_cmdpb::CmdType::RedisCmd:
+            return ApplyRedisCmd(cmd);
+        case raft_cmdpb::CmdType::LeaderTime:
+            return Status::OK();
         default:
             RANGE_LOG_ERROR("Apply cmd type error %s", CmdType_Name(cmd.cmd_type()).c_str());
             return Status(Status::kNotSupported, "cmd type not supported", "");
     }
 }
 
+// 只解析出命令的cmd_id(field 1)，序列化时按字段号排序，cmd_id总是在最前面
+bool Range::peekCmdID(const std::string& cmd, raft_cmdpb::CmdID* cmd_id) {
+    google::protobuf::io::CodedInputStream input(
+        reinterpret_cast<const uint8_t*>(cmd.data()), static_cast<int>(cmd.size()));
+    auto tag = input.ReadTag();
+    if (tag != google::protobuf::internal::WireFormatLite::MakeTag(
+                   raft_cmdpb::Command::kCmdIdFieldNumber,
+                   google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+        return false;
+    }
+    uint32_t len = 0;
+    if (!input.ReadVarint32(&len)) {
+        return false;
+    }
+    auto limit = input.PushLimit(static_cast<int>(len));
+    if (!cmd_id->ParseFromCodedStream(&input) || !input.ConsumedEntireMessage()) {
+        return false;
+    }
+    input.PopLimit(limit);
+    return true;
+}
+
 Status Range::Apply(const std::string &cmd, uint64_t index) {
     if (!valid_) {
         RANGE_LOG_ERROR("is invalid!");
@@ -236,12 +367,31 @@ Status Range::Apply(const std::string &cmd, uint64_t index) {
 
     auto start = std::chrono::system_clock::now();
 
-    raft_cmdpb::Command raft_cmd;
-    common::GetMessage(cmd.data(), cmd.size(), &raft_cmd);
+    // 本节点提交的命令还在提交队列里，直接复用，省去一次反序列化
+    std::shared_ptr<const raft_cmdpb::Command> local_cmd;
+    raft_cmdpb::CmdID cmd_id;
+    if (peekCmdID(cmd, &cmd_id) && cmd_id.node_id() == node_id_) {
+        local_cmd = submit_queue_.GetCommand(cmd_id.seq());
+    }
+    raft_cmdpb::Command parsed_cmd;
+    if (local_cmd == nullptr) {
+        common::GetMessage(cmd.data(), cmd.size(), &parsed_cmd);
+    }
+    const raft_cmdpb::Command& raft_cmd = local_cmd ? *local_cmd : parsed_cmd;
+
+    if (store_->IsMvcc()) {
+        // 写入版本在apply时按日志顺序分配：不低于leader_time，且严格大于前一条命令的版本
+        // 各副本从相同的版本起点(持久化、快照、分裂继承)应用相同的日志，得到相同的版本
+        auto min_version = static_cast<uint64_t>(std::max<int64_t>(raft_cmd.leader_time(), 0));
+        mvcc_version_ = std::max(min_version, mvcc_version_.load() + 1);
+        store_->SetWriteVersion(mvcc_version_);
+    }
 
     Status ret;
     if (raft_cmd.cmd_type() == raft_cmdpb::CmdType::AdminSplit) {
         ret = ApplySplit(raft_cmd, index);
+    } else if (raft_cmd.cmd_type() == raft_cmdpb::CmdType::AdminBatchSplit) {
+        ret = ApplyBatchSplit(raft_cmd, index);
     } else {
         auto ret = Apply(raft_cmd, index);
         // 非IO错误(致命），不给raft返回错误，不然raft会停止自己
@@ -254,7 +404,13 @@ Status Range::Apply(const std::string &cmd, uint64_t index) {
     }
 
     apply_index_ = index;
-    auto s = context_->MetaStore()->SaveApplyIndex(id_, apply_index_);
+    // 不同leader的时钟可能有偏差，只取最大值
+    auto leader_time = raft_cmd.leader_time();
+    auto applied_time = applied_leader_time_.load();
+    while (leader_time > applied_time &&
+           !applied_leader_time_.compare_exchange_weak(applied_time, leader_time)) {
+    }
+    auto s = saveApplyIndex(apply_index_);
     if (!s.ok()) {
         RANGE_LOG_ERROR("save apply index error %s", s.ToString().c_str());
         return s;
@@ -271,8 +427,12 @@ Status Range::Apply(const std::string &cmd, uint64_t index) {
     return Status::OK();
 }
 
-Status Range::Submit(const raft_cmdpb::Command &cmd) {
+Status Range::Submit(raft_cmdpb::Command &cmd) {
     if (is_leader_) {
+        // mvcc的写入版本在apply时由leader_time推出，这里只记录时间，不要求递增
+        auto now = getticks();
+        cmd.set_leader_time(now);
+        last_propose_time_ = now;
         std::string str_cmd = std::move(cmd.SerializeAsString());
         if (str_cmd.empty()) {
             return Status(Status::kCorruption, "protobuf serialize failed", "");
@@ -286,19 +446,18 @@ Status Range::Submit(const raft_cmdpb::Command &cmd) {
 
 Status Range::SubmitCmd(common::ProtoMessage *msg, const kvrpcpb::RequestHeader& header,
                  const std::function<void(raft_cmdpb::Command &cmd)> &init) {
-    raft_cmdpb::Command cmd;
-    init(cmd);
+    auto cmd = std::make_shared<raft_cmdpb::Command>();
+    init(*cmd);
 
     // set verify epoch
     auto epoch = new metapb::RangeEpoch(header.range_epoch());
-    cmd.set_allocated_verify_epoch(epoch);
+    cmd->set_allocated_verify_epoch(epoch);
+    cmd->mutable_cmd_id()->set_node_id(node_id_);
 
-    // add to queue
-    auto seq = submit_queue_.Add(header, cmd.cmd_type(), msg);
-    cmd.mutable_cmd_id()->set_node_id(node_id_);
-    cmd.mutable_cmd_id()->set_seq(seq);
+    // add to queue, 队列里保留命令，apply时复用
+    auto seq = submit_queue_.Add(header, cmd, msg);
 
-    auto ret = Submit(cmd);
+    auto ret = Submit(*cmd);
     if (!ret.ok()) {
         auto ctx = submit_queue_.Remove(seq);
         if (ctx) {
@@ -322,8 +481,14 @@ void Range::OnLeaderChange(uint64_t leader, uint64_t term) {
     if (is_leader_) {
         if (!prev_is_leader) {
             store_->ResetMetric();
+            if (ds_config.range_config.lock_lease_in_memory) {
+                lock_table_.Enable();
+            }
         }
         context_->ScheduleHeartbeat(id_, false);
+    } else if (prev_is_leader) {
+        // 未持久化的续约随之丢弃，持锁者在delete_time之前仍然持有锁
+        lock_table_.Disable();
     }
     context_->Statistics()->ReportLeader(id_, is_leader_.load());
 }
@@ -331,8 +496,9 @@ void Range::OnLeaderChange(uint64_t leader, uint64_t term) {
 std::shared_ptr<raft::Snapshot> Range::GetSnapshot() {
     raft_cmdpb::SnapshotContext ctx;
     meta_.Get(ctx.mutable_meta());
+    ctx.set_mvcc_version(mvcc_version_);
     return std::shared_ptr<raft::Snapshot>(
-        new Snapshot(apply_index_, std::move(ctx), store_->NewIterator()));
+        new Snapshot(apply_index_, std::move(ctx), store_->NewRawIterator()));
 }
 
 Status Range::ApplySnapshotStart(const std::string &context) {
@@ -349,6 +515,8 @@ Status Range::ApplySnapshotStart(const std::string &context) {
     if (!s.ok()) {
         return s;
     }
+    context_->Compactor()->ScheduleRangeDeleted(store_->DBBound(start_key_),
+                                                store_->DBBound(meta_.GetEndKey()));
 
     raft_cmdpb::SnapshotContext ctx;
     if (!ctx.ParseFromString(context)) {
@@ -356,6 +524,7 @@ Status Range::ApplySnapshotStart(const std::string &context) {
     }
 
     meta_.Set(ctx.meta());
+    mvcc_version_ = ctx.mvcc_version();
     s = SaveMeta(ctx.meta()) ;
     if (!s.ok()) {
         RANGE_LOG_ERROR("save snapshot meta failed: %s", s.ToString().c_str());
@@ -385,7 +554,7 @@ Status Range::ApplySnapshotFinish(uint64_t index) {
     }
 
     apply_index_ = index;
-    auto s = context_->MetaStore()->SaveApplyIndex(id_, index);
+    auto s = saveApplyIndex(index);
     if (!s.ok()) {
         RANGE_LOG_ERROR("save snapshot applied index failed(%s)!", s.ToString().c_str());
         return s;
@@ -417,6 +586,8 @@ Status Range::Destroy() {
         RANGE_LOG_ERROR("truncate store fail: %s", s.ToString().c_str());
         return s;
     }
+    context_->Compactor()->ScheduleRangeDeleted(store_->DBBound(start_key_),
+                                                store_->DBBound(meta_.GetEndKey()));
     s = context_->MetaStore()->DeleteApplyIndex(id_);
     if (!s.ok()) {
         RANGE_LOG_ERROR("truncate delete apply fail: %s", s.ToString().c_str());
@@ -438,6 +609,13 @@ void Range::TransferLeader() {
     }
 }
 
+Status Range::TransferLeaderTo(uint64_t node_id) {
+    if (!valid_) {
+        return Status(Status::kNotFound, "range is invalid", std::to_string(id_));
+    }
+    return raft_->TransferLeader(node_id);
+}
+
 void Range::GetPeerInfo(raft::RaftStatus *raft_status) { raft_->GetStatus(raft_status); }
 
 void Range::GetReplica(metapb::Replica *rep) {
@@ -465,12 +643,21 @@ bool Range::VerifyLeader(errorpb::Error *&err) {
     return false;
 }
 
-bool Range::VerifyReadable(uint64_t read_index, errorpb::Error *&err) {
+bool Range::VerifyReadable(const kvrpcpb::RequestHeader &header, errorpb::Error *&err) {
     uint64_t leader, term;
     raft_->GetLeaderTerm(&leader, &term);
+    auto read_index = header.read_index();
+    if (header.read_ts() > 0 && store_->IsMvcc()) {
+        return VerifyReadTs(header.read_ts(), err);
+    }
     // we are leader
     if (leader == node_id_) {
         return true;
+    } else if (header.max_staleness_ms() > 0 && applied_leader_time_ > 0 &&
+               getticks() - applied_leader_time_ <=
+                   static_cast<int64_t>(header.max_staleness_ms())) {
+        // 有界过期读：已应用的数据足够新，不需要read_index
+        return true;
     } else if (read_index != 0) {
         auto current_index = apply_index_;
         if (read_index > current_index) {
@@ -502,6 +689,20 @@ bool Range::CheckWriteable() {
     }
 }
 
+bool Range::AcceptWrite(Status::Code *code) {
+    if (!CheckWriteable()) {
+        *code = Status::kNoLeftSpace;
+        return false;
+    }
+    if (mem_tracker_.HardLimitExceeded()) {
+        RANGE_LOG_ERROR("memory hard limit reached(usage: %" PRId64 "), reject write request",
+                MemTracker::Root()->Usage());
+        *code = Status::kResourceExhaust;
+        return false;
+    }
+    return true;
+}
+
 bool Range::KeyInRange(const std::string &key) {
     if (key < start_key_) {
         RANGE_LOG_WARN("key: %s less than start_key:%s, out of range",
@@ -551,6 +752,15 @@ void Range::ClearExpiredContext() {
 }
 
 
+errorpb::Error *Range::MemoryBusyError() {
+    errorpb::Error *err = new errorpb::Error;
+
+    err->set_message("memory limit exceeded");
+    err->mutable_server_is_busy()->set_reason("memory limit exceeded");
+
+    return err;
+}
+
 errorpb::Error *Range::NoLeaderError() {
     errorpb::Error *err = new errorpb::Error;
 
@@ -615,6 +825,30 @@ errorpb::Error *Range::StaleEpochError(const metapb::RangeEpoch &epoch) {
     return err;
 }
 
+bool Range::VerifyReadTs(uint64_t read_ts, errorpb::Error *&err) {
+    auto gc_window_ms = static_cast<uint64_t>(ds_config.range_config.mvcc_gc_seconds) * 1000;
+    if (read_ts < storage::MvccGCFilterFactory::SafePoint(gc_window_ms)) {
+        err = new errorpb::Error;
+        err->set_message("read_ts is older than mvcc gc safe point");
+        return false;
+    }
+    // 版本按apply顺序严格递增，已分配到read_ts后，之后的写入版本都大于read_ts
+    if (mvcc_version_ >= read_ts) {
+        return true;
+    }
+    err = ReadTsBusyError();
+    return false;
+}
+
+errorpb::Error *Range::ReadTsBusyError() {
+    errorpb::Error *err = new errorpb::Error;
+
+    err->set_message("read_ts not applied yet");
+    err->mutable_server_is_busy()->set_reason("read_ts not applied yet");
+
+    return err;
+}
+
 errorpb::Error *Range::StaleReadIndexError(uint64_t read_index, uint64_t current_index) {
     errorpb::Error *err = new errorpb::Error;
     err->mutable_stale_read_index()->set_read_index(read_index);
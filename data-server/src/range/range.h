@@ -2,11 +2,15 @@ _Pragma("once");
 
 #include <stdint.h>
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "frame/sf_logger.h"
 #include "frame/sf_util.h"
 
+#include "base/mem_tracker.h"
 #include "base/shared_mutex.h"
 #include "base/util.h"
 
@@ -24,6 +28,7 @@ _Pragma("once");
 #include "proto/gen/kvrpcpb.pb.h"
 #include "proto/gen/mspb.pb.h"
 #include "proto/gen/raft_cmdpb.pb.h"
+#include "proto/gen/redispb.pb.h"
 #include "proto/gen/watchpb.pb.h"
 
 #include "server/context_server.h"
@@ -33,6 +38,7 @@ _Pragma("once");
 
 #include "meta_keeper.h"
 #include "context.h"
+#include "lock_table.h"
 #include "submit.h"
 #include "range_logger.h"
 
@@ -66,6 +72,8 @@ public:
     Range &operator=(const Range &) volatile = delete;
 
     Status Initialize(uint64_t leader = 0, uint64_t log_start_index = 0);
+    // 节点启动时恢复已有的range，apply位置由调用方批量加载后传入
+    Status Recover(uint64_t apply_index);
     Status Shutdown();
 
     Status Apply(const std::string &cmd, uint64_t index) override;
@@ -81,10 +89,15 @@ public:
     Status ApplySnapshotFinish(uint64_t index) override;
 
     void TransferLeader();
+    // 把本range的leader转移给node_id上的副本
+    Status TransferLeaderTo(uint64_t node_id);
     void GetPeerInfo(raft::RaftStatus *raft_status);
     uint64_t GetPeerID() const;
 
     Status ForceSplit(uint64_t version, std::string* split_key);
+    // 一次分裂成多个range：keys为空时按key空间平均分成count份
+    Status PreSplit(uint64_t version, std::vector<std::string> keys, uint32_t count,
+                    std::vector<std::string>* split_keys);
 
     // lock
     kvrpcpb::LockValue *LockGet(const std::string &key);
@@ -113,6 +126,9 @@ public:
     void KVRangeDelete(common::ProtoMessage *msg, kvrpcpb::DsKvRangeDeleteRequest &req);
     void KVScan(common::ProtoMessage *msg, kvrpcpb::DsKvScanRequest &req);
 
+    // redis复合类型命令
+    void RedisCmd(common::ProtoMessage *msg, redispb::DsRedisRequest &req);
+
     //KV watch series
     Status GetAndResp( watch::WatcherPtr pWatcher, const watchpb::WatchCreateRequest& req, const std::string &dbKey, const bool &prefix,
                               int64_t &version, watchpb::DsWatchResponse *dsResp);
@@ -138,8 +154,15 @@ public:
     bool DeleteSubmit(common::ProtoMessage *msg, kvrpcpb::DsDeleteRequest &req);
 
 private:
+    Status startRaft(uint64_t leader, uint64_t log_start_index);
     void ClearExpiredContext();
 
+    // mvcc模式下apply位置和写入版本一起保存
+    Status saveApplyIndex(uint64_t index);
+    Status loadMvccVersion();
+    // 分裂出的range继承分裂时的写入版本，已存在(重放分裂日志)时不回退
+    Status seedMvccVersion(uint64_t new_range_id);
+
 private:
     kvrpcpb::KvRawGetResponse *RawGetTry(const std::string &key);
     kvrpcpb::SelectResponse *SelectTry(const kvrpcpb::DsSelectRequest &req);
@@ -148,12 +171,14 @@ private:
     bool DeleteTry(common::ProtoMessage *msg, kvrpcpb::DsDeleteRequest &req);
     
 private:
-    Status Submit(const raft_cmdpb::Command &cmd);
+    // leader提交前在命令中记录当前时间
+    Status Submit(raft_cmdpb::Command &cmd);
 
     Status SubmitCmd(common::ProtoMessage *msg, const kvrpcpb::RequestHeader& header,
                      const std::function<void(raft_cmdpb::Command &cmd)> &init);
 
     Status Apply(const raft_cmdpb::Command &cmd, uint64_t index);
+    static bool peekCmdID(const std::string& cmd, raft_cmdpb::CmdID* cmd_id);
 
     Status ApplyRawPut(const raft_cmdpb::Command &cmd);
     Status ApplyRawDelete(const raft_cmdpb::Command &cmd);
@@ -165,6 +190,7 @@ private:
     Status ApplyDelete(const raft_cmdpb::Command &cmd);
 
     Status ApplySplit(const raft_cmdpb::Command &cmd, uint64_t index);
+    Status ApplyBatchSplit(const raft_cmdpb::Command &cmd, uint64_t index);
 
     Status ApplyAddPeer(const raft::ConfChange &cc, bool *updated);
     Status ApplyDelPeer(const raft::ConfChange &cc, bool *updated);
@@ -176,16 +202,42 @@ private:
     Status ApplyKVBatchDelete(const raft_cmdpb::Command &cmd);
     Status ApplyKVRangeDelete(const raft_cmdpb::Command &cmd);
 
-    Status ApplyLock(const raft_cmdpb::Command &cmd);
+    Status ApplyRedisCmd(const raft_cmdpb::Command &cmd);
+
+    Status ApplyLock(const raft_cmdpb::Command &cmd, uint64_t index);
     Status ApplyLockUpdate(const raft_cmdpb::Command &cmd);
     Status ApplyUnlock(const raft_cmdpb::Command &cmd);
     Status ApplyUnlockForce(const raft_cmdpb::Command &cmd);
 
+    // 在leader的内存锁表中续约，返回false表示需要走raft
+    bool LockRenew(common::ProtoMessage *msg, kvrpcpb::DsLockUpdateRequest &req,
+                   const std::string &encode_key);
+    // 新leader apply追上后才能从存储加载锁
+    bool LockTableReady();
+    // 把内存中的续约批量通过raft持久化
+    void CheckpointLocks();
+
+    // range空闲时提交一个只带leader_time的空命令，让follower的已应用时间继续前进
+    void ProposeLeaderTime();
+
     // split func
     void CheckSplit(uint64_t size);
     void AskSplit(std::string &&key, metapb::Range&& meta, bool force = false);
+    void AskBatchSplit(std::vector<std::string> &&keys, metapb::Range&& meta);
     void ReportSplit(const metapb::Range &new_range);
 
+    // 批量分裂：master每次AskSplit分配一个新range的id，每个分裂点分别请求，
+    // 收齐所有回应后提交一条AdminBatchSplit
+    struct BatchSplitAsk {
+        uint64_t version = 0;
+        std::vector<std::string> keys;
+        std::vector<mspb::AskSplitResponse> resps;  // 与keys一一对应
+        size_t received = 0;
+    };
+    // resp是批量分裂中某个分裂点的回应时返回true
+    bool collectBatchSplit(mspb::AskSplitResponse &resp);
+    void AdminBatchSplit(const BatchSplitAsk &ask);
+
     int64_t checkMaxCount(int64_t maxCount) {
         if (maxCount <= 0) maxCount = std::numeric_limits<int64_t>::max();
         if (maxCount > max_count_) {
@@ -241,6 +293,10 @@ public:
     void GetReplica(metapb::Replica *rep);
     uint64_t GetSplitRangeID() const { return split_range_id_; }
     size_t GetSubmitQueueSize() const { return submit_queue_.Size(); }
+    const MemTracker& GetMemTracker() const { return mem_tracker_; }
+    const LockTable& GetLockTable() const { return lock_table_; }
+    // 只读取，不衰减（衰减在心跳时进行）
+    void GetHotKeys(storage::HotKeysStat *stat) { store_->CollectHotKeys(stat, false); }
 
     void setLeaderFlag(bool flag) {
         is_leader_ = flag;
@@ -248,8 +304,17 @@ public:
 
 private:
     bool VerifyLeader(errorpb::Error *&err);
-    bool VerifyReadable(uint64_t read_index, errorpb::Error *&err);
+    bool VerifyReadable(const kvrpcpb::RequestHeader &header, errorpb::Error *&err);
+    // mvcc快照读：read_ts之前的写入都已应用并且还没有被回收
+    bool VerifyReadTs(uint64_t read_ts, errorpb::Error *&err);
+    // 读取的版本，没有指定read_ts或者不是mvcc存储时读最新版本
+    uint64_t ReadVersion(const kvrpcpb::RequestHeader &header) const {
+        return header.read_ts() > 0 && store_->IsMvcc() ? header.read_ts()
+                                                        : storage::kMaxVersion;
+    }
     bool CheckWriteable();
+    // 检查磁盘空间和内存是否允许写入，不允许时code返回错误码
+    bool AcceptWrite(Status::Code *code);
     bool KeyInRange(const std::string &key);
     bool KeyInRange(const std::string &key, errorpb::Error *&err);
 
@@ -266,6 +331,8 @@ private:
     errorpb::Error *KeyNotInRange(const std::string &key);
     errorpb::Error *StaleEpochError(const metapb::RangeEpoch &epoch);
     errorpb::Error *StaleReadIndexError(uint64_t read_index, uint64_t current_index);
+    errorpb::Error *MemoryBusyError();
+    errorpb::Error *ReadTsBusyError();
 
 private:
     friend class ::sharkstore::test::helper::RangeTestFixture;
@@ -280,6 +347,8 @@ private:
 
 private:
     static const int kTimeTakeWarnThresoldUSec = 500000;
+    // 每次心跳最多持久化的续约个数
+    static const size_t kLockCheckpointBatch = 1000;
 
     RangeContext* context_ = nullptr;
     const uint64_t node_id_ = 0;
@@ -293,13 +362,24 @@ private:
     std::atomic<bool> valid_ = { true };
 
     uint64_t apply_index_ = 0;
+    // 已应用命令中最大的leader_time(ms)，用于有界过期读
+    std::atomic<int64_t> applied_leader_time_ = {0};
+    // leader最近一次提交命令的时间(ms)
+    std::atomic<int64_t> last_propose_time_ = {0};
+    // mvcc模式下最近一次分配的写入版本，apply时按日志顺序递增
+    std::atomic<uint64_t> mvcc_version_ = {0};
     std::atomic<bool> is_leader_ = {false};
 
     uint64_t real_size_ = 0;
     std::atomic<bool> statis_flag_ = {false};
     std::atomic<uint64_t> statis_size_ = {0};
     uint64_t split_range_id_ = 0;
+    std::mutex batch_split_mu_;
+    std::unique_ptr<BatchSplitAsk> batch_split_;
 
+    // 需要在eventBuffer和submit_queue_之前构造
+    MemTracker mem_tracker_;
+    LockTable lock_table_;
     watch::CEventBuffer *eventBuffer = nullptr;
     SubmitQueue submit_queue_;
 
@@ -43,9 +43,10 @@ void Range::RawDelete(common::ProtoMessage *msg, kvrpcpb::DsKvRawDeleteRequest &
 
     RANGE_LOG_DEBUG("RawDelete begin");
 
-    if (!CheckWriteable()) {
+    Status::Code reject_code = Status::kOk;
+    if (!AcceptWrite(&reject_code)) {
         auto resp = new kvrpcpb::DsKvRawDeleteResponse;
-        resp->mutable_resp()->set_code(Status::kNoLeftSpace);
+        resp->mutable_resp()->set_code(reject_code);
         return SendError(msg, req.header(), resp, nullptr);
     }
 
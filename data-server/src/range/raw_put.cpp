@@ -40,9 +40,10 @@ void Range::RawPut(common::ProtoMessage *msg, kvrpcpb::DsKvRawPutRequest &req) {
 
     RANGE_LOG_DEBUG("RawPut begin");
 
-    if (!CheckWriteable()) {
+    Status::Code reject_code = Status::kOk;
+    if (!AcceptWrite(&reject_code)) {
         auto resp = new kvrpcpb::DsKvRawPutResponse;
-        resp->mutable_resp()->set_code(Status::kNoLeftSpace);
+        resp->mutable_resp()->set_code(reject_code);
         return SendError(msg, req.header(), resp, nullptr);
     }
 
@@ -0,0 +1,132 @@
+#include "range.h"
+#include "server/range_server.h"
+
+#include "range_logger.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace range {
+
+using namespace sharkstore::monitor;
+
+static void setRedisReply(const Status &s, redispb::Reply *reply) {
+    reply->set_code(static_cast<int>(s.code()));
+    if (!s.ok()) {
+        reply->set_error(s.ToString());
+    }
+}
+
+// 读命令直接在leader上执行，写命令一个命令一次raft提交
+void Range::RedisCmd(common::ProtoMessage *msg, redispb::DsRedisRequest &req) {
+    context_->Statistics()->PushTime(HistogramType::kQWait,
+                                     get_micro_second() - msg->begin_time);
+
+    auto is_write = storage::Store::IsRedisWrite(req.req().type());
+    if (is_write) {
+        Status::Code reject_code = Status::kOk;
+        if (!AcceptWrite(&reject_code)) {
+            auto resp = new redispb::DsRedisResponse;
+            resp->mutable_resp()->set_code(reject_code);
+            return SendError(msg, req.header(), resp, nullptr);
+        }
+    }
+
+    auto &key = req.req().key();
+    errorpb::Error *err = nullptr;
+
+    do {
+        if (!VerifyLeader(err)) {
+            RANGE_LOG_WARN("RedisCmd error: %s", err->message().c_str());
+            break;
+        }
+
+        if (key.empty() || !KeyInRange(key, err)) {
+            RANGE_LOG_WARN("RedisCmd error: %s", err->message().c_str());
+            break;
+        }
+
+        if (!is_write) {
+            auto ds_resp = new redispb::DsRedisResponse;
+            auto btime = get_micro_second();
+            auto ret = store_->RedisRead(req.req(), ds_resp->mutable_resp());
+            context_->Statistics()->PushTime(HistogramType::kStore,
+                                             get_micro_second() - btime);
+            setRedisReply(ret, ds_resp->mutable_resp());
+
+            common::SetResponseHeader(req.header(), ds_resp->mutable_header(), nullptr);
+            context_->SocketSession()->Send(msg, ds_resp);
+            return;
+        }
+
+        auto epoch = req.header().range_epoch();
+        if (!EpochIsEqual(epoch, err)) {
+            RANGE_LOG_WARN("RedisCmd error: %s", err->message().c_str());
+            break;
+        }
+
+        auto ret = SubmitCmd(msg, req.header(), [&req](raft_cmdpb::Command &cmd) {
+            cmd.set_cmd_type(raft_cmdpb::CmdType::RedisCmd);
+            cmd.set_allocated_redis_cmd(req.release_req());
+        });
+
+        if (!ret.ok()) {
+            RANGE_LOG_ERROR("RedisCmd raft submit error: %s", ret.ToString().c_str());
+
+            err = RaftFailError();
+        }
+    } while (false);
+
+    if (err != nullptr) {
+        auto resp = new redispb::DsRedisResponse;
+        SendError(msg, req.header(), resp, err);
+    }
+}
+
+Status Range::ApplyRedisCmd(const raft_cmdpb::Command &cmd) {
+    Status ret;
+    errorpb::Error *err = nullptr;
+    redispb::Reply reply;
+
+    auto &req = cmd.redis_cmd();
+    auto btime = get_micro_second();
+    do {
+        auto &epoch = cmd.verify_epoch();
+        if (!EpochIsEqual(epoch, err)) {
+            RANGE_LOG_WARN("ApplyRedisCmd error: %s", err->message().c_str());
+            break;
+        }
+
+        ret = store_->RedisWrite(req, &reply);
+        context_->Statistics()->PushTime(HistogramType::kStore, get_micro_second() - btime);
+        if (!ret.ok()) {
+            // 类型不匹配等命令错误在所有副本上结果一致，只返回给客户端
+            RANGE_LOG_WARN("ApplyRedisCmd %s failed: %s",
+                           redispb::CmdType_Name(req.type()).c_str(), ret.ToString().c_str());
+        }
+
+        if (cmd.cmd_id().node_id() == node_id_) {
+            uint64_t len = req.key().size();
+            for (const auto &f : req.fields()) {
+                len += f.size();
+            }
+            for (const auto &v : req.values()) {
+                len += v.size();
+            }
+            CheckSplit(len);
+        }
+    } while (false);
+
+    if (cmd.cmd_id().node_id() == node_id_) {
+        auto resp = new redispb::DsRedisResponse;
+        resp->mutable_resp()->Swap(&reply);
+        setRedisReply(ret, resp->mutable_resp());
+        ReplySubmit(cmd, resp, err, btime);
+    } else if (err != nullptr) {
+        delete err;
+    }
+    return ret;
+}
+
+}  // namespace range
+}  // namespace dataserver
+}  // namespace sharkstore
@@ -15,7 +15,7 @@ kvrpcpb::SelectResponse *Range::SelectResp(const kvrpcpb::DsSelectRequest &req)
 
     if (is_leader_ && (key.empty() || KeyInRange(key))) {
         auto resp = new kvrpcpb::SelectResponse;
-        auto ret = store_->Select(req.req(), resp);
+        auto ret = store_->Select(req.req(), resp, ReadVersion(req.header()));
         if (ret.ok()) {
             resp->set_code(0);
         } else {
@@ -49,7 +49,7 @@ void Range::Select(common::ProtoMessage *msg, kvrpcpb::DsSelectRequest &req) {
     RANGE_LOG_DEBUG("Select begin");
 
     do {
-        if (!VerifyReadable(req.header().read_index(), err)) {
+        if (!VerifyReadable(req.header(), err)) {
             break;
         }
 
@@ -85,7 +85,7 @@ void Range::Select(common::ProtoMessage *msg, kvrpcpb::DsSelectRequest &req) {
         auto resp = ds_resp->mutable_resp();
 
         auto btime = get_micro_second();
-        auto ret = store_->Select(req.req(), resp);
+        auto ret = store_->Select(req.req(), resp, ReadVersion(req.header()));
         auto etime = get_micro_second();
         context_->Statistics()->PushTime(HistogramType::kStore, etime - btime);
 
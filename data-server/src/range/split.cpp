@@ -1,5 +1,6 @@
 #include "range.h"
 
+#include <algorithm>
 #include <sstream>
 #include "frame/sf_util.h"
 #include "master/worker.h"
@@ -14,6 +15,30 @@ namespace sharkstore {
 namespace dataserver {
 namespace range {
 
+// 按master分配的id构造分裂出的新range，本节点的副本放在第一个
+static void buildSplitRange(metapb::Range *range, uint64_t node_id, uint64_t new_range_id,
+                            const google::protobuf::RepeatedField<uint64_t> &new_peer_ids,
+                            const std::string &start_key, const std::string &end_key) {
+    range->set_id(new_range_id);
+    range->set_start_key(start_key);
+    range->set_end_key(end_key);
+
+    auto epoch = range->mutable_range_epoch();
+    epoch->set_conf_ver(1);
+    epoch->set_version(1);
+
+    auto p0 = range->mutable_peers(0);
+    for (int i = 0; i < range->peers_size(); i++) {
+        auto px = range->mutable_peers(i);
+        px->set_id(new_peer_ids.Get(i));
+
+        // Don't consider the role
+        if (i > 0 && px->node_id() == node_id) {
+            p0->Swap(px);
+        }
+    }
+}
+
 void Range::CheckSplit(uint64_t size) {
     statis_size_ += size;
 
@@ -90,6 +115,32 @@ void Range::AskSplit(std::string &&key, metapb::Range&& meta, bool force) {
     context_->MasterClient()->AsyncAskSplit(ask);
 }
 
+void Range::AskBatchSplit(std::vector<std::string> &&keys, metapb::Range&& meta) {
+    assert(!keys.empty());
+
+    RANGE_LOG_INFO("AskBatchSplit, version: %" PRIu64 ", keys: %zu, first: %s, last: %s",
+            meta.range_epoch().version(), keys.size(), EncodeToHex(keys.front()).c_str(),
+            EncodeToHex(keys.back()).c_str());
+
+    std::unique_ptr<BatchSplitAsk> ask(new BatchSplitAsk);
+    ask->version = meta.range_epoch().version();
+    ask->keys = keys;
+    ask->resps.resize(keys.size());
+    {
+        // 替换掉之前还没收齐的请求
+        std::lock_guard<std::mutex> lock(batch_split_mu_);
+        batch_split_ = std::move(ask);
+    }
+
+    for (auto &key : keys) {
+        mspb::AskSplitRequest req;
+        *req.mutable_range() = meta;
+        req.set_split_key(std::move(key));
+        req.set_force(true);
+        context_->MasterClient()->AsyncAskSplit(req);
+    }
+}
+
 void Range::ReportSplit(const metapb::Range &new_range) {
     mspb::ReportSplitRequest report;
     meta_.Get(report.mutable_left());
@@ -103,6 +154,10 @@ void Range::AdminSplit(mspb::AskSplitResponse &resp) {
         return;
     }
 
+    if (collectBatchSplit(resp)) {
+        return;
+    }
+
     auto &split_key = resp.split_key();
 
     RANGE_LOG_INFO(
@@ -143,33 +198,90 @@ void Range::AdminSplit(mspb::AskSplitResponse &resp) {
     // no need set con_ver;con_ver is member change
     // split_req->mutable_epoch()->set_version(epoch->conf_ver());
 
-    // set range id
-    range->set_id(resp.new_range_id());
-    // set range start_key
-    range->set_start_key(split_key);
     // range end_key doesn't need to change.
+    auto end_key = range->end_key();
+    buildSplitRange(range, node_id_, resp.new_range_id(), resp.new_peer_ids(), split_key,
+                    end_key);
 
-    // set range_epoch
-    epoch->set_conf_ver(1);
-    epoch->set_version(1);
+    split_req->set_allocated_new_range(range);
 
-    auto p0 = range->mutable_peers(0);
-    // set range peers
-    for (int i = 0; i < psize; i++) {
-        auto px = range->mutable_peers(i);
-        px->set_id(resp.new_peer_ids(i));
+    auto ret = Submit(cmd);
+    if (!ret.ok()) {
+        RANGE_LOG_ERROR("AdminSplit raft submit error: %s", ret.ToString().c_str());
+    }
+}
 
-        // Don't consider the role
-        if (i > 0 && px->node_id() == node_id_) {
-            p0->Swap(px);
+bool Range::collectBatchSplit(mspb::AskSplitResponse &resp) {
+    std::unique_ptr<BatchSplitAsk> ask;
+    {
+        std::lock_guard<std::mutex> lock(batch_split_mu_);
+        if (batch_split_ == nullptr) {
+            return false;
+        }
+        // 调用前已检查resp的版本跟当前一致，不一致说明批量分裂的请求已经过期
+        if (resp.range().range_epoch().version() != batch_split_->version) {
+            batch_split_.reset();
+            return false;
+        }
+        const auto &keys = batch_split_->keys;
+        auto it = std::lower_bound(keys.begin(), keys.end(), resp.split_key());
+        if (it == keys.end() || *it != resp.split_key()) {
+            return false;
+        }
+        auto &slot = batch_split_->resps[it - keys.begin()];
+        if (!slot.has_range()) {
+            slot.Swap(&resp);
+            ++batch_split_->received;
+        }
+        if (batch_split_->received < keys.size()) {
+            return true;
         }
+        ask = std::move(batch_split_);
     }
+    AdminBatchSplit(*ask);
+    return true;
+}
 
-    split_req->set_allocated_new_range(range);
+void Range::AdminBatchSplit(const BatchSplitAsk &ask) {
+    const auto &range = ask.resps[0].range();
+    const auto &keys = ask.keys;
+
+    RANGE_LOG_INFO("AdminBatchSplit split into %zu ranges, first new_range_id: %" PRIu64,
+            keys.size() + 1, ask.resps[0].new_range_id());
+
+    raft_cmdpb::Command cmd;
+    cmd.mutable_cmd_id()->set_node_id(node_id_);
+    cmd.mutable_cmd_id()->set_seq(submit_queue_.GetSeq());
+    cmd.set_cmd_type(raft_cmdpb::CmdType::AdminBatchSplit);
+    cmd.set_allocated_verify_epoch(new metapb::RangeEpoch(range.range_epoch()));
+
+    auto split_req = cmd.mutable_admin_batch_split_req();
+    split_req->set_leader(node_id_);
+    // 相当于从右往左连续分裂了keys.size()次
+    split_req->mutable_epoch()->set_version(range.range_epoch().version() + keys.size());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const auto &resp = ask.resps[i];
+        if (resp.new_peer_ids_size() != range.peers_size()) {
+            RANGE_LOG_WARN("AdminBatchSplit peers_size no equal");
+            return;
+        }
+        if (keys[i] <= (i == 0 ? range.start_key() : keys[i - 1]) ||
+            keys[i] >= range.end_key()) {
+            RANGE_LOG_WARN("AdminBatchSplit invalid split key: %s", EncodeToHex(keys[i]).c_str());
+            return;
+        }
+        split_req->add_split_keys(keys[i]);
+
+        auto new_range = split_req->add_new_ranges();
+        *new_range = range;
+        buildSplitRange(new_range, node_id_, resp.new_range_id(), resp.new_peer_ids(), keys[i],
+                        i + 1 < keys.size() ? keys[i + 1] : range.end_key());
+    }
 
     auto ret = Submit(cmd);
     if (!ret.ok()) {
-        RANGE_LOG_ERROR("AdminSplit raft submit error: %s", ret.ToString().c_str());
+        RANGE_LOG_ERROR("AdminBatchSplit raft submit error: %s", ret.ToString().c_str());
     }
 }
 
@@ -193,6 +305,13 @@ Status Range::ApplySplit(const raft_cmdpb::Command &cmd, uint64_t index) {
         return ret;
     }
 
+    ret = seedMvccVersion(req.new_range().id());
+    if (!ret.ok()) {
+        RANGE_LOG_ERROR("ApplySplit(new range: %" PRIu64 ") save mvcc version failed: %s",
+                        req.new_range().id(), ret.ToString().c_str());
+        return ret;
+    }
+
     context_->Statistics()->IncrSplitCount();
 
     ret = context_->SplitRange(id_, req, index);
@@ -229,6 +348,80 @@ Status Range::ApplySplit(const raft_cmdpb::Command &cmd, uint64_t index) {
     return ret;
 }
 
+Status Range::ApplyBatchSplit(const raft_cmdpb::Command &cmd, uint64_t index) {
+    const auto& req = cmd.admin_batch_split_req();
+    RANGE_LOG_INFO("ApplyBatchSplit Begin, version: %" PRIu64 ", index: %" PRIu64
+            ", new ranges: %d", meta_.GetVersion(), index, req.new_ranges_size());
+
+    if (req.split_keys_size() == 0 || req.split_keys_size() != req.new_ranges_size()) {
+        RANGE_LOG_ERROR("ApplyBatchSplit invalid request: %s", req.ShortDebugString().c_str());
+        return Status::OK();
+    }
+    for (const auto& key : req.split_keys()) {
+        auto ret = meta_.CheckSplit(key, cmd.verify_epoch().version());
+        if (ret.code() == Status::kStaleEpoch || ret.code() == Status::kOutOfBound) {
+            RANGE_LOG_WARN("ApplyBatchSplit check failed: %s", ret.ToString().c_str());
+            return Status::OK();
+        } else if (!ret.ok()) {
+            RANGE_LOG_ERROR("ApplyBatchSplit check failed: %s", ret.ToString().c_str());
+            return ret;
+        }
+    }
+
+    for (const auto& new_range : req.new_ranges()) {
+        auto ret = seedMvccVersion(new_range.id());
+        if (!ret.ok()) {
+            RANGE_LOG_ERROR("ApplyBatchSplit(new range: %" PRIu64 ") save mvcc version failed: %s",
+                            new_range.id(), ret.ToString().c_str());
+            return ret;
+        }
+    }
+
+    context_->Statistics()->IncrSplitCount();
+
+    auto ret = context_->BatchSplitRange(id_, req, index);
+    if (!ret.ok()) {
+        RANGE_LOG_ERROR("ApplyBatchSplit create failed: %s", ret.ToString().c_str());
+        return ret;
+    }
+
+    const auto& first_key = req.split_keys(0);
+    meta_.Split(first_key, req.epoch().version());
+    store_->SetEndKey(first_key);
+    split_range_id_ = req.new_ranges(0).id();
+
+    if (req.leader() == node_id_) {
+        auto count = static_cast<uint64_t>(req.new_ranges_size());
+        auto rsize = real_size_ / (count + 1);
+
+        // 按从右往左逐个分裂的顺序上报，每次上报的左边range版本递增
+        mspb::ReportSplitRequest report;
+        meta_.Get(report.mutable_left());
+        auto left = report.mutable_left();
+        for (auto i = req.new_ranges_size() - 1; i >= 0; --i) {
+            const auto& new_range = req.new_ranges(i);
+            left->set_end_key(new_range.start_key());
+            left->mutable_range_epoch()->set_version(req.epoch().version() - i);
+            *report.mutable_right() = new_range;
+            context_->MasterClient()->AsyncReportSplit(report);
+
+            context_->ScheduleHeartbeat(new_range.id(), false);
+            auto rng = context_->FindRange(new_range.id());
+            if (rng != nullptr) {
+                rng->SetRealSize(rsize);
+            }
+        }
+        real_size_ = rsize;
+    }
+
+    context_->Statistics()->DecrSplitCount();
+
+    RANGE_LOG_INFO("ApplyBatchSplit End. version:%" PRIu64 ", end key: %s", meta_.GetVersion(),
+            EncodeToHex(first_key).c_str());
+
+    return Status::OK();
+}
+
 Status Range::ForceSplit(uint64_t version, std::string *result_split_key) {
     auto meta = meta_.Get();
     // check version when version ne zero
@@ -266,6 +459,36 @@ Status Range::ForceSplit(uint64_t version, std::string *result_split_key) {
     return Status::OK();
 }
 
+Status Range::PreSplit(uint64_t version, std::vector<std::string> keys, uint32_t count,
+                       std::vector<std::string> *split_keys) {
+    auto meta = meta_.Get();
+    if (version != 0 && meta.range_epoch().version() != version) {
+        std::ostringstream ss;
+        ss << "request version: " << version << ", ";
+        ss << "current version: " << meta.range_epoch().version();
+        return Status(Status::kStaleEpoch, "pre split", ss.str());
+    }
+    if (!is_leader_) {
+        return Status(Status::kNotLeader, "pre split", std::to_string(id_));
+    }
+
+    if (keys.empty()) {
+        keys = FindSplitKeys(meta.start_key(), meta.end_key(), count);
+    }
+    if (keys.empty()) {
+        return Status(Status::kInvalidArgument, "pre split", "no split keys");
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] <= (i == 0 ? meta.start_key() : keys[i - 1]) || keys[i] >= meta.end_key()) {
+            return Status(Status::kInvalidArgument, "pre split key", EncodeToHex(keys[i]));
+        }
+    }
+
+    *split_keys = keys;
+    AskBatchSplit(std::move(keys), std::move(meta));
+    return Status::OK();
+}
+
 }  // namespace range
 }  // namespace dataserver
 }  // namespace sharkstore
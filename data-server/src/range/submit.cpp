@@ -9,12 +9,14 @@ namespace dataserver {
 namespace range {
 
 SubmitContext::SubmitContext(const kvrpcpb::RequestHeader &req_header,
-        raft_cmdpb::CmdType type, common::ProtoMessage *msg) :
+        const std::shared_ptr<raft_cmdpb::Command>& cmd, common::ProtoMessage *msg) :
     cluster_id_(req_header.cluster_id()),
     trace_id_(req_header.trace_id()),
     create_time_(get_micro_second()),
-    type_(type),
-    msg_(msg) {
+    type_(cmd->cmd_type()),
+    cmd_(cmd),
+    msg_(msg),
+    mem_bytes_(cmd->ByteSizeLong() + (msg != nullptr ? msg->MemBytes() : 0)) {
 }
 
 SubmitContext::~SubmitContext() {
@@ -54,17 +56,26 @@ void SubmitContext::CheckExecuteTime(uint64_t rangeID, int64_t thresold_usecs) {
 }
 
 
+// seq从启动时的微秒时间开始递增，单个range每秒提交的命令远少于一百万条，
+// 所以重启后的seq不会跟重启前写入raft日志的命令重复，
+// apply时可以安全地通过cmd_id找到本地提交的命令
+SubmitQueue::SubmitQueue(MemTracker* mem_parent) :
+    seq_(static_cast<uint64_t>(get_micro_second())),
+    mem_tracker_("submit_queue", mem_parent != nullptr ? mem_parent : MemTracker::Root()) {}
+
 uint64_t SubmitQueue::GetSeq() {
     std::lock_guard<std::mutex> lock(mu_);
     return ++seq_;
 }
 
 uint64_t SubmitQueue::Add(const kvrpcpb::RequestHeader& req_header,
-             raft_cmdpb::CmdType type, common::ProtoMessage *msg) {
-    SubmitContextPtr ctx(new SubmitContext(req_header, type, msg));
+             const std::shared_ptr<raft_cmdpb::Command>& cmd, common::ProtoMessage *msg) {
+    SubmitContextPtr ctx(new SubmitContext(req_header, cmd, msg));
+    mem_tracker_.Consume(ctx->MemBytes());
 
     std::lock_guard<std::mutex> lock(mu_);
-    ctx_map_.emplace(++seq_, std::move(ctx));
+    cmd->mutable_cmd_id()->set_seq(++seq_);
+    ctx_map_.emplace(seq_, std::move(ctx));
     expire_que_.emplace(msg->expire_time, seq_);
     return seq_;
 }
@@ -76,10 +87,20 @@ std::unique_ptr<SubmitContext> SubmitQueue::Remove(uint64_t seq_id) {
     if (it != ctx_map_.end()) {
         ret = std::move(it->second);
         ctx_map_.erase(it);
+        mem_tracker_.Release(ret->MemBytes());
     }
     return ret;
 }
 
+std::shared_ptr<const raft_cmdpb::Command> SubmitQueue::GetCommand(uint64_t seq_id) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = ctx_map_.find(seq_id);
+    if (it != ctx_map_.end()) {
+        return it->second->Command();
+    }
+    return nullptr;
+}
+
 std::vector<uint64_t> SubmitQueue::GetExpired(size_t max_count) {
     std::vector<uint64_t> result;
     auto now = getticks();
@@ -1,10 +1,13 @@
 _Pragma("once");
 
+#include <memory>
 #include <queue>
 #include <vector>
 #include <unordered_map>
 #include <mutex>
 
+#include "base/block_pool.h"
+#include "base/mem_tracker.h"
 #include "proto/gen/raft_cmdpb.pb.h"
 #include "common/socket_session.h"
 
@@ -15,10 +18,10 @@ namespace range {
 // 提交raft命令之前创建一个SubmitContext保存上下文到队列中
 // 等复制并Apply完成后，再从队列里拿出来给客户端回应
 
-class SubmitContext {
+class SubmitContext : public PoolAllocated<SubmitContext> {
 public:
     SubmitContext(const kvrpcpb::RequestHeader &req_header,
-            raft_cmdpb::CmdType type, common::ProtoMessage *msg);
+            const std::shared_ptr<raft_cmdpb::Command>& cmd, common::ProtoMessage *msg);
 
     ~SubmitContext();
 
@@ -26,9 +29,13 @@ public:
     SubmitContext& operator=(const SubmitContext&) = delete;
 
     common::ProtoMessage* Msg() const { return msg_; }
+    // 入队时请求占用的内存，用于内存统计
+    int64_t MemBytes() const { return mem_bytes_; }
     void ClearMsg() { msg_ = nullptr; }
     int64_t CreateTime() const { return create_time_; }
     raft_cmdpb::CmdType Type() const { return type_; }
+    // 提交的命令，leader本地apply时直接使用，不用再从raft日志中解析
+    const std::shared_ptr<raft_cmdpb::Command>& Command() const { return cmd_; }
 
     template <class ResponseT>
     void Reply(common::SocketSession* session, ResponseT* resp, errorpb::Error *err = nullptr) {
@@ -56,12 +63,15 @@ private:
 
     int64_t create_time_ = 0;
     raft_cmdpb::CmdType type_;
+    std::shared_ptr<raft_cmdpb::Command> cmd_;
     common::ProtoMessage *msg_ = nullptr;
+    int64_t mem_bytes_ = 0;
 };
 
 class SubmitQueue {
 public:
-    SubmitQueue() = default;
+    // mem_parent: 内存统计的父节点，nullptr时挂在根节点下
+    explicit SubmitQueue(MemTracker* mem_parent = nullptr);
     ~SubmitQueue() = default;
 
     SubmitQueue(const SubmitQueue&) = delete;
@@ -70,14 +80,19 @@ public:
     // 只获取一个递增的ID, for split command
     uint64_t GetSeq();
 
+    // 设置cmd的cmd_id.seq并加入队列，返回seq
     uint64_t Add(const kvrpcpb::RequestHeader& req_header,
-                 raft_cmdpb::CmdType type, common::ProtoMessage *msg);
+                 const std::shared_ptr<raft_cmdpb::Command>& cmd, common::ProtoMessage *msg);
 
     std::unique_ptr<SubmitContext> Remove(uint64_t seq_id);
 
+    // 获取还在队列中的已提交命令，不存在返回nullptr
+    std::shared_ptr<const raft_cmdpb::Command> GetCommand(uint64_t seq_id) const;
+
     std::vector<uint64_t> GetExpired(size_t max_count = 10000);
 
     size_t Size() const;
+    int64_t MemBytes() const { return mem_tracker_.Usage(); }
 
 private:
     using ExpirePair = std::pair<time_t, uint64_t>;
@@ -89,6 +104,8 @@ private:
     ContextMap ctx_map_;
     ExpireQueue expire_que_;
     mutable std::mutex mu_;
+
+    MemTracker mem_tracker_;
 };
 
 }  // namespace range
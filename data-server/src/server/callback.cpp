@@ -34,6 +34,7 @@ void ds_worker_deal_callback(request_buff_t *request, void *args) {
                    request->session_id, req->header.msg_id, req->header.func_id,
                    req->header.body_len);
 
+        cs->run_status->IncrRequest(req->header.func_id);
         cs->worker->Push(req);
     }
 }
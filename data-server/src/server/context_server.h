@@ -11,6 +11,7 @@ namespace dataserver {
 
 namespace storage {
 class MetaStore;
+class Compactor;
 }
 
 namespace master {
@@ -24,6 +25,7 @@ class Manager;
 class RunStatus;
 class RangeServer;
 class RunStatus;
+class LeaderBalancer;
 
 struct ContextServer {
     uint64_t node_id = 0;
@@ -40,6 +42,8 @@ struct ContextServer {
     std::shared_ptr<rocksdb::Cache> row_cache; // rocksdb row cache
     std::shared_ptr<rocksdb::Statistics> db_stats; // rocksdb stats
     storage::MetaStore *meta_store = nullptr;
+    storage::Compactor *compactor = nullptr;
+    LeaderBalancer *leader_balancer = nullptr;
 
     raft::RaftServer *raft_server = nullptr;
 };
@@ -0,0 +1,276 @@
+#include "leader_balancer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/util.h"
+#include "frame/sf_logger.h"
+#include "monitor/metrics.h"
+#include "range_server.h"
+#include "run_status.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace server {
+
+namespace {
+
+// 超过几轮间隔没有更新的节点分布不再使用
+static const uint64_t kLoadExpireRounds = 3;
+
+struct BalancerMetrics {
+    monitor::metrics::Counter* transfers;
+    monitor::metrics::Gauge* skew;
+    monitor::metrics::Histogram* converge;
+
+    BalancerMetrics() {
+        auto registry = monitor::metrics::Registry::Default();
+        transfers = registry->AddCounter("sharkstore_ds_leader_transfers_total",
+                                         "Leader transfers started by the leader balancer.")
+                        ->WithLabels({});
+        skew = registry->AddGauge("sharkstore_ds_leader_skew_percent",
+                                  "Max leader ratio gap to replica nodes in percent.")
+                   ->WithLabels({});
+        // 单位毫秒：1s ~ 1h
+        converge = registry->AddHistogram(
+                               "sharkstore_ds_leader_converge_seconds",
+                               "Time from leader skew detected to balanced.", {},
+                               {1000, 5000, 10000, 30000, 60000, 300000, 600000, 1800000,
+                                3600000},
+                               1e-3)
+                       ->WithLabels({});
+    }
+};
+
+BalancerMetrics& balancerMetrics() {
+    static BalancerMetrics metrics;
+    return metrics;
+}
+
+double leaderRatio(uint64_t leaders, uint64_t rafts) {
+    return rafts == 0 ? 0 : static_cast<double>(leaders) * 100 / rafts;
+}
+
+uint64_t elapsedMsec(LeaderBalancer::Clock::time_point from,
+                     LeaderBalancer::Clock::time_point to) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count());
+}
+
+}  // namespace
+
+LeaderBalancer::LeaderBalancer(ContextServer* context, const LeaderBalancerOptions& opt)
+    : context_(context), opt_(opt) {}
+
+LeaderBalancer::~LeaderBalancer() { Stop(); }
+
+void LeaderBalancer::Start() {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (running_ || opt_.interval_msec == 0) {
+        return;
+    }
+    running_ = true;
+    thr_ = std::thread(&LeaderBalancer::run, this);
+    AnnotateThread(thr_.native_handle(), "leader_balance");
+}
+
+void LeaderBalancer::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    cond_.notify_all();
+    if (thr_.joinable()) {
+        thr_.join();
+    }
+}
+
+void LeaderBalancer::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            cond_.wait_for(lock, std::chrono::milliseconds(opt_.interval_msec),
+                           [this] { return !running_; });
+            if (!running_) {
+                return;
+            }
+        }
+        balance();
+    }
+}
+
+void LeaderBalancer::balance() {
+    raft::NodeLoad local;
+    local.leader_count = context_->run_status->GetLeaderCount();
+    local.raft_count = context_->range_server->GetRangesSize();
+
+    std::map<uint64_t, raft::NodeLoad> peers;
+    context_->raft_server->GetNodeLoads(&peers);
+
+    std::vector<LeaderCandidate> candidates;
+    collectCandidates(&candidates);
+
+    auto transfers = Plan(local, peers, candidates, Clock::now());
+    for (const auto& t : transfers) {
+        auto rng = context_->range_server->Find(t.range_id);
+        if (rng == nullptr) {
+            continue;
+        }
+        auto s = rng->TransferLeaderTo(t.to_node);
+        if (!s.ok()) {
+            FLOG_WARN("leader balance: range[%" PRIu64 "] transfer leader to node %" PRIu64
+                      " failed: %s",
+                      t.range_id, t.to_node, s.ToString().c_str());
+        } else {
+            FLOG_INFO("leader balance: range[%" PRIu64 "] transfer leader to node %" PRIu64
+                      ", local leaders: %" PRIu64 "/%" PRIu64,
+                      t.range_id, t.to_node, local.leader_count, local.raft_count);
+        }
+    }
+}
+
+void LeaderBalancer::collectCandidates(std::vector<LeaderCandidate>* candidates) const {
+    std::vector<std::shared_ptr<range::Range>> ranges;
+    context_->range_server->GetRanges(&ranges);
+    for (const auto& rng : ranges) {
+        raft::RaftStatus status;
+        rng->GetPeerInfo(&status);
+        if (status.leader != context_->node_id) {
+            continue;
+        }
+
+        LeaderCandidate c;
+        c.range_id = rng->options().id();
+        for (const auto& pr : status.replicas) {
+            const auto& rs = pr.second;
+            if (pr.first == context_->node_id || rs.peer.type != raft::PeerType::kNormal ||
+                rs.snapshotting || rs.inactive_seconds > 0 || rs.match < status.commit) {
+                continue;
+            }
+            c.nodes.push_back(pr.first);
+        }
+        if (!c.nodes.empty()) {
+            candidates->push_back(std::move(c));
+        }
+    }
+}
+
+std::vector<LeaderTransfer> LeaderBalancer::Plan(
+    const raft::NodeLoad& local, const std::map<uint64_t, raft::NodeLoad>& peers,
+    const std::vector<LeaderCandidate>& candidates, Clock::time_point now) {
+    std::vector<LeaderTransfer> transfers;
+    std::lock_guard<std::mutex> lock(mu_);
+
+    auto interval = std::chrono::milliseconds(opt_.interval_msec);
+    auto local_ratio = leaderRatio(local.leader_count, local.raft_count);
+
+    // 有效期内的节点分布，本轮的转移会计入其中
+    std::map<uint64_t, raft::NodeLoad> loads;
+    double skew = 0;
+    for (const auto& kv : peers) {
+        const auto& load = kv.second;
+        if (load.raft_count == 0 || now - load.update_time > kLoadExpireRounds * interval) {
+            continue;
+        }
+        skew = std::max(skew, std::fabs(local_ratio - leaderRatio(load.leader_count,
+                                                                  load.raft_count)));
+        // 之前向它转移过，分布还没有在心跳中更新
+        auto it = node_transfer_time_.find(kv.first);
+        if (it != node_transfer_time_.end() && load.update_time < it->second + interval / 2) {
+            continue;
+        }
+        loads.emplace(kv.first, load);
+    }
+    updateSkew(static_cast<uint64_t>(skew), now);
+
+    for (auto it = range_cooldown_.begin(); it != range_cooldown_.end();) {
+        if (it->second <= now) {
+            it = range_cooldown_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto leaders = local.leader_count;
+    for (const auto& c : candidates) {
+        if (transfers.size() >= opt_.max_transfers || leaders == 0) {
+            break;
+        }
+        if (range_cooldown_.count(c.range_id) > 0) {
+            continue;
+        }
+
+        // 选leader比例最低、转移后不会反超本节点的副本节点
+        auto ratio = leaderRatio(leaders, local.raft_count);
+        auto after = leaderRatio(leaders - 1, local.raft_count);
+        raft::NodeLoad* target = nullptr;
+        uint64_t target_node = 0;
+        double target_ratio = 0;
+        for (auto node : c.nodes) {
+            auto it = loads.find(node);
+            if (it == loads.end()) {
+                continue;
+            }
+            auto& load = it->second;
+            auto peer_ratio = leaderRatio(load.leader_count, load.raft_count);
+            if (ratio - peer_ratio <= opt_.tolerance_percent ||
+                leaderRatio(load.leader_count + 1, load.raft_count) > after) {
+                continue;
+            }
+            if (target == nullptr || peer_ratio < target_ratio) {
+                target = &load;
+                target_node = node;
+                target_ratio = peer_ratio;
+            }
+        }
+        if (target == nullptr) {
+            continue;
+        }
+
+        LeaderTransfer t;
+        t.range_id = c.range_id;
+        t.to_node = target_node;
+        transfers.push_back(t);
+
+        --leaders;
+        ++target->leader_count;
+        range_cooldown_[c.range_id] = now + std::chrono::milliseconds(opt_.range_cooldown_msec);
+        node_transfer_time_[target_node] = now;
+    }
+
+    stats_.transfer_count += transfers.size();
+    balancerMetrics().transfers->Inc(transfers.size());
+    return transfers;
+}
+
+void LeaderBalancer::updateSkew(uint64_t skew_percent, Clock::time_point now) {
+    stats_.skew_percent = skew_percent;
+    balancerMetrics().skew->Set(static_cast<int64_t>(skew_percent));
+
+    if (skew_percent > opt_.tolerance_percent) {
+        if (!unbalanced_) {
+            unbalanced_ = true;
+            unbalanced_since_ = now;
+        }
+        stats_.unbalanced_msec = elapsedMsec(unbalanced_since_, now);
+    } else if (unbalanced_) {
+        unbalanced_ = false;
+        stats_.unbalanced_msec = 0;
+        stats_.last_converge_msec = elapsedMsec(unbalanced_since_, now);
+        ++stats_.converge_count;
+        balancerMetrics().converge->Observe(stats_.last_converge_msec);
+        FLOG_INFO("leader balance: converged in %" PRIu64 " ms", stats_.last_converge_msec);
+    }
+}
+
+void LeaderBalancer::GetStats(LeaderBalanceStats* stats) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    *stats = stats_;
+}
+
+}  // namespace server
+}  // namespace dataserver
+}  // namespace sharkstore
@@ -0,0 +1,107 @@
+_Pragma("once");
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "raft/status.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace server {
+
+struct ContextServer;
+
+struct LeaderBalancerOptions {
+    // 两轮均衡之间的间隔，为0表示不做均衡
+    uint64_t interval_msec = 0;
+    // 本节点的leader比例(leader数/range数)比对方高出超过该百分点才转移
+    // 转移后不能反超对方，两者之间的区间就是滞后区间，避免leader来回转移
+    uint64_t tolerance_percent = 10;
+    // 每轮最多发起的转移个数
+    size_t max_transfers = 4;
+    // 同一个range两次转移之间的最小间隔
+    uint64_t range_cooldown_msec = 300000;
+};
+
+// 本节点是leader的一个range
+struct LeaderCandidate {
+    uint64_t range_id = 0;
+    // 日志已经跟上、可以接收leader的其他普通副本所在的节点
+    std::vector<uint64_t> nodes;
+};
+
+struct LeaderTransfer {
+    uint64_t range_id = 0;
+    uint64_t to_node = 0;
+};
+
+struct LeaderBalanceStats {
+    uint64_t transfer_count = 0;
+    // 本节点与副本节点之间leader比例的最大差距(百分点)
+    uint64_t skew_percent = 0;
+    // 当前失衡已经持续的时间，均衡时为0
+    uint64_t unbalanced_msec = 0;
+    // 最近一次从失衡恢复到均衡所用的时间
+    uint64_t last_converge_msec = 0;
+    uint64_t converge_count = 0;
+};
+
+// 节点间leader数的均衡
+// 其他节点的leader分布来自raft节点间的心跳，本节点的leader比例明显高于某个副本节点时，
+// 按轮次把部分leader转移给它。负载较轻的一方只统计失衡时间，由较重的一方发起转移。
+// 向一个节点转移后，要等到它在一轮间隔之后的心跳中更新了分布才会再向它转移
+class LeaderBalancer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    LeaderBalancer(ContextServer* context, const LeaderBalancerOptions& opt);
+    ~LeaderBalancer();
+
+    LeaderBalancer(const LeaderBalancer&) = delete;
+    LeaderBalancer& operator=(const LeaderBalancer&) = delete;
+
+    void Start();
+    void Stop();
+
+    // 计算本轮要发起的转移，local和peers为本节点和其他节点的leader分布，
+    // 返回的转移计入冷却时间和统计
+    std::vector<LeaderTransfer> Plan(const raft::NodeLoad& local,
+                                     const std::map<uint64_t, raft::NodeLoad>& peers,
+                                     const std::vector<LeaderCandidate>& candidates,
+                                     Clock::time_point now);
+
+    void GetStats(LeaderBalanceStats* stats) const;
+
+private:
+    void run();
+    void balance();
+    void collectCandidates(std::vector<LeaderCandidate>* candidates) const;
+
+    void updateSkew(uint64_t skew_percent, Clock::time_point now);
+
+private:
+    ContextServer* const context_ = nullptr;
+    const LeaderBalancerOptions opt_;
+
+    // range_id -> 可以再次转移的时间
+    std::map<uint64_t, Clock::time_point> range_cooldown_;
+    // node_id -> 最近一次向该节点转移的时间
+    std::map<uint64_t, Clock::time_point> node_transfer_time_;
+
+    LeaderBalanceStats stats_;
+    Clock::time_point unbalanced_since_;
+    bool unbalanced_ = false;
+
+    mutable std::mutex mu_;
+    std::condition_variable cond_;
+    bool running_ = false;
+    std::thread thr_;
+};
+
+}  // namespace server
+}  // namespace dataserver
+}  // namespace sharkstore
@@ -72,6 +72,12 @@ Status RangeContextImpl::SplitRange(uint64_t range_id, const raft_cmdpb::SplitRe
     return server_->range_server->SplitRange(range_id, req, raft_index);
 }
 
+Status RangeContextImpl::BatchSplitRange(uint64_t range_id,
+                                         const raft_cmdpb::BatchSplitRequest &req,
+                                         uint64_t raft_index) {
+    return server_->range_server->BatchSplitRange(range_id, req, raft_index);
+}
+
 }  // namespace server
 }  // namespace dataserver
 }  // namespace sharkstore
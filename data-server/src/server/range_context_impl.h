@@ -21,6 +21,7 @@ public:
     master::Worker* MasterClient() override  { return server_->master_worker; }
     raft::RaftServer* RaftServer() override { return server_->raft_server; }
     storage::MetaStore* MetaStore() override { return server_->meta_store; }
+    storage::Compactor* Compactor() override { return server_->compactor; }
     common::SocketSession* SocketSession() override { return server_->socket_session; }
     range::RangeStats* Statistics() override { return server_->run_status; }
 	watch::WatchServer* WatchServer() override { return server_->range_server->watch_server_; }
@@ -36,6 +37,8 @@ public:
     // split
     Status SplitRange(uint64_t range_id, const raft_cmdpb::SplitRequest &req,
             uint64_t raft_index) override;
+    Status BatchSplitRange(uint64_t range_id, const raft_cmdpb::BatchSplitRequest &req,
+            uint64_t raft_index) override;
 
 private:
     ContextServer* server_ = nullptr;
@@ -1,5 +1,6 @@
 #include "range_server.h"
 
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <thread>
@@ -11,18 +12,21 @@
 #include <rocksdb/utilities/db_ttl.h>
 #include <rocksdb/utilities/blob_db/blob_db.h>
 #include <rocksdb/rate_limiter.h>
+#include <rocksdb/utilities/table_properties_collectors.h>
 #include <fastcommon/shared_func.h>
 #include <common/ds_config.h>
 
 #include "base/util.h"
 #include "common/ds_config.h"
 #include "common/ds_encoding.h"
+#include "common/multi_message.h"
 #include "frame/sf_logger.h"
 #include "frame/sf_util.h"
 #include "proto/gen/funcpb.pb.h"
 #include "proto/gen/metapb.pb.h"
 #include "proto/gen/schpb.pb.h"
 #include "storage/metric.h"
+#include "storage/mvcc.h"
 #include "run_status.h"
 
 #include "server.h"
@@ -40,14 +44,6 @@ int RangeServer::Init(ContextServer *context) {
 
     context_ = context;
 
-    // 打开数据db
-    if (OpenDB() != 0) {
-        FLOG_ERROR("RangeServer Init error ...");
-        return -1;
-    }
-
-    context_->rocks_db = db_;
-
     // 打开meta db
     auto meta_path = JoinFilePath({ds_config.rocksdb_config.path, kMetaPathSuffix});
     meta_store_ = new storage::MetaStore(meta_path);
@@ -68,16 +64,57 @@ int RangeServer::Init(ContextServer *context) {
     }
     context_->meta_store = meta_store_;
 
+    // 数据db打开时就会按mvcc模式设置compaction filter，要先检查
+    if (checkStorageMode() != 0) {
+        return -1;
+    }
+
+    // 打开数据db
+    if (OpenDB() != 0) {
+        FLOG_ERROR("RangeServer Init error ...");
+        return -1;
+    }
+
+    context_->rocks_db = db_;
+
+    storage::CompactorOptions compactor_opt;
+    compactor_opt.interval_msec = ds_config.rocksdb_config.tombstone_compact_interval_ms;
+    compactor_opt.tombstone_percent =
+            static_cast<uint64_t>(ds_config.rocksdb_config.tombstone_compact_percent);
+    compactor_.reset(new storage::Compactor(db_, compactor_opt));
+    context_->compactor = compactor_.get();
+
+    LeaderBalancerOptions balance_opt;
+    balance_opt.interval_msec = ds_config.range_config.leader_balance_interval_ms;
+    balance_opt.tolerance_percent =
+            static_cast<uint64_t>(ds_config.range_config.leader_balance_tolerance);
+    balance_opt.max_transfers =
+            static_cast<size_t>(ds_config.range_config.leader_balance_max_transfers);
+    balance_opt.range_cooldown_msec =
+            static_cast<uint64_t>(ds_config.range_config.leader_balance_cooldown) * 1000;
+    leader_balancer_.reset(new LeaderBalancer(context_, balance_opt));
+    context_->leader_balancer = leader_balancer_.get();
+
     // 创建RangeContext
     range_context_.reset(new RangeContextImpl(context_));
 
     std::vector<metapb::Range> range_metas;
-    ret = meta_store_->GetAllRange(&range_metas);
+    std::map<uint64_t, uint64_t> apply_indexes;
+    ret = meta_store_->GetAllRange(&range_metas, &apply_indexes);
     if (!ret.ok()) {
         FLOG_ERROR("load range metas failed(%s)", ret.ToString().c_str());
         return -1;
     }
-    if (recover(range_metas) != 0) {
+    sortRecoverOrder(&range_metas);
+    if (ds_config.range_config.recover_in_background) {
+        // 先注册，请求返回可重试的错误，Start后在后台恢复
+        std::unique_lock<sharkstore::shared_mutex> lock(rw_lock_);
+        for (const auto& meta : range_metas) {
+            recovering_.insert(meta.id());
+        }
+        recover_metas_ = std::move(range_metas);
+        recover_applied_ = std::move(apply_indexes);
+    } else if (recover(range_metas, apply_indexes) != 0) {
         FLOG_ERROR("load local range meta failed");
         return -1;
     }
@@ -93,11 +130,25 @@ int RangeServer::Init(ContextServer *context) {
 int RangeServer::Start() {
     FLOG_INFO("RangeServer Start begin ...");
 
+    compactor_->Start();
+    leader_balancer_->Start();
+
     range_heartbeat_ = std::thread(&RangeServer::Heartbeat, this);
 
     auto handle = range_heartbeat_.native_handle();
     AnnotateThread(handle, "range_hb");
 
+    if (!recover_metas_.empty()) {
+        recover_thread_ = std::thread([this] {
+            if (recover(recover_metas_, recover_applied_) != 0) {
+                FLOG_ERROR("background range recovery has failed ranges");
+            }
+            recover_metas_.clear();
+            recover_applied_.clear();
+        });
+        AnnotateThread(recover_thread_.native_handle(), "range_recover");
+    }
+
     char name[32] = {'\0'};
     for (int i = 0; i < ds_config.range_config.worker_threads; i++) {
         worker_.emplace_back([this] {
@@ -138,6 +189,15 @@ int RangeServer::Start() {
 void RangeServer::Stop() {
     FLOG_INFO("RangeServer Stop begin ...");
 
+    recover_stopped_ = true;
+    if (recover_thread_.joinable()) {
+        recover_thread_.join();
+    }
+
+    if (leader_balancer_ != nullptr) {
+        leader_balancer_->Stop();
+    }
+
     queue_cond_.notify_all();
     statis_cond_.notify_all();
 
@@ -151,6 +211,10 @@ void RangeServer::Stop() {
         range_heartbeat_.join();
     }
 
+    if (compactor_ != nullptr) {
+        compactor_->Stop();
+    }
+
     CloseDB();
 
     auto it = ranges_.begin();
@@ -234,6 +298,16 @@ void RangeServer::buildDBOptions(rocksdb::Options& ops) {
     ops.max_background_compactions = ds_config.rocksdb_config.max_background_compactions;
     ops.level0_file_num_compaction_trigger =
             ds_config.rocksdb_config.level0_file_num_compaction_trigger;
+    if (ds_config.rocksdb_config.compact_on_deletion_window > 0) {
+        ops.table_properties_collector_factories.emplace_back(
+                rocksdb::NewCompactOnDeletionCollectorFactory(
+                        ds_config.rocksdb_config.compact_on_deletion_window,
+                        ds_config.rocksdb_config.compact_on_deletion_trigger));
+    }
+    if (ds_config.range_config.mvcc) {
+        ops.compaction_filter_factory = std::make_shared<storage::MvccGCFilterFactory>(
+                static_cast<uint64_t>(ds_config.range_config.mvcc_gc_seconds) * 1000);
+    }
 
     // write pause
     ops.level0_slowdown_writes_trigger =
@@ -460,6 +534,12 @@ void RangeServer::DealTask(common::ProtoMessage *msg) {
         case funcpb::kFuncKvScan:
             KVScan(msg);
             break;
+        case funcpb::kFuncRedisCmd:
+            RedisCmd(msg);
+            break;
+        case funcpb::kFuncMulti:
+            Multi(msg);
+            break;
         default:
             FLOG_ERROR("func id is Invalid %d", header.func_id);
             return context_->socket_session->Send(msg, nullptr);
@@ -480,6 +560,14 @@ void RangeServer::CreateRange(common::ProtoMessage *msg) {
     do {
         std::unique_lock<sharkstore::shared_mutex> lock(rw_lock_);
 
+        if (recovering_.count(req.range().id()) > 0) {
+            FLOG_WARN("range[%" PRIu64 "] is recovering.", req.range().id());
+            err = new errorpb::Error;
+            err->set_message("range is recovering");
+            err->mutable_server_is_busy()->set_reason("range is recovering");
+            break;
+        }
+
         auto it = ranges_.find(req.range().id());
         if (it != ranges_.end()) {
             FLOG_WARN("range[%" PRIu64 "] already exist.", req.range().id());
@@ -537,7 +625,7 @@ Status RangeServer::CreateRange(const metapb::Range &range, uint64_t leader,
     }
 
     auto it = ranges_.find(range.id());
-    if (it != ranges_.end()) {
+    if (it != ranges_.end() || recovering_.count(range.id()) > 0) {
         FLOG_WARN("CreateRange range[%" PRIu64 "] is exist.", range.id());
         return Status(Status::kDuplicate, "range is exist", "");
     }
@@ -584,6 +672,9 @@ Status RangeServer::DeleteRange(uint64_t range_id, uint64_t peer_id) {
     do {
         std::unique_lock<sharkstore::shared_mutex> lock(rw_lock_);
 
+        if (recovering_.count(range_id) > 0) {
+            return Status(Status::kBusy, "range is recovering", std::to_string(range_id));
+        }
         auto it = ranges_.find(range_id);
         if (it == ranges_.end()) {
             FLOG_WARN("delete range[%" PRIu64 "] not found.", range_id);
@@ -637,6 +728,10 @@ int RangeServer::OfflineRange(uint64_t range_id) {
     do {
         std::unique_lock<sharkstore::shared_mutex> lock(rw_lock_);
 
+        if (recovering_.count(range_id) > 0) {
+            FLOG_WARN("offline range[%" PRIu64 "] is recovering.", range_id);
+            return -1;
+        }
         auto it = ranges_.find(range_id);
         if (it == ranges_.end()) {
             FLOG_WARN("offline range[%" PRIu64 "] not found.", range_id);
@@ -660,6 +755,11 @@ int RangeServer::CloseRange(uint64_t range_id) {
     do {
         std::unique_lock<sharkstore::shared_mutex> lock(rw_lock_);
 
+        if (recovering_.count(range_id) > 0) {
+            FLOG_WARN("close range[%" PRIu64 "] is recovering.", range_id);
+            return -1;
+        }
+
         meta_store_->DelRange(range_id);
 
         auto it = ranges_.find(range_id);
@@ -785,6 +885,16 @@ size_t RangeServer::GetRangesSize() const {
     return ranges_.size();
 }
 
+void RangeServer::GetRanges(std::vector<std::shared_ptr<range::Range>> *ranges) const {
+    sharkstore::shared_lock<sharkstore::shared_mutex> lock(rw_lock_);
+    ranges->reserve(ranges_.size());
+    for (const auto &kv : ranges_) {
+        if (kv.second->valid()) {
+            ranges->push_back(kv.second);
+        }
+    }
+}
+
 std::shared_ptr<range::Range> RangeServer::Find(uint64_t range_id) {
     sharkstore::shared_lock<sharkstore::shared_mutex> lock(rw_lock_);
 
@@ -805,6 +915,11 @@ std::shared_ptr<range::Range> RangeServer::Find(uint64_t range_id) {
     return it->second;
 }
 
+bool RangeServer::IsRecovering(uint64_t range_id) const {
+    sharkstore::shared_lock<sharkstore::shared_mutex> lock(rw_lock_);
+    return recovering_.count(range_id) > 0;
+}
+
 void RangeServer::RawGet(common::ProtoMessage *msg) {
     kvrpcpb::DsKvRawGetRequest req;
     kvrpcpb::DsKvRawGetResponse *resp;
@@ -929,10 +1044,16 @@ std::shared_ptr<range::Range> RangeServer::CheckAndDecodeRequest(
 
     auto range = Find(request.header().range_id());
     if (range == nullptr) {
-        FLOG_ERROR("%s request not found range_id %" PRIu64 " failed", func_name,
-                   request.header().range_id());
         respone = new ResponseT;
-        RangeNotFound(request.header(), respone->mutable_header());
+        if (IsRecovering(request.header().range_id())) {
+            FLOG_WARN("%s request range_id %" PRIu64 " is recovering", func_name,
+                      request.header().range_id());
+            RangeRecovering(request.header(), respone->mutable_header());
+        } else {
+            FLOG_ERROR("%s request not found range_id %" PRIu64 " failed", func_name,
+                       request.header().range_id());
+            RangeNotFound(request.header(), respone->mutable_header());
+        }
         context_->socket_session->Send(msg, respone);
         return nullptr;
     }
@@ -1070,6 +1191,74 @@ void RangeServer::KVScan(common::ProtoMessage *msg) {
     }
 }
 
+void RangeServer::RedisCmd(common::ProtoMessage *msg) {
+    redispb::DsRedisRequest req;
+    redispb::DsRedisResponse *resp;
+
+    auto range = CheckAndDecodeRequest("RedisCmd", req, resp, msg);
+    if (range != nullptr) {
+        range->RedisCmd(msg, req);
+    }
+}
+
+bool RangeServer::isMultiSubFunc(int func_id) {
+    switch (func_id) {
+        case funcpb::kFuncRawGet:
+        case funcpb::kFuncRawPut:
+        case funcpb::kFuncRawDelete:
+        case funcpb::kFuncSelect:
+        case funcpb::kFuncInsert:
+        case funcpb::kFuncDelete:
+        case funcpb::kFuncPureGet:
+        case funcpb::kFuncWatchPut:
+        case funcpb::kFuncWatchDel:
+        case funcpb::kFuncKvSet:
+        case funcpb::kFuncKvGet:
+        case funcpb::kFuncKvBatchSet:
+        case funcpb::kFuncKvBatchGet:
+        case funcpb::kFuncKvDel:
+        case funcpb::kFuncKvBatchDel:
+        case funcpb::kFuncKvRangeDel:
+        case funcpb::kFuncKvScan:
+        case funcpb::kFuncRedisCmd:
+        case funcpb::kFuncLock:
+        case funcpb::kFuncLockUpdate:
+        case funcpb::kFuncUnlock:
+        case funcpb::kFuncUnlockForce:
+            return true;
+        default:
+            // watch会长时间持有请求，admin类请求和嵌套的批量请求不允许
+            return false;
+    }
+}
+
+void RangeServer::Multi(common::ProtoMessage *msg) {
+    kvrpcpb::DsMultiRequest req;
+    if (!common::GetMessage(msg->body.data(), msg->body.size(), &req)) {
+        FLOG_ERROR("deserialize Multi request failed");
+        return context_->socket_session->Send(msg, nullptr);
+    }
+
+    FLOG_DEBUG("Multi called. sub requests: %d", req.reqs_size());
+
+    // 子请求在当前线程依次处理，同一个range的写请求在raft提交时会合并到一次propose中，
+    // 调用方把同一个range的子请求放在一起可以提高合并的效果
+    auto multi = new common::MultiMessage(msg, context_->socket_session, req.reqs_size());
+    for (int i = 0; i < req.reqs_size(); ++i) {
+        const auto &sub = req.reqs(i);
+        auto func_id = static_cast<int>(sub.func_id());
+        if (!isMultiSubFunc(func_id)) {
+            FLOG_WARN("Multi request: func id %d is not allowed", func_id);
+            multi->SetError(i, sub.func_id(), "func id not allowed in multi request");
+            continue;
+        }
+        context_->run_status->IncrRequest(func_id);
+        DealTask(multi->NewSubMessage(i, sub));
+    }
+    // 最后一个子请求结束时发送回应
+    multi->Release();
+}
+
 Status RangeServer::SplitRange(uint64_t old_range_id, const raft_cmdpb::SplitRequest &req,
                   uint64_t raft_index) {
     auto rng = Find(old_range_id);
@@ -1106,6 +1295,50 @@ Status RangeServer::SplitRange(uint64_t old_range_id, const raft_cmdpb::SplitReq
     return ret;
 }
 
+Status RangeServer::BatchSplitRange(uint64_t old_range_id,
+                                    const raft_cmdpb::BatchSplitRequest &req,
+                                    uint64_t raft_index) {
+    auto rng = Find(old_range_id);
+    if (rng == nullptr) {
+        return Status(Status::kNotFound, "range not found", "");
+    }
+
+    metapb::Range meta = rng->options();
+    meta.set_end_key(req.split_keys(0));
+    meta.mutable_range_epoch()->set_version(req.epoch().version());
+    std::vector<metapb::Range> batch_ranges{meta};
+
+    // 本次新创建的range，持久化失败时删除
+    std::vector<uint64_t> created;
+    {
+        std::unique_lock<sharkstore::shared_mutex> lock(rw_lock_);
+        for (const auto &new_range : req.new_ranges()) {
+            auto ret = CreateRange(new_range, req.leader(), raft_index + 1);
+            if (ret.code() == Status::kDuplicate) {
+                FLOG_WARN("range[%" PRIu64 "] ApplyBatchSplit(new range: %" PRIu64
+                          ") already exist.", old_range_id, new_range.id());
+                continue;
+            } else if (!ret.ok()) {
+                lock.unlock();
+                for (auto id : created) {
+                    DeleteRange(id);
+                }
+                return ret;
+            }
+            created.push_back(new_range.id());
+            batch_ranges.push_back(new_range);
+        }
+    }
+
+    auto ret = meta_store_->BatchAddRange(batch_ranges);
+    if (!ret.ok()) {
+        for (auto id : created) {
+            DeleteRange(id);
+        }
+    }
+    return ret;
+}
+
 void RangeServer::TimeOut(const kvrpcpb::RequestHeader &req,
                           kvrpcpb::ResponseHeader *resp) {
     auto err = new errorpb::Error;
@@ -1124,12 +1357,22 @@ void RangeServer::RangeNotFound(const kvrpcpb::RequestHeader &req,
     common::SetResponseHeader(req, resp, err);
 }
 
-Status RangeServer::recover(const metapb::Range& meta) {
+void RangeServer::RangeRecovering(const kvrpcpb::RequestHeader &req,
+                                  kvrpcpb::ResponseHeader *resp) {
+    auto err = new errorpb::Error;
+    err->set_message("range is recovering");
+    err->mutable_server_is_busy()->set_reason("range is recovering");
+
+    common::SetResponseHeader(req, resp, err);
+}
+
+Status RangeServer::recover(const metapb::Range& meta, uint64_t apply_index) {
     auto rng = std::make_shared<range::Range>(range_context_.get(), meta);
-    auto s = rng->Initialize(0);
-    if (!s.ok()) return s;
+    auto s = rng->Recover(apply_index);
 
     std::unique_lock<sharkstore::shared_mutex> lock(rw_lock_);
+    recovering_.erase(meta.id());
+    if (!s.ok()) return s;
     auto ret = ranges_.emplace(meta.id(), rng);
     if (!ret.second) {
         return Status(Status::kDuplicate, "save range", std::to_string(meta.id()));
@@ -1137,7 +1380,52 @@ Status RangeServer::recover(const metapb::Range& meta) {
     return Status::OK();
 }
 
-int RangeServer::recover(const std::vector<metapb::Range> &metas) {
+int RangeServer::checkStorageMode() {
+    bool mvcc = false, exists = false;
+    auto ret = meta_store_->LoadStorageMode(&mvcc, &exists);
+    if (!ret.ok()) {
+        FLOG_ERROR("load storage mode failed(%s)", ret.ToString().c_str());
+        return -1;
+    }
+    if (!exists) {
+        // 还没有保存过：之前的版本只有非mvcc编码，有range时数据是非mvcc的
+        std::vector<metapb::Range> metas;
+        ret = meta_store_->GetAllRange(&metas);
+        if (!ret.ok()) {
+            FLOG_ERROR("load range metas failed(%s)", ret.ToString().c_str());
+            return -1;
+        }
+        mvcc = metas.empty() ? ds_config.range_config.mvcc : false;
+        ret = meta_store_->SaveStorageMode(mvcc);
+        if (!ret.ok()) {
+            FLOG_ERROR("save storage mode failed(%s)", ret.ToString().c_str());
+            return -1;
+        }
+    }
+    // 编码方式不同的数据不能互相读写，mvcc的gc也会删掉非mvcc编码的数据
+    if (mvcc != ds_config.range_config.mvcc) {
+        FLOG_ERROR("storage mode mismatch: data is %s, but range.mvcc is %s",
+                   mvcc ? "mvcc" : "plain", ds_config.range_config.mvcc ? "on" : "off");
+        return -1;
+    }
+    return 0;
+}
+
+void RangeServer::sortRecoverOrder(std::vector<metapb::Range> *metas) const {
+    // 本节点是普通副本的range可能成为leader，先恢复；learner副本放到最后
+    auto node_id = context_->node_id;
+    std::stable_partition(metas->begin(), metas->end(), [node_id](const metapb::Range& meta) {
+        for (const auto& peer : meta.peers()) {
+            if (peer.node_id() == node_id) {
+                return peer.type() != metapb::PeerType_Learner;
+            }
+        }
+        return true;
+    });
+}
+
+int RangeServer::recover(const std::vector<metapb::Range> &metas,
+                         const std::map<uint64_t, uint64_t> &apply_indexes) {
     assert(ds_config.range_config.recover_concurrency > 0);
     auto actual_concurrency = std::min(metas.size() / 4 + 1,
                                        static_cast<size_t>(ds_config.range_config.recover_concurrency));
@@ -1160,12 +1448,13 @@ int RangeServer::recover(const std::vector<metapb::Range> &metas) {
         auto f = std::async(std::launch::async, [&, this] {
             while (true) {
                 auto pos = recover_pos.fetch_add(1);
-                if (pos >= metas.size()) {
+                if (pos >= metas.size() || recover_stopped_) {
                     return Status::OK();
                 }
                 const auto& meta = metas[pos];
                 FLOG_DEBUG("Start Recover range id=%" PRIu64, meta.id());
-                auto s = recover(meta);
+                auto it = apply_indexes.find(meta.id());
+                auto s = recover(meta, it == apply_indexes.end() ? 0 : it->second);
                 if (s.ok()) {
                     ++success_counter;
                 } else {
@@ -1192,6 +1481,14 @@ int RangeServer::recover(const std::vector<metapb::Range> &metas) {
         if (!s.ok()) last_error = s;
     }
 
+    // 中途退出没有恢复的range不再处于恢复状态
+    {
+        std::unique_lock<sharkstore::shared_mutex> lock(rw_lock_);
+        for (const auto& meta : metas) {
+            recovering_.erase(meta.id());
+        }
+    }
+
     auto took_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - begin).count();
 
@@ -3,11 +3,13 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "proto/gen/mspb.pb.h"
@@ -17,9 +19,11 @@
 #include "base/status.h"
 #include "master/task_handler.h"
 #include "range/range.h"
+#include "storage/compactor.h"
 #include "storage/meta_store.h"
 
 #include "server/context_server.h"
+#include "server/leader_balancer.h"
 #include "watch/watch_server.h"
 
 namespace sharkstore {
@@ -44,9 +48,13 @@ public:
     void StatisPush(uint64_t range_id);
 
     storage::MetaStore *meta_store() { return meta_store_; }
+    storage::Compactor *compactor() { return compactor_.get(); }
 
     size_t GetRangesSize() const;
+    void GetRanges(std::vector<std::shared_ptr<range::Range>> *ranges) const;
     std::shared_ptr<range::Range> Find(uint64_t range_id);
+    // range已注册但还在启动恢复中
+    bool IsRecovering(uint64_t range_id) const;
 
     void OnNodeHeartbeatResp(const mspb::NodeHeartbeatResponse &) override;
     void OnRangeHeartbeatResp(const mspb::RangeHeartbeatResponse &) override;
@@ -57,9 +65,13 @@ private:
     void buildDBOptions(rocksdb::Options& ops);
     int OpenDB();
     void CloseDB();
+    // 检查数据db的编码方式跟配置的mvcc是否一致，第一次启动时保存
+    int checkStorageMode();
 
-    Status recover(const metapb::Range& meta);
-    int recover(const std::vector<metapb::Range> &metas);
+    Status recover(const metapb::Range& meta, uint64_t apply_index);
+    int recover(const std::vector<metapb::Range> &metas,
+                const std::map<uint64_t, uint64_t> &apply_indexes);
+    void sortRecoverOrder(std::vector<metapb::Range> *metas) const;
 
     void RawGet(common::ProtoMessage *msg);
     void RawPut(common::ProtoMessage *msg);
@@ -92,10 +104,18 @@ private:
     void KVRangeDelete(common::ProtoMessage *msg);
     void KVScan(common::ProtoMessage *msg);
 
+    void RedisCmd(common::ProtoMessage *msg);
+
+    // 批量请求，拆成子请求分别处理后合并回应
+    void Multi(common::ProtoMessage *msg);
+    static bool isMultiSubFunc(int func_id);
+
     void TimeOut(const kvrpcpb::RequestHeader &req,
                  kvrpcpb::ResponseHeader *resp);
     void RangeNotFound(const kvrpcpb::RequestHeader &req,
                        kvrpcpb::ResponseHeader *resp);
+    void RangeRecovering(const kvrpcpb::RequestHeader &req,
+                         kvrpcpb::ResponseHeader *resp);
 
     template <class RequestT, class ResponseT>
     std::shared_ptr<range::Range> CheckAndDecodeRequest(
@@ -105,6 +125,8 @@ private:
 public:
     Status SplitRange(uint64_t old_range_id, const raft_cmdpb::SplitRequest &req,
             uint64_t raft_index);
+    Status BatchSplitRange(uint64_t old_range_id, const raft_cmdpb::BatchSplitRequest &req,
+            uint64_t raft_index);
 
     void LeaderQueuePush(uint64_t leader, time_t expire);
 
@@ -129,6 +151,13 @@ private:  // admin
 private:
     mutable shared_mutex rw_lock_;
     std::unordered_map<int64_t, std::shared_ptr<range::Range>> ranges_;
+    // 后台恢复中的range，恢复完成后移到ranges_
+    std::unordered_set<uint64_t> recovering_;
+
+    std::vector<metapb::Range> recover_metas_;
+    std::map<uint64_t, uint64_t> recover_applied_;
+    std::thread recover_thread_;
+    std::atomic<bool> recover_stopped_ = {false};
 
     std::mutex statis_mutex_;
     std::condition_variable statis_cond_;
@@ -146,6 +175,8 @@ private:
 
     rocksdb::DB *db_ = nullptr;
     storage::MetaStore *meta_store_ = nullptr;
+    std::unique_ptr<storage::Compactor> compactor_;
+    std::unique_ptr<LeaderBalancer> leader_balancer_;
 
     ContextServer *context_ = nullptr;
     std::unique_ptr<range::RangeContext> range_context_;
@@ -8,10 +8,13 @@
 #include "base/util.h"
 #include "common/ds_config.h"
 #include "common/ds_version.h"
+#include "common/socket_session_impl.h"
 #include "frame/sf_logger.h"
 #include "frame/sf_util.h"
 #include "master/worker.h"
+#include "proto/gen/funcpb.pb.h"
 
+#include "range_server.h"
 #include "server.h"
 #include "worker.h"
 
@@ -19,8 +22,19 @@ namespace sharkstore {
 namespace dataserver {
 namespace server {
 
+using monitor::metrics::Registry;
+
+static monitor::metrics::CounterFamily* requestFamily() {
+    return Registry::Default()->AddCounter("sharkstore_ds_requests_total",
+                                           "Requests received by function.", {"func"});
+}
+
 int RunStatus::Init(ContextServer *context) {
     context_ = context;
+    for (auto& c : request_counters_) {
+        c.store(nullptr, std::memory_order_relaxed);
+    }
+    other_requests_ = requestFamily()->WithLabels({"other"});
     return 0;
 }
 
@@ -34,12 +48,20 @@ int RunStatus::Start() {
     // set monitor version
     system_status_.PutVersion(get_version());
 
+    collector_id_ = Registry::Default()->AddCollector(
+        [this](monitor::metrics::Writer* writer) { collectMetrics(writer); });
+
     return 0;
 }
 
 void RunStatus::Stop() {
     FLOG_INFO("RunStatus Stop begin ...");
 
+    if (collector_id_ != 0) {
+        Registry::Default()->RemoveCollector(collector_id_);
+        collector_id_ = 0;
+    }
+
     cond_.notify_all();
 
     if (metric_thread_.joinable()) {
@@ -50,6 +72,7 @@ void RunStatus::Stop() {
 void RunStatus::run() {
     while (g_continue_flag) {
         collectDiskUsage();
+        collectDBMemUsage();
         printDBMetric();
         context_->worker->PrintQueueSize();
         printStatistics();
@@ -94,6 +117,65 @@ uint64_t RunStatus::GetLeaderCount() const {
     return leaders_.size();
 }
 
+void RunStatus::IncrRequest(int func_id) {
+    if (func_id < 0 || func_id >= kMaxFuncID || !funcpb::FunctionID_IsValid(func_id)) {
+        other_requests_->Inc();
+        return;
+    }
+    auto counter = request_counters_[func_id].load(std::memory_order_acquire);
+    if (counter == nullptr) {
+        // 同一个func_id并发创建时WithLabels返回同一个counter
+        counter = requestFamily()->WithLabels(
+            {funcpb::FunctionID_Name(static_cast<funcpb::FunctionID>(func_id))});
+        request_counters_[func_id].store(counter, std::memory_order_release);
+    }
+    counter->Inc();
+}
+
+void RunStatus::collectMetrics(monitor::metrics::Writer* writer) {
+    using monitor::metrics::Labels;
+
+    uint64_t total = context_->range_server->GetRangesSize();
+    uint64_t leaders = GetLeaderCount();
+    writer->Header("sharkstore_ds_ranges", "Ranges on this node by raft role.", "gauge");
+    writer->Sample("sharkstore_ds_ranges", Labels{{"role", "leader"}}, leaders);
+    writer->Sample("sharkstore_ds_ranges", Labels{{"role", "follower"}},
+                   total > leaders ? total - leaders : 0);
+    writer->Header("sharkstore_ds_range_splits", "Range splits in progress.", "gauge");
+    writer->Sample("sharkstore_ds_range_splits", Labels{}, GetSplitCount());
+
+    FileSystemUsage usage;
+    if (GetFilesystemUsage(&usage)) {
+        writer->Header("sharkstore_ds_filesystem_bytes", "Filesystem usage of the data path.", "gauge");
+        writer->Sample("sharkstore_ds_filesystem_bytes", Labels{{"type", "total"}}, usage.total_size);
+        writer->Sample("sharkstore_ds_filesystem_bytes", Labels{{"type", "used"}}, usage.used_size);
+        writer->Sample("sharkstore_ds_filesystem_bytes", Labels{{"type", "free"}}, usage.free_size);
+    }
+
+    // rocksdb的部分在run()中定时采集，这里只读取已有的值
+    auto root = MemTracker::Root();
+    writer->Header("sharkstore_ds_memory_usage_bytes", "Tracked memory usage by subsystem.", "gauge");
+    writer->Sample("sharkstore_ds_memory_usage_bytes", Labels{{"tracker", root->Label()}}, root->Usage());
+    root->VisitChildren([writer](const MemTracker& child) {
+        writer->Sample("sharkstore_ds_memory_usage_bytes", Labels{{"tracker", child.Label()}},
+                       child.Usage());
+    });
+
+    // 平均每个回应分配和拷贝的字节数 = bytes_total / responses_total
+    const auto& send = common::SocketSessionImpl::Stats();
+    writer->Header("sharkstore_ds_responses_total", "Responses serialized for sending.", "counter");
+    writer->Sample("sharkstore_ds_responses_total", Labels{}, send.responses.load());
+    writer->Header("sharkstore_ds_response_bytes_total",
+                   "Bytes allocated and serialized into response buffers, including headers.", "counter");
+    writer->Sample("sharkstore_ds_response_bytes_total", Labels{}, send.bytes.load());
+    writer->Header("sharkstore_ds_response_serialize_seconds_total",
+                   "Time spent sizing and serializing responses.", "counter");
+    writer->Sample("sharkstore_ds_response_serialize_seconds_total", Labels{},
+                   send.serialize_usec.load() / 1e6);
+
+    proc_collector_.Collect(writer);
+}
+
 // 定时采集磁盘使用率
 void RunStatus::collectDiskUsage() {
     FileSystemUsage usage;
@@ -102,6 +184,31 @@ void RunStatus::collectDiskUsage() {
     }
 }
 
+// 定时采集rocksdb内存使用，计入内存统计
+void RunStatus::collectDBMemUsage() {
+    auto db = context_->rocks_db;
+    uint64_t value = 0;
+    if (db->GetIntProperty("rocksdb.cur-size-all-mem-tables", &value)) {
+        memtable_mem_tracker_.Set(static_cast<int64_t>(value));
+    }
+    value = 0;
+    if (db->GetIntProperty("rocksdb.estimate-table-readers-mem", &value)) {
+        table_reader_mem_tracker_.Set(static_cast<int64_t>(value));
+    }
+    block_cache_mem_tracker_.Set(static_cast<int64_t>(context_->block_cache->GetUsage()));
+    if (context_->row_cache) {
+        row_cache_mem_tracker_.Set(static_cast<int64_t>(context_->row_cache->GetUsage()));
+    }
+
+    auto root = MemTracker::Root();
+    auto level = root->CheckLimit();
+    if (level != MemTracker::Level::kNormal) {
+        FLOG_WARN("memory usage %" PRId64 " exceeds %s limit(soft=%" PRId64 ", hard=%" PRId64 ")",
+                  root->Usage(), MemTrackerLevelName(level).c_str(),
+                  root->SoftLimit(), root->HardLimit());
+    }
+}
+
 void RunStatus::printStatistics() {
     FLOG_INFO("\n%s", statistics_.ToString().c_str());
     statistics_.Reset();
@@ -6,9 +6,12 @@
 #include <mutex>
 #include <string>
 
+#include "base/mem_tracker.h"
 #include "common/socket_client.h"
 #include "frame/sf_status.h"
 #include "monitor/isystemstatus.h"
+#include "monitor/metrics.h"
+#include "monitor/proc_collector.h"
 #include "monitor/syscommon.h"
 #include "monitor/statistics.h"
 #include "range/stats.h"
@@ -41,6 +44,9 @@ public:
         if (time > 0) statistics_.PushTime(type, static_cast<uint64_t>(time));
     }
 
+    // 按func_id统计收到的请求数
+    void IncrRequest(int func_id);
+
     bool GetFilesystemUsage(FileSystemUsage* usage);
     uint64_t GetFilesystemUsedPercent() const { return fs_usage_percent_.load();}
 
@@ -56,6 +62,9 @@ private:
     void collectDiskUsage();
     void printStatistics();
     void printDBMetric();
+    void collectDBMemUsage();
+    // 抓取metrics时调用
+    void collectMetrics(monitor::metrics::Writer* writer);
 
 private:
     ContextServer *context_ = nullptr;
@@ -66,12 +75,27 @@ private:
     std::atomic<uint64_t> fs_usage_percent_ = {0};
     std::atomic<uint64_t> split_count_ = {0};
 
+    static const int kMaxFuncID = 4096;
+    // 按func_id缓存的counter，第一次使用时创建
+    std::atomic<monitor::metrics::Counter*> request_counters_[kMaxFuncID];
+    monitor::metrics::Counter* other_requests_ = nullptr;
+
+    monitor::ProcCollector proc_collector_;
+    uint64_t collector_id_ = 0;
+
     std::set<uint64_t> leaders_;
     mutable std::mutex leaders_mu_;
 
     std::mutex mutex_;
     std::condition_variable cond_;
     std::thread metric_thread_;
+
+    // rocksdb自己管理的内存，定时采集
+    MemTracker db_mem_tracker_{"rocksdb", MemTracker::Root()};
+    MemTracker memtable_mem_tracker_{"memtable", &db_mem_tracker_};
+    MemTracker table_reader_mem_tracker_{"table_reader", &db_mem_tracker_};
+    MemTracker block_cache_mem_tracker_{"block_cache", &db_mem_tracker_};
+    MemTracker row_cache_mem_tracker_{"row_cache", &db_mem_tracker_};
 };
 
 }  // namespace server
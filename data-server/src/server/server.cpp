@@ -3,6 +3,7 @@
 #include <common/ds_config.h>
 #include <iostream>
 
+#include "base/mem_tracker.h"
 #include "common/ds_config.h"
 #include "common/socket_session_impl.h"
 
@@ -62,14 +63,24 @@ bool DataServer::startRaftServer() {
     ops.consensus_threads_num =
         static_cast<uint8_t>(ds_config.raft_config.consensus_threads);
     ops.consensus_queue_capacity = ds_config.raft_config.consensus_queue;
+    ops.apply_in_place = ds_config.raft_config.apply_in_place != 0;
     ops.apply_threads_num = static_cast<uint8_t>(ds_config.raft_config.apply_threads);
     ops.apply_queue_capacity = ds_config.raft_config.apply_queue;
+    ops.log_mmap_budget = ds_config.raft_config.log_mmap_budget;
     ops.tick_interval = std::chrono::milliseconds(ds_config.raft_config.tick_interval_ms);
+    ops.election_tick = static_cast<unsigned>(ds_config.raft_config.election_tick);
+    ops.enable_pre_vote = ds_config.raft_config.pre_vote != 0;
+    ops.enable_check_quorum = ds_config.raft_config.check_quorum != 0;
     ops.max_size_per_msg = ds_config.raft_config.max_msg_size;
 
     ops.transport_options.listen_port = static_cast<uint16_t>(ds_config.raft_config.port);
     ops.transport_options.send_io_threads = ds_config.raft_config.transport_send_threads;
     ops.transport_options.recv_io_threads = ds_config.raft_config.transport_recv_threads;
+    ops.transport_options.connection_pool_size = ds_config.raft_config.transport_connections;
+    ops.transport_options.compression =
+        static_cast<raft::CompressionType>(ds_config.raft_config.transport_compression);
+    ops.transport_options.compress_threshold =
+        ds_config.raft_config.transport_compress_threshold;
     ops.transport_options.resolver =
         std::make_shared<NodeAddress>(context_->master_worker);
 
@@ -108,6 +119,11 @@ int DataServer::Init() {
         context_->range_server->Clear();
     }
 
+    MemTracker::Root()->SetLimit(ds_config.memory_config.soft_limit,
+                                 ds_config.memory_config.hard_limit);
+    FLOG_INFO("memory limits: soft=%lu, hard=%lu", ds_config.memory_config.soft_limit,
+              ds_config.memory_config.hard_limit);
+
     if (!startRaftServer()) {
         return -1;
     }
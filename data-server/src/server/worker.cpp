@@ -61,6 +61,7 @@ void Worker::StartWorker(std::vector<std::thread> &worker,
 
                     if (task != nullptr) {
                         --hash_queue.all_msg_size;
+                        mem_tracker_.Release(task->MemBytes());
                         DealTask(task);
                     }
                 }
@@ -150,6 +151,7 @@ void Worker::Push(common::ProtoMessage *task) {
         return;
     }
 
+    mem_tracker_.Consume(task->MemBytes());
     if (isSlow(task)) {
         auto slot = ++slot_seed_ % ds_config.slow_worker_num;
         auto mq = slow_queue_.msg_queue[slot];
@@ -174,34 +176,33 @@ void Worker::DealTask(common::ProtoMessage *task) {
 }
 
 void Worker::Clean(HashQueue &hash_queue) {
+    clearHashQueue(hash_queue);
     for (auto mq : hash_queue.msg_queue) {
-        common::ProtoMessage *task = nullptr;
-        while (mq->msg_queue.try_dequeue(task)) {
+        delete mq;
+    }
+}
+
+size_t Worker::clearHashQueue(HashQueue &hash_queue) {
+    size_t count = 0;
+    for (auto& q : hash_queue.msg_queue) {
+        common::ProtoMessage *task;
+        while (q->msg_queue.try_dequeue(task)) {
+            --hash_queue.all_msg_size;
+            mem_tracker_.Release(task->MemBytes());
             delete task;
+            ++count;
         }
-        delete mq;
     }
+    return count;
 }
 
 size_t Worker::ClearQueue(bool fast, bool slow) {
     size_t count = 0;
     if (fast) {
-        for (auto& q : fast_queue_.msg_queue) {
-            common::ProtoMessage *task;
-            while (q->msg_queue.try_dequeue(task)) {
-                delete task;
-                ++count;
-            }
-        }
+        count += clearHashQueue(fast_queue_);
     }
     if (slow) {
-        for (auto& q : slow_queue_.msg_queue) {
-            common::ProtoMessage *task;
-            while (q->msg_queue.try_dequeue(task)) {
-                delete task;
-                ++count;
-            }
-        }
+        count += clearHashQueue(slow_queue_);
     }
     return count;
 }
@@ -7,6 +7,7 @@
 #include <thread>
 #include <vector>
 
+#include "base/mem_tracker.h"
 #include "common/ds_config.h"
 #include "common/socket_server.h"
 #include "frame/sf_status.h"
@@ -40,6 +41,8 @@ public:
 
     uint64_t FastQueueSize() const { return fast_queue_.all_msg_size; }
     uint64_t SlowQueueSize() const { return slow_queue_.all_msg_size; }
+    // 队列中等待处理的请求占用的内存
+    int64_t QueueBytes() const { return mem_tracker_.Usage(); }
 
     // TODO:
     void GetPending() const {}
@@ -61,6 +64,7 @@ private:
 
     void DealTask(common::ProtoMessage *task);
     void Clean(HashQueue &hash_queue);
+    size_t clearHashQueue(HashQueue &hash_queue);
 
     void StartWorker(std::vector<std::thread> &worker, HashQueue & hash_queue, int num);
 
@@ -72,6 +76,8 @@ private:
     HashQueue fast_queue_;
     HashQueue slow_queue_;
 
+    MemTracker mem_tracker_{"worker_queue", MemTracker::Root()};
+
     common::SocketServer socket_server_;
 
     sf_socket_status_t worker_status_ = {0};
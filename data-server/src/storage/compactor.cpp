@@ -0,0 +1,189 @@
+#include "compactor.h"
+
+#include <algorithm>
+#include <iterator>
+#include <rocksdb/table_properties.h>
+
+#include "base/util.h"
+#include "frame/sf_logger.h"
+#include "frame/sf_util.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace storage {
+
+Status GetTombstoneStats(rocksdb::DB* db, const std::string& start, const std::string& end,
+                         TombstoneStats* stats) {
+    rocksdb::Range range(start, end);
+    rocksdb::TablePropertiesCollection props;
+    auto s = db->GetPropertiesOfTablesInRange(db->DefaultColumnFamily(), &range, 1, &props);
+    if (!s.ok()) {
+        return Status(Status::kIOError, "get table properties", s.ToString());
+    }
+    for (const auto& p : props) {
+        ++stats->num_files;
+        stats->num_entries += p.second->num_entries;
+        stats->num_deletions += rocksdb::GetDeletedKeys(p.second->user_collected_properties);
+    }
+    return Status::OK();
+}
+
+Compactor::Compactor(rocksdb::DB* db, const CompactorOptions& opt) : db_(db), opt_(opt) {}
+
+Compactor::~Compactor() { Stop(); }
+
+void Compactor::Start() {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (running_ || opt_.interval_msec == 0) {
+        return;
+    }
+    running_ = true;
+    thr_ = std::thread(&Compactor::run, this);
+    AnnotateThread(thr_.native_handle(), "db_compactor");
+}
+
+void Compactor::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    cond_.notify_all();
+    if (thr_.joinable()) {
+        thr_.join();
+    }
+}
+
+void Compactor::ScheduleRangeDeleted(const std::string& start, const std::string& end) {
+    schedule(start, end, true, 0);
+}
+
+void Compactor::ScheduleKeysDeleted(const std::string& start, const std::string& end,
+                                    uint64_t deleted_keys) {
+    schedule(start, end, false, deleted_keys);
+}
+
+size_t Compactor::PendingCount() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return pending_.size();
+}
+
+void Compactor::schedule(const std::string& start, const std::string& end, bool force,
+                         uint64_t deleted_keys) {
+    if (opt_.interval_msec == 0 || start > end) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mu_);
+    if (!running_) {
+        return;
+    }
+
+    Task task;
+    task.end = end;
+    task.force = force;
+    task.deleted_keys = deleted_keys;
+    auto task_start = start;
+
+    // 合并所有与[start, end]相邻或重叠的区间
+    auto it = pending_.upper_bound(task_start);
+    if (it != pending_.begin()) {
+        auto prev = std::prev(it);
+        if (prev->second.end >= task_start) {
+            it = prev;
+        }
+    }
+    while (it != pending_.end() && it->first <= task.end) {
+        task_start = std::min(task_start, it->first);
+        task.end = std::max(task.end, it->second.end);
+        task.force = task.force || it->second.force;
+        task.deleted_keys += it->second.deleted_keys;
+        it = pending_.erase(it);
+    }
+
+    if (pending_.size() >= opt_.max_pending) {
+        ++skipped_count_;
+        FLOG_WARN("compactor: too many pending ranges(%zu), drop [%s-%s]", pending_.size(),
+                  EncodeToHex(task_start).c_str(), EncodeToHex(task.end).c_str());
+        return;
+    }
+    pending_.emplace(std::move(task_start), std::move(task));
+    lock.unlock();
+    cond_.notify_one();
+}
+
+void Compactor::run() {
+    while (true) {
+        std::string start;
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            cond_.wait(lock, [this] { return !running_ || !pending_.empty(); });
+            if (!running_) {
+                return;
+            }
+            auto it = pending_.begin();
+            start = it->first;
+            task = std::move(it->second);
+            pending_.erase(it);
+        }
+
+        compact(start, task);
+
+        // 限速，两次压缩之间至少间隔interval_msec
+        std::unique_lock<std::mutex> lock(mu_);
+        cond_.wait_for(lock, std::chrono::milliseconds(opt_.interval_msec),
+                       [this] { return !running_; });
+        if (!running_) {
+            return;
+        }
+    }
+}
+
+void Compactor::compact(const std::string& start, const Task& task) {
+    if (!task.force) {
+        TombstoneStats stats;
+        auto s = GetTombstoneStats(db_, start, task.end, &stats);
+        if (!s.ok()) {
+            FLOG_WARN("compactor: %s", s.ToString().c_str());
+            return;
+        }
+        // 刚删除的key还在memtable中，table properties里没有，需要加上
+        // 被删除的key原来都在sst里，已经计入了num_entries
+        if (stats.num_entries == 0) {
+            ++skipped_count_;
+            return;
+        }
+        stats.num_deletions += task.deleted_keys;
+        if (stats.Percent() < opt_.tombstone_percent) {
+            ++skipped_count_;
+            FLOG_DEBUG("compactor: skip [%s-%s], files: %" PRIu64 ", tombstones: %" PRIu64 "%%",
+                       EncodeToHex(start).c_str(), EncodeToHex(task.end).c_str(),
+                       stats.num_files, stats.Percent());
+            return;
+        }
+    }
+
+    auto begin_time = getticks();
+    rocksdb::CompactRangeOptions ops;
+    // 不阻塞自动压缩
+    ops.exclusive_manual_compaction = false;
+    rocksdb::Slice begin(start);
+    rocksdb::Slice end(task.end);
+    auto s = db_->CompactRange(ops, &begin, &end);
+    if (!s.ok()) {
+        FLOG_ERROR("compactor: compact [%s-%s] failed: %s", EncodeToHex(start).c_str(),
+                   EncodeToHex(task.end).c_str(), s.ToString().c_str());
+        return;
+    }
+    ++compacted_count_;
+    FLOG_INFO("compactor: compact [%s-%s] finished, force: %d, take %" PRId64 " ms",
+              EncodeToHex(start).c_str(), EncodeToHex(task.end).c_str(), task.force,
+              getticks() - begin_time);
+}
+
+}  // namespace storage
+}  // namespace dataserver
+}  // namespace sharkstore
@@ -0,0 +1,94 @@
+_Pragma("once");
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <rocksdb/db.h>
+
+#include "base/status.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace storage {
+
+// 区间内sst文件的删除标记统计（来自table properties，不包括memtable）
+struct TombstoneStats {
+    uint64_t num_files = 0;
+    uint64_t num_entries = 0;
+    uint64_t num_deletions = 0;
+
+    // 删除标记所占的百分比
+    uint64_t Percent() const {
+        return num_entries == 0 ? 0 : num_deletions * 100 / num_entries;
+    }
+};
+
+Status GetTombstoneStats(rocksdb::DB* db, const std::string& start, const std::string& end,
+                         TombstoneStats* stats);
+
+struct CompactorOptions {
+    // 两次压缩之间的最小间隔，用来限制压缩速度，为0表示不做定向压缩
+    uint64_t interval_msec = 10000;
+    // 删除标记百分比超过该值时压缩
+    uint64_t tombstone_percent = 30;
+    // 等待压缩的区间个数上限，超过后丢弃新的区间
+    size_t max_pending = 1024;
+};
+
+// 大量删除之后对删除的区间做定向压缩，避免后续扫描跨过大量删除标记
+// 相邻或重叠的区间在等待期间合并，后台线程按照间隔逐个执行
+class Compactor {
+public:
+    Compactor(rocksdb::DB* db, const CompactorOptions& opt);
+    ~Compactor();
+
+    Compactor(const Compactor&) = delete;
+    Compactor& operator=(const Compactor&) = delete;
+
+    void Start();
+    void Stop();
+
+    // DeleteRange之后调用，不检查删除标记比例直接压缩
+    void ScheduleRangeDeleted(const std::string& start, const std::string& end);
+    // 逐个删除deleted_keys个key之后调用，加上sst中的删除标记超过比例才压缩
+    void ScheduleKeysDeleted(const std::string& start, const std::string& end,
+                             uint64_t deleted_keys);
+
+    size_t PendingCount() const;
+    uint64_t CompactedCount() const { return compacted_count_; }
+    uint64_t SkippedCount() const { return skipped_count_; }
+
+private:
+    struct Task {
+        std::string end;
+        bool force = false;
+        uint64_t deleted_keys = 0;
+    };
+
+    void schedule(const std::string& start, const std::string& end, bool force,
+                  uint64_t deleted_keys);
+    void run();
+    void compact(const std::string& start, const Task& task);
+
+private:
+    rocksdb::DB* const db_ = nullptr;
+    const CompactorOptions opt_;
+
+    // start key -> task，区间互不重叠
+    std::map<std::string, Task> pending_;
+    mutable std::mutex mu_;
+    std::condition_variable cond_;
+    bool running_ = false;
+    std::thread thr_;
+
+    std::atomic<uint64_t> compacted_count_ = {0};
+    std::atomic<uint64_t> skipped_count_ = {0};
+};
+
+}  // namespace storage
+}  // namespace dataserver
+}  // namespace sharkstore
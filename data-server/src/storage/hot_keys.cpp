@@ -0,0 +1,128 @@
+#include "hot_keys.h"
+
+#include <algorithm>
+
+namespace sharkstore {
+namespace dataserver {
+namespace storage {
+
+HotKeySketch::HotKeySketch(size_t capacity) : capacity_(capacity) {}
+
+void HotKeySketch::update(const std::string& key, Entry* entry, uint64_t count) {
+    ordered_.erase(std::make_pair(entry->count, key));
+    entry->count += count;
+    ordered_.emplace(entry->count, key);
+}
+
+void HotKeySketch::Add(const std::string& key, uint64_t count) {
+    if (capacity_ == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        update(key, &it->second, count);
+        return;
+    }
+
+    Entry entry;
+    if (entries_.size() >= capacity_) {
+        // 替换计数最小的key
+        auto min = ordered_.begin();
+        entry.count = min->first;
+        entry.error = min->first;
+        entries_.erase(min->second);
+        ordered_.erase(min);
+    }
+    entry.count += count;
+    entries_.emplace(key, entry);
+    ordered_.emplace(entry.count, key);
+}
+
+bool HotKeySketch::Sample(uint64_t interval) {
+    if (interval <= 1) {
+        return true;
+    }
+    return access_count_.fetch_add(1, std::memory_order_relaxed) % interval == interval - 1;
+}
+
+void HotKeySketch::TopK(size_t top_k, std::vector<HotKey>* result) const {
+    result->clear();
+    std::lock_guard<std::mutex> lock(mu_);
+    for (auto it = ordered_.rbegin(); it != ordered_.rend() && result->size() < top_k; ++it) {
+        HotKey hk;
+        hk.key = it->second;
+        hk.count = it->first;
+        hk.error = entries_.at(it->second).error;
+        result->push_back(std::move(hk));
+    }
+}
+
+void HotKeySketch::Decay() {
+    std::lock_guard<std::mutex> lock(mu_);
+    ordered_.clear();
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        it->second.count /= 2;
+        it->second.error /= 2;
+        if (it->second.count == 0) {
+            it = entries_.erase(it);
+        } else {
+            ordered_.emplace(it->second.count, it->first);
+            ++it;
+        }
+    }
+}
+
+size_t HotKeySketch::Size() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return entries_.size();
+}
+
+const size_t HotKeys::kMaxKeyLength;
+const size_t HotKeys::kCapacityFactor;
+
+HotKeys::HotKeys(size_t top_k, size_t prefix_len, uint64_t sample_interval)
+    : top_k_(top_k),
+      prefix_len_(std::min(prefix_len, kMaxKeyLength)),
+      sample_interval_(std::max(sample_interval, static_cast<uint64_t>(1))),
+      read_keys_(top_k * kCapacityFactor),
+      write_keys_(top_k * kCapacityFactor),
+      read_prefixes_(prefix_len > 0 ? top_k * kCapacityFactor : 0),
+      write_prefixes_(prefix_len > 0 ? top_k * kCapacityFactor : 0) {}
+
+void HotKeys::record(const std::string& key, HotKeySketch* keys, HotKeySketch* prefixes) {
+    if (top_k_ == 0) {
+        return;
+    }
+    // 按完整key的sketch计数采样，前缀跟随同一次采样
+    if (!keys->Sample(sample_interval_)) {
+        return;
+    }
+
+    if (key.size() > kMaxKeyLength) {
+        keys->Add(key.substr(0, kMaxKeyLength), sample_interval_);
+    } else {
+        keys->Add(key, sample_interval_);
+    }
+    if (prefix_len_ > 0 && key.size() > prefix_len_) {
+        prefixes->Add(key.substr(0, prefix_len_), sample_interval_);
+    }
+}
+
+void HotKeys::Collect(HotKeysStat* stat, bool decay) {
+    read_keys_.TopK(top_k_, &stat->read_keys);
+    write_keys_.TopK(top_k_, &stat->write_keys);
+    read_prefixes_.TopK(top_k_, &stat->read_prefixes);
+    write_prefixes_.TopK(top_k_, &stat->write_prefixes);
+    if (decay) {
+        read_keys_.Decay();
+        write_keys_.Decay();
+        read_prefixes_.Decay();
+        write_prefixes_.Decay();
+    }
+}
+
+} /* namespace storage */
+} /* namespace dataserver */
+} /* namespace sharkstore */
@@ -0,0 +1,104 @@
+_Pragma("once");
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sharkstore {
+namespace dataserver {
+namespace storage {
+
+struct HotKey {
+    std::string key;
+    uint64_t count = 0;  // 估计的访问次数（衰减后），不小于真实值
+    uint64_t error = 0;  // count的最大高估量
+};
+
+// Space-Saving算法：最多保留capacity个计数器，
+// 新key进来时替换计数最小的key并继承它的计数作为误差，真实次数大于N/capacity的key一定会被保留
+class HotKeySketch {
+public:
+    explicit HotKeySketch(size_t capacity);
+
+    HotKeySketch(const HotKeySketch&) = delete;
+    HotKeySketch& operator=(const HotKeySketch&) = delete;
+
+    void Add(const std::string& key, uint64_t count = 1);
+
+    // 每interval次调用返回一次true，每个sketch单独计数
+    bool Sample(uint64_t interval);
+
+    // 按count降序返回最多top_k个
+    void TopK(size_t top_k, std::vector<HotKey>* result) const;
+
+    // 所有计数减半，减到0的移除，使统计偏向最近的访问
+    void Decay();
+
+    size_t Size() const;
+
+private:
+    struct Entry {
+        uint64_t count = 0;
+        uint64_t error = 0;
+    };
+
+    void update(const std::string& key, Entry* entry, uint64_t count);
+
+private:
+    const size_t capacity_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::set<std::pair<uint64_t, std::string>> ordered_;  // (count, key)
+    mutable std::mutex mu_;
+    // 采样计数，不需要精确，不加锁
+    std::atomic<uint64_t> access_count_{0};
+};
+
+struct HotKeysStat {
+    std::vector<HotKey> read_keys;
+    std::vector<HotKey> write_keys;
+    std::vector<HotKey> read_prefixes;
+    std::vector<HotKey> write_prefixes;
+};
+
+// 一个range的读写热点统计，读和写、完整key和key前缀分别统计
+class HotKeys {
+public:
+    // top_k为0表示不统计；prefix_len为0表示不统计前缀；每sample_interval次访问采样一次
+    HotKeys(size_t top_k, size_t prefix_len, uint64_t sample_interval);
+
+    HotKeys(const HotKeys&) = delete;
+    HotKeys& operator=(const HotKeys&) = delete;
+
+    bool Enabled() const { return top_k_ > 0; }
+
+    void RecordRead(const std::string& key) { record(key, &read_keys_, &read_prefixes_); }
+    void RecordWrite(const std::string& key) { record(key, &write_keys_, &write_prefixes_); }
+
+    // decay为true时取出后衰减（range心跳时），否则只读取（admin查询）
+    void Collect(HotKeysStat* stat, bool decay);
+
+private:
+    void record(const std::string& key, HotKeySketch* keys, HotKeySketch* prefixes);
+
+private:
+    // 超过的部分截断，限制内存
+    static const size_t kMaxKeyLength = 256;
+    // 计数器个数为top_k的倍数，提高top_k的准确性
+    static const size_t kCapacityFactor = 4;
+
+    const size_t top_k_;
+    const size_t prefix_len_;
+    const uint64_t sample_interval_;
+
+    HotKeySketch read_keys_;
+    HotKeySketch write_keys_;
+    HotKeySketch read_prefixes_;
+    HotKeySketch write_prefixes_;
+};
+
+} /* namespace storage */
+} /* namespace dataserver */
+} /* namespace sharkstore */
@@ -1,9 +1,18 @@
 #include "iterator.h"
 
+#include "mvcc.h"
+
 namespace sharkstore {
 namespace dataserver {
 namespace storage {
 
+// 大于key的所有版本、小于其它key的位置
+static std::string pastVersions(const std::string& key) {
+    auto buf = EncodeMvccKey(key, 0);
+    buf.push_back('\0');
+    return buf;
+}
+
 Iterator::Iterator(rocksdb::Iterator* it, const std::string& start,
                    const std::string& limit)
     : rit_(it), limit_(limit) {
@@ -12,11 +21,56 @@ Iterator::Iterator(rocksdb::Iterator* it, const std::string& start,
     rit_->Seek(start);
 }
 
+Iterator::Iterator(rocksdb::Iterator* it, const std::string& start,
+                   const std::string& limit, uint64_t version)
+    : rit_(it), limit_(EncodeMvccBound(limit)), mvcc_(true), version_(version) {
+    assert(!start.empty());
+    assert(!limit.empty());
+    rit_->Seek(EncodeMvccBound(start));
+    seekVisible();
+}
+
 Iterator::~Iterator() { delete rit_; }
 
-bool Iterator::Valid() { return rit_->Valid() && (key() < limit_); }
+// 直接比较Slice，不拷贝出key
+bool Iterator::Valid() {
+    if (mvcc_) {
+        return valid_;
+    }
+    return rit_->Valid() && rit_->key().compare(limit_) < 0;
+}
 
-void Iterator::Next() { rit_->Next(); }
+void Iterator::Next() {
+    if (!mvcc_) {
+        rit_->Next();
+        return;
+    }
+    // 跳过当前key更旧的版本
+    rit_->Seek(pastVersions(key_));
+    seekVisible();
+}
+
+void Iterator::seekVisible() {
+    valid_ = false;
+    while (rit_->Valid() && rit_->key().compare(limit_) < 0) {
+        uint64_t version = 0;
+        if (!DecodeMvccKey(rit_->key(), &key_, &version)) {
+            rit_->Next();
+            continue;
+        }
+        if (version > version_) {
+            // 跳到不大于version_的最新版本
+            rit_->Seek(EncodeMvccKey(key_, version_));
+            continue;
+        }
+        if (!IsMvccDeletion(rit_->value())) {
+            valid_ = true;
+            return;
+        }
+        // 已删除，跳过这个key的所有版本
+        rit_->Seek(pastVersions(key_));
+    }
+}
 
 Status Iterator::status() {
     if (!rit_->status().ok()) {
@@ -25,13 +79,33 @@ Status Iterator::status() {
     return Status::OK();
 }
 
-std::string Iterator::key() { return rit_->key().ToString(); }
+std::string Iterator::key() {
+    if (mvcc_) {
+        return key_;
+    }
+    return rit_->key().ToString();
+}
 
-std::string Iterator::value() { return rit_->value().ToString(); }
+std::string Iterator::value() {
+    if (mvcc_) {
+        return MvccValue(rit_->value()).ToString();
+    }
+    return rit_->value().ToString();
+}
 
-uint64_t Iterator::key_size() { return rit_->key().size(); }
+uint64_t Iterator::key_size() {
+    if (mvcc_) {
+        return key_.size();
+    }
+    return rit_->key().size();
+}
 
-uint64_t Iterator::value_size() { return rit_->value().size(); }
+uint64_t Iterator::value_size() {
+    if (mvcc_) {
+        return MvccValue(rit_->value()).size();
+    }
+    return rit_->value().size();
+}
 
 } /* namespace storage */
 } /* namespace dataserver */
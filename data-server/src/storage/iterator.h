@@ -13,6 +13,9 @@ class Iterator {
 public:
     Iterator(rocksdb::Iterator* it, const std::string& start,
              const std::string& limit);
+    // mvcc编码的数据，只返回每个key在version时可见的版本
+    Iterator(rocksdb::Iterator* it, const std::string& start,
+             const std::string& limit, uint64_t version);
     ~Iterator();
 
     bool Valid();
@@ -25,9 +28,18 @@ public:
     uint64_t key_size();
     uint64_t value_size();
 
+private:
+    // 从当前位置开始找到第一个有可见版本的key
+    void seekVisible();
+
 private:
     rocksdb::Iterator* rit_ = nullptr;
-    const std::string limit_;
+    const std::string limit_;  // mvcc模式下是编码后的位置
+
+    const bool mvcc_ = false;
+    const uint64_t version_ = 0;
+    bool valid_ = false;
+    std::string key_;  // mvcc模式下当前的原始key
 };
 
 } /* namespace storage */
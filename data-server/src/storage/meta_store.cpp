@@ -113,6 +113,36 @@ Status MetaStore::GetAllRange(std::vector<metapb::Range>* range_metas) {
     return Status::OK();
 }
 
+Status MetaStore::GetAllRange(std::vector<metapb::Range>* range_metas,
+                              std::map<uint64_t, uint64_t>* apply_indexes) {
+    std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(rocksdb::ReadOptions()));
+    for (it->Seek(kRangeMetaPrefix); it->Valid(); it->Next()) {
+        auto key = it->key();
+        if (key.starts_with(kRangeMetaPrefix)) {
+            metapb::Range rng;
+            if (!rng.ParseFromArray(it->value().data(), static_cast<int>(it->value().size()))) {
+                return Status(Status::kCorruption, "parse", it->value().ToString(true));
+            }
+            range_metas->push_back(std::move(rng));
+        } else if (key.starts_with(kRangeApplyPrefix)) {
+            key.remove_prefix(kRangeApplyPrefix.size());
+            try {
+                auto range_id = std::stoull(key.ToString());
+                (*apply_indexes)[range_id] = std::stoull(it->value().ToString());
+            } catch (std::exception &e) {
+                return Status(Status::kCorruption, "invalid applied",
+                              EncodeToHex(key.ToString()) + ": " + EncodeToHex(it->value().ToString()));
+            }
+        } else {
+            break;
+        }
+    }
+    if (!it->status().ok()) {
+        return Status(Status::kIOError, "iterator", it->status().ToString());
+    }
+    return Status::OK();
+}
+
 Status MetaStore::GetRange(uint64_t range_id, metapb::Range* meta) {
     std::string key = kRangeMetaPrefix + std::to_string(range_id);
 
@@ -208,8 +238,10 @@ Status MetaStore::LoadApplyIndex(uint64_t range_id, uint64_t *apply_index) {
 }
 
 Status MetaStore::DeleteApplyIndex(uint64_t range_id) {
-    std::string key = kRangeApplyPrefix + std::to_string(range_id);
-    auto ret = db_->Delete(rocksdb::WriteOptions(), key);
+    rocksdb::WriteBatch batch;
+    batch.Delete(kRangeApplyPrefix + std::to_string(range_id));
+    batch.Delete(kRangeMvccVersionPrefix + std::to_string(range_id));
+    auto ret = db_->Write(rocksdb::WriteOptions(), &batch);
     if (ret.ok()) {
         return Status::OK();
     } else {
@@ -217,6 +249,80 @@ Status MetaStore::DeleteApplyIndex(uint64_t range_id) {
     }
 }
 
+Status MetaStore::SaveApplyIndex(uint64_t range_id, uint64_t apply_index,
+                                 uint64_t mvcc_version) {
+    rocksdb::WriteBatch batch;
+    batch.Put(kRangeApplyPrefix + std::to_string(range_id), std::to_string(apply_index));
+    batch.Put(kRangeMvccVersionPrefix + std::to_string(range_id), std::to_string(mvcc_version));
+    auto ret = db_->Write(rocksdb::WriteOptions(), &batch);
+    if (ret.ok()) {
+        return Status::OK();
+    } else {
+        return Status(Status::kIOError, "meta save apply", ret.ToString());
+    }
+}
+
+Status MetaStore::SaveMvccVersion(uint64_t range_id, uint64_t mvcc_version) {
+    std::string key = kRangeMvccVersionPrefix + std::to_string(range_id);
+    auto ret = db_->Put(rocksdb::WriteOptions(), key, std::to_string(mvcc_version));
+    if (ret.ok()) {
+        return Status::OK();
+    } else {
+        return Status(Status::kIOError, "meta save mvcc version", ret.ToString());
+    }
+}
+
+Status MetaStore::LoadMvccVersion(uint64_t range_id, uint64_t *mvcc_version) {
+    std::string key = kRangeMvccVersionPrefix + std::to_string(range_id);
+    std::string value;
+    auto ret = db_->Get(rocksdb::ReadOptions(), key, &value);
+    if (ret.ok()) {
+        try {
+            *mvcc_version = std::stoull(value);
+        } catch (std::exception &e) {
+            return Status(Status::kCorruption, "invalid mvcc version", EncodeToHex(value));
+        }
+        return Status::OK();
+    } else if (ret.IsNotFound()) {
+        *mvcc_version = 0;
+        return Status::OK();
+    } else {
+        return Status(Status::kIOError, "meta load mvcc version", ret.ToString());
+    }
+}
+
+static const std::string kStorageModeMvcc = "mvcc";
+static const std::string kStorageModePlain = "plain";
+
+Status MetaStore::SaveStorageMode(bool mvcc) {
+    auto ret = db_->Put(write_options_, kStorageModeKey,
+                        mvcc ? kStorageModeMvcc : kStorageModePlain);
+    if (ret.ok()) {
+        return Status::OK();
+    } else {
+        return Status(Status::kIOError, "meta save storage mode", ret.ToString());
+    }
+}
+
+Status MetaStore::LoadStorageMode(bool *mvcc, bool *exists) {
+    std::string value;
+    auto ret = db_->Get(rocksdb::ReadOptions(), kStorageModeKey, &value);
+    if (ret.ok()) {
+        if (value != kStorageModeMvcc && value != kStorageModePlain) {
+            return Status(Status::kCorruption, "invalid storage mode", EncodeToHex(value));
+        }
+        *mvcc = (value == kStorageModeMvcc);
+        *exists = true;
+        return Status::OK();
+    } else if (ret.IsNotFound()) {
+        *mvcc = false;
+        *exists = false;
+        return Status::OK();
+    } else {
+        return Status(Status::kIOError, "meta load storage mode", ret.ToString());
+    }
+}
+
 }  // namespace storage
 }  // namespace dataserver
 }  // namespace sharkstore
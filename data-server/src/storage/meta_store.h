@@ -17,6 +17,8 @@ static const std::string kRangeMetaPrefix = "\x02";
 static const std::string kRangeApplyPrefix = "\x03";
 static const std::string kNodeIDKey = "\x04NodeID";
 static const std::string kRangeVersionPrefix = "\x05";
+static const std::string kRangeMvccVersionPrefix = "\x06";
+static const std::string kStorageModeKey = "\x07StorageMode";
 
 class MetaStore {
 public:
@@ -36,6 +38,9 @@ public:
     Status GetVersionID(const uint64_t &range_id, int64_t* ver_id);
 
     Status GetAllRange(std::vector<metapb::Range>* range_metas);
+    // 一次遍历同时加载所有range的元数据和apply位置（两者的前缀相邻）
+    Status GetAllRange(std::vector<metapb::Range>* range_metas,
+                       std::map<uint64_t, uint64_t>* apply_indexes);
     Status GetRange(uint64_t range_id, metapb::Range* meta);
     Status AddRange(const metapb::Range& meta);
     Status BatchAddRange(const std::vector<metapb::Range>& range_metas);
@@ -45,6 +50,15 @@ public:
     Status LoadApplyIndex(uint64_t range_id, uint64_t* apply_index);
     Status DeleteApplyIndex(uint64_t range_id);
 
+    // mvcc模式下apply位置和最近分配的写入版本在同一个batch里保存
+    Status SaveApplyIndex(uint64_t range_id, uint64_t apply_index, uint64_t mvcc_version);
+    Status SaveMvccVersion(uint64_t range_id, uint64_t mvcc_version);
+    Status LoadMvccVersion(uint64_t range_id, uint64_t* mvcc_version);
+
+    // 数据db的编码方式(是否mvcc)，没有保存过时exists为false
+    Status SaveStorageMode(bool mvcc);
+    Status LoadStorageMode(bool* mvcc, bool* exists);
+
 private:
     const std::string path_;
     rocksdb::WriteOptions write_options_;
@@ -0,0 +1,157 @@
+#include "mvcc.h"
+
+#include <cstring>
+
+#include "common/ds_encoding.h"
+#include "frame/sf_util.h"
+#include "store.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace storage {
+
+static const char kMvccTypeValue = 'v';
+static const char kMvccTypeDeletion = 'd';
+
+// EncodeBytesAscending的结束符
+static const char kMvccKeyTerm[] = {'\x00', '\x01'};
+static const size_t kMvccKeyTermSize = sizeof(kMvccKeyTerm);
+
+std::string EncodeMvccKey(const std::string& key, uint64_t version) {
+    std::string buf;
+    buf.reserve(key.size() + 3 + kMvccVersionSize);
+    EncodeBytesAscending(&buf, key.data(), key.size());
+    // 取反后新的版本排在前面
+    EncodeUint64Ascending(&buf, ~version);
+    return buf;
+}
+
+std::string EncodeMvccBound(const std::string& key) {
+    std::string buf;
+    buf.reserve(key.size() + 3);
+    EncodeBytesAscending(&buf, key.data(), key.size());
+    // 去掉结束符，是key所有版本的公共前缀，且大于所有比key小的原始key的编码
+    buf.resize(buf.size() - kMvccKeyTermSize);
+    return buf;
+}
+
+// 拆出编码后的key部分和版本，不解码原始key
+static bool splitMvccKey(const rocksdb::Slice& mvcc_key, rocksdb::Slice* encoded_key,
+                         uint64_t* version) {
+    if (mvcc_key.size() < 1 + kMvccKeyTermSize + kMvccVersionSize) {
+        return false;
+    }
+    auto key_size = mvcc_key.size() - kMvccVersionSize;
+    if (memcmp(mvcc_key.data() + key_size - kMvccKeyTermSize, kMvccKeyTerm,
+               kMvccKeyTermSize) != 0) {
+        return false;
+    }
+    auto p = reinterpret_cast<const unsigned char*>(mvcc_key.data()) + key_size;
+    uint64_t v = 0;
+    for (size_t i = 0; i < kMvccVersionSize; ++i) {
+        v = (v << 8) | p[i];
+    }
+    *encoded_key = rocksdb::Slice(mvcc_key.data(), key_size);
+    *version = ~v;
+    return true;
+}
+
+bool DecodeMvccKey(const rocksdb::Slice& mvcc_key, std::string* key, uint64_t* version) {
+    rocksdb::Slice encoded_key;
+    if (!splitMvccKey(mvcc_key, &encoded_key, version)) {
+        return false;
+    }
+    std::string buf(encoded_key.data(), encoded_key.size());
+    size_t pos = 0;
+    key->clear();
+    return DecodeBytesAscending(buf, pos, key) && pos == buf.size();
+}
+
+std::string EncodeMvccValue(const std::string& value) {
+    std::string buf;
+    buf.reserve(value.size() + 1);
+    buf.push_back(kMvccTypeValue);
+    buf.append(value);
+    return buf;
+}
+
+std::string EncodeMvccDeletion() { return std::string(1, kMvccTypeDeletion); }
+
+bool IsMvccDeletion(const rocksdb::Slice& value) {
+    return value.size() == 0 || value[0] == kMvccTypeDeletion;
+}
+
+rocksdb::Slice MvccValue(const rocksdb::Slice& value) {
+    if (value.size() == 0) {
+        return value;
+    }
+    return rocksdb::Slice(value.data() + 1, value.size() - 1);
+}
+
+rocksdb::Status MvccGet(rocksdb::Iterator* it, const std::string& key, uint64_t version,
+                        std::string* value) {
+    auto seek_key = EncodeMvccKey(key, version);
+    it->Seek(seek_key);
+    if (!it->Valid()) {
+        return it->status().ok() ? rocksdb::Status::NotFound() : it->status();
+    }
+    // 比较编码后的key部分，不需要解码
+    rocksdb::Slice encoded_key;
+    uint64_t found = 0;
+    if (!splitMvccKey(it->key(), &encoded_key, &found) ||
+        encoded_key.compare(rocksdb::Slice(seek_key.data(),
+                                           seek_key.size() - kMvccVersionSize)) != 0 ||
+        IsMvccDeletion(it->value())) {
+        return rocksdb::Status::NotFound();
+    }
+    auto v = MvccValue(it->value());
+    value->assign(v.data(), v.size());
+    return rocksdb::Status::OK();
+}
+
+MvccGCFilter::MvccGCFilter(uint64_t safe_point, bool full_compaction)
+    : safe_point_(safe_point), full_compaction_(full_compaction) {}
+
+bool MvccGCFilter::Filter(int level, const rocksdb::Slice& key,
+                          const rocksdb::Slice& existing_value, std::string* new_value,
+                          bool* value_changed) const {
+    // watch变更日志不是mvcc编码
+    if (key.size() > 0 && static_cast<unsigned char>(key[0]) == kWatchLogPrefixByte) {
+        return false;
+    }
+
+    rocksdb::Slice encoded_key;
+    uint64_t version = 0;
+    if (!splitMvccKey(key, &encoded_key, &version)) {
+        return false;
+    }
+
+    if (encoded_key.compare(last_key_) != 0) {
+        last_key_.assign(encoded_key.data(), encoded_key.size());
+        last_key_kept_ = false;
+    }
+    if (version > safe_point_) {
+        return false;
+    }
+    // 安全点之前已经保留了一个更新的版本
+    if (last_key_kept_) {
+        return true;
+    }
+    last_key_kept_ = true;
+    return full_compaction_ && IsMvccDeletion(existing_value);
+}
+
+std::unique_ptr<rocksdb::CompactionFilter> MvccGCFilterFactory::CreateCompactionFilter(
+    const rocksdb::CompactionFilter::Context& context) {
+    return std::unique_ptr<rocksdb::CompactionFilter>(
+        new MvccGCFilter(SafePoint(gc_window_ms_), context.is_full_compaction));
+}
+
+uint64_t MvccGCFilterFactory::SafePoint(uint64_t gc_window_ms) {
+    auto now = static_cast<uint64_t>(getticks());
+    return now > gc_window_ms ? now - gc_window_ms : 0;
+}
+
+} /* namespace storage */
+} /* namespace dataserver */
+} /* namespace sharkstore */
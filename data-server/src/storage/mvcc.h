@@ -0,0 +1,76 @@
+_Pragma("once");
+
+#include <rocksdb/compaction_filter.h>
+#include <rocksdb/db.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace sharkstore {
+namespace dataserver {
+namespace storage {
+
+// MVCC编码
+// key: EncodeBytesAscending(原始key) + 8字节取反的版本(大端)，同一个key的版本从新到旧相邻排列
+//      原始key转义并加结束符，有前缀关系的key之间也保持原始key的顺序
+// value: 1字节类型 + 原始value，删除写入一个删除类型的版本
+// 版本(ms)在apply时按日志顺序分配，不低于命令的leader_time
+static const uint64_t kMaxVersion = std::numeric_limits<uint64_t>::max();
+static const size_t kMvccVersionSize = 8;
+
+std::string EncodeMvccKey(const std::string& key, uint64_t version);
+bool DecodeMvccKey(const rocksdb::Slice& mvcc_key, std::string* key, uint64_t* version);
+// 原始key作为区间边界[start, limit)时在编码后对应的位置：
+// 不小于原始key的所有版本都不小于它，小于原始key的都小于它
+std::string EncodeMvccBound(const std::string& key);
+
+std::string EncodeMvccValue(const std::string& value);
+std::string EncodeMvccDeletion();
+bool IsMvccDeletion(const rocksdb::Slice& value);
+// 去掉类型，返回原始value
+rocksdb::Slice MvccValue(const rocksdb::Slice& value);
+
+// 读取key在version时的值，key不存在或者已删除返回kNotFound
+rocksdb::Status MvccGet(rocksdb::Iterator* it, const std::string& key, uint64_t version,
+                        std::string* value);
+
+// 版本回收：安全点(当前时间 - gc_window_ms)之前，每个key只保留最新的一个版本
+// 更旧的版本在compaction时删除；最新的版本是删除标记时只在全量compaction时删除，
+// 否则下层文件中更旧的版本会重新可见
+class MvccGCFilter : public rocksdb::CompactionFilter {
+public:
+    MvccGCFilter(uint64_t safe_point, bool full_compaction);
+
+    bool Filter(int level, const rocksdb::Slice& key, const rocksdb::Slice& existing_value,
+                std::string* new_value, bool* value_changed) const override;
+
+    const char* Name() const override { return "sharkstore.MvccGCFilter"; }
+
+private:
+    const uint64_t safe_point_;
+    const bool full_compaction_;
+
+    // compaction按key顺序调用，记录上一个key(编码后)是否已经保留了安全点之前的版本
+    mutable std::string last_key_;
+    mutable bool last_key_kept_ = false;
+};
+
+class MvccGCFilterFactory : public rocksdb::CompactionFilterFactory {
+public:
+    explicit MvccGCFilterFactory(uint64_t gc_window_ms) : gc_window_ms_(gc_window_ms) {}
+
+    std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
+        const rocksdb::CompactionFilter::Context& context) override;
+
+    const char* Name() const override { return "sharkstore.MvccGCFilterFactory"; }
+
+    // 当前的安全点，比它旧的版本可能已经被回收，不能再读
+    static uint64_t SafePoint(uint64_t gc_window_ms);
+
+private:
+    const uint64_t gc_window_ms_;
+};
+
+} /* namespace storage */
+} /* namespace dataserver */
+} /* namespace sharkstore */
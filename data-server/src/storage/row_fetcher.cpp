@@ -11,9 +11,10 @@ namespace storage {
 
 static const size_t kIteratorTooManyKeys = 1000;
 
-RowFetcher::RowFetcher(Store& s, const kvrpcpb::SelectRequest& req)
+RowFetcher::RowFetcher(Store& s, const kvrpcpb::SelectRequest& req, uint64_t version)
     : store_(s),
-      decoder_(s.GetPrimaryKeys(), req.field_list(), req.where_filters()) {
+      decoder_(s.GetPrimaryKeys(), req.field_list(), req.where_filters()),
+      version_(version) {
     init(req.key(), req.scope());
 }
 
@@ -42,7 +43,11 @@ void RowFetcher::init(const std::string& key, const ::kvrpcpb::Scope& scope) {
         key_ = key;
         return;
     }
-    iter_ = store_.NewIterator(scope);
+    iter_ = store_.NewIterator(scope, version_);
+    // 范围扫描按起始key统计热点
+    if (!scope.start().empty()) {
+        store_.hot_keys_.RecordRead(scope.start());
+    }
 }
 
 Status RowFetcher::nextOneKey(RowResult* result, bool* over) {
@@ -55,7 +60,7 @@ Status RowFetcher::nextOneKey(RowResult* result, bool* over) {
     }
 
     std::string buf;
-    last_status_ = store_.Get(key_, &buf);
+    last_status_ = store_.Get(key_, &buf, version_);
     iter_count_++;
     if (last_status_.code() == Status::kNotFound) {
         last_status_ = Status::OK();
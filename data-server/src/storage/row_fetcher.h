@@ -11,7 +11,8 @@ namespace storage {
 
 class RowFetcher {
 public:
-    RowFetcher(Store& s, const kvrpcpb::SelectRequest& req);
+    // version: mvcc模式下读取的版本
+    RowFetcher(Store& s, const kvrpcpb::SelectRequest& req, uint64_t version = kMaxVersion);
     RowFetcher(Store& s, const kvrpcpb::DeleteRequest& req);
 
     ~RowFetcher();
@@ -31,6 +32,7 @@ private:
     RowDecoder decoder_;
 
     std::string key_;
+    uint64_t version_ = kMaxVersion;
     Iterator* iter_ = nullptr;
     Status last_status_;
     bool matched_ = false;
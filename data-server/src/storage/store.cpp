@@ -1,11 +1,14 @@
 #include "store.h"
 #include <common/ds_config.h>
+#include <rocksdb/convenience.h>
 
 #include "aggregate_calc.h"
 #include "base/util.h"
 #include "common/ds_config.h"
 #include "common/ds_encoding.h"
 #include "field_value.h"
+#include "frame/sf_logger.h"
+#include "monitor/metrics.h"
 #include "proto/gen/raft_cmdpb.pb.h"
 #include "proto/gen/redispb.pb.h"
 #include "row_fetcher.h"
@@ -17,12 +20,44 @@ namespace storage {
 
 static const size_t kDefaultMaxSelectLimit = 10000;
 
+namespace {
+
+// 所有range累计的读写量，导出到metrics
+struct StoreCounters {
+    monitor::metrics::Counter* read_keys;
+    monitor::metrics::Counter* read_bytes;
+    monitor::metrics::Counter* write_keys;
+    monitor::metrics::Counter* write_bytes;
+
+    StoreCounters() {
+        auto registry = monitor::metrics::Registry::Default();
+        auto keys = registry->AddCounter("sharkstore_ds_store_keys_total",
+                                         "Keys read or written by the store.", {"op"});
+        auto bytes = registry->AddCounter("sharkstore_ds_store_bytes_total",
+                                          "Bytes read or written by the store.", {"op"});
+        read_keys = keys->WithLabels({"read"});
+        read_bytes = bytes->WithLabels({"read"});
+        write_keys = keys->WithLabels({"write"});
+        write_bytes = bytes->WithLabels({"write"});
+    }
+};
+
+const StoreCounters& storeCounters() {
+    static StoreCounters counters;
+    return counters;
+}
+
+}  // namespace
+
 Store::Store(const metapb::Range& meta, rocksdb::DB* db) :
     table_id_(meta.table_id()) ,
     range_id_(meta.id()),
     start_key_(meta.start_key()),
     end_key_(meta.end_key()),
-    db_(db) {
+    db_(db),
+    mvcc_(ds_config.range_config.mvcc),
+    hot_keys_(ds_config.range_config.hotkey_top_k, ds_config.range_config.hotkey_prefix_len,
+              ds_config.range_config.hotkey_sample_interval) {
     assert(!start_key_.empty());
     assert(!end_key_.empty());
     assert(meta.primary_keys_size() > 0);
@@ -36,7 +71,19 @@ Store::Store(const metapb::Range& meta, rocksdb::DB* db) :
 Store::~Store() {}
 
 Status Store::Get(const std::string& key, std::string* value) {
-    rocksdb::Status s = db_->Get(rocksdb::ReadOptions(ds_config.rocksdb_config.read_checksum,true), key, value);
+    return Get(key, value, kMaxVersion);
+}
+
+Status Store::Get(const std::string& key, std::string* value, uint64_t version) {
+    rocksdb::Status s;
+    rocksdb::ReadOptions read_options(ds_config.rocksdb_config.read_checksum, true);
+    if (mvcc_) {
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(read_options));
+        s = MvccGet(it.get(), key, version, value);
+    } else {
+        s = db_->Get(read_options, key, value);
+    }
+    hot_keys_.RecordRead(key);
     if (s.ok()) {
         addMetricRead(1, key.size() + value->size());
         return Status::OK();
@@ -49,7 +96,9 @@ Status Store::Get(const std::string& key, std::string* value) {
 
 Status Store::Put(const std::string& key, const std::string& value) {
     rocksdb::Status s;
-    if(ds_config.rocksdb_config.storage_type == 1 && ds_config.rocksdb_config.ttl > 0){
+    if (mvcc_) {
+        s = db_->Put(write_options_, EncodeMvccKey(key, write_version_), EncodeMvccValue(value));
+    } else if(ds_config.rocksdb_config.storage_type == 1 && ds_config.rocksdb_config.ttl > 0){
         auto *blobdb = static_cast<rocksdb::blob_db::BlobDB*>(db_);
         s = blobdb->PutWithTTL(write_options_,rocksdb::Slice(key),rocksdb::Slice(value),ds_config.rocksdb_config.ttl);
     }else{
@@ -58,15 +107,22 @@ Status Store::Put(const std::string& key, const std::string& value) {
 
     if (s.ok()) {
         addMetricWrite(1, key.size() + value.size());
+        hot_keys_.RecordWrite(key);
         return Status::OK();
     }
     return Status(Status::kIOError, "put", s.ToString());
 }
 
 Status Store::Delete(const std::string& key) {
-    rocksdb::Status s = db_->Delete(write_options_, key);
+    rocksdb::Status s;
+    if (mvcc_) {
+        s = db_->Put(write_options_, EncodeMvccKey(key, write_version_), EncodeMvccDeletion());
+    } else {
+        s = db_->Delete(write_options_, key);
+    }
     if (s.ok()) {
         addMetricWrite(1, key.size());
+        hot_keys_.RecordWrite(key);
         return Status::OK();
     } else if (s.IsNotFound()) {
         return Status(Status::kNotFound);
@@ -97,6 +153,7 @@ Status Store::Insert(const kvrpcpb::InsertRequest& req, uint64_t* affected) {
                 return Status(Status::kIOError, "blobdb put", s.ToString());
             }else{
                 addMetricWrite(*affected, kv.key().size()+kv.value().size());
+                hot_keys_.RecordWrite(kv.key());
                 *affected = *affected + 1;
             }
 
@@ -111,21 +168,26 @@ Status Store::Insert(const kvrpcpb::InsertRequest& req, uint64_t* affected) {
     rocksdb::Status s;
     std::string value;
     bool check_dup = req.check_duplicate();
+    std::unique_ptr<rocksdb::Iterator> mvcc_it;
+    if (check_dup && mvcc_) {
+        mvcc_it.reset(db_->NewIterator(rocksdb::ReadOptions(ds_config.rocksdb_config.read_checksum,true)));
+    }
     *affected = 0;
     for (int i = 0; i < req.rows_size(); ++i) {
         const kvrpcpb::KeyValue& kv = req.rows(i);
         if (check_dup) {
-            s = db_->Get(rocksdb::ReadOptions(ds_config.rocksdb_config.read_checksum,true), kv.key(), &value);
+            if (mvcc_) {
+                s = MvccGet(mvcc_it.get(), kv.key(), kMaxVersion, &value);
+            } else {
+                s = db_->Get(rocksdb::ReadOptions(ds_config.rocksdb_config.read_checksum,true), kv.key(), &value);
+            }
             if (s.ok()) {
                 return Status(Status::kDuplicate);
             } else if (!s.IsNotFound()) {
                 return Status(Status::kIOError, "get", s.ToString());
             }
         }
-        s = batch.Put(kv.key(), kv.value());
-        if (!s.ok()) {
-            return Status(Status::kIOError, "batch put", s.ToString());
-        }
+        batchPut(&batch, kv.key(), kv.value());
         *affected = *affected + 1;
         bytes_written += (kv.key().size(), kv.value().size());
     }
@@ -134,6 +196,9 @@ Status Store::Insert(const kvrpcpb::InsertRequest& req, uint64_t* affected) {
         return Status(Status::kIOError, "batch write", s.ToString());
     } else {
         addMetricWrite(*affected, bytes_written);
+        for (int i = 0; i < req.rows_size(); ++i) {
+            hot_keys_.RecordWrite(req.rows(i).key());
+        }
         return Status::OK();
     }
 }
@@ -154,8 +219,8 @@ static void addRow(const kvrpcpb::SelectRequest& req,
 }
 
 Status Store::selectSimple(const kvrpcpb::SelectRequest& req,
-                           kvrpcpb::SelectResponse* resp) {
-    RowFetcher f(*this, req);
+                           kvrpcpb::SelectResponse* resp, uint64_t version) {
+    RowFetcher f(*this, req, version);
     Status s;
     std::unique_ptr<RowResult> r(new RowResult);
     bool over = false;
@@ -179,7 +244,7 @@ Status Store::selectSimple(const kvrpcpb::SelectRequest& req,
 }
 
 Status Store::selectAggre(const kvrpcpb::SelectRequest& req,
-                          kvrpcpb::SelectResponse* resp) {
+                          kvrpcpb::SelectResponse* resp, uint64_t version) {
     // 暂时不支持带group by的聚合函数
     if (req.group_bys_size() > 0) {
         return Status(Status::kNotSupported, "select",
@@ -203,7 +268,7 @@ Status Store::selectAggre(const kvrpcpb::SelectRequest& req,
         }
     }
 
-    RowFetcher f(*this, req);
+    RowFetcher f(*this, req, version);
     Status s;
     std::unique_ptr<RowResult> r(new RowResult);
     bool over = false;
@@ -235,7 +300,7 @@ Status Store::selectAggre(const kvrpcpb::SelectRequest& req,
 }
 
 Status Store::Select(const kvrpcpb::SelectRequest& req,
-                     kvrpcpb::SelectResponse* resp) {
+                     kvrpcpb::SelectResponse* resp, uint64_t version) {
     if (req.field_list_size() == 0) {
         return Status(Status::kNotSupported, "select",
                       "invalid select field list size");
@@ -262,9 +327,9 @@ Status Store::Select(const kvrpcpb::SelectRequest& req,
         return Status(Status::kNotSupported, "select",
                       "mixture of aggregate and column select field");
     } else if (has_column) {
-        return selectSimple(req, resp);
+        return selectSimple(req, resp, version);
     } else {
-        return selectAggre(req, resp);
+        return selectAggre(req, resp, version);
     }
 }
 
@@ -282,7 +347,7 @@ Status Store::DeleteRows(const kvrpcpb::DeleteRequest& req,
         s = f.Next(r.get(), &over);
         if (s.ok() && !over) {
             assert(!r->Key().empty());
-            batch.Delete(r->Key());
+            batchDelete(&batch, r->Key());
             ++(*affected);
             bytes_written += r->Key().size();
         }
@@ -310,10 +375,14 @@ Status Store::Truncate() {
     assert(!end_key_.empty());
     assert(start_key_ < end_key_);
 
-    auto s = db_->DeleteRange(op, family, start_key_, end_key_);
+    auto start = DBBound(start_key_);
+    auto end = DBBound(end_key_);
+    auto s = db_->DeleteRange(op, family, start, end);
     if (!s.ok()) {
         return Status(Status::kIOError, "delete range", s.ToString());
     }
+    deleteFilesInRange(start, end);
+    clearWatchLog();
 
     return Status::OK();
 };
@@ -329,7 +398,7 @@ std::string Store::GetEndKey() const {
     return end_key_;
 }
 
-Iterator* Store::NewIterator(const kvrpcpb::Scope& scope) {
+Iterator* Store::NewIterator(const kvrpcpb::Scope& scope, uint64_t version) {
     auto it = db_->NewIterator(rocksdb::ReadOptions(ds_config.rocksdb_config.read_checksum,true));
     std::string start = scope.start();
     std::string limit = scope.limit();
@@ -343,10 +412,13 @@ Iterator* Store::NewIterator(const kvrpcpb::Scope& scope) {
             limit = end_key_;
         }
     }
+    if (mvcc_) {
+        return new Iterator(it, start, limit, version);
+    }
     return new Iterator(it, start, limit);
 }
 
-Iterator* Store::NewIterator(std::string start, std::string limit) {
+Iterator* Store::NewIterator(std::string start, std::string limit, uint64_t version) {
     auto it = db_->NewIterator(rocksdb::ReadOptions(ds_config.rocksdb_config.read_checksum,true));
     if (start.empty() || start < start_key_) {
         start = start_key_;
@@ -358,9 +430,38 @@ Iterator* Store::NewIterator(std::string start, std::string limit) {
             limit = end_key_;
         }
     }
+    if (mvcc_) {
+        return new Iterator(it, start, limit, version);
+    }
     return new Iterator(it, start, limit);
 }
 
+Iterator* Store::NewRawIterator() {
+    auto it = db_->NewIterator(rocksdb::ReadOptions(ds_config.rocksdb_config.read_checksum,true));
+    std::unique_lock<std::mutex> lock(key_lock_);
+    return new Iterator(it, DBBound(start_key_), DBBound(end_key_));
+}
+
+std::string Store::DBBound(const std::string& key) const {
+    return mvcc_ ? EncodeMvccBound(key) : key;
+}
+
+void Store::batchPut(rocksdb::WriteBatch* batch, const std::string& key, const std::string& value) {
+    if (mvcc_) {
+        batch->Put(EncodeMvccKey(key, write_version_), EncodeMvccValue(value));
+    } else {
+        batch->Put(key, value);
+    }
+}
+
+void Store::batchDelete(rocksdb::WriteBatch* batch, const std::string& key) {
+    if (mvcc_) {
+        batch->Put(EncodeMvccKey(key, write_version_), EncodeMvccDeletion());
+    } else {
+        batch->Delete(key);
+    }
+}
+
 Status Store::BatchDelete(const std::vector<std::string>& keys) {
     if (keys.empty()) return Status::OK();
 
@@ -369,9 +470,10 @@ Status Store::BatchDelete(const std::vector<std::string>& keys) {
 
     rocksdb::WriteBatch batch;
     for (auto& key : keys) {
-        batch.Delete(key);
+        batchDelete(&batch, key);
         ++keys_written;
         bytes_written += key.size();
+        hot_keys_.RecordWrite(key);
     }
     auto ret = db_->Write(write_options_, &batch);
     if (ret.ok()) {
@@ -383,10 +485,15 @@ Status Store::BatchDelete(const std::vector<std::string>& keys) {
 }
 
 bool Store::KeyExists(const std::string& key) {
+    if (mvcc_) {
+        std::string value;
+        return Get(key, &value).ok();
+    }
     rocksdb::PinnableSlice value;
     auto ret = db_->Get(rocksdb::ReadOptions(ds_config.rocksdb_config.read_checksum,true), db_->DefaultColumnFamily(), key,
                         &value);
     addMetricRead(1, key.size() + value.size());
+    hot_keys_.RecordRead(key);
     return ret.ok();
 }
 
@@ -399,9 +506,10 @@ Status Store::BatchSet(
 
     rocksdb::WriteBatch batch;
     for (auto& kv : keyValues) {
-        batch.Put(kv.first, kv.second);
+        batchPut(&batch, kv.first, kv.second);
         ++keys_written;
         bytes_written += (kv.first.size() + kv.second.size());
+        hot_keys_.RecordWrite(kv.first);
     }
     auto ret = db_->Write(write_options_, &batch);
     if (ret.ok()) {
@@ -413,11 +521,42 @@ Status Store::BatchSet(
 }
 
 Status Store::RangeDelete(const std::string& start, const std::string& limit) {
+    if (mvcc_) {
+        // 保留旧版本，给区间内的每个key写入删除版本
+        std::vector<std::string> keys;
+        std::unique_ptr<Iterator> it(NewIterator(start, limit));
+        for (; it->Valid(); it->Next()) {
+            keys.push_back(it->key());
+        }
+        if (!it->status().ok()) {
+            return it->status();
+        }
+        return BatchDelete(keys);
+    }
     auto ret = db_->DeleteRange(write_options_, db_->DefaultColumnFamily(),
                                 start, limit);
+    if (ret.ok()) {
+        deleteFilesInRange(start, limit);
+    }
     return Status(ret.ok() ? Status::OK() : Status(Status::kUnknown));
 }
 
+void Store::deleteFilesInRange(const std::string& start, const std::string& limit) {
+    // 必须在DeleteRange成功之后调用：被删除的文件里如果有删除标记，
+    // 更下层被它覆盖的旧值仍然会被DeleteRange的删除标记覆盖，不会重新出现
+    // 同一个区间的新数据写在DeleteRange之后，不在要删除的文件里
+    // limit不在删除区间内，include_end必须为false（默认为true），
+    // 否则最大key恰好等于limit的文件会被整个删掉
+    rocksdb::Slice begin(start);
+    rocksdb::Slice end(limit);
+    auto s = rocksdb::DeleteFilesInRange(db_, db_->DefaultColumnFamily(), &begin, &end,
+                                         false);
+    if (!s.ok()) {
+        FLOG_WARN("range[%" PRIu64 "] delete files in range failed: %s", range_id_,
+                  s.ToString().c_str());
+    }
+}
+
 Status Store::ApplySnapshot(const std::vector<std::string>& datas) {
     rocksdb::WriteBatch batch;
     for (const auto& data : datas) {
@@ -440,11 +579,15 @@ Status Store::ApplySnapshot(const std::vector<std::string>& datas) {
 void Store::addMetricRead(uint64_t keys, uint64_t bytes) {
     metric_.AddRead(keys, bytes);
     g_metric.AddRead(keys, bytes);
+    storeCounters().read_keys->Inc(keys);
+    storeCounters().read_bytes->Inc(bytes);
 }
 
 void Store::addMetricWrite(uint64_t keys, uint64_t bytes) {
     metric_.AddWrite(keys, bytes);
     g_metric.AddWrite(keys, bytes);
+    storeCounters().write_keys->Inc(keys);
+    storeCounters().write_bytes->Inc(bytes);
 }
 
 Status Store::parseSplitKey(const std::string& key, range::SplitKeyMode mode, std::string *split_key) {
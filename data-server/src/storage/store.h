@@ -2,13 +2,17 @@ _Pragma("once");
 
 #include <rocksdb/db.h>
 #include <rocksdb/utilities/blob_db/blob_db.h>
+#include <functional>
 #include <mutex>
 
+#include "hot_keys.h"
 #include "iterator.h"
 #include "metric.h"
+#include "mvcc.h"
 #include "range/split_policy.h"
 #include "proto/gen/kvrpcpb.pb.h"
 #include "proto/gen/watchpb.pb.h"
+#include "proto/gen/redispb.pb.h"
 
 // test fixture forward declare for friend class
 namespace sharkstore { namespace test { namespace helper { class StoreTestFixture; }}}
@@ -20,6 +24,17 @@ namespace storage {
 // 行前缀长度: 1字节特殊标记+8字节table id
 static const size_t kRowPrefixLength = 9;
 static const unsigned char kStoreKVPrefixByte = '\x01';
+// watch变更日志: 前缀 + range id + 版本(raft index) + db key，
+// 不落在任何range的数据区间内
+static const unsigned char kWatchLogPrefixByte = '\x08';
+
+// watch变更日志中的一条记录
+struct WatchLogEntry {
+    int64_t version = 0;
+    watchpb::EventType type = watchpb::PUT;
+    std::string key;    // db key
+    std::string value;  // db value，DELETE时为空
+};
 
 class Store {
 public:
@@ -30,12 +45,14 @@ public:
     Store& operator=(const Store&) = delete;
 
     Status Get(const std::string& key, std::string* value);
+    // mvcc模式下读取version时的值，非mvcc模式忽略version
+    Status Get(const std::string& key, std::string* value, uint64_t version);
     Status Put(const std::string& key, const std::string& value);
     Status Delete(const std::string& key);
 
     Status Insert(const kvrpcpb::InsertRequest& req, uint64_t* affected);
     Status Select(const kvrpcpb::SelectRequest& req,
-                  kvrpcpb::SelectResponse* resp);
+                  kvrpcpb::SelectResponse* resp, uint64_t version = kMaxVersion);
     Status DeleteRows(const kvrpcpb::DeleteRequest& req, uint64_t* affected);
     Status Truncate();
 
@@ -45,6 +62,24 @@ public:
             watchpb::DsKvWatchGetMultiResponse *resp);
     Status WatchScan();
 
+    // watch写入，数据和变更日志在同一个WriteBatch中写入，超出保留窗口的日志同时删除
+    // 只在apply线程调用；日志未开启时等同于Put/Delete
+    Status PutWithWatchLog(const std::string& key, const std::string& value, int64_t version);
+    Status DeleteWithWatchLog(const std::string& key, int64_t version);
+    // 按版本顺序读取[start, limit)内版本大于from_version的变更
+    // from_version之后的变更不完整（超出保留窗口或者日志未开启）时返回kCompacted
+    Status ScanWatchLog(const std::string& start, const std::string& limit,
+                        int64_t from_version, std::vector<WatchLogEntry>* entries);
+
+    // redis复合类型命令，写命令在apply时执行，一个命令一个WriteBatch
+    static bool IsRedisWrite(redispb::CmdType type);
+    Status RedisRead(const redispb::Command& cmd, redispb::Reply* reply);
+    Status RedisWrite(const redispb::Command& cmd, redispb::Reply* reply);
+
+    // mvcc模式下之后的写入使用的版本，只在apply线程调用
+    void SetWriteVersion(uint64_t version) { write_version_ = version; }
+    bool IsMvcc() const { return mvcc_; }
+
     void SetEndKey(std::string end_key);
     std::string GetEndKey() const;
 
@@ -54,15 +89,23 @@ public:
 
     void ResetMetric() { metric_.Reset(); }
     void CollectMetric(MetricStat* stat) { metric_.Collect(stat); }
+    // 读写热点key，decay为true时取出后衰减
+    void CollectHotKeys(HotKeysStat* stat, bool decay) { hot_keys_.Collect(stat, decay); }
 
     // 统计存储实际大小，并且根据split_size返回中间key
     Status StatSize(uint64_t split_size, range::SplitKeyMode mode,
             uint64_t *real_size, std::string *split_key);
 
 public:
-    Iterator* NewIterator(const ::kvrpcpb::Scope& scope);
+    Iterator* NewIterator(const ::kvrpcpb::Scope& scope, uint64_t version = kMaxVersion);
     Iterator* NewIterator(std::string start = std::string(),
-                          std::string limit = std::string());
+                          std::string limit = std::string(),
+                          uint64_t version = kMaxVersion);
+    // 遍历range内的原始数据，mvcc模式下包括所有版本（生成raft快照）
+    Iterator* NewRawIterator();
+    // 原始key作为区间边界时在db中对应的位置，mvcc模式下是编码后的位置
+    // 直接按区间操作db（删除、compaction）时使用
+    std::string DBBound(const std::string& key) const;
     Status BatchDelete(const std::vector<std::string>& keys);
     bool KeyExists(const std::string& key);
     Status BatchSet(
@@ -76,9 +119,13 @@ private:
     friend class ::sharkstore::test::helper::StoreTestFixture;
 
     Status selectSimple(const kvrpcpb::SelectRequest& req,
-                        kvrpcpb::SelectResponse* resp);
+                        kvrpcpb::SelectResponse* resp, uint64_t version);
     Status selectAggre(const kvrpcpb::SelectRequest& req,
-                       kvrpcpb::SelectResponse* resp);
+                       kvrpcpb::SelectResponse* resp, uint64_t version);
+
+    // 写入batch，mvcc模式下写入一个新版本
+    void batchPut(rocksdb::WriteBatch* batch, const std::string& key, const std::string& value);
+    void batchDelete(rocksdb::WriteBatch* batch, const std::string& key);
 
     void addMetricRead(uint64_t keys, uint64_t bytes);
     void addMetricWrite(uint64_t keys, uint64_t bytes);
@@ -88,8 +135,35 @@ private:
     bool decodeWatchKey(const std::string& key, watchpb::WatchKeyValue *kv) const;
     bool decodeWatchValue(const std::string& value, watchpb::WatchKeyValue *kv) const;
 
+    bool watchLogEnabled() const;
+    std::string watchLogKey(int64_t version) const;
+    // 把更新日志下限和删除过期日志加入batch，返回新的下限
+    int64_t prepareWatchLog(int64_t version, rocksdb::WriteBatch* batch);
+    Status writeWatchLog(rocksdb::WriteBatch* batch, int64_t floor);
+    void clearWatchLog();
+
+    Status redisLoadMeta(const std::string& key, redispb::KeyType type,
+                         const rocksdb::Snapshot* snapshot, redispb::Meta* meta, bool* exists);
+    Status redisGet(const std::string& key, const rocksdb::Snapshot* snapshot,
+                    std::string* value, bool* exists);
+    // fn返回false时停止扫描
+    Status redisScan(const std::string& start, const std::string& limit,
+                     const rocksdb::Snapshot* snapshot,
+                     const std::function<bool(const std::string&, const std::string&)>& fn);
+    Status redisHash(const redispb::Command& cmd, rocksdb::WriteBatch* batch,
+                     redispb::Reply* reply);
+    Status redisList(const redispb::Command& cmd, rocksdb::WriteBatch* batch,
+                     redispb::Reply* reply);
+    Status redisSet(const redispb::Command& cmd, rocksdb::WriteBatch* batch,
+                    redispb::Reply* reply);
+    Status redisZSet(const redispb::Command& cmd, rocksdb::WriteBatch* batch,
+                     redispb::Reply* reply);
+
     Status parseSplitKey(const std::string& key, range::SplitKeyMode mode, std::string *split_key);
 
+    // 删除完全落在区间内的sst文件
+    void deleteFilesInRange(const std::string& start, const std::string& limit);
+
 private:
     const uint64_t table_id_ = 0;
     const uint64_t range_id_ = 0;
@@ -101,9 +175,18 @@ private:
     rocksdb::DB* db_;
     rocksdb::WriteOptions write_options_;
 
+    const bool mvcc_ = false;
+    uint64_t write_version_ = 0;
+
+    // 变更日志下限，日志包含所有版本大于下限的变更；只在apply线程访问
+    // kWatchLogUnloaded表示还没有从db中读取，-1表示没有日志
+    static const int64_t kWatchLogUnloaded = -2;
+    int64_t watch_log_floor_ = kWatchLogUnloaded;
+
     std::vector<metapb::Column> primary_keys_;
 
     Metric metric_;
+    HotKeys hot_keys_;
 };
 
 } /* namespace storage */
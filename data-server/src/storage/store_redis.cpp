@@ -0,0 +1,699 @@
+#include "store.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+
+#include "base/util.h"
+#include "common/ds_config.h"
+#include "common/ds_encoding.h"
+
+namespace sharkstore {
+namespace dataserver {
+namespace storage {
+
+using redispb::CmdType;
+using redispb::KeyType;
+
+// 复合类型的存储格式（key为proxy编码后的ns + key，split时不会被拆开）:
+//   meta:        key + KEY_META                               -> redispb::Meta
+//   hash field:  key + KEY_HASH_FIELD + field                 -> value
+//   set member:  key + KEY_SET_MEMBER + member                -> ""
+//   list:        key + KEY_LIST_ELEMENT + uint64(seq)         -> value
+//   zset score:  key + KEY_ZSET_SCORE + member                -> float(score)
+//   zset sort:   key + KEY_ZSET_SORT + float(score) + member  -> ""
+// zset sort按照分数有序，范围查询只需要一次seek
+
+namespace {
+
+// list元素序号的初始值，两端都留有足够的空间
+static const uint64_t kListInitSeq = 1ULL << 62;
+
+static const char* kWrongType = "WRONGTYPE Operation against a key holding the wrong kind of value";
+
+std::string subKey(const std::string& key, KeyType type) {
+    std::string buf;
+    buf.reserve(key.size() + 1);
+    buf.append(key);
+    buf.push_back(static_cast<char>(type));
+    return buf;
+}
+
+std::string subKey(const std::string& key, KeyType type, const std::string& field) {
+    auto buf = subKey(key, type);
+    buf.append(field);
+    return buf;
+}
+
+// 某个类型所有子key的上界
+std::string subKeyEnd(const std::string& key, KeyType type) {
+    return subKey(key, static_cast<KeyType>(type + 1));
+}
+
+std::string listKey(const std::string& key, uint64_t seq) {
+    auto buf = subKey(key, redispb::KEY_LIST_ELEMENT);
+    EncodeUint64Ascending(&buf, seq);
+    return buf;
+}
+
+std::string encodeScore(double score) {
+    std::string buf;
+    EncodeFloatAscending(&buf, score);
+    return buf;
+}
+
+std::string zsetSortKey(const std::string& key, double score, const std::string& member) {
+    auto buf = subKey(key, redispb::KEY_ZSET_SORT);
+    EncodeFloatAscending(&buf, score);
+    buf.append(member);
+    return buf;
+}
+
+KeyType cmdKeyType(CmdType type) {
+    switch (type) {
+        case redispb::HGet:
+        case redispb::HSet:
+        case redispb::HDel:
+        case redispb::HIncrBy:
+        case redispb::HGetAll:
+        case redispb::HLen:
+            return redispb::KEY_HASH;
+        case redispb::LPush:
+        case redispb::RPush:
+        case redispb::LPop:
+        case redispb::RPop:
+        case redispb::LIndex:
+        case redispb::LRange:
+        case redispb::LLen:
+            return redispb::KEY_LIST;
+        case redispb::SAdd:
+        case redispb::SRem:
+        case redispb::SIsMember:
+        case redispb::SMembers:
+        case redispb::SCard:
+            return redispb::KEY_SET;
+        case redispb::ZAdd:
+        case redispb::ZRem:
+        case redispb::ZScore:
+        case redispb::ZRangeByScore:
+        case redispb::ZCard:
+            return redispb::KEY_ZSET;
+        default:
+            return redispb::Invalid;
+    }
+}
+
+bool parseInt64(const std::string& str, int64_t* value) {
+    if (str.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    *value = strtoll(str.c_str(), &end, 10);
+    return errno == 0 && end == str.c_str() + str.size();
+}
+
+// 元素个数为0时删除meta
+void writeMeta(const std::string& key, bool exists, const redispb::Meta& old_meta,
+               const redispb::Meta& meta, rocksdb::WriteBatch* batch) {
+    if (meta.size() == 0) {
+        if (exists) batch->Delete(subKey(key, redispb::KEY_META));
+    } else if (!exists || meta.size() != old_meta.size() || meta.head() != old_meta.head() ||
+               meta.tail() != old_meta.tail()) {
+        batch->Put(subKey(key, redispb::KEY_META), meta.SerializeAsString());
+    }
+}
+
+class SnapshotGuard {
+public:
+    explicit SnapshotGuard(rocksdb::DB* db) : db_(db), snapshot_(db->GetSnapshot()) {}
+    ~SnapshotGuard() { db_->ReleaseSnapshot(snapshot_); }
+
+    SnapshotGuard(const SnapshotGuard&) = delete;
+    SnapshotGuard& operator=(const SnapshotGuard&) = delete;
+
+    const rocksdb::Snapshot* get() const { return snapshot_; }
+
+private:
+    rocksdb::DB* db_;
+    const rocksdb::Snapshot* snapshot_;
+};
+
+} /* namespace */
+
+bool Store::IsRedisWrite(CmdType type) {
+    switch (type) {
+        case redispb::HSet:
+        case redispb::HDel:
+        case redispb::HIncrBy:
+        case redispb::LPush:
+        case redispb::RPush:
+        case redispb::LPop:
+        case redispb::RPop:
+        case redispb::SAdd:
+        case redispb::SRem:
+        case redispb::ZAdd:
+        case redispb::ZRem:
+            return true;
+        default:
+            return false;
+    }
+}
+
+Status Store::redisGet(const std::string& key, const rocksdb::Snapshot* snapshot,
+                       std::string* value, bool* exists) {
+    rocksdb::ReadOptions opt(ds_config.rocksdb_config.read_checksum, true);
+    opt.snapshot = snapshot;
+    auto s = db_->Get(opt, key, value);
+    if (s.ok()) {
+        *exists = true;
+        addMetricRead(1, key.size() + value->size());
+        return Status::OK();
+    } else if (s.IsNotFound()) {
+        *exists = false;
+        return Status::OK();
+    } else {
+        return Status(Status::kIOError, "get", s.ToString());
+    }
+}
+
+Status Store::redisLoadMeta(const std::string& key, KeyType type,
+                            const rocksdb::Snapshot* snapshot, redispb::Meta* meta,
+                            bool* exists) {
+    std::string value;
+    auto s = redisGet(subKey(key, redispb::KEY_META), snapshot, &value, exists);
+    if (!s.ok() || !*exists) {
+        return s;
+    }
+    if (!meta->ParseFromString(value)) {
+        return Status(Status::kCorruption, "redis meta", EncodeToHex(key));
+    }
+    if (meta->type() != type) {
+        return Status(Status::kInvalidArgument, kWrongType, EncodeToHex(key));
+    }
+    return Status::OK();
+}
+
+Status Store::redisScan(const std::string& start, const std::string& limit,
+                        const rocksdb::Snapshot* snapshot,
+                        const std::function<bool(const std::string&, const std::string&)>& fn) {
+    rocksdb::ReadOptions opt(ds_config.rocksdb_config.read_checksum, true);
+    opt.snapshot = snapshot;
+    std::unique_ptr<Iterator> it(new Iterator(db_->NewIterator(opt), start, limit));
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+    for (; it->Valid(); it->Next()) {
+        auto key = it->key();
+        auto value = it->value();
+        ++count;
+        bytes += key.size() + value.size();
+        if (!fn(key, value)) {
+            break;
+        }
+    }
+    addMetricRead(count, bytes);
+    return it->status();
+}
+
+Status Store::RedisRead(const redispb::Command& cmd, redispb::Reply* reply) {
+    // 复合类型的元数据和成员直接读写db，不支持mvcc编码
+    if (mvcc_) {
+        return Status(Status::kNotSupported, "redis", "mvcc storage");
+    }
+    if (cmd.key().empty()) {
+        return Status(Status::kInvalidArgument, "redis key", "empty");
+    }
+    if (IsRedisWrite(cmd.type()) || cmdKeyType(cmd.type()) == redispb::Invalid) {
+        return Status(Status::kNotSupported, "redis read", redispb::CmdType_Name(cmd.type()));
+    }
+
+    const auto& key = cmd.key();
+    hot_keys_.RecordRead(key);
+    std::string value;
+    bool exists = false;
+    Status s;
+
+    // 单个元素的查询不需要读meta，一次点查
+    switch (cmd.type()) {
+        case redispb::HGet:
+        case redispb::SIsMember:
+        case redispb::ZScore: {
+            if (cmd.fields_size() != 1) {
+                return Status(Status::kInvalidArgument, "redis fields size",
+                              std::to_string(cmd.fields_size()));
+            }
+            auto sub_type = cmd.type() == redispb::HGet      ? redispb::KEY_HASH_FIELD
+                            : cmd.type() == redispb::SIsMember ? redispb::KEY_SET_MEMBER
+                                                               : redispb::KEY_ZSET_SCORE;
+            s = redisGet(subKey(key, sub_type, cmd.fields(0)), nullptr, &value, &exists);
+            if (!s.ok()) return s;
+            if (cmd.type() == redispb::SIsMember) {
+                reply->set_integer(exists ? 1 : 0);
+            } else if (exists && cmd.type() == redispb::HGet) {
+                reply->set_has_value(true);
+                reply->set_value(std::move(value));
+            } else if (exists) {
+                double score = 0;
+                size_t offset = 0;
+                if (!DecodeFloatAscending(value, offset, &score)) {
+                    return Status(Status::kCorruption, "redis zset score", EncodeToHex(key));
+                }
+                reply->set_has_value(true);
+                reply->add_scores(score);
+            }
+            return Status::OK();
+        }
+        default:
+            break;
+    }
+
+    // meta和元素在同一个快照上读取
+    SnapshotGuard snapshot(db_);
+    redispb::Meta meta;
+    s = redisLoadMeta(key, cmdKeyType(cmd.type()), snapshot.get(), &meta, &exists);
+    if (!s.ok() || !exists) {
+        return s;
+    }
+    auto size = static_cast<int64_t>(meta.size());
+
+    switch (cmd.type()) {
+        case redispb::HLen:
+        case redispb::LLen:
+        case redispb::SCard:
+        case redispb::ZCard:
+            reply->set_integer(size);
+            break;
+
+        case redispb::HGetAll:
+        case redispb::SMembers: {
+            auto sub_type = cmd.type() == redispb::HGetAll ? redispb::KEY_HASH_FIELD
+                                                           : redispb::KEY_SET_MEMBER;
+            auto prefix_len = key.size() + 1;
+            s = redisScan(subKey(key, sub_type), subKeyEnd(key, sub_type), snapshot.get(),
+                          [reply, prefix_len, sub_type](const std::string& k, const std::string& v) {
+                              reply->add_fields(k.substr(prefix_len));
+                              if (sub_type == redispb::KEY_HASH_FIELD) reply->add_values(v);
+                              return true;
+                          });
+            break;
+        }
+
+        case redispb::LIndex: {
+            auto index = cmd.start() < 0 ? cmd.start() + size : cmd.start();
+            if (index < 0 || index >= size) break;
+            s = redisGet(listKey(key, meta.head() + index), snapshot.get(), &value, &exists);
+            if (s.ok() && exists) {
+                reply->set_has_value(true);
+                reply->set_value(std::move(value));
+            }
+            break;
+        }
+
+        case redispb::LRange: {
+            auto start = cmd.start() < 0 ? cmd.start() + size : cmd.start();
+            auto stop = cmd.stop() < 0 ? cmd.stop() + size : cmd.stop();
+            if (start < 0) start = 0;
+            if (stop >= size) stop = size - 1;
+            if (start > stop) break;
+            s = redisScan(listKey(key, meta.head() + start), listKey(key, meta.head() + stop + 1),
+                          snapshot.get(), [reply](const std::string&, const std::string& v) {
+                              reply->add_values(v);
+                              return true;
+                          });
+            break;
+        }
+
+        case redispb::ZRangeByScore: {
+            if (std::isnan(cmd.min_score()) || std::isnan(cmd.max_score()) ||
+                cmd.min_score() > cmd.max_score()) {
+                break;
+            }
+            auto prefix = subKey(key, redispb::KEY_ZSET_SORT);
+            auto start = prefix + encodeScore(cmd.min_score());
+            bool corrupted = false;
+            s = redisScan(start, subKeyEnd(key, redispb::KEY_ZSET_SORT), snapshot.get(),
+                          [&](const std::string& k, const std::string&) {
+                              double score = 0;
+                              size_t offset = prefix.size();
+                              if (!DecodeFloatAscending(k, offset, &score)) {
+                                  corrupted = true;
+                                  return false;
+                              }
+                              if (score > cmd.max_score()) return false;
+                              reply->add_fields(k.substr(offset));
+                              reply->add_scores(score);
+                              return cmd.limit() == 0 ||
+                                     static_cast<uint64_t>(reply->fields_size()) < cmd.limit();
+                          });
+            if (s.ok() && corrupted) {
+                s = Status(Status::kCorruption, "redis zset sort key", EncodeToHex(key));
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+    return s;
+}
+
+Status Store::RedisWrite(const redispb::Command& cmd, redispb::Reply* reply) {
+    if (mvcc_) {
+        return Status(Status::kNotSupported, "redis", "mvcc storage");
+    }
+    if (cmd.key().empty()) {
+        return Status(Status::kInvalidArgument, "redis key", "empty");
+    }
+    if (!IsRedisWrite(cmd.type())) {
+        return Status(Status::kNotSupported, "redis write", redispb::CmdType_Name(cmd.type()));
+    }
+
+    rocksdb::WriteBatch batch;
+    Status s;
+    switch (cmdKeyType(cmd.type())) {
+        case redispb::KEY_HASH:
+            s = redisHash(cmd, &batch, reply);
+            break;
+        case redispb::KEY_LIST:
+            s = redisList(cmd, &batch, reply);
+            break;
+        case redispb::KEY_SET:
+            s = redisSet(cmd, &batch, reply);
+            break;
+        case redispb::KEY_ZSET:
+            s = redisZSet(cmd, &batch, reply);
+            break;
+        default:
+            return Status(Status::kNotSupported, "redis write", redispb::CmdType_Name(cmd.type()));
+    }
+    if (!s.ok() || batch.Count() == 0) {
+        return s;
+    }
+
+    auto ret = db_->Write(write_options_, &batch);
+    if (!ret.ok()) {
+        return Status(Status::kIOError, "redis write", ret.ToString());
+    }
+    addMetricWrite(batch.Count(), batch.GetDataSize());
+    hot_keys_.RecordWrite(cmd.key());
+    return Status::OK();
+}
+
+Status Store::redisHash(const redispb::Command& cmd, rocksdb::WriteBatch* batch,
+                        redispb::Reply* reply) {
+    const auto& key = cmd.key();
+    redispb::Meta old_meta;
+    bool exists = false;
+    auto s = redisLoadMeta(key, redispb::KEY_HASH, nullptr, &old_meta, &exists);
+    if (!s.ok()) return s;
+    redispb::Meta meta(old_meta);
+    meta.set_type(redispb::KEY_HASH);
+
+    std::string value;
+    bool found = false;
+    switch (cmd.type()) {
+        case redispb::HSet: {
+            if (cmd.fields_size() == 0 || cmd.fields_size() != cmd.values_size()) {
+                return Status(Status::kInvalidArgument, "redis hset",
+                              "mismatched fields and values");
+            }
+            // 同一个命令中重复的field以最后一个为准
+            std::map<std::string, std::string> kvs;
+            for (int i = 0; i < cmd.fields_size(); ++i) {
+                kvs[cmd.fields(i)] = cmd.values(i);
+            }
+            int64_t added = 0;
+            for (const auto& kv : kvs) {
+                auto field_key = subKey(key, redispb::KEY_HASH_FIELD, kv.first);
+                if (exists) {
+                    s = redisGet(field_key, nullptr, &value, &found);
+                    if (!s.ok()) return s;
+                }
+                if (!exists || !found) ++added;
+                batch->Put(field_key, kv.second);
+            }
+            meta.set_size(meta.size() + added);
+            reply->set_integer(added);
+            break;
+        }
+
+        case redispb::HDel: {
+            std::set<std::string> fields(cmd.fields().begin(), cmd.fields().end());
+            int64_t removed = 0;
+            for (const auto& field : fields) {
+                if (!exists) break;
+                auto field_key = subKey(key, redispb::KEY_HASH_FIELD, field);
+                s = redisGet(field_key, nullptr, &value, &found);
+                if (!s.ok()) return s;
+                if (found) {
+                    batch->Delete(field_key);
+                    ++removed;
+                }
+            }
+            meta.set_size(meta.size() - removed);
+            reply->set_integer(removed);
+            break;
+        }
+
+        case redispb::HIncrBy: {
+            if (cmd.fields_size() != 1) {
+                return Status(Status::kInvalidArgument, "redis fields size",
+                              std::to_string(cmd.fields_size()));
+            }
+            auto field_key = subKey(key, redispb::KEY_HASH_FIELD, cmd.fields(0));
+            if (exists) {
+                s = redisGet(field_key, nullptr, &value, &found);
+                if (!s.ok()) return s;
+            }
+            int64_t current = 0;
+            if (found && !parseInt64(value, &current)) {
+                return Status(Status::kInvalidArgument, "ERR hash value is not an integer",
+                              cmd.fields(0));
+            }
+            auto incr = cmd.incr();
+            if ((incr > 0 && current > std::numeric_limits<int64_t>::max() - incr) ||
+                (incr < 0 && current < std::numeric_limits<int64_t>::min() - incr)) {
+                return Status(Status::kInvalidArgument,
+                              "ERR increment or decrement would overflow", std::to_string(incr));
+            }
+            current += incr;
+            batch->Put(field_key, std::to_string(current));
+            if (!found) meta.set_size(meta.size() + 1);
+            reply->set_integer(current);
+            break;
+        }
+
+        default:
+            return Status(Status::kNotSupported, "redis hash", redispb::CmdType_Name(cmd.type()));
+    }
+
+    writeMeta(key, exists, old_meta, meta, batch);
+    return Status::OK();
+}
+
+Status Store::redisList(const redispb::Command& cmd, rocksdb::WriteBatch* batch,
+                        redispb::Reply* reply) {
+    const auto& key = cmd.key();
+    redispb::Meta old_meta;
+    bool exists = false;
+    auto s = redisLoadMeta(key, redispb::KEY_LIST, nullptr, &old_meta, &exists);
+    if (!s.ok()) return s;
+    redispb::Meta meta(old_meta);
+    if (!exists) {
+        meta.set_type(redispb::KEY_LIST);
+        meta.set_head(kListInitSeq);
+        meta.set_tail(kListInitSeq);
+    }
+
+    switch (cmd.type()) {
+        case redispb::LPush:
+        case redispb::RPush: {
+            if (cmd.values_size() == 0) {
+                return Status(Status::kInvalidArgument, "redis push", "empty values");
+            }
+            for (const auto& value : cmd.values()) {
+                if (cmd.type() == redispb::LPush) {
+                    meta.set_head(meta.head() - 1);
+                    batch->Put(listKey(key, meta.head()), value);
+                } else {
+                    batch->Put(listKey(key, meta.tail()), value);
+                    meta.set_tail(meta.tail() + 1);
+                }
+            }
+            meta.set_size(meta.size() + cmd.values_size());
+            reply->set_integer(meta.size());
+            break;
+        }
+
+        case redispb::LPop:
+        case redispb::RPop: {
+            if (!exists || meta.size() == 0) break;
+            auto seq = cmd.type() == redispb::LPop ? meta.head() : meta.tail() - 1;
+            auto elem_key = listKey(key, seq);
+            std::string value;
+            bool found = false;
+            s = redisGet(elem_key, nullptr, &value, &found);
+            if (!s.ok()) return s;
+            if (!found) {
+                return Status(Status::kCorruption, "redis list element", EncodeToHex(elem_key));
+            }
+            batch->Delete(elem_key);
+            if (cmd.type() == redispb::LPop) {
+                meta.set_head(meta.head() + 1);
+            } else {
+                meta.set_tail(meta.tail() - 1);
+            }
+            meta.set_size(meta.size() - 1);
+            reply->set_has_value(true);
+            reply->set_value(std::move(value));
+            break;
+        }
+
+        default:
+            return Status(Status::kNotSupported, "redis list", redispb::CmdType_Name(cmd.type()));
+    }
+
+    writeMeta(key, exists, old_meta, meta, batch);
+    return Status::OK();
+}
+
+Status Store::redisSet(const redispb::Command& cmd, rocksdb::WriteBatch* batch,
+                       redispb::Reply* reply) {
+    const auto& key = cmd.key();
+    redispb::Meta old_meta;
+    bool exists = false;
+    auto s = redisLoadMeta(key, redispb::KEY_SET, nullptr, &old_meta, &exists);
+    if (!s.ok()) return s;
+    redispb::Meta meta(old_meta);
+    meta.set_type(redispb::KEY_SET);
+
+    if (cmd.type() != redispb::SAdd && cmd.type() != redispb::SRem) {
+        return Status(Status::kNotSupported, "redis set", redispb::CmdType_Name(cmd.type()));
+    }
+    if (cmd.type() == redispb::SAdd && cmd.fields_size() == 0) {
+        return Status(Status::kInvalidArgument, "redis sadd", "empty members");
+    }
+
+    std::set<std::string> members(cmd.fields().begin(), cmd.fields().end());
+    std::string value;
+    int64_t changed = 0;
+    for (const auto& member : members) {
+        auto member_key = subKey(key, redispb::KEY_SET_MEMBER, member);
+        bool found = false;
+        if (exists) {
+            s = redisGet(member_key, nullptr, &value, &found);
+            if (!s.ok()) return s;
+        }
+        if (cmd.type() == redispb::SAdd && !found) {
+            batch->Put(member_key, "");
+            ++changed;
+        } else if (cmd.type() == redispb::SRem && found) {
+            batch->Delete(member_key);
+            ++changed;
+        }
+    }
+    if (cmd.type() == redispb::SAdd) {
+        meta.set_size(meta.size() + changed);
+    } else {
+        meta.set_size(meta.size() - changed);
+    }
+    reply->set_integer(changed);
+
+    writeMeta(key, exists, old_meta, meta, batch);
+    return Status::OK();
+}
+
+Status Store::redisZSet(const redispb::Command& cmd, rocksdb::WriteBatch* batch,
+                        redispb::Reply* reply) {
+    const auto& key = cmd.key();
+    redispb::Meta old_meta;
+    bool exists = false;
+    auto s = redisLoadMeta(key, redispb::KEY_ZSET, nullptr, &old_meta, &exists);
+    if (!s.ok()) return s;
+    redispb::Meta meta(old_meta);
+    meta.set_type(redispb::KEY_ZSET);
+
+    // 读取member当前的分数
+    auto loadScore = [&](const std::string& score_key, double* score, bool* found) {
+        *found = false;
+        if (!exists) return Status::OK();
+        std::string value;
+        auto s = redisGet(score_key, nullptr, &value, found);
+        if (!s.ok() || !*found) return s;
+        size_t offset = 0;
+        if (!DecodeFloatAscending(value, offset, score)) {
+            return Status(Status::kCorruption, "redis zset score", EncodeToHex(score_key));
+        }
+        return Status::OK();
+    };
+
+    switch (cmd.type()) {
+        case redispb::ZAdd: {
+            if (cmd.fields_size() == 0 || cmd.fields_size() != cmd.scores_size()) {
+                return Status(Status::kInvalidArgument, "redis zadd",
+                              "mismatched members and scores");
+            }
+            std::map<std::string, double> scores;
+            for (int i = 0; i < cmd.fields_size(); ++i) {
+                auto score = cmd.scores(i);
+                if (std::isnan(score)) {
+                    return Status(Status::kInvalidArgument, "ERR value is not a valid float",
+                                  cmd.fields(i));
+                }
+                // -0与0使用相同的编码
+                scores[cmd.fields(i)] = score == 0 ? 0 : score;
+            }
+            int64_t added = 0;
+            for (const auto& ms : scores) {
+                auto score_key = subKey(key, redispb::KEY_ZSET_SCORE, ms.first);
+                double old_score = 0;
+                bool found = false;
+                s = loadScore(score_key, &old_score, &found);
+                if (!s.ok()) return s;
+                if (found) {
+                    if (old_score == ms.second) continue;
+                    batch->Delete(zsetSortKey(key, old_score, ms.first));
+                } else {
+                    ++added;
+                }
+                batch->Put(score_key, encodeScore(ms.second));
+                batch->Put(zsetSortKey(key, ms.second, ms.first), "");
+            }
+            meta.set_size(meta.size() + added);
+            reply->set_integer(added);
+            break;
+        }
+
+        case redispb::ZRem: {
+            std::set<std::string> members(cmd.fields().begin(), cmd.fields().end());
+            int64_t removed = 0;
+            for (const auto& member : members) {
+                auto score_key = subKey(key, redispb::KEY_ZSET_SCORE, member);
+                double score = 0;
+                bool found = false;
+                s = loadScore(score_key, &score, &found);
+                if (!s.ok()) return s;
+                if (found) {
+                    batch->Delete(score_key);
+                    batch->Delete(zsetSortKey(key, score, member));
+                    ++removed;
+                }
+            }
+            meta.set_size(meta.size() - removed);
+            reply->set_integer(removed);
+            break;
+        }
+
+        default:
+            return Status(Status::kNotSupported, "redis zset", redispb::CmdType_Name(cmd.type()));
+    }
+
+    writeMeta(key, exists, old_meta, meta, batch);
+    return Status::OK();
+}
+
+} /* namespace storage */
+} /* namespace dataserver */
+} /* namespace sharkstore */
@@ -1,7 +1,12 @@
 #include "store.h"
 
+#include <string.h>
+#include <memory>
+
 #include "base/util.h"
+#include "common/ds_config.h"
 #include "common/ds_encoding.h"
+#include "frame/sf_logger.h"
 
 namespace sharkstore {
 namespace dataserver {
@@ -111,6 +116,196 @@ Status Store::WatchScan() {
     return Status(Status::kNotSupported);
 }
 
+namespace {
+
+// 日志下限的key，同一个range的日志都在它之后
+std::string watchLogPrefix(uint64_t range_id) {
+    std::string buf;
+    buf.push_back(static_cast<char>(kWatchLogPrefixByte));
+    EncodeUint64Ascending(&buf, range_id);
+    return buf;
+}
+
+}  // namespace
+
+bool Store::watchLogEnabled() const {
+    // blobdb的ttl写入不能和日志放在同一个batch里
+    if (ds_config.rocksdb_config.storage_type == 1 && ds_config.rocksdb_config.ttl > 0) {
+        return false;
+    }
+    return ds_config.range_config.watch_log_retention > 0;
+}
+
+std::string Store::watchLogKey(int64_t version) const {
+    auto buf = watchLogPrefix(range_id_);
+    EncodeUint64Ascending(&buf, static_cast<uint64_t>(version));
+    return buf;
+}
+
+int64_t Store::prepareWatchLog(int64_t version, rocksdb::WriteBatch* batch) {
+    auto prefix = watchLogPrefix(range_id_);
+    if (watch_log_floor_ == kWatchLogUnloaded) {
+        std::string value;
+        auto s = db_->Get(rocksdb::ReadOptions(), prefix, &value);
+        uint64_t floor = 0;
+        size_t offset = 0;
+        if (s.ok() && DecodeUint64Ascending(value, offset, &floor)) {
+            watch_log_floor_ = static_cast<int64_t>(floor);
+        } else {
+            watch_log_floor_ = -1;
+        }
+    }
+
+    auto floor = watch_log_floor_;
+    auto retention = static_cast<int64_t>(ds_config.range_config.watch_log_retention);
+    if (floor < 0 || floor >= version) {
+        // 没有日志（或者日志在当前版本之后，不应该出现），从这个版本开始记录
+        floor = version - 1;
+        batch->DeleteRange(prefix, NextComparable(prefix));
+    } else if (version - floor > retention + retention / 8) {
+        // 超出保留窗口一定比例后批量删除，避免每次写入都产生删除标记
+        floor = version - retention;
+        batch->DeleteRange(watchLogKey(0), watchLogKey(floor + 1));
+    } else {
+        return floor;
+    }
+
+    std::string value;
+    EncodeUint64Ascending(&value, static_cast<uint64_t>(floor));
+    batch->Put(prefix, value);
+    return floor;
+}
+
+Status Store::writeWatchLog(rocksdb::WriteBatch* batch, int64_t floor) {
+    auto s = db_->Write(write_options_, batch);
+    if (!s.ok()) {
+        return Status(Status::kIOError, "write watch log", s.ToString());
+    }
+    watch_log_floor_ = floor;
+    return Status::OK();
+}
+
+void Store::clearWatchLog() {
+    auto prefix = watchLogPrefix(range_id_);
+    auto s = db_->DeleteRange(rocksdb::WriteOptions(), db_->DefaultColumnFamily(), prefix,
+                              NextComparable(prefix));
+    if (!s.ok()) {
+        FLOG_WARN("range[%" PRIu64 "] clear watch log failed: %s", range_id_, s.ToString().c_str());
+        watch_log_floor_ = kWatchLogUnloaded;
+    } else {
+        watch_log_floor_ = -1;
+    }
+}
+
+Status Store::PutWithWatchLog(const std::string& key, const std::string& value, int64_t version) {
+    if (!watchLogEnabled()) {
+        return this->Put(key, value);
+    }
+
+    rocksdb::WriteBatch batch;
+    auto floor = prepareWatchLog(version, &batch);
+    batchPut(&batch, key, value);
+
+    std::string log_value;
+    log_value.push_back(static_cast<char>(watchpb::PUT));
+    log_value.append(value);
+    auto log_key = watchLogKey(version);
+    log_key.append(key);
+    batch.Put(log_key, log_value);
+
+    auto s = writeWatchLog(&batch, floor);
+    if (s.ok()) {
+        addMetricWrite(1, key.size() + value.size());
+        hot_keys_.RecordWrite(key);
+    }
+    return s;
+}
+
+Status Store::DeleteWithWatchLog(const std::string& key, int64_t version) {
+    if (!watchLogEnabled()) {
+        return this->Delete(key);
+    }
+
+    rocksdb::WriteBatch batch;
+    auto floor = prepareWatchLog(version, &batch);
+    batchDelete(&batch, key);
+
+    auto log_key = watchLogKey(version);
+    log_key.append(key);
+    batch.Put(log_key, std::string(1, static_cast<char>(watchpb::DELETE)));
+
+    auto s = writeWatchLog(&batch, floor);
+    if (s.ok()) {
+        addMetricWrite(1, key.size());
+        hot_keys_.RecordWrite(key);
+    }
+    return s;
+}
+
+Status Store::ScanWatchLog(const std::string& start, const std::string& limit,
+                           int64_t from_version, std::vector<WatchLogEntry>* entries) {
+    if (!watchLogEnabled()) {
+        return Status(Status::kCompacted, "watch log disabled", "");
+    }
+
+    // 下限和日志从同一个迭代器读取，读取过程中的删除不可见
+    auto prefix = watchLogPrefix(range_id_);
+    std::unique_ptr<rocksdb::Iterator> it(
+        db_->NewIterator(rocksdb::ReadOptions(ds_config.rocksdb_config.read_checksum, true)));
+    it->Seek(prefix);
+    if (!it->Valid() || it->key().ToString() != prefix) {
+        if (!it->status().ok()) {
+            return Status(Status::kIOError, "seek watch log", it->status().ToString());
+        }
+        return Status(Status::kCompacted, "no watch log", "");
+    }
+
+    uint64_t floor = 0;
+    size_t offset = 0;
+    if (!DecodeUint64Ascending(it->value().ToString(), offset, &floor)) {
+        return Status(Status::kCorruption, "watch log floor", EncodeToHex(it->value().ToString()));
+    }
+    if (from_version < static_cast<int64_t>(floor)) {
+        return Status(Status::kCompacted, "watch log compacted", std::to_string(floor));
+    }
+
+    uint64_t keys = 0;
+    uint64_t bytes = 0;
+    const size_t header_len = prefix.size() + 8;
+    for (it->Seek(watchLogKey(from_version + 1)); it->Valid(); it->Next()) {
+        auto log_key = it->key();
+        if (log_key.size() < header_len || memcmp(log_key.data(), prefix.data(), prefix.size()) != 0) {
+            break;
+        }
+        auto log_value = it->value();
+        if (log_value.size() == 0) {
+            return Status(Status::kCorruption, "watch log value", EncodeToHex(log_key.ToString()));
+        }
+        ++keys;
+        bytes += log_key.size() + log_value.size();
+
+        std::string key(log_key.data() + header_len, log_key.size() - header_len);
+        if (key < start || (!limit.empty() && key >= limit)) {
+            continue;
+        }
+
+        WatchLogEntry entry;
+        uint64_t version = 0;
+        offset = prefix.size();
+        DecodeUint64Ascending(std::string(log_key.data(), header_len), offset, &version);
+        entry.version = static_cast<int64_t>(version);
+        entry.type = static_cast<watchpb::EventType>(log_value[0]);
+        entry.key = std::move(key);
+        entry.value.assign(log_value.data() + 1, log_value.size() - 1);
+        entries->push_back(std::move(entry));
+    }
+    addMetricRead(keys, bytes);
+    if (!it->status().ok()) {
+        return Status(Status::kIOError, "scan watch log", it->status().ToString());
+    }
+    return Status::OK();
+}
+
 
 } /* namespace storage */
 } /* namespace dataserver */
@@ -67,6 +67,19 @@ namespace watch {
         void printQueue(void(*pFunc)(T));
         //适配所有模板类的打印，传入一个对应类型的打印函数指针
 
+        int32_t capacity() const { return m_iCapacity; }
+
+        //下一次入队将要覆盖的位置（可能是已出队但未释放的旧元素）
+        const T &tailSlot() const { return m_pQueue[m_iTail]; }
+
+        //遍历整个数组（包括已出队的旧元素），用于统计内存
+        template<class F>
+        void forEachSlot(F f) const {
+            for (int32_t i = 0; i < m_iCapacity; i++) {
+                f(m_pQueue[i]);
+            }
+        }
+
     private:
         //队列数组指针
         T *m_pQueue = nullptr;
@@ -24,12 +24,14 @@ bool operator < (const struct SGroupKey &l, const struct SGroupKey &r) {
 bool CEventBuffer::thread_flag_=true;
 int32_t CEventBuffer::milli_timeout_ = EVENT_BUFFER_TIME_OUT;
 
-CEventBuffer::CEventBuffer() {
+CEventBuffer::CEventBuffer() :
+    mem_tracker_(new MemTracker("watch_buffer", MemTracker::Root())) {
     mapGroupBuffer.clear();
 //    create_thread();
 }
 
-CEventBuffer::CEventBuffer(const int &mapSize, const int &queueSize) {
+CEventBuffer::CEventBuffer(const int &mapSize, const int &queueSize, MemTracker *mem_parent) :
+    mem_tracker_(new MemTracker("watch_buffer", mem_parent != nullptr ? mem_parent : MemTracker::Root())) {
     map_capacity_ = mapSize>MAX_EVENT_BUFFER_MAP_SIZE?MAX_EVENT_BUFFER_MAP_SIZE:mapSize;
     queue_capacity_ = queueSize>MAX_EVENT_QUEUE_SIZE?MAX_EVENT_QUEUE_SIZE:queueSize;
 
@@ -42,6 +44,7 @@ CEventBuffer::CEventBuffer(const int &mapSize, const int &queueSize) {
 
 CEventBuffer::~CEventBuffer() {
     for(auto it : mapGroupBuffer) {
+        mem_tracker_->Release(groupBytes(it.second));
         delete it.second;
     }
     loop_flag_ = false;
@@ -87,25 +90,23 @@ bool CEventBuffer::enQueue(const std::string &grpKey, const CEventBufferValue *b
 
         //to do escasp from map
         if(isFull()) {
-            GroupKey k(listGroupBuffer.begin()->key_, listGroupBuffer.begin()->create_time_);
-            listGroupBuffer.pop_front();
-
-            FLOG_INFO("buffer_map auto pop key:%s", EncodeToHexString(k.key_).c_str());
+            popOldest();
+        }
 
-            auto itMap = mapGroupBuffer.find(k);
-            if(itMap != mapGroupBuffer.end()) {
-                deQueue(itMap->second);
-                mapGroupBuffer.erase(itMap);
-                map_size_--;
-                FLOG_INFO("map pop success, key:%s  create(ms):%" PRId64 " map-length:%" PRId32, k.key_.c_str(), k.create_time_, map_size_);
-            } else {
-                FLOG_INFO("map pop error, key:%s  create(ms):%" PRId64 " map-length:%" PRId32, k.key_.c_str(), k.create_time_, map_size_);
+        // 内存超过软限制，新建group之前先淘汰一半
+        if (mem_tracker_->SoftLimitExceeded() && map_size_ > 0) {
+            auto keep = map_size_ / 2;
+            while (map_size_ > keep && popOldest()) {
             }
+            FLOG_WARN("memory soft limit exceeded, event buffer shrunk to %" PRId32, map_size_);
         }
 
         auto grpValue = new GroupValue(queue_capacity_);
+        mem_tracker_->Consume(groupBytes(grpValue));
 
+        auto bytes = valueBytes(*bufferValue) - valueBytes(grpValue->tailSlot());
         if(grpValue->enQueue(*bufferValue)) {
+            mem_tracker_->Consume(bytes);
             listGroupBuffer.push_back(key);
             auto result = mapGroupBuffer.emplace(std::make_pair(key, grpValue));
             if(result.second) {
@@ -123,9 +124,16 @@ bool CEventBuffer::enQueue(const std::string &grpKey, const CEventBufferValue *b
             FLOG_WARN("map[%s]->queue is full[%" PRId32 "]", EncodeToHexString(grpKey).c_str(), queue_capacity_);
             ret = false;
         }
+        if (!ret) {
+            mem_tracker_->Release(groupBytes(grpValue));
+            delete grpValue;
+        }
     } else {
+        auto bytes = valueBytes(*bufferValue) - valueBytes(it->second->tailSlot());
         ret = it->second->enQueue(*bufferValue);
-        if(!ret) {
+        if (ret) {
+            mem_tracker_->Consume(bytes);
+        } else {
             FLOG_WARN("map[%s]->queue is full..", EncodeToHexString(grpKey).c_str());
         }
         queueLength = it->second->length();
@@ -139,6 +147,68 @@ bool CEventBuffer::enQueue(const std::string &grpKey, const CEventBufferValue *b
     return ret;
 }
 
+void CEventBuffer::clear(const std::string &grpKey) {
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+
+    auto it = mapGroupBuffer.find(GroupKey(grpKey));
+    if (it != mapGroupBuffer.end()) {
+        eraseGroup(it);
+        listGroupBuffer.remove_if([&grpKey](const GroupKey &k) { return k.key_ == grpKey; });
+    }
+}
+
+size_t CEventBuffer::shrink(size_t keep) {
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+
+    size_t count = 0;
+    while (static_cast<size_t>(map_size_) > keep && popOldest()) {
+        ++count;
+    }
+    return count;
+}
+
+bool CEventBuffer::popOldest() {
+    while (!listGroupBuffer.empty()) {
+        GroupKey k(listGroupBuffer.begin()->key_, listGroupBuffer.begin()->create_time_);
+        listGroupBuffer.pop_front();
+
+        FLOG_INFO("buffer_map auto pop key:%s", EncodeToHexString(k.key_).c_str());
+
+        auto itMap = mapGroupBuffer.find(k);
+        if(itMap != mapGroupBuffer.end()) {
+            eraseGroup(itMap);
+            FLOG_INFO("map pop success, key:%s  create(ms):%" PRId64 " map-length:%" PRId32, k.key_.c_str(), k.create_time_, map_size_);
+            return true;
+        } else {
+            FLOG_INFO("map pop error, key:%s  create(ms):%" PRId64 " map-length:%" PRId32, k.key_.c_str(), k.create_time_, map_size_);
+        }
+    }
+    return false;
+}
+
+void CEventBuffer::eraseGroup(MapGroupBuffer::iterator it) {
+    mem_tracker_->Release(groupBytes(it->second));
+    deQueue(it->second);
+    mapGroupBuffer.erase(it);
+    map_size_--;
+}
+
+int64_t CEventBuffer::valueBytes(const CEventBufferValue &val) {
+    int64_t bytes = val.value().size();
+    for (const auto &k : val.key()) {
+        bytes += k.size();
+    }
+    return bytes;
+}
+
+int64_t CEventBuffer::groupBytes(const GroupValue *grpVal) {
+    // 队列数组是一次性分配的，出队的元素在被覆盖前也仍然占用内存
+    int64_t bytes = sizeof(GroupValue) +
+            static_cast<int64_t>(grpVal->capacity()) * sizeof(CEventBufferValue);
+    grpVal->forEachSlot([&bytes](const CEventBufferValue &val) { bytes += valueBytes(val); });
+    return bytes;
+}
+
 bool CEventBuffer::deQueue(GroupValue   *grpVal) {
 
     //std::lock_guard<std::mutex> lock(buffer_mutex_);
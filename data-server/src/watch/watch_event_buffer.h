@@ -4,12 +4,14 @@
 _Pragma("once");
 
 #include "circular_queue.h"
+#include "base/mem_tracker.h"
 #include "proto/gen/watchpb.pb.h"
 #include "frame/sf_logger.h"
 #include "common/ds_encoding.h"
 #include "frame/sf_util.h"
 
 #include <list>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <condition_variable>
@@ -124,7 +126,8 @@ using ListGroupBuffer = std::list<GroupKey>;
 class CEventBuffer {
 public:
     CEventBuffer();
-    CEventBuffer(const int &mapSize, const int &queueSize);
+    // mem_parent: 内存统计的父节点，nullptr时挂在根节点下
+    CEventBuffer(const int &mapSize, const int &queueSize, MemTracker *mem_parent = nullptr);
     ~CEventBuffer();
 
     //<hit cnt:version scope in buffer<from:to> >
@@ -134,15 +137,12 @@ public:
 
     bool deQueue(GroupValue   *grpVal);
 
-    void clear(const std::string &grpKey) {
-        GroupKey gk(grpKey);
+    void clear(const std::string &grpKey);
 
-        auto it = mapGroupBuffer.find(gk);
-        if (it != mapGroupBuffer.end()) {
-            it->second->clearQueue();
-            mapGroupBuffer.erase(it);
-        }
-    }
+    // 内存超过软限制时调用，淘汰最早创建的group直到剩余keep个，返回淘汰个数
+    size_t shrink(size_t keep);
+
+    int64_t memBytes() const { return mem_tracker_->Usage(); }
 
     bool isEmpty() const {
         return (mapGroupBuffer.size() == 0);
@@ -152,8 +152,14 @@ public:
         return (mapGroupBuffer.size() == MAX_EVENT_BUFFER_MAP_SIZE);
     }
 
+private:
+    // 淘汰最早创建的group，调用方需持有buffer_mutex_
+    bool popOldest();
+    // 删除group并释放内存统计，调用方需持有buffer_mutex_
+    void eraseGroup(MapGroupBuffer::iterator it);
 
-
+    static int64_t valueBytes(const CEventBufferValue &val);
+    static int64_t groupBytes(const GroupValue *grpVal);
 
 private:
     MapGroupBuffer mapGroupBuffer;
@@ -171,6 +177,8 @@ private:
     std::thread clear_thread_;
     volatile bool loop_flag_{true};
 
+    std::unique_ptr<MemTracker> mem_tracker_;
+
 };
 
 
@@ -458,6 +458,23 @@ std::pair<int32_t, bool> WatcherSet::loadFromDb(storage::Store *store, const wat
                    const std::string &endKey, const int64_t &startVersion, const uint64_t &tableId,
                    watchpb::DsWatchResponse *dsResp) {
 
+    //<db-count:db-exists-data>
+    std::pair<int32_t, bool> result;
+    result.second = false;
+
+    //客户端有版本时先从变更日志中读取增量，版本已经超出日志保留窗口时全量加载
+    if (startVersion > 0) {
+        std::vector<storage::WatchLogEntry> entries;
+        auto s = store->ScanWatchLog(fromKey, endKey, startVersion, &entries);
+        if (s.ok()) {
+            result.first = loadFromLog(entries, tableId, dsResp);
+            result.second = true;
+            return result;
+        }
+        FLOG_DEBUG("loadFromDb: version %" PRId64 " not in watch log(%s), load all", startVersion,
+                   s.ToString().c_str());
+    }
+
     //need to encode and decode
     std::shared_ptr<storage::Iterator> iterator(store->NewIterator(fromKey, endKey));
     int32_t count{0};
@@ -465,10 +482,6 @@ std::pair<int32_t, bool> WatcherSet::loadFromDb(storage::Store *store, const wat
     int64_t maxVersion{0};
     auto err = std::make_shared<errorpb::Error>();
 
-    //<db-count:db-exists-data>
-    std::pair<int32_t, bool> result;
-    result.second = false;
-
     auto resp = dsResp->mutable_resp();
     resp->set_code(Status::kOk);
     resp->set_scope(watchpb::RESPONSE_ALL);
@@ -522,6 +535,31 @@ std::pair<int32_t, bool> WatcherSet::loadFromDb(storage::Store *store, const wat
     return result;
 }
 
+int32_t WatcherSet::loadFromLog(std::vector<storage::WatchLogEntry> &entries, const uint64_t &tableId,
+                                watchpb::DsWatchResponse *dsResp) {
+    errorpb::Error err;
+    auto resp = dsResp->mutable_resp();
+    resp->set_code(Status::kOk);
+    resp->set_scope(watchpb::RESPONSE_PART);
+
+    int32_t count{0};
+    for (auto &entry : entries) {
+        watchpb::WatchKeyValue kv;
+        if (Status::kOk != range::WatchEncodeAndDecode::DecodeKv(funcpb::kFuncPureGet, tableId, &kv, entry.key,
+                                                                 entry.value, &err)) {
+            continue;
+        }
+
+        auto evt = resp->add_events();
+        evt->set_type(entry.type);
+        evt->mutable_kv()->Swap(&kv);
+        //删除事件没有value，版本取日志中的版本
+        evt->mutable_kv()->set_version(entry.version);
+        count++;
+    }
+    return count;
+}
+
 } // namespace watch
 }
 }
@@ -74,6 +74,10 @@ public:
                        const std::string &endKey, const int64_t &startVersion, const uint64_t &tableId,
                        watchpb::DsWatchResponse *dsResp);
 
+    //把变更日志中的记录按顺序转成事件，返回事件个数
+    int32_t loadFromLog(std::vector<storage::WatchLogEntry> &entries, const uint64_t &tableId,
+                        watchpb::DsWatchResponse *dsResp);
+
 
 private:
     WatcherMap              key_watcher_map_;
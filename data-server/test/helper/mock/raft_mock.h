@@ -16,6 +16,7 @@ public:
     void GetLeaderTerm(uint64_t* leader, uint64_t* term) const override;
     bool IsLeader() const override;
     Status TryToLeader() override { return Status::OK(); }
+    Status TransferLeader(uint64_t node_id) override { return Status::OK(); }
 
     Status Submit(std::string& cmd) override ;
     Status ChangeMemeber(const ConfChange& conf) override ;
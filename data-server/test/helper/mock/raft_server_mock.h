@@ -23,6 +23,8 @@ public:
 
     void GetStatus(ServerStatus* status) const override {}
 
+    void GetNodeLoads(std::map<uint64_t, NodeLoad>* loads) const override {}
+
 private:
     RaftServerOptions rop_;
 };
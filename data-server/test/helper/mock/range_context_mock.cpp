@@ -39,6 +39,9 @@ Status RangeContextMock::Init() {
     auto ret = meta_store_->Open();
     if (!ret.ok()) return ret;
 
+    // compactor，不启动后台线程
+    compactor_.reset(new storage::Compactor(db_, storage::CompactorOptions()));
+
     // master worker
     master_worker_.reset(new MasterWorkerMock);
 
@@ -108,6 +111,13 @@ Status RangeContextMock::SplitRange(uint64_t range_id, const raft_cmdpb::SplitRe
     return Status::OK();
 }
 
+Status RangeContextMock::BatchSplitRange(uint64_t range_id, const raft_cmdpb::BatchSplitRequest &req, uint64_t raft_index) {
+    for (const auto& new_range : req.new_ranges()) {
+        CreateRange(new_range, req.leader(), raft_index);
+    }
+    return Status::OK();
+}
+
 }
 }
 }
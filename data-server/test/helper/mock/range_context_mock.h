@@ -4,6 +4,7 @@ _Pragma("once");
 #include <mutex>
 
 #include "range/context.h"
+#include "storage/compactor.h"
 #include "raft/server.h"
 #include "master/worker.h"
 #include "watch/watch_server.h"
@@ -29,6 +30,7 @@ public:
     master::Worker* MasterClient() override { return master_worker_.get(); }
     raft::RaftServer* RaftServer() override { return raft_server_.get(); }
     storage::MetaStore* MetaStore() override { return meta_store_.get(); }
+    storage::Compactor* Compactor() override { return compactor_.get(); }
     common::SocketSession* SocketSession() override { return socket_session_.get(); }
     RangeStats* Statistics() override { return range_stats_.get(); }
     watch::WatchServer* WatchServer() override { return watch_server_.get(); }
@@ -43,11 +45,13 @@ public:
             uint64_t index = 0, std::shared_ptr<Range> *result = nullptr);
     std::shared_ptr<Range> FindRange(uint64_t range_id) override;
     Status SplitRange(uint64_t range_id, const raft_cmdpb::SplitRequest &req, uint64_t raft_index) override;
+    Status BatchSplitRange(uint64_t range_id, const raft_cmdpb::BatchSplitRequest &req, uint64_t raft_index) override;
 
 private:
     std::string path_;
     rocksdb::DB *db_ = nullptr;
     std::unique_ptr<storage::MetaStore> meta_store_;
+    std::unique_ptr<storage::Compactor> compactor_;
     std::unique_ptr<master::Worker> master_worker_;
     std::unique_ptr<raft::RaftServer> raft_server_;
     std::unique_ptr<common::SocketSession> socket_session_;
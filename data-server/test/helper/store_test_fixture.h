@@ -43,10 +43,10 @@ protected:
     std::unique_ptr<Table> table_;
     metapb::Range meta_;
     dataserver::storage::Store* store_ = nullptr;
+    rocksdb::DB* db_ = nullptr;
 
 private:
     std::string tmp_dir_;
-    rocksdb::DB* db_ = nullptr;
 };
 
 } /* namespace helper */
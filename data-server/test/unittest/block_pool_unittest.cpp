@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "base/block_pool.h"
+#include "common/socket_message.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+using sharkstore::dataserver::common::ProtoMessage;
+
+struct Small : public PoolAllocated<Small> {
+    uint64_t a = 0;
+    uint64_t b = 0;
+};
+
+// 比Small大，不使用Small的池
+struct Bigger : public Small {
+    uint64_t c = 0;
+};
+
+TEST(BlockPool, Reuse) {
+    auto p1 = new Small;
+    delete p1;
+    auto p2 = new Small;
+    // 同一个线程释放后立即被复用
+    ASSERT_EQ(p1, p2);
+    delete p2;
+
+    auto sys_allocs = Small::PoolStats().sys_allocs.load();
+    std::vector<Small*> objs;
+    for (int i = 0; i < 1000; ++i) {
+        objs.push_back(new Small);
+    }
+    for (auto o : objs) delete o;
+    objs.clear();
+    auto after_first = Small::PoolStats().sys_allocs.load();
+    ASSERT_GE(after_first - sys_allocs, 900U);
+
+    for (int i = 0; i < 1000; ++i) {
+        objs.push_back(new Small);
+    }
+    for (auto o : objs) delete o;
+    // 第二轮全部来自池
+    ASSERT_EQ(Small::PoolStats().sys_allocs.load(), after_first);
+}
+
+TEST(BlockPool, DifferentSize) {
+    Small* p = new Bigger;
+    static_cast<Bigger*>(p)->c = 1;
+    auto sys_allocs = Small::PoolStats().sys_allocs.load();
+    delete static_cast<Bigger*>(p);
+    ASSERT_EQ(Small::PoolStats().sys_allocs.load(), sys_allocs);
+}
+
+// 一个线程分配，另一个线程释放，空闲块通过全局批量回到分配线程
+TEST(BlockPool, CrossThread) {
+    const int kOps = 200000;
+    std::vector<ProtoMessage*> queue(kOps);
+    auto sys_before = ProtoMessage::PoolStats().sys_allocs.load();
+
+    const int kRounds = 10;
+    const int kPerRound = kOps / kRounds;
+    for (int r = 0; r < kRounds; ++r) {
+        std::thread producer([&] {
+            for (int i = 0; i < kPerRound; ++i) {
+                queue[r * kPerRound + i] = new ProtoMessage;
+            }
+        });
+        producer.join();
+        std::thread consumer([&] {
+            for (int i = 0; i < kPerRound; ++i) {
+                delete queue[r * kPerRound + i];
+            }
+        });
+        consumer.join();
+    }
+    auto sys_allocs = ProtoMessage::PoolStats().sys_allocs.load() - sys_before;
+    // 后面的轮次复用第一轮归还的块
+    std::cout << "cross thread: " << kOps << " ops, sys allocs: " << sys_allocs << std::endl;
+    ASSERT_LT(sys_allocs, static_cast<uint64_t>(kOps / 2));
+}
+
+// 微基准：每次请求的ProtoMessage分配
+TEST(BlockPool, Bench) {
+    const int kOps = 1000000;
+    auto sys_before = ProtoMessage::PoolStats().sys_allocs.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOps; ++i) {
+        auto msg = new ProtoMessage;
+        msg->msg_id = i;
+        delete msg;
+    }
+    auto pool_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start).count();
+    auto sys_allocs = ProtoMessage::PoolStats().sys_allocs.load() - sys_before;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOps; ++i) {
+        auto p = ::operator new(sizeof(ProtoMessage));
+        static_cast<ProtoMessage*>(p)->msg_id = i;
+        ::operator delete(p);
+    }
+    auto malloc_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "ProtoMessage pool: " << pool_ns / kOps << " ns/op, "
+              << static_cast<double>(sys_allocs) / kOps << " sys allocs/op; "
+              << "malloc: " << malloc_ns / kOps << " ns/op, 1 sys alloc/op" << std::endl;
+    ASSERT_LE(sys_allocs, 1U);
+}
+
+}  // namespace
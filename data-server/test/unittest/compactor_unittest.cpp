@@ -0,0 +1,137 @@
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "base/status.h"
+#include "base/util.h"
+#include "storage/compactor.h"
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+using namespace sharkstore::dataserver;
+using namespace sharkstore::dataserver::storage;
+
+static const int kKeyCount = 1000;
+
+class CompactorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char path[] = "/tmp/sharkstore_ds_compactor_test_XXXXXX";
+        char *tmp = mkdtemp(path);
+        ASSERT_TRUE(tmp != NULL);
+        tmp_dir_ = tmp;
+
+        rocksdb::Options ops;
+        ops.create_if_missing = true;
+        auto s = rocksdb::DB::Open(ops, tmp_dir_, &db_);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+
+    void TearDown() override {
+        delete db_;
+        if (!tmp_dir_.empty()) {
+            sharkstore::RemoveDirAll(tmp_dir_.c_str());
+        }
+    }
+
+    static std::string key(int i) {
+        char buf[32] = {'\0'};
+        snprintf(buf, sizeof(buf), "key_%06d", i);
+        return buf;
+    }
+
+    // 写入kKeyCount个key再逐个删除，删除标记和数据分别在两个sst里
+    void writeAndDelete() {
+        for (int i = 0; i < kKeyCount; ++i) {
+            auto s = db_->Put(rocksdb::WriteOptions(), key(i), "value");
+            ASSERT_TRUE(s.ok()) << s.ToString();
+        }
+        ASSERT_TRUE(db_->Flush(rocksdb::FlushOptions()).ok());
+        for (int i = 0; i < kKeyCount; ++i) {
+            auto s = db_->Delete(rocksdb::WriteOptions(), key(i));
+            ASSERT_TRUE(s.ok()) << s.ToString();
+        }
+        ASSERT_TRUE(db_->Flush(rocksdb::FlushOptions()).ok());
+    }
+
+    static void waitCompacted(const Compactor& compactor, uint64_t count) {
+        for (int i = 0; i < 500 && compactor.CompactedCount() < count; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+protected:
+    std::string tmp_dir_;
+    rocksdb::DB *db_ = nullptr;
+};
+
+TEST_F(CompactorTest, TombstoneStats) {
+    writeAndDelete();
+
+    TombstoneStats stats;
+    auto s = GetTombstoneStats(db_, key(0), key(kKeyCount), &stats);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(stats.num_files, 2U);
+    ASSERT_EQ(stats.num_entries, static_cast<uint64_t>(kKeyCount * 2));
+    ASSERT_EQ(stats.num_deletions, static_cast<uint64_t>(kKeyCount));
+    ASSERT_EQ(stats.Percent(), 50U);
+}
+
+TEST_F(CompactorTest, CompactKeysDeleted) {
+    writeAndDelete();
+
+    CompactorOptions opt;
+    opt.interval_msec = 1;
+    opt.tombstone_percent = 30;
+    Compactor compactor(db_, opt);
+    compactor.Start();
+
+    // 分批调度的相邻区间合并成一个
+    compactor.ScheduleKeysDeleted(key(0), key(kKeyCount / 2), kKeyCount / 2);
+    compactor.ScheduleKeysDeleted(key(kKeyCount / 2), key(kKeyCount - 1), kKeyCount / 2);
+    waitCompacted(compactor, 1);
+    ASSERT_EQ(compactor.CompactedCount(), 1U);
+    ASSERT_EQ(compactor.PendingCount(), 0U);
+
+    // 压缩到最底层后删除标记和数据都被清除
+    TombstoneStats stats;
+    auto s = GetTombstoneStats(db_, key(0), key(kKeyCount), &stats);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(stats.num_entries, 0U);
+    ASSERT_EQ(stats.num_deletions, 0U);
+
+    compactor.Stop();
+}
+
+TEST_F(CompactorTest, SkipSparseTombstones) {
+    for (int i = 0; i < kKeyCount; ++i) {
+        auto s = db_->Put(rocksdb::WriteOptions(), key(i), "value");
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    ASSERT_TRUE(db_->Flush(rocksdb::FlushOptions()).ok());
+
+    CompactorOptions opt;
+    opt.interval_msec = 1;
+    opt.tombstone_percent = 30;
+    Compactor compactor(db_, opt);
+    compactor.Start();
+
+    // 只删除了少量key，不需要压缩
+    ASSERT_TRUE(db_->Delete(rocksdb::WriteOptions(), key(0)).ok());
+    compactor.ScheduleKeysDeleted(key(0), key(0), 1);
+    // 强制压缩的区间在其后执行
+    compactor.ScheduleRangeDeleted(key(kKeyCount), key(kKeyCount + 1));
+    waitCompacted(compactor, 1);
+    ASSERT_EQ(compactor.CompactedCount(), 1U);
+    ASSERT_EQ(compactor.SkippedCount(), 1U);
+
+    compactor.Stop();
+}
+
+} /* namespace  */
@@ -3,6 +3,8 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <cmath>
+#include <vector>
 
 #include "common/ds_encoding.h"
 
@@ -193,5 +195,31 @@ TEST(Encoding, AscInt) {
     ASSERT_EQ(value, 1);
 }
 
+TEST(Encoding, AscFloat) {
+    std::vector<double> nums = {-std::numeric_limits<double>::max(), -1e10, -1.5, -0.00123, 0,
+                                0.00123, 1.5, 1e10, std::numeric_limits<double>::max()};
+    std::string prev;
+    for (auto num : nums) {
+        std::string buf;
+        EncodeFloatAscending(&buf, num);
+        // 编码后的顺序与数值顺序一致
+        ASSERT_LT(prev, buf) << num;
+        prev = buf;
+
+        double value = 0;
+        size_t offset = 0;
+        ASSERT_TRUE(DecodeFloatAscending(buf, offset, &value));
+        ASSERT_EQ(offset, buf.size());
+        ASSERT_EQ(value, num);
+    }
+
+    std::string buf;
+    EncodeFloatAscending(&buf, std::numeric_limits<double>::quiet_NaN());
+    double value = 0;
+    size_t offset = 0;
+    ASSERT_TRUE(DecodeFloatAscending(buf, offset, &value));
+    ASSERT_TRUE(std::isnan(value));
+}
+
 // end namespace
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "storage/hot_keys.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore::dataserver::storage;
+
+TEST(HotKeys, SpaceSaving) {
+    HotKeySketch sketch(4);
+    // 一个热点key混在大量只访问一次的key中
+    for (int i = 0; i < 1000; ++i) {
+        sketch.Add("hot");
+        if (i % 2 == 0) sketch.Add("warm");
+        sketch.Add("cold" + std::to_string(i));
+    }
+    ASSERT_EQ(sketch.Size(), 4U);
+
+    std::vector<HotKey> top;
+    sketch.TopK(2, &top);
+    ASSERT_EQ(top.size(), 2U);
+    ASSERT_EQ(top[0].key, "hot");
+    ASSERT_GE(top[0].count, 1000U);
+    ASSERT_LE(top[0].count - top[0].error, 1000U);
+    ASSERT_EQ(top[1].key, "warm");
+    ASSERT_GE(top[1].count, 500U);
+
+    // 计数减半，只访问过一次的被淘汰
+    sketch.Decay();
+    sketch.TopK(10, &top);
+    ASSERT_EQ(top[0].key, "hot");
+    ASSERT_GE(top[0].count, 500U);
+    for (int i = 0; i < 20; ++i) {
+        sketch.Decay();
+    }
+    ASSERT_EQ(sketch.Size(), 0U);
+}
+
+TEST(HotKeys, Prefix) {
+    HotKeys hot_keys(2, 3, 1);
+    ASSERT_TRUE(hot_keys.Enabled());
+    for (int i = 0; i < 100; ++i) {
+        hot_keys.RecordRead("abc" + std::to_string(i));
+        hot_keys.RecordWrite("xyz");
+    }
+    hot_keys.RecordWrite("xyz1");
+
+    HotKeysStat stat;
+    hot_keys.Collect(&stat, false);
+    ASSERT_EQ(stat.read_prefixes.size(), 1U);
+    ASSERT_EQ(stat.read_prefixes[0].key, "abc");
+    ASSERT_EQ(stat.read_prefixes[0].count, 100U);
+    ASSERT_EQ(stat.write_keys[0].key, "xyz");
+    ASSERT_EQ(stat.write_keys[0].count, 100U);
+    // 不超过前缀长度的key不计入前缀
+    ASSERT_EQ(stat.write_prefixes.size(), 1U);
+    ASSERT_EQ(stat.write_prefixes[0].count, 1U);
+
+    hot_keys.Collect(&stat, true);
+    hot_keys.Collect(&stat, false);
+    ASSERT_EQ(stat.write_keys[0].count, 50U);
+
+    HotKeys disabled(0, 3, 1);
+    ASSERT_FALSE(disabled.Enabled());
+    disabled.RecordRead("abc");
+    disabled.Collect(&stat, false);
+    ASSERT_TRUE(stat.read_keys.empty());
+}
+
+TEST(HotKeys, Sample) {
+    HotKeys hot_keys(1, 0, 4);
+    std::thread t([&hot_keys] {
+        for (int i = 0; i < 400; ++i) {
+            hot_keys.RecordRead("k");
+        }
+    });
+    t.join();
+    HotKeysStat stat;
+    hot_keys.Collect(&stat, false);
+    ASSERT_EQ(stat.read_keys.size(), 1U);
+    ASSERT_EQ(stat.read_keys[0].count, 400U);
+    ASSERT_TRUE(stat.read_prefixes.empty());
+
+    // 读写交替、多个range交替访问时各自采样
+    HotKeys a(1, 0, 4), b(1, 0, 4);
+    for (int i = 0; i < 400; ++i) {
+        a.RecordRead("r");
+        a.RecordWrite("w");
+        b.RecordRead("r");
+    }
+    a.Collect(&stat, false);
+    ASSERT_EQ(stat.read_keys.size(), 1U);
+    ASSERT_EQ(stat.read_keys[0].count, 400U);
+    ASSERT_EQ(stat.write_keys.size(), 1U);
+    ASSERT_EQ(stat.write_keys[0].count, 400U);
+    b.Collect(&stat, false);
+    ASSERT_EQ(stat.read_keys[0].count, 400U);
+}
+
+} /* namespace  */
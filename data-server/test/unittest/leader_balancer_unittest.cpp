@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include "frame/sf_logger.h"
+#include "server/leader_balancer.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore::dataserver::server;
+using sharkstore::raft::NodeLoad;
+using Clock = LeaderBalancer::Clock;
+
+class LeaderBalancerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        log_init2();
+
+        opt_.interval_msec = 1000;
+        opt_.tolerance_percent = 10;
+        opt_.max_transfers = 4;
+        opt_.range_cooldown_msec = 60000;
+        now_ = Clock::now();
+    }
+
+    NodeLoad load(uint64_t leaders, uint64_t rafts) {
+        NodeLoad l;
+        l.leader_count = leaders;
+        l.raft_count = rafts;
+        l.update_time = now_;
+        return l;
+    }
+
+    // range_id从1到count，副本都在nodes上
+    static std::vector<LeaderCandidate> candidates(uint64_t count,
+                                                   const std::vector<uint64_t>& nodes) {
+        std::vector<LeaderCandidate> result;
+        for (uint64_t i = 1; i <= count; ++i) {
+            LeaderCandidate c;
+            c.range_id = i;
+            c.nodes = nodes;
+            result.push_back(c);
+        }
+        return result;
+    }
+
+    void advance(uint64_t msec) { now_ += std::chrono::milliseconds(msec); }
+
+protected:
+    LeaderBalancerOptions opt_;
+    Clock::time_point now_;
+};
+
+TEST_F(LeaderBalancerTest, Tolerance) {
+    LeaderBalancer balancer(nullptr, opt_);
+    // 40% vs 32%，在容忍范围内
+    std::map<uint64_t, NodeLoad> peers = {{2, load(8, 25)}};
+    auto transfers = balancer.Plan(load(40, 100), peers, candidates(40, {2}), now_);
+    ASSERT_TRUE(transfers.empty());
+
+    LeaderBalanceStats stats;
+    balancer.GetStats(&stats);
+    ASSERT_EQ(stats.skew_percent, 8U);
+    ASSERT_EQ(stats.unbalanced_msec, 0U);
+
+    // 本节点比例较低时由对方转移
+    peers = {{2, load(20, 25)}};
+    transfers = balancer.Plan(load(10, 100), peers, candidates(10, {2}), now_);
+    ASSERT_TRUE(transfers.empty());
+    balancer.GetStats(&stats);
+    ASSERT_EQ(stats.skew_percent, 70U);
+}
+
+TEST_F(LeaderBalancerTest, RateLimit) {
+    LeaderBalancer balancer(nullptr, opt_);
+    // 刚重启的节点3没有leader
+    std::map<uint64_t, NodeLoad> peers = {{2, load(50, 100)}, {3, load(0, 100)}};
+    auto transfers = balancer.Plan(load(50, 100), peers, candidates(50, {2, 3}), now_);
+    ASSERT_EQ(transfers.size(), opt_.max_transfers);
+    for (const auto& t : transfers) {
+        ASSERT_EQ(t.to_node, 3U);
+    }
+
+    LeaderBalanceStats stats;
+    balancer.GetStats(&stats);
+    ASSERT_EQ(stats.transfer_count, opt_.max_transfers);
+    ASSERT_EQ(stats.skew_percent, 50U);
+}
+
+TEST_F(LeaderBalancerTest, NoOvershoot) {
+    opt_.max_transfers = 100;
+    LeaderBalancer balancer(nullptr, opt_);
+    // 60% vs 20%，转移到差距不超过容忍范围为止：45% vs 35%
+    std::map<uint64_t, NodeLoad> peers = {{2, load(20, 100)}};
+    auto transfers = balancer.Plan(load(60, 100), peers, candidates(60, {2}), now_);
+    ASSERT_EQ(transfers.size(), 15U);
+
+    // 剩下的差距在容忍范围内，不再转移
+    advance(opt_.interval_msec);
+    peers = {{2, load(35, 100)}};
+    peers[2].update_time = now_;
+    transfers = balancer.Plan(load(45, 100), peers, candidates(60, {2}), now_);
+    ASSERT_TRUE(transfers.empty());
+}
+
+TEST_F(LeaderBalancerTest, Cooldown) {
+    LeaderBalancer balancer(nullptr, opt_);
+    std::map<uint64_t, NodeLoad> peers = {{2, load(0, 100)}, {3, load(0, 100)}};
+    auto cands = candidates(4, {2, 3});
+    auto transfers = balancer.Plan(load(100, 100), peers, cands, now_);
+    ASSERT_EQ(transfers.size(), 4U);
+
+    // 对方的分布还没有更新，不再向它转移
+    advance(opt_.interval_msec);
+    cands = candidates(8, {2, 3});
+    transfers = balancer.Plan(load(96, 100), peers, cands, now_);
+    ASSERT_TRUE(transfers.empty());
+
+    // 对方更新后继续，已经转移过的range在冷却中
+    peers = {{2, load(2, 100)}, {3, load(2, 100)}};
+    transfers = balancer.Plan(load(96, 100), peers, cands, now_);
+    ASSERT_EQ(transfers.size(), 4U);
+    for (const auto& t : transfers) {
+        ASSERT_GT(t.range_id, 4U);
+    }
+
+    // 冷却结束后可以再次转移
+    advance(opt_.range_cooldown_msec);
+    peers = {{2, load(4, 100)}, {3, load(4, 100)}};
+    transfers = balancer.Plan(load(92, 100), peers, cands, now_);
+    ASSERT_EQ(transfers.size(), 4U);
+    ASSERT_EQ(transfers[0].range_id, 1U);
+}
+
+TEST_F(LeaderBalancerTest, ExpiredLoad) {
+    LeaderBalancer balancer(nullptr, opt_);
+    std::map<uint64_t, NodeLoad> peers = {{2, load(0, 100)}};
+    advance(opt_.interval_msec * 10);
+    auto transfers = balancer.Plan(load(100, 100), peers, candidates(10, {2}), now_);
+    ASSERT_TRUE(transfers.empty());
+
+    // 不是副本节点
+    peers = {{2, load(0, 100)}};
+    transfers = balancer.Plan(load(100, 100), peers, candidates(10, {3}), now_);
+    ASSERT_TRUE(transfers.empty());
+}
+
+// 模拟两个节点各有100个range的副本，节点2重启后没有leader，
+// 每轮按计划转移，统计收敛的轮数和时间
+TEST_F(LeaderBalancerTest, Converge) {
+    const uint64_t kRanges = 100;
+    LeaderBalancer balancer(nullptr, opt_);
+    uint64_t local = kRanges, remote = 0;
+    std::vector<bool> local_leader(kRanges + 1, true);
+
+    int rounds = 0;
+    LeaderBalanceStats stats;
+    for (; rounds < 100; ++rounds) {
+        std::vector<LeaderCandidate> cands;
+        for (uint64_t i = 1; i <= kRanges; ++i) {
+            if (local_leader[i]) {
+                LeaderCandidate c;
+                c.range_id = i;
+                c.nodes = {2};
+                cands.push_back(c);
+            }
+        }
+        std::map<uint64_t, NodeLoad> peers = {{2, load(remote, kRanges)}};
+        auto transfers = balancer.Plan(load(local, kRanges), peers, cands, now_);
+        for (const auto& t : transfers) {
+            local_leader[t.range_id] = false;
+            --local;
+            ++remote;
+        }
+        balancer.GetStats(&stats);
+        if (stats.converge_count > 0) {
+            break;
+        }
+        advance(opt_.interval_msec);
+    }
+
+    ASSERT_EQ(stats.converge_count, 1U);
+    ASSERT_LE(local - remote, kRanges * opt_.tolerance_percent / 100);
+    ASSERT_EQ(stats.last_converge_msec, rounds * opt_.interval_msec);
+    ASSERT_EQ(stats.unbalanced_msec, 0U);
+    ASSERT_EQ(stats.transfer_count, kRanges - local);
+    std::cout << "converged in " << rounds << " rounds, leaders " << local << "/" << remote
+              << std::endl;
+}
+
+}  // namespace
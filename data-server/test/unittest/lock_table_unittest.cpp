@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include "frame/sf_util.h"
+#include "range/lock_table.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+using namespace sharkstore::dataserver::range;
+
+kvrpcpb::LockValue makeValue(const std::string& id, const std::string& value,
+                             int64_t delete_time = 0) {
+    kvrpcpb::LockValue v;
+    v.set_id(id);
+    v.set_value(value);
+    v.set_delete_time(delete_time);
+    v.set_update_time(getticks());
+    v.set_by("owner");
+    return v;
+}
+
+kvrpcpb::LockUpdateRequest makeRenew(const std::string& key, const std::string& id,
+                                     const std::string& value, int64_t update_time) {
+    kvrpcpb::LockUpdateRequest req;
+    req.set_key(key);
+    req.set_id(id);
+    req.set_update_value(value);
+    req.set_update_time(update_time);
+    req.set_by("renewer");
+    return req;
+}
+
+TEST(LockTable, Renew) {
+    MemTracker parent("parent", nullptr);
+    LockTable table(&parent);
+    kvrpcpb::LockValue current;
+
+    // 未启用时全部走raft
+    table.OnAcquire("k1", makeValue("id1", "v1"), 10);
+    ASSERT_EQ(table.Size(), 0U);
+    ASSERT_EQ(table.Renew(makeRenew("k1", "id1", "v1", 1), &current),
+              LockTable::RenewResult::kNeedReplicate);
+
+    table.Enable();
+    ASSERT_EQ(table.Renew(makeRenew("k1", "id1", "v1", 1), &current),
+              LockTable::RenewResult::kNotFound);
+
+    table.OnAcquire("k1", makeValue("id1", "v1"), 10);
+    ASSERT_EQ(table.Size(), 1U);
+    ASSERT_GT(parent.Usage(), 0);
+
+    ASSERT_EQ(table.Renew(makeRenew("k1", "id1", "v1", 100), &current),
+              LockTable::RenewResult::kOK);
+    ASSERT_EQ(table.DirtyCount(), 1U);
+    LockTable::Entry entry;
+    ASSERT_TRUE(table.Get("k1", &entry));
+    ASSERT_TRUE(entry.dirty);
+    ASSERT_EQ(entry.fence, 10U);
+    ASSERT_EQ(entry.value.update_time(), 100);
+    ASSERT_EQ(entry.value.by(), "renewer");
+
+    // id不匹配
+    ASSERT_EQ(table.Renew(makeRenew("k1", "id2", "v1", 100), &current),
+              LockTable::RenewResult::kIDMismatch);
+    ASSERT_EQ(current.id(), "id1");
+
+    // 修改value需要走raft
+    ASSERT_EQ(table.Renew(makeRenew("k1", "id1", "v2", 100), &current),
+              LockTable::RenewResult::kNeedReplicate);
+
+    // 过期的锁从表中删除
+    table.OnAcquire("k2", makeValue("id1", "v1", getticks() - 1), 11);
+    ASSERT_EQ(table.Renew(makeRenew("k2", "id1", "v1", 100), &current),
+              LockTable::RenewResult::kNeedReplicate);
+    ASSERT_FALSE(table.Get("k2", &entry));
+
+    table.OnRelease("k1");
+    ASSERT_EQ(table.Size(), 0U);
+    ASSERT_EQ(table.DirtyCount(), 0U);
+    ASSERT_EQ(parent.Usage(), 0);
+
+    table.OnAcquire("k1", makeValue("id1", "v1"), 12);
+    table.Disable();
+    ASSERT_EQ(table.Size(), 0U);
+    ASSERT_EQ(parent.Usage(), 0);
+}
+
+TEST(LockTable, Load) {
+    LockTable table;
+    ASSERT_FALSE(table.Load("k1", makeValue("id1", "v1"), 5, table.Generation()));
+
+    table.Enable();
+    ASSERT_EQ(table.ReadyIndex(), 0U);
+    table.SetReadyIndex(100);
+    table.SetReadyIndex(200);
+    ASSERT_EQ(table.ReadyIndex(), 100U);
+
+    // 加载期间有apply，放弃加载
+    auto generation = table.Generation();
+    table.OnRelease("other");
+    ASSERT_FALSE(table.Load("k1", makeValue("id1", "v1"), 5, generation));
+    ASSERT_EQ(table.Size(), 0U);
+
+    generation = table.Generation();
+    ASSERT_TRUE(table.Load("k1", makeValue("id1", "v1"), 5, generation));
+    ASSERT_EQ(table.Size(), 1U);
+
+    // 重新成为leader后ready index需要重新设置
+    table.Disable();
+    table.Enable();
+    ASSERT_EQ(table.ReadyIndex(), 0U);
+    ASSERT_EQ(table.Size(), 0U);
+}
+
+TEST(LockTable, Checkpoint) {
+    LockTable table;
+    table.Enable();
+    kvrpcpb::LockValue current;
+    for (int i = 0; i < 5; ++i) {
+        auto key = "k" + std::to_string(i);
+        table.OnAcquire(key, makeValue("id", "v"), i + 1);
+        ASSERT_EQ(table.Renew(makeRenew(key, "id", "v", 100 + i), &current),
+                  LockTable::RenewResult::kOK);
+    }
+    ASSERT_EQ(table.DirtyCount(), 5U);
+
+    std::vector<kvrpcpb::LockUpdateRequest> reqs;
+    ASSERT_EQ(table.CollectDirty(3, &reqs), 3U);
+    ASSERT_EQ(table.DirtyCount(), 2U);
+    for (const auto& req : reqs) {
+        ASSERT_EQ(req.id(), "id");
+        // 只持久化续约，不带value
+        ASSERT_TRUE(req.update_value().empty());
+        ASSERT_EQ(req.by(), "renewer");
+        ASSERT_GE(req.update_time(), 100);
+    }
+    reqs.clear();
+    ASSERT_EQ(table.CollectDirty(10, &reqs), 2U);
+    ASSERT_EQ(table.DirtyCount(), 0U);
+
+    // apply较早收集的续约时不覆盖内存中之后的续约
+    ASSERT_EQ(table.Renew(makeRenew("k0", "id", "v", 500), &current),
+              LockTable::RenewResult::kOK);
+    auto stale = makeValue("id", "v");
+    stale.set_update_time(100);
+    table.OnUpdate("k0", stale, true);
+    LockTable::Entry entry;
+    ASSERT_TRUE(table.Get("k0", &entry));
+    ASSERT_EQ(entry.value.update_time(), 500);
+    ASSERT_TRUE(entry.dirty);
+
+    // 重新加锁清除dirty
+    table.OnAcquire("k0", makeValue("id3", "v3"), 20);
+    ASSERT_EQ(table.DirtyCount(), 0U);
+    ASSERT_TRUE(table.Get("k0", &entry));
+    ASSERT_EQ(entry.fence, 20U);
+}
+
+TEST(LockTable, CheckpointWithValueChange) {
+    LockTable table;
+    table.Enable();
+    kvrpcpb::LockValue current;
+    table.OnAcquire("k", makeValue("id", "v1"), 1);
+    ASSERT_EQ(table.Renew(makeRenew("k", "id", "v1", 200), &current),
+              LockTable::RenewResult::kOK);
+
+    // 收集续约后，客户端修改value的请求先apply
+    std::vector<kvrpcpb::LockUpdateRequest> reqs;
+    ASSERT_EQ(table.CollectDirty(10, &reqs), 1U);
+    ASSERT_TRUE(reqs[0].update_value().empty());
+    auto changed = makeValue("id", "v2");
+    changed.set_update_time(300);
+    table.OnUpdate("k", changed, false);
+    LockTable::Entry entry;
+    ASSERT_TRUE(table.Get("k", &entry));
+    ASSERT_EQ(entry.value.value(), "v2");
+    ASSERT_EQ(entry.value.update_time(), 300);
+
+    // 之后的续约基于新的value
+    ASSERT_EQ(table.Renew(makeRenew("k", "id", "v1", 400), &current),
+              LockTable::RenewResult::kNeedReplicate);
+    ASSERT_EQ(table.Renew(makeRenew("k", "id", "v2", 400), &current),
+              LockTable::RenewResult::kOK);
+
+    // 旧的续约apply时存储中保留v2，更新时间不回退(与ApplyLockUpdate一致)
+    auto stored = changed;
+    ASSERT_LT(reqs[0].update_time(), stored.update_time());
+    table.OnUpdate("k", stored, true);
+    ASSERT_TRUE(table.Get("k", &entry));
+    ASSERT_EQ(entry.value.value(), "v2");
+    ASSERT_EQ(entry.value.update_time(), 400);
+    ASSERT_TRUE(entry.dirty);
+
+    // 复制的修改优先，清除未持久化的续约
+    auto replicated = makeValue("id", "v3");
+    replicated.set_update_time(350);
+    table.OnUpdate("k", replicated, false);
+    ASSERT_TRUE(table.Get("k", &entry));
+    ASSERT_EQ(entry.value.value(), "v3");
+    ASSERT_EQ(entry.value.update_time(), 350);
+    ASSERT_FALSE(entry.dirty);
+    ASSERT_EQ(table.DirtyCount(), 0U);
+}
+
+} /* namespace  */
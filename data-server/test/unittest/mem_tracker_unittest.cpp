@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "base/mem_tracker.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+
+TEST(MemTracker, Hierarchy) {
+    MemTracker parent("parent", nullptr);
+    parent.SetLimit(100, 200);
+    {
+        MemTracker child("child", &parent);
+        ASSERT_EQ(parent.ChildrenCount(), 1U);
+
+        child.Consume(50);
+        ASSERT_EQ(child.Usage(), 50);
+        ASSERT_EQ(parent.Usage(), 50);
+        ASSERT_EQ(child.CheckLimit(), MemTracker::Level::kNormal);
+
+        child.Consume(60);
+        ASSERT_EQ(child.CheckLimit(), MemTracker::Level::kSoft);
+        ASSERT_TRUE(child.SoftLimitExceeded());
+        ASSERT_FALSE(child.HardLimitExceeded());
+
+        child.Set(250);
+        ASSERT_EQ(parent.Usage(), 250);
+        ASSERT_TRUE(child.HardLimitExceeded());
+        ASSERT_EQ(parent.Peak(), 250);
+
+        child.Release(200);
+        ASSERT_EQ(parent.Usage(), 50);
+        ASSERT_EQ(parent.Peak(), 250);
+    }
+    // 子节点析构后剩余用量从父节点扣除
+    ASSERT_EQ(parent.ChildrenCount(), 0U);
+    ASSERT_EQ(parent.Usage(), 0);
+}
+
+TEST(MemTracker, Scoped) {
+    MemTracker tracker("scoped", nullptr);
+    {
+        ScopedMemConsume mem(&tracker, 100);
+        ASSERT_EQ(tracker.Usage(), 100);
+    }
+    ASSERT_EQ(tracker.Usage(), 0);
+    ASSERT_EQ(tracker.Peak(), 100);
+}
+
+}  // namespace
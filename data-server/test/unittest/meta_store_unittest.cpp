@@ -55,6 +55,22 @@ TEST_F(MetaStoreTest, NodeID) {
     ASSERT_EQ(node2, node);
 }
 
+TEST_F(MetaStoreTest, StorageMode) {
+    bool mvcc = true, exists = true;
+    auto s = store_->LoadStorageMode(&mvcc, &exists);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_FALSE(exists);
+
+    for (bool expected : {true, false}) {
+        s = store_->SaveStorageMode(expected);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        s = store_->LoadStorageMode(&mvcc, &exists);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        ASSERT_TRUE(exists);
+        ASSERT_EQ(mvcc, expected);
+    }
+}
+
 TEST_F(MetaStoreTest, ApplyIndex) {
     uint64_t range_id = sharkstore::randomInt();
     uint64_t applied = 1;
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "monitor/metrics.h"
+#include "monitor/proc_collector.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore::monitor;
+using namespace sharkstore::monitor::metrics;
+
+static bool contains(const std::string& text, const std::string& line) {
+    return text.find(line + "\n") != std::string::npos;
+}
+
+TEST(Metrics, CounterAndGauge) {
+    Registry registry;
+    auto family = registry.AddCounter("test_requests_total", "Requests.", {"func", "code"});
+    ASSERT_EQ(family, registry.AddCounter("test_requests_total", "Requests.", {"func", "code"}));
+
+    auto c = family->WithLabels({"get", "ok"});
+    ASSERT_EQ(c, family->WithLabels({"get", "ok"}));
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([c] {
+            for (int j = 0; j < 1000; ++j) c->Inc();
+        });
+    }
+    for (auto& t : threads) t.join();
+    ASSERT_EQ(c->Value(), 8000U);
+    family->WithLabels({"put", "a\"b\\c"})->Inc(3);
+
+    auto g = registry.AddGauge("test_queue_size", "Queue size.")->WithLabels({});
+    g->Set(10);
+    g->Add(-15);
+    ASSERT_EQ(g->Value(), -5);
+
+    auto text = registry.Render();
+    ASSERT_TRUE(contains(text, "# HELP test_requests_total Requests.")) << text;
+    ASSERT_TRUE(contains(text, "# TYPE test_requests_total counter")) << text;
+    ASSERT_TRUE(contains(text, "test_requests_total{func=\"get\",code=\"ok\"} 8000")) << text;
+    ASSERT_TRUE(contains(text, "test_requests_total{func=\"put\",code=\"a\\\"b\\\\c\"} 3")) << text;
+    ASSERT_TRUE(contains(text, "# TYPE test_queue_size gauge")) << text;
+    ASSERT_TRUE(contains(text, "test_queue_size -5")) << text;
+}
+
+TEST(Metrics, Histogram) {
+    Registry registry;
+    auto h = registry.AddHistogram("test_duration_seconds", "Duration.", {"stage"},
+                                   {100, 1000}, 1e-6)->WithLabels({"raft"});
+    h->Observe(50);
+    h->Observe(100);
+    h->Observe(500);
+    h->Observe(5000);
+
+    Histogram::Snapshot snapshot;
+    h->Collect(&snapshot);
+    ASSERT_EQ(snapshot.cumulative, std::vector<uint64_t>({2, 3, 4}));
+    ASSERT_EQ(snapshot.count, 4U);
+    ASSERT_EQ(snapshot.sum, 5650U);
+
+    auto text = registry.Render();
+    ASSERT_TRUE(contains(text, "# TYPE test_duration_seconds histogram")) << text;
+    ASSERT_TRUE(contains(text, "test_duration_seconds_bucket{stage=\"raft\",le=\"0.0001\"} 2")) << text;
+    ASSERT_TRUE(contains(text, "test_duration_seconds_bucket{stage=\"raft\",le=\"0.001\"} 3")) << text;
+    ASSERT_TRUE(contains(text, "test_duration_seconds_bucket{stage=\"raft\",le=\"+Inf\"} 4")) << text;
+    ASSERT_TRUE(contains(text, "test_duration_seconds_sum{stage=\"raft\"} 0.00565")) << text;
+    ASSERT_TRUE(contains(text, "test_duration_seconds_count{stage=\"raft\"} 4")) << text;
+}
+
+TEST(Metrics, Collector) {
+    Registry registry;
+    int calls = 0;
+    auto id = registry.AddCollector([&calls](Writer* w) {
+        ++calls;
+        w->Header("test_collected", "Collected.", "gauge");
+        w->Sample("test_collected", Labels{{"k", "v"}}, 1.5);
+    });
+    auto text = registry.Render();
+    ASSERT_EQ(calls, 1);
+    ASSERT_TRUE(contains(text, "test_collected{k=\"v\"} 1.5")) << text;
+
+    registry.RemoveCollector(id);
+    text = registry.Render();
+    ASSERT_EQ(calls, 1);
+    ASSERT_EQ(text.find("test_collected"), std::string::npos);
+}
+
+TEST(Metrics, ParseProc) {
+    ProcSelfStat self;
+    std::string stat = "1234 (ds (main) x) S 1 1234 1234 0 -1 4194560 100 0 0 0 "
+                       "250 50 0 0 20 0 17 0 3000 104857600 2048 18446744073709551615";
+    ASSERT_TRUE(ParseProcSelfStat(stat, &self));
+    ASSERT_EQ(self.utime_ticks, 250U);
+    ASSERT_EQ(self.stime_ticks, 50U);
+    ASSERT_EQ(self.num_threads, 17U);
+    ASSERT_EQ(self.start_ticks, 3000U);
+    ASSERT_EQ(self.vsize, 104857600U);
+    ASSERT_EQ(self.rss_pages, 2048U);
+    ASSERT_FALSE(ParseProcSelfStat("1234 (ds) S 1 2 3", &self));
+
+    ProcCPUStat cpu;
+    uint64_t btime = 0;
+    std::string cpu_stat = "cpu  100 10 50 800 40 0 0 0 0 0\n"
+                           "cpu0 50 5 25 400 20 0 0 0 0 0\n"
+                           "intr 12345\n"
+                           "btime 1600000000\n";
+    ASSERT_TRUE(ParseProcCPUStat(cpu_stat, &cpu, &btime));
+    ASSERT_EQ(cpu.total_ticks, 1000U);
+    ASSERT_EQ(cpu.idle_ticks, 840U);
+    ASSERT_EQ(btime, 1600000000U);
+
+    uint64_t read_bytes = 0, write_bytes = 0;
+    std::string io = "rchar: 100\nwchar: 200\nsyscr: 1\nsyscw: 2\n"
+                     "read_bytes: 4096\nwrite_bytes: 8192\ncancelled_write_bytes: 0\n";
+    ASSERT_TRUE(ParseProcIO(io, &read_bytes, &write_bytes));
+    ASSERT_EQ(read_bytes, 4096U);
+    ASSERT_EQ(write_bytes, 8192U);
+}
+
+TEST(Metrics, ProcCollector) {
+    ProcCollector collector;
+    std::string text;
+    Writer writer(&text);
+    collector.Collect(&writer);
+    // 第二次抓取才有cpu使用率
+    collector.Collect(&writer);
+    ASSERT_NE(text.find("process_resident_memory_bytes "), std::string::npos) << text;
+    ASSERT_NE(text.find("process_open_fds "), std::string::npos) << text;
+}
+
+} /* namespace  */
@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <signal.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "base/util.h"
+#include "monitor/cpu_profiler.h"
 #include "monitor/isystemstatus.h"
 #include "monitor/statistics.h"
 
@@ -10,6 +17,7 @@ int main(int argc, char* argv[]) {
 
 namespace {
 
+using namespace sharkstore;
 using namespace sharkstore::monitor;
 
 TEST(Monitor, Basic) {
@@ -28,4 +36,73 @@ TEST(Monitor, Statistics) {
     s.ToString();
 }
 
+static uint64_t busyLoop(const std::atomic<bool>& stop) {
+    uint64_t x = 0;
+    while (!stop) {
+        for (int i = 0; i < 10000; ++i) x = x * 31 + i;
+    }
+    return x;
+}
+
+TEST(Monitor, CPUProfile) {
+    std::atomic<bool> stop = {false};
+    std::atomic<uint64_t> result = {0};
+    std::thread busy([&] { result = busyLoop(stop); });
+    sharkstore::AnnotateThread(busy.native_handle(), "busy_worker:0");
+    std::thread idle([&] { result = busyLoop(stop); });
+    sharkstore::AnnotateThread(idle.native_handle(), "other:0");
+
+    CPUProfileOptions opt;
+    opt.seconds = 1;
+    opt.frequency = 200;
+    opt.thread_prefixes = {"busy_worker"};
+    CPUProfileResult profile;
+    auto s = CPUProfiler::Instance()->Profile(opt, &profile);
+    stop = true;
+    busy.join();
+    idle.join();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_GT(profile.samples, 0U);
+    std::cout << profile.collapsed << std::endl;
+    // 只有busy_worker线程池的样本，线程编号被去掉
+    size_t pos = 0;
+    while (pos < profile.collapsed.size()) {
+        ASSERT_EQ(profile.collapsed.compare(pos, 12, "busy_worker;"), 0) << profile.collapsed;
+        pos = profile.collapsed.find('\n', pos) + 1;
+    }
+
+    opt.frequency = CPUProfiler::kMaxFrequency + 1;
+    ASSERT_EQ(CPUProfiler::Instance()->Profile(opt, &profile).code(), Status::kInvalidArgument);
+}
+
+TEST(Monitor, CPUProfileAgain) {
+    CPUProfileOptions opt;
+    opt.seconds = 1;
+    CPUProfileResult profile;
+    ASSERT_TRUE(CPUProfiler::Instance()->Profile(opt, &profile).ok());
+    // 停止后处理函数仍然安装着，迟到的SIGPROF不会终止进程
+    raise(SIGPROF);
+    // 上一次留下的是自己的处理函数，不当作被其他profiler占用
+    auto s = CPUProfiler::Instance()->Profile(opt, &profile);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+}
+
+// 会让之后的Profile都失败，放在最后
+TEST(Monitor, CPUProfileShutdown) {
+    CPUProfileOptions opt;
+    opt.seconds = CPUProfiler::kMaxSeconds;
+    CPUProfileResult profile;
+    Status s;
+    auto begin = std::chrono::steady_clock::now();
+    std::thread profiling([&] { s = CPUProfiler::Instance()->Profile(opt, &profile); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CPUProfiler::Instance()->Shutdown();
+    profiling.join();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(5));
+
+    ASSERT_EQ(CPUProfiler::Instance()->Profile(opt, &profile).code(),
+              Status::kShutdownInProgress);
+}
+
 } /* namespace  */
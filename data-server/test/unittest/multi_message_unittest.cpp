@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "common/multi_message.h"
+#include "common/socket_session_impl.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore::dataserver;
+using namespace sharkstore::dataserver::common;
+
+// 子请求的回应走SocketSessionImpl（发给MultiMessage），合并后的回应保存下来
+class TestSession : public SocketSession {
+public:
+    void Send(ProtoMessage* msg, google::protobuf::Message* resp) override {
+        if (msg->socket != nullptr) {
+            impl_.Send(msg, resp);
+            return;
+        }
+        ++replies;
+        result.reset(dynamic_cast<kvrpcpb::DsMultiResponse*>(resp));
+        delete msg;
+    }
+
+    int replies = 0;
+    std::unique_ptr<kvrpcpb::DsMultiResponse> result;
+
+private:
+    SocketSessionImpl impl_;
+};
+
+kvrpcpb::MultiSubRequest makeSubRequest(uint32_t func_id, uint64_t range_id) {
+    kvrpcpb::DsKvGetRequest req;
+    req.mutable_header()->set_range_id(range_id);
+    req.mutable_req()->set_key("key");
+
+    kvrpcpb::MultiSubRequest sub;
+    sub.set_func_id(func_id);
+    sub.set_body(req.SerializeAsString());
+    return sub;
+}
+
+TEST(MultiMessage, Reply) {
+    TestSession session;
+    auto msg = new ProtoMessage;
+    msg->header.func_id = 150;
+    msg->header.msg_id = 12345;
+
+    auto multi = new MultiMessage(msg, &session, 4);
+
+    // 0: 正常回应
+    auto sub0 = multi->NewSubMessage(0, makeSubRequest(101, 1));
+    ASSERT_EQ(sub0->header.func_id, 101);
+    ASSERT_EQ(sub0->header.msg_id, 0);
+    kvrpcpb::DsKvGetRequest req0;
+    ASSERT_TRUE(req0.ParseFromArray(sub0->body.data(), static_cast<int>(sub0->body.size())));
+    ASSERT_EQ(req0.header().range_id(), 1U);
+
+    // 1: 不执行，直接设置错误
+    multi->SetError(1, 1001, "not allowed");
+
+    // 2: 回应错误（不是leader）
+    auto sub2 = multi->NewSubMessage(2, makeSubRequest(101, 2));
+    // 3: 没有回应直接丢弃
+    auto sub3 = multi->NewSubMessage(3, makeSubRequest(100, 3));
+
+    // 乱序回应
+    auto resp2 = new kvrpcpb::DsKvGetResponse;
+    resp2->mutable_header()->mutable_error()->mutable_not_leader()->set_range_id(2);
+    session.Send(sub2, resp2);
+    delete sub3;
+
+    auto resp0 = new kvrpcpb::DsKvGetResponse;
+    resp0->mutable_resp()->set_value("value");
+    session.Send(sub0, resp0);
+
+    // 分发结束之前不回应
+    ASSERT_EQ(session.replies, 0);
+    multi->Release();
+    ASSERT_EQ(session.replies, 1);
+
+    auto& result = *session.result;
+    ASSERT_EQ(result.resps_size(), 4);
+
+    kvrpcpb::DsKvGetResponse get_resp;
+    ASSERT_EQ(result.resps(0).func_id(), 101U);
+    ASSERT_FALSE(result.resps(0).has_error());
+    ASSERT_TRUE(get_resp.ParseFromString(result.resps(0).body()));
+    ASSERT_EQ(get_resp.resp().value(), "value");
+
+    ASSERT_EQ(result.resps(1).func_id(), 1001U);
+    ASSERT_TRUE(result.resps(1).body().empty());
+    ASSERT_EQ(result.resps(1).error().message(), "not allowed");
+
+    ASSERT_FALSE(result.resps(2).has_error());
+    ASSERT_TRUE(get_resp.ParseFromString(result.resps(2).body()));
+    ASSERT_TRUE(get_resp.header().error().has_not_leader());
+    ASSERT_EQ(get_resp.header().error().not_leader().range_id(), 2U);
+
+    ASSERT_EQ(result.resps(3).func_id(), 100U);
+    ASSERT_TRUE(result.resps(3).has_error());
+}
+
+TEST(MultiMessage, Empty) {
+    TestSession session;
+    auto multi = new MultiMessage(new ProtoMessage, &session, 0);
+    multi->Release();
+    ASSERT_EQ(session.replies, 1);
+    ASSERT_EQ(session.result->resps_size(), 0);
+}
+
+}  // namespace
@@ -0,0 +1,297 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "base/util.h"
+#include "frame/sf_util.h"
+#include "storage/iterator.h"
+#include "storage/mvcc.h"
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+using namespace sharkstore::dataserver;
+using namespace sharkstore::dataserver::storage;
+
+static const uint64_t kGCWindowMs = 10000;
+
+class MvccTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char path[] = "/tmp/sharkstore_ds_mvcc_test_XXXXXX";
+        char *tmp = mkdtemp(path);
+        ASSERT_TRUE(tmp != NULL);
+        tmp_dir_ = tmp;
+        open(tmp_dir_ + "/mvcc", true, &db_);
+    }
+
+    void TearDown() override {
+        delete db_;
+        delete plain_db_;
+        if (!tmp_dir_.empty()) {
+            sharkstore::RemoveDirAll(tmp_dir_.c_str());
+        }
+    }
+
+    void open(const std::string& path, bool mvcc, rocksdb::DB **db) {
+        rocksdb::Options ops;
+        ops.create_if_missing = true;
+        if (mvcc) {
+            ops.compaction_filter_factory =
+                std::make_shared<MvccGCFilterFactory>(kGCWindowMs);
+        }
+        auto s = rocksdb::DB::Open(ops, path, db);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+
+    void put(const std::string& key, uint64_t version, const std::string& value) {
+        auto s = db_->Put(rocksdb::WriteOptions(), EncodeMvccKey(key, version),
+                          EncodeMvccValue(value));
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+
+    void del(const std::string& key, uint64_t version) {
+        auto s = db_->Put(rocksdb::WriteOptions(), EncodeMvccKey(key, version),
+                          EncodeMvccDeletion());
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+
+    std::string get(const std::string& key, uint64_t version) {
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(rocksdb::ReadOptions()));
+        std::string value;
+        auto s = MvccGet(it.get(), key, version, &value);
+        return s.ok() ? value : "<none>";
+    }
+
+    // 返回version时[start, limit)内可见的key=value
+    std::string scan(const std::string& start, const std::string& limit, uint64_t version) {
+        Iterator it(db_->NewIterator(rocksdb::ReadOptions()), start, limit, version);
+        std::string result;
+        while (it.Valid()) {
+            result += it.key() + "=" + it.value() + ";";
+            it.Next();
+        }
+        return result;
+    }
+
+    uint64_t countRaw() {
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(rocksdb::ReadOptions()));
+        uint64_t count = 0;
+        for (it->SeekToFirst(); it->Valid(); it->Next()) {
+            ++count;
+        }
+        return count;
+    }
+
+    static uint64_t sstSize(rocksdb::DB *db) {
+        uint64_t size = 0;
+        db->GetIntProperty("rocksdb.total-sst-files-size", &size);
+        return size;
+    }
+
+protected:
+    std::string tmp_dir_;
+    rocksdb::DB *db_ = nullptr;
+    rocksdb::DB *plain_db_ = nullptr;
+};
+
+TEST_F(MvccTest, Encoding) {
+    auto k1 = EncodeMvccKey("abc", 1);
+    auto k2 = EncodeMvccKey("abc", 2);
+    // 新版本排在前面
+    ASSERT_LT(k2, k1);
+    ASSERT_LT(k1, EncodeMvccKey("abd", kMaxVersion));
+
+    std::string key;
+    uint64_t version = 0;
+    ASSERT_TRUE(DecodeMvccKey(k2, &key, &version));
+    ASSERT_EQ(key, "abc");
+    ASSERT_EQ(version, 2U);
+    ASSERT_FALSE(DecodeMvccKey("short", &key, &version));
+    ASSERT_FALSE(DecodeMvccKey("abc" + std::string(kMvccVersionSize, '\x01'), &key, &version));
+
+    // 包含转义字符的key
+    std::string zero("a\x00" "b", 3);
+    ASSERT_TRUE(DecodeMvccKey(EncodeMvccKey(zero, 7), &key, &version));
+    ASSERT_EQ(key, zero);
+    ASSERT_EQ(version, 7U);
+
+    auto v = EncodeMvccValue("value");
+    ASSERT_FALSE(IsMvccDeletion(v));
+    ASSERT_EQ(MvccValue(v).ToString(), "value");
+    ASSERT_TRUE(IsMvccDeletion(EncodeMvccDeletion()));
+    // 空值也是一个有效版本
+    ASSERT_FALSE(IsMvccDeletion(EncodeMvccValue("")));
+}
+
+TEST_F(MvccTest, PrefixKeys) {
+    // 有前缀关系的key，所有版本都按原始key排序
+    std::vector<std::string> keys = {"a", std::string("a\x00", 2), std::string("a\x00\x00", 3),
+                                     std::string("a\x01", 2), "ab", "abc", "b"};
+    for (size_t i = 0; i + 1 < keys.size(); ++i) {
+        ASSERT_LT(EncodeMvccKey(keys[i], 0), EncodeMvccKey(keys[i + 1], kMaxVersion)) << i;
+        // 区间边界
+        ASSERT_LE(EncodeMvccBound(keys[i]), EncodeMvccKey(keys[i], kMaxVersion)) << i;
+        ASSERT_LT(EncodeMvccKey(keys[i], 0), EncodeMvccBound(keys[i + 1])) << i;
+    }
+
+    put("a", 10, "a10");
+    put("a", 30, "a30");
+    put("ab", 20, "ab20");
+    put("abc", 20, "abc20");
+    put(std::string("a\x00", 2), 20, "a0");
+    del("ab", 40);
+
+    ASSERT_EQ(get("a", 20), "a10");
+    ASSERT_EQ(get("a", kMaxVersion), "a30");
+    ASSERT_EQ(get("ab", 30), "ab20");
+    ASSERT_EQ(get("ab", kMaxVersion), "<none>");
+    const std::string a0("a\x00", 2);
+    ASSERT_EQ(scan("a", "b", 25), "a=a10;" + a0 + "=a0;ab=ab20;abc=abc20;");
+    ASSERT_EQ(scan("a", "b", kMaxVersion), "a=a30;" + a0 + "=a0;abc=abc20;");
+    ASSERT_EQ(scan("ab", "abd", kMaxVersion), "abc=abc20;");
+    ASSERT_EQ(scan(a0, "ab", kMaxVersion), a0 + "=a0;");
+}
+
+TEST_F(MvccTest, ReadAtVersion) {
+    put("a", 10, "a10");
+    put("a", 20, "a20");
+    del("a", 30);
+    put("b", 15, "b15");
+    put("c", 25, "c25");
+    put("d", 10, "d10");
+
+    ASSERT_EQ(get("a", 9), "<none>");
+    ASSERT_EQ(get("a", 10), "a10");
+    ASSERT_EQ(get("a", 19), "a10");
+    ASSERT_EQ(get("a", 20), "a20");
+    ASSERT_EQ(get("a", 30), "<none>");
+    ASSERT_EQ(get("a", kMaxVersion), "<none>");
+    ASSERT_EQ(get("x", kMaxVersion), "<none>");
+
+    ASSERT_EQ(scan("a", "z", 5), "");
+    ASSERT_EQ(scan("a", "z", 10), "a=a10;d=d10;");
+    ASSERT_EQ(scan("a", "z", 20), "a=a20;b=b15;d=d10;");
+    ASSERT_EQ(scan("a", "z", 29), "a=a20;b=b15;c=c25;d=d10;");
+    ASSERT_EQ(scan("a", "z", kMaxVersion), "b=b15;c=c25;d=d10;");
+    ASSERT_EQ(scan("b", "d", kMaxVersion), "b=b15;c=c25;");
+}
+
+TEST_F(MvccTest, GC) {
+    auto now = static_cast<uint64_t>(getticks());
+    // 安全点之前的多个版本只保留最新一个
+    put("a", now - 50000, "a1");
+    put("a", now - 40000, "a2");
+    put("a", now, "a3");
+    // 安全点之前最新的版本是删除，全量compaction时整个key回收
+    put("b", now - 50000, "b1");
+    del("b", now - 40000);
+    // 安全点之后的版本都保留
+    put("c", now - 1000, "c1");
+    put("c", now, "c2");
+    ASSERT_EQ(countRaw(), 7U);
+
+    ASSERT_TRUE(db_->Flush(rocksdb::FlushOptions()).ok());
+    rocksdb::CompactRangeOptions cops;
+    cops.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForce;
+    ASSERT_TRUE(db_->CompactRange(cops, nullptr, nullptr).ok());
+
+    ASSERT_EQ(countRaw(), 4U);
+    ASSERT_EQ(get("a", now - 40000), "a2");
+    ASSERT_EQ(get("a", now - 50000), "<none>");
+    ASSERT_EQ(get("a", kMaxVersion), "a3");
+    ASSERT_EQ(get("b", now - 50000), "<none>");
+    ASSERT_EQ(get("c", now - 1000), "c1");
+    ASSERT_EQ(scan("a", "z", kMaxVersion), "a=a3;c=c2;");
+}
+
+// 微基准：每个key有kVersions个版本，比较mvcc和原地更新两种布局的
+// 读延迟、写入字节和compaction后的空间
+TEST_F(MvccTest, Bench) {
+    const int kKeys = 20000;
+    const int kVersions = 4;
+    open(tmp_dir_ + "/plain", false, &plain_db_);
+
+    auto now = static_cast<uint64_t>(getticks());
+    uint64_t mvcc_bytes = 0, plain_bytes = 0;
+    std::string value(100, 'v');
+    for (int v = 0; v < kVersions; ++v) {
+        for (int i = 0; i < kKeys; ++i) {
+            char buf[32] = {'\0'};
+            snprintf(buf, sizeof(buf), "key_%08d", i);
+            // 只有最后一个版本在gc窗口内
+            auto version = v + 1 < kVersions ? now - 100000 + v : now;
+            auto mkey = EncodeMvccKey(buf, version);
+            auto mvalue = EncodeMvccValue(value);
+            ASSERT_TRUE(db_->Put(rocksdb::WriteOptions(), mkey, mvalue).ok());
+            ASSERT_TRUE(plain_db_->Put(rocksdb::WriteOptions(), buf, value).ok());
+            mvcc_bytes += mkey.size() + mvalue.size();
+            plain_bytes += strlen(buf) + value.size();
+        }
+    }
+    for (auto db : {db_, plain_db_}) {
+        ASSERT_TRUE(db->Flush(rocksdb::FlushOptions()).ok());
+    }
+    auto mvcc_flushed = sstSize(db_);
+    auto plain_flushed = sstSize(plain_db_);
+    for (auto db : {db_, plain_db_}) {
+        ASSERT_TRUE(db->CompactRange(rocksdb::CompactRangeOptions(), nullptr, nullptr).ok());
+    }
+
+    auto bench_get = [&](bool mvcc) {
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(rocksdb::ReadOptions()));
+        std::string got;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kKeys; ++i) {
+            char buf[32] = {'\0'};
+            snprintf(buf, sizeof(buf), "key_%08d", (i * 7919) % kKeys);
+            if (mvcc) {
+                EXPECT_TRUE(MvccGet(it.get(), buf, kMaxVersion, &got).ok());
+            } else {
+                EXPECT_TRUE(plain_db_->Get(rocksdb::ReadOptions(), buf, &got).ok());
+            }
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start).count() / kKeys;
+    };
+    auto mvcc_get_ns = bench_get(true);
+    auto plain_get_ns = bench_get(false);
+
+    auto bench_scan = [&](rocksdb::DB *db, bool mvcc) {
+        auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<Iterator> it;
+        if (mvcc) {
+            it.reset(new Iterator(db->NewIterator(rocksdb::ReadOptions()), "key_", "key_~",
+                                  kMaxVersion));
+        } else {
+            it.reset(new Iterator(db->NewIterator(rocksdb::ReadOptions()), "key_", "key_~"));
+        }
+        int count = 0;
+        for (; it->Valid(); it->Next()) {
+            ++count;
+        }
+        EXPECT_EQ(count, kKeys);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start).count() / kKeys;
+    };
+    auto mvcc_scan_ns = bench_scan(db_, true);
+    auto plain_scan_ns = bench_scan(plain_db_, false);
+
+    std::cout << "get: mvcc " << mvcc_get_ns << " ns/key, plain " << plain_get_ns << " ns/key\n"
+              << "scan: mvcc " << mvcc_scan_ns << " ns/key, plain " << plain_scan_ns << " ns/key\n"
+              << "written bytes: mvcc " << mvcc_bytes << ", plain " << plain_bytes << "\n"
+              << "sst before gc: mvcc " << mvcc_flushed << ", plain " << plain_flushed
+              << "; after compaction: mvcc " << sstSize(db_) << ", plain "
+              << sstSize(plain_db_) << std::endl;
+    // gc后每个key剩下安全点前后各一个版本
+    ASSERT_EQ(countRaw(), static_cast<uint64_t>(kKeys) * 2);
+}
+
+}  // namespace
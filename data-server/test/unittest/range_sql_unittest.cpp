@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
 
 #include "helper/range_test_fixture.h"
 #include "helper/helper_util.h"
@@ -95,6 +97,74 @@ TEST_F(RangeTestFixture, NotLeader) {
     }
 }
 
+TEST_F(RangeTestFixture, StaleRead) {
+    SetLeader(GetNodeID());
+
+    std::vector<std::vector<std::string>> rows = {
+            {"1", "user1", "111"},
+            {"2", "user2", "222"},
+    };
+    {
+        DsInsertRequest req;
+        MakeHeader(req.mutable_header());
+        InsertRequestBuilder builder(table_.get());
+        builder.AddRows(rows);
+        req.mutable_req()->CopyFrom(builder.Build());
+        DsInsertResponse resp;
+        auto s = TestInsert(req, &resp);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        ASSERT_FALSE(resp.header().has_error()) << resp.header().error().ShortDebugString();
+    }
+
+    // 变成follower
+    SetLeader(2);
+    // 没有指定max_staleness_ms
+    {
+        DsSelectRequest req;
+        MakeHeader(req.mutable_header());
+        SelectRequestBuilder builder(table_.get());
+        builder.AddAllFields();
+        *req.mutable_req() = builder.Build();
+        DsSelectResponse resp;
+        auto s = TestSelect(req, &resp);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        ASSERT_TRUE(resp.header().has_error());
+        ASSERT_TRUE(resp.header().error().has_not_leader());
+    }
+    // 已应用的数据在max_staleness_ms之内
+    {
+        DsSelectRequest req;
+        MakeHeader(req.mutable_header());
+        req.mutable_header()->set_max_staleness_ms(60 * 1000);
+        SelectRequestBuilder builder(table_.get());
+        builder.AddAllFields();
+        *req.mutable_req() = builder.Build();
+        DsSelectResponse resp;
+        auto s = TestSelect(req, &resp);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        ASSERT_FALSE(resp.header().has_error()) << resp.header().error().ShortDebugString();
+        SelectResultParser parser(req.req(), resp.resp());
+        s = parser.Match(rows);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    // 超过max_staleness_ms
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        DsSelectRequest req;
+        MakeHeader(req.mutable_header());
+        req.mutable_header()->set_max_staleness_ms(10);
+        SelectRequestBuilder builder(table_.get());
+        builder.AddAllFields();
+        *req.mutable_req() = builder.Build();
+        DsSelectResponse resp;
+        auto s = TestSelect(req, &resp);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+        ASSERT_TRUE(resp.header().has_error());
+        ASSERT_TRUE(resp.header().error().has_not_leader());
+        ASSERT_EQ(resp.header().error().not_leader().leader().node_id(), 2);
+    }
+}
+
 TEST_F(RangeTestFixture, StaleEpoch) {
     SetLeader(GetNodeID());
     auto old_ver = range_->options().range_epoch().version();
@@ -142,6 +212,71 @@ TEST_F(RangeTestFixture, StaleEpoch) {
     }
 }
 
+TEST_F(RangeTestFixture, BatchSplit) {
+    SetLeader(GetNodeID());
+    auto old_meta = range_->options();
+
+    std::vector<std::string> keys;
+    for (char c : {'\x20', '\x40', '\x60'}) {
+        std::string key;
+        EncodeKeyPrefix(&key, table_->GetID());
+        key.push_back(c);
+        keys.push_back(key);
+    }
+    std::vector<std::string> split_keys;
+    auto s = range_->PreSplit(0, keys, 0, &split_keys);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(split_keys, keys);
+
+    // master对每个分裂点的回应，顺序可能打乱
+    std::vector<mspb::AskSplitResponse> resps;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        mspb::AskSplitResponse resp;
+        *resp.mutable_range() = old_meta;
+        resp.set_split_key(keys[i]);
+        resp.set_new_range_id(11 + i);
+        for (const auto &peer : old_meta.peers()) {
+            resp.add_new_peer_ids(peer.id() + 10 * (i + 1));
+        }
+        resps.push_back(resp);
+    }
+    for (auto i : {2, 0}) {
+        auto resp = resps[i];
+        range_->AdminSplit(resp);
+        // 重复的回应
+        resp = resps[i];
+        range_->AdminSplit(resp);
+        // 没收齐之前不分裂
+        ASSERT_EQ(range_->options().range_epoch().version(), old_meta.range_epoch().version());
+        ASSERT_TRUE(context_->FindRange(11 + i) == nullptr);
+    }
+    auto last = resps[1];
+    range_->AdminSplit(last);
+
+    // 原range只剩第一段，版本相当于分裂了三次
+    auto meta = range_->options();
+    ASSERT_EQ(meta.end_key(), keys[0]);
+    ASSERT_EQ(meta.range_epoch().version(), old_meta.range_epoch().version() + 3);
+    ASSERT_EQ(GetSplitRangeID(), 11U);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto rng = context_->FindRange(11 + i);
+        ASSERT_TRUE(rng != nullptr);
+        auto new_meta = rng->options();
+        ASSERT_EQ(new_meta.start_key(), keys[i]);
+        ASSERT_EQ(new_meta.end_key(), i + 1 < keys.size() ? keys[i + 1] : old_meta.end_key());
+        ASSERT_EQ(new_meta.range_epoch().version(), 1U);
+        ASSERT_EQ(new_meta.peers_size(), old_meta.peers_size());
+        for (int j = 0; j < new_meta.peers_size(); ++j) {
+            ASSERT_EQ(new_meta.peers(j).id(), old_meta.peers(j).id() + 10 * (i + 1));
+            ASSERT_EQ(new_meta.peers(j).node_id(), old_meta.peers(j).node_id());
+        }
+    }
+
+    // 旧版本的分裂请求被忽略
+    range_->AdminSplit(resps[1]);
+    ASSERT_EQ(range_->options().range_epoch().version(), meta.range_epoch().version());
+}
+
 TEST_F(RangeTestFixture, CURD) {
     SetLeader(GetNodeID());
 
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include "common/ds_encoding.h"
+#include "helper/helper_util.h"
+#include "helper/store_test_fixture.h"
+#include "proto/gen/redispb.pb.h"
+
+int main(int argc, char* argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using namespace sharkstore;
+using namespace sharkstore::test::helper;
+using namespace sharkstore::dataserver;
+
+class StoreRedisTest : public StoreTestFixture {
+public:
+    StoreRedisTest() : StoreTestFixture(CreateAccountTable()) {}
+
+protected:
+    // 与proxy相同的编码：表前缀 + ns + key
+    std::string redisKey(const std::string& key) {
+        std::string buf;
+        EncodeKeyPrefix(&buf, table_->GetID());
+        EncodeUvarintAscending(&buf, 1);
+        EncodeBytesAscending(&buf, key.c_str(), key.size());
+        return buf;
+    }
+
+    redispb::Command command(redispb::CmdType type, const std::string& key,
+                             const std::vector<std::string>& fields = {},
+                             const std::vector<std::string>& values = {}) {
+        redispb::Command cmd;
+        cmd.set_type(type);
+        cmd.set_key(redisKey(key));
+        for (const auto& f : fields) {
+            cmd.add_fields(f);
+        }
+        for (const auto& v : values) {
+            cmd.add_values(v);
+        }
+        return cmd;
+    }
+
+    redispb::Reply execute(const redispb::Command& cmd, Status::Code expected = Status::kOk) {
+        redispb::Reply reply;
+        Status s;
+        if (Store::IsRedisWrite(cmd.type())) {
+            s = store_->RedisWrite(cmd, &reply);
+        } else {
+            s = store_->RedisRead(cmd, &reply);
+        }
+        EXPECT_EQ(s.code(), expected) << s.ToString();
+        return reply;
+    }
+
+    static std::vector<std::string> toVector(
+        const ::google::protobuf::RepeatedPtrField<std::string>& values) {
+        return std::vector<std::string>(values.begin(), values.end());
+    }
+};
+
+TEST_F(StoreRedisTest, Hash) {
+    auto reply = execute(command(redispb::HSet, "h", {"f1", "f2", "f1"}, {"a", "b", "c"}));
+    ASSERT_EQ(reply.integer(), 2);
+    reply = execute(command(redispb::HSet, "h", {"f2", "f3"}, {"bb", "d"}));
+    ASSERT_EQ(reply.integer(), 1);
+
+    reply = execute(command(redispb::HGet, "h", {"f1"}));
+    ASSERT_TRUE(reply.has_value());
+    ASSERT_EQ(reply.value(), "c");
+    reply = execute(command(redispb::HGet, "h", {"f4"}));
+    ASSERT_FALSE(reply.has_value());
+
+    reply = execute(command(redispb::HGetAll, "h"));
+    ASSERT_EQ(toVector(reply.fields()), std::vector<std::string>({"f1", "f2", "f3"}));
+    ASSERT_EQ(toVector(reply.values()), std::vector<std::string>({"c", "bb", "d"}));
+    ASSERT_EQ(execute(command(redispb::HLen, "h")).integer(), 3);
+
+    // 自增
+    auto incr = command(redispb::HIncrBy, "h", {"n"});
+    incr.set_incr(5);
+    ASSERT_EQ(execute(incr).integer(), 5);
+    incr.set_incr(-7);
+    ASSERT_EQ(execute(incr).integer(), -2);
+    ASSERT_EQ(execute(command(redispb::HLen, "h")).integer(), 4);
+    incr.set_fields(0, "f1");
+    execute(incr, Status::kInvalidArgument);
+
+    ASSERT_EQ(execute(command(redispb::HDel, "h", {"f1", "f1", "f4"})).integer(), 1);
+    ASSERT_EQ(execute(command(redispb::HDel, "h", {"f2", "f3", "n"})).integer(), 3);
+    ASSERT_EQ(execute(command(redispb::HLen, "h")).integer(), 0);
+    ASSERT_EQ(execute(command(redispb::HGetAll, "h")).fields_size(), 0);
+
+    // 所有元素删除后key可以被其他类型使用
+    ASSERT_EQ(execute(command(redispb::SAdd, "h", {"m"})).integer(), 1);
+}
+
+TEST_F(StoreRedisTest, List) {
+    ASSERT_EQ(execute(command(redispb::RPush, "l", {}, {"b", "c"})).integer(), 2);
+    ASSERT_EQ(execute(command(redispb::LPush, "l", {}, {"a", "z"})).integer(), 4);
+
+    auto range = command(redispb::LRange, "l");
+    range.set_start(0);
+    range.set_stop(-1);
+    ASSERT_EQ(toVector(execute(range).values()), std::vector<std::string>({"z", "a", "b", "c"}));
+    range.set_start(1);
+    range.set_stop(2);
+    ASSERT_EQ(toVector(execute(range).values()), std::vector<std::string>({"a", "b"}));
+    range.set_start(-2);
+    range.set_stop(100);
+    ASSERT_EQ(toVector(execute(range).values()), std::vector<std::string>({"b", "c"}));
+    range.set_start(3);
+    range.set_stop(1);
+    ASSERT_EQ(execute(range).values_size(), 0);
+
+    auto index = command(redispb::LIndex, "l");
+    index.set_start(-1);
+    ASSERT_EQ(execute(index).value(), "c");
+    index.set_start(4);
+    ASSERT_FALSE(execute(index).has_value());
+
+    auto reply = execute(command(redispb::LPop, "l"));
+    ASSERT_TRUE(reply.has_value());
+    ASSERT_EQ(reply.value(), "z");
+    ASSERT_EQ(execute(command(redispb::RPop, "l")).value(), "c");
+    ASSERT_EQ(execute(command(redispb::LLen, "l")).integer(), 2);
+    ASSERT_EQ(execute(command(redispb::RPop, "l")).value(), "b");
+    ASSERT_EQ(execute(command(redispb::RPop, "l")).value(), "a");
+    ASSERT_FALSE(execute(command(redispb::LPop, "l")).has_value());
+    ASSERT_EQ(execute(command(redispb::LLen, "l")).integer(), 0);
+}
+
+TEST_F(StoreRedisTest, Set) {
+    ASSERT_EQ(execute(command(redispb::SAdd, "s", {"b", "a", "b"})).integer(), 2);
+    ASSERT_EQ(execute(command(redispb::SAdd, "s", {"a", "c"})).integer(), 1);
+    ASSERT_EQ(execute(command(redispb::SIsMember, "s", {"a"})).integer(), 1);
+    ASSERT_EQ(execute(command(redispb::SIsMember, "s", {"d"})).integer(), 0);
+    ASSERT_EQ(toVector(execute(command(redispb::SMembers, "s")).fields()),
+              std::vector<std::string>({"a", "b", "c"}));
+    ASSERT_EQ(execute(command(redispb::SCard, "s")).integer(), 3);
+    ASSERT_EQ(execute(command(redispb::SRem, "s", {"a", "d"})).integer(), 1);
+    ASSERT_EQ(execute(command(redispb::SCard, "s")).integer(), 2);
+}
+
+TEST_F(StoreRedisTest, ZSet) {
+    auto zadd = command(redispb::ZAdd, "z", {"a", "b", "c", "d"});
+    for (auto score : {3.0, -1.5, 10.0, 0.0}) {
+        zadd.add_scores(score);
+    }
+    ASSERT_EQ(execute(zadd).integer(), 4);
+
+    // 更新分数
+    zadd = command(redispb::ZAdd, "z", {"c", "e"});
+    zadd.add_scores(-2);
+    zadd.add_scores(3);
+    ASSERT_EQ(execute(zadd).integer(), 1);
+    ASSERT_EQ(execute(command(redispb::ZCard, "z")).integer(), 5);
+
+    auto reply = execute(command(redispb::ZScore, "z", {"c"}));
+    ASSERT_TRUE(reply.has_value());
+    ASSERT_EQ(reply.scores(0), -2);
+
+    auto range = command(redispb::ZRangeByScore, "z");
+    range.set_min_score(-100);
+    range.set_max_score(100);
+    reply = execute(range);
+    ASSERT_EQ(toVector(reply.fields()), std::vector<std::string>({"c", "b", "d", "a", "e"}));
+    ASSERT_EQ(std::vector<double>(reply.scores().begin(), reply.scores().end()),
+              std::vector<double>({-2, -1.5, 0, 3, 3}));
+
+    range.set_min_score(-1.5);
+    range.set_max_score(3);
+    range.set_limit(3);
+    ASSERT_EQ(toVector(execute(range).fields()), std::vector<std::string>({"b", "d", "a"}));
+
+    ASSERT_EQ(execute(command(redispb::ZRem, "z", {"b", "x"})).integer(), 1);
+    range.set_limit(0);
+    ASSERT_EQ(toVector(execute(range).fields()), std::vector<std::string>({"d", "a", "e"}));
+    ASSERT_EQ(execute(command(redispb::ZCard, "z")).integer(), 4);
+}
+
+TEST_F(StoreRedisTest, WrongType) {
+    execute(command(redispb::SAdd, "k", {"m"}));
+    execute(command(redispb::HSet, "k", {"f"}, {"v"}), Status::kInvalidArgument);
+    execute(command(redispb::RPush, "k", {}, {"v"}), Status::kInvalidArgument);
+    execute(command(redispb::HLen, "k"), Status::kInvalidArgument);
+    execute(command(redispb::HSet, "k2", {"f"}, {}), Status::kInvalidArgument);
+    execute(command(redispb::HGet, "k2"), Status::kInvalidArgument);
+}
+
+} /* namespace  */
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "base/util.h"
+#include "common/ds_config.h"
 #include "helper/store_test_fixture.h"
 #include "proto/gen/watchpb.pb.h"
 
@@ -628,6 +629,31 @@ TEST_F(StoreTest, DeleteWhere) {
 
 
 
+TEST_F(StoreTest, RangeDeleteKeepLimit) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 10; ++i) {
+        keys.push_back("range-delete-" + std::to_string(i));
+        auto s = store_->Put(keys.back(), "value");
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    // 压到L0以下的同一个文件里，文件的最大key恰好是limit
+    ASSERT_TRUE(db_->Flush(rocksdb::FlushOptions()).ok());
+    ASSERT_TRUE(db_->CompactRange(rocksdb::CompactRangeOptions(), nullptr, nullptr).ok());
+
+    auto s = store_->RangeDelete(keys.front(), keys.back());
+    ASSERT_TRUE(s.ok()) << s.ToString();
+
+    std::string value;
+    for (size_t i = 0; i + 1 < keys.size(); ++i) {
+        s = store_->Get(keys[i], &value);
+        ASSERT_EQ(s.code(), sharkstore::Status::kNotFound) << keys[i];
+    }
+    // limit不在删除区间内
+    s = store_->Get(keys.back(), &value);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(value, "value");
+}
+
 TEST_F(StoreTest, Watch) {
     {
         watchpb::KvWatchPutRequest req;
@@ -753,6 +779,82 @@ TEST_F(StoreTest, Watch) {
     }
 }
 
+TEST_F(StoreTest, WatchLog) {
+    auto old_retention = ds_config.range_config.watch_log_retention;
+    ds_config.range_config.watch_log_retention = 10;
+
+    auto start = encodeWatchKey({"a"});
+    auto limit = NextComparable(start);
+    std::vector<storage::WatchLogEntry> entries;
+
+    // 日志开启前没有日志
+    auto s = store_->ScanWatchLog(start, limit, 1, &entries);
+    ASSERT_EQ(s.code(), sharkstore::Status::kCompacted);
+
+    for (int i = 1; i <= 5; ++i) {
+        s = store_->PutWithWatchLog(encodeWatchKey({"a", "x" + std::to_string(i)}),
+                                    "value" + std::to_string(i), i);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    s = store_->DeleteWithWatchLog(encodeWatchKey({"a", "x2"}), 6);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    // 不在区间内
+    s = store_->PutWithWatchLog(encodeWatchKey({"b", "y"}), "value", 7);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+
+    std::string value;
+    ASSERT_EQ(store_->Get(encodeWatchKey({"a", "x2"}), &value).code(), sharkstore::Status::kNotFound);
+    ASSERT_TRUE(store_->Get(encodeWatchKey({"a", "x3"}), &value).ok());
+    ASSERT_EQ(value, "value3");
+
+    // 只返回版本3之后的增量
+    s = store_->ScanWatchLog(start, limit, 3, &entries);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(entries.size(), 3U);
+    ASSERT_EQ(entries[0].version, 4);
+    ASSERT_EQ(entries[0].type, watchpb::PUT);
+    ASSERT_EQ(entries[0].key, encodeWatchKey({"a", "x4"}));
+    ASSERT_EQ(entries[0].value, "value4");
+    ASSERT_EQ(entries[1].version, 5);
+    ASSERT_EQ(entries[2].version, 6);
+    ASSERT_EQ(entries[2].type, watchpb::DELETE);
+    ASSERT_EQ(entries[2].key, encodeWatchKey({"a", "x2"}));
+    ASSERT_TRUE(entries[2].value.empty());
+
+    entries.clear();
+    s = store_->ScanWatchLog(start, limit, 0, &entries);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(entries.size(), 6U);
+
+    entries.clear();
+    s = store_->ScanWatchLog(start, limit, 7, &entries);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_TRUE(entries.empty());
+
+    // 超出保留窗口的日志被删除
+    for (int i = 8; i <= 30; ++i) {
+        s = store_->PutWithWatchLog(encodeWatchKey({"a", "z"}), "value" + std::to_string(i), i);
+        ASSERT_TRUE(s.ok()) << s.ToString();
+    }
+    s = store_->ScanWatchLog(start, limit, 5, &entries);
+    ASSERT_EQ(s.code(), sharkstore::Status::kCompacted);
+
+    entries.clear();
+    s = store_->ScanWatchLog(start, limit, 25, &entries);
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    ASSERT_EQ(entries.size(), 5U);
+    ASSERT_EQ(entries.back().version, 30);
+    ASSERT_EQ(entries.back().value, "value30");
+
+    // 清空数据时日志一起删除
+    s = store_->Truncate();
+    ASSERT_TRUE(s.ok()) << s.ToString();
+    s = store_->ScanWatchLog(start, limit, 25, &entries);
+    ASSERT_EQ(s.code(), sharkstore::Status::kCompacted);
+
+    ds_config.range_config.watch_log_retention = old_retention;
+}
+
 TEST_F(StoreTest, Split) {
     // parse watch key
     {
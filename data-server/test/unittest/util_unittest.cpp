@@ -177,4 +177,40 @@ TEST(Util, MiddleKey) {
     }
 }
 
+TEST(Util, SplitKeys) {
+    {
+        std::string left("\x01\x00\x00\x00\x00\x00\x00\x00\x01", 9);
+        std::string right("\x01\x00\x00\x00\x00\x00\x00\x00\x02", 9);
+        auto keys = FindSplitKeys(left, right, 4);
+        ASSERT_EQ(keys.size(), 3U);
+        ASSERT_EQ(keys[0], std::string("\x01\x00\x00\x00\x00\x00\x00\x00\x01\x40", 10));
+        ASSERT_EQ(keys[1], std::string("\x01\x00\x00\x00\x00\x00\x00\x00\x01\x80", 10));
+        ASSERT_EQ(keys[2], std::string("\x01\x00\x00\x00\x00\x00\x00\x00\x01\xc0", 10));
+        // 两份和FindMiddle一致
+        keys = FindSplitKeys(left, right, 2);
+        ASSERT_EQ(keys.size(), 1U);
+        ASSERT_EQ(keys[0], FindMiddle(left, right));
+    }
+    {
+        auto keys = FindSplitKeys("a", "c", 2);
+        ASSERT_EQ(keys.size(), 1U);
+        ASSERT_EQ(keys[0], "b");
+        keys = FindSplitKeys("a", "e", 10);
+        ASSERT_EQ(keys.size(), 9U);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_LT(i == 0 ? std::string("a") : keys[i - 1], keys[i]);
+        }
+        ASSERT_LT(keys.back(), "e");
+    }
+    {
+        // 区间内分不出这么多key
+        std::string left("a");
+        std::string right("a\x00\x00\x00\x00\x00\x00\x00\x00\x03", 10);
+        auto keys = FindSplitKeys(left, right, 10);
+        ASSERT_LE(keys.size(), 2U);
+        ASSERT_TRUE(FindSplitKeys("c", "a", 4).empty());
+        ASSERT_TRUE(FindSplitKeys("a", "c", 1).empty());
+    }
+}
+
 } /* namespace  */